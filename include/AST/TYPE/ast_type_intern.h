@@ -0,0 +1,80 @@
+
+#ifndef _ISAAC_AST_TYPE_INTERN_H
+#define _ISAAC_AST_TYPE_INTERN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    =========================== ast_type_intern.h ===========================
+    Module for interning AST types
+
+    Each distinct type that is interned into a table maps to exactly one
+    canonical copy, which has its hash and a small integer id precomputed.
+    Two canonical types are identical if and only if they are the same
+    pointer (or have the same id), so they can be compared and kept
+    around without being cloned.
+
+    Interning a type costs one hash and (on a hit) one comparison, the
+    same as a lookup in any other hashed cache, so it only pays off for
+    keys that are kept around. Each IR module has a table, which keys the
+    special function cache (by id) and the vtree list (by pointer).
+
+    Canonical types are never modified and belong to the table that
+    created them. Regular (mutable) AST types are unaffected.
+    --------------------------------------------------------------------------
+*/
+
+#include "AST/ast_type_lean.h"
+#include "UTIL/ground.h"
+#include "UTIL/hash.h"
+
+// ---------------- ast_canonical_type_t ----------------
+// The canonical copy of an interned AST type
+// NOTE: Must never be modified
+typedef struct {
+    ast_type_t type;
+    hash_t hash;
+    length_t id; // Dense, in order of interning, usable as an array index
+} ast_canonical_type_t;
+
+// ---------------- ast_type_intern_table_t ----------------
+// A table of canonical AST types
+typedef struct {
+    // Canonical types by id, each separately heap allocated so they never move
+    ast_canonical_type_t **types;
+    length_t length;
+    length_t capacity;
+
+    // Open-addressed slots which contain (id + 1), or zero when empty
+    // NOTE: 'slots_capacity' is always a power of two
+    length_t *slots;
+    length_t slots_capacity;
+} ast_type_intern_table_t;
+
+// ---------------- ast_type_intern_table_init ----------------
+// Initializes a table of canonical AST types
+void ast_type_intern_table_init(ast_type_intern_table_t *table);
+
+// ---------------- ast_type_intern_table_free ----------------
+// Frees a table of canonical AST types, including every canonical type in it
+void ast_type_intern_table_free(ast_type_intern_table_t *table);
+
+// ---------------- ast_type_intern ----------------
+// Returns the canonical copy of an AST type,
+// creating it if the type hasn't been interned before
+// Will never return NULL
+// NOTE: Does not take any ownership of 'type'
+const ast_canonical_type_t *ast_type_intern(ast_type_intern_table_t *table, const ast_type_t *type);
+
+// ---------------- ast_type_intern_find ----------------
+// Returns the canonical copy of an AST type,
+// or NULL if the type hasn't been interned
+const ast_canonical_type_t *ast_type_intern_find(ast_type_intern_table_t *table, const ast_type_t *type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_AST_TYPE_INTERN_H
@@ -10,7 +10,7 @@
 // A set collection of AST types
 typedef struct { set_t impl; } ast_type_set_t;
 
-void ast_type_set_init(ast_type_set_t *set, length_t num_buckets);
+void ast_type_set_init(ast_type_set_t *set, length_t starting_capacity);
 bool ast_type_set_insert(ast_type_set_t *set, ast_type_t *type);
 void ast_type_set_traverse(ast_type_set_t *set, void (*run_func)(ast_type_t*));
 void ast_type_set_free(ast_type_set_t *set);
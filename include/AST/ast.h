@@ -18,11 +18,13 @@ extern "C" {
 #include "AST/ast_expr.h"
 #include "AST/ast_layout.h"
 #include "AST/ast_named_expression.h"
+#include "AST/ast_pool.h"
 #include "AST/ast_type.h"
 #include "AST/meta_directives.h"
 #include "UTIL/color.h"
 #include "UTIL/ground.h"
 #include "UTIL/index_id_list.h"
+#include "UTIL/map.h"
 #include "UTIL/trait.h"
 
 struct compiler;
@@ -250,6 +252,14 @@ typedef struct {
     ast_poly_composite_t *poly_composites;
     length_t poly_composites_length;
     length_t poly_composites_capacity;
+
+    // Indices (plus one) of composites by name, and of polymorphic composites
+    // by name and number of generics (see 'ast_add_composite' and 'ast_add_poly_composite')
+    map_t composites_by_name;
+    map_t poly_composites_by_name;
+
+    // Memory pool for expressions and type elements
+    ast_pool_t pool;
 } ast_t;
 
 #define LIBRARY_KIND_NONE           0x00
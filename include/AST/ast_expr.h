@@ -212,7 +212,7 @@ typedef struct { DERIVE_AST_EXPR; weak_cstr_t name; } ast_expr_variable_t;
 typedef struct {
     DERIVE_AST_EXPR;
     ast_expr_t *value;
-    strong_cstr_t member;
+    weak_cstr_t member; // Interned in the compiler's symbol table
 } ast_expr_member_t;
 
 // ---------------- ast_expr_func_addr_t ----------------
@@ -653,8 +653,9 @@ ast_expr_t *ast_expr_create_return(source_t source, ast_expr_t *value, ast_expr_
 
 // ---------------- ast_expr_create_member ----------------
 // Creates a member expression
-// NOTE: Ownership of 'value' and 'member_name' will be taken
-ast_expr_t *ast_expr_create_member(ast_expr_t *value, strong_cstr_t member_name, source_t source);
+// NOTE: Ownership of 'value' will be taken
+// NOTE: 'member_name' must be interned in the compiler's symbol table
+ast_expr_t *ast_expr_create_member(ast_expr_t *value, weak_cstr_t member_name, source_t source);
 
 // ---------------- ast_expr_create_access ----------------
 // Creates an array access expression
@@ -113,8 +113,19 @@ typedef struct {
 
     // Whether this field map doesn't contain any overlapping fields
     bool is_simple;
+
+    // Optional open-addressed index from field name to arrow,
+    // where each slot contains (arrow index + 1), or zero when empty
+    // NOTE: 'slots_capacity' is always a power of two
+    // NOTE: Only built for field maps with many arrows, otherwise NULL
+    length_t *slots;
+    length_t slots_capacity;
 } ast_field_map_t;
 
+// ---------------- AST_FIELD_MAP_INDEX_THRESHOLD ----------------
+// Minimum number of arrows before a field map is worth indexing
+#define AST_FIELD_MAP_INDEX_THRESHOLD 16
+
 // ---------------- ast_field_map_init ----------------
 // Constructs an empty AST field map
 void ast_field_map_init(ast_field_map_t *field_map);
@@ -303,6 +314,12 @@ bool ast_field_maps_identical(ast_field_map_t *field_map_a, ast_field_map_t *fie
 // Adds an arrow from individual components to an 'ast_field_map_t'
 void ast_field_map_add(ast_field_map_t *field_map, strong_cstr_t name, ast_layout_endpoint_t endpoint);
 
+// ---------------- ast_field_map_build_index ----------------
+// Builds a hash index for finding fields by name,
+// if the field map has enough arrows for it to be worthwhile.
+// Once built, the index is kept up to date by 'ast_field_map_add'
+void ast_field_map_build_index(ast_field_map_t *field_map);
+
 // ---------------- ast_field_map_find ----------------
 // Finds the endpoint which a name points to within
 // an 'ast_field_map_t'
@@ -0,0 +1,110 @@
+
+#ifndef _ISAAC_AST_POOL_H
+#define _ISAAC_AST_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    =============================== ast_pool.h ===============================
+    Module for allocating AST nodes in bulk
+
+    Expression nodes and type elements are allocated from the pool of the
+    AST that is being worked on, so that related nodes are next to each
+    other in memory. Each stage that works on an AST selects its pool for
+    the duration of that stage (see 'ast_pool_use'). The selection is per
+    thread, so other threads are never affected by it.
+
+    Every node has a small header that records the pool it came from, so
+    releasing a node never has to search for its pool. Released nodes are
+    kept on a free list of their pool for reuse by later nodes of the same
+    size, and all of the pool's memory is freed at once when the pool is.
+
+    When no pool is in use, nodes are allocated with 'malloc' as usual.
+    ---------------------------------------------------------------------------
+*/
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "UTIL/ground.h"
+
+#define AST_POOL_ALLOCATION_ALIGNMENT sizeof(void*)
+
+// Released nodes up to this size are reused, larger ones are left until the pool is freed
+#define AST_POOL_MAX_REUSED_SIZE 256
+#define AST_POOL_SIZE_CLASSES (AST_POOL_MAX_REUSED_SIZE / AST_POOL_ALLOCATION_ALIGNMENT + 1)
+
+// ---------------- ast_alloc_init ----------------
+// Like 'malloc_init', except for AST nodes (see 'ast_alloc')
+#define ast_alloc_init(TYPE, ...) (TYPE*) memcpy(ast_alloc(sizeof(TYPE)), (TYPE[]){ __VA_ARGS__ }, sizeof(TYPE))
+
+// ---------------- ast_pool_fragment_t ----------------
+// A memory fragment within an 'ast_pool_t'
+typedef struct {
+    char *memory;
+    length_t used;
+    length_t capacity;
+} ast_pool_fragment_t;
+
+// ---------------- ast_pool_t ----------------
+// A memory pool containing the nodes of an AST
+typedef struct ast_pool {
+    ast_pool_fragment_t *fragments;
+    length_t length;
+    length_t capacity;
+
+    // Released nodes by size class, linked through their first word
+    void *free_lists[AST_POOL_SIZE_CLASSES];
+} ast_pool_t;
+
+// ---------------- ast_alloc_header_t ----------------
+// Header in front of every AST node
+typedef struct {
+    ast_pool_t *pool; // Pool that owns the node, or NULL if it was allocated with 'malloc'
+    length_t size;    // Size of the node (rounded up to the allocation alignment)
+} ast_alloc_header_t;
+
+// ---------------- ast_pool_init ----------------
+// Initializes an AST memory pool
+// NOTE: Memory isn't reserved until the first allocation
+void ast_pool_init(ast_pool_t *pool);
+
+// ---------------- ast_pool_free ----------------
+// Frees all memory allocated by an AST memory pool
+// If the pool is in use by the calling thread, nodes will be allocated normally afterwards
+void ast_pool_free(ast_pool_t *pool);
+
+// ---------------- ast_pool_alloc ----------------
+// Allocates memory for an AST node in an AST memory pool
+void *ast_pool_alloc(ast_pool_t *pool, length_t bytes);
+
+// ---------------- ast_pool_owns ----------------
+// Returns whether an AST node was allocated from an AST memory pool
+bool ast_pool_owns(ast_pool_t *pool, const void *memory);
+
+// ---------------- ast_pool_use ----------------
+// Sets the pool that the calling thread allocates AST nodes from,
+// or NULL to allocate them normally
+// Returns the pool that was previously in use, so it can be restored afterwards
+ast_pool_t *ast_pool_use(ast_pool_t *pool);
+
+// ---------------- ast_alloc ----------------
+// Allocates memory for an AST node
+void *ast_alloc(length_t bytes);
+
+// ---------------- ast_memclone ----------------
+// Creates a copy of an AST node (see 'ast_alloc')
+void *ast_memclone(const void *memory, length_t bytes);
+
+// ---------------- ast_release ----------------
+// Releases memory for an AST node
+// NOTE: 'memory' must have been allocated by 'ast_alloc' (or be NULL)
+void ast_release(void *memory);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_AST_POOL_H
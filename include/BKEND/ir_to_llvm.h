@@ -10,6 +10,7 @@
 
 #include <llvm-c/TargetMachine.h>
 
+#include "BKEND/llvm_type_cache.h"
 #include "DRVR/compiler.h"
 #include "DRVR/object.h"
 #include "IR/ir.h"
@@ -82,9 +83,34 @@ typedef struct {
     LLVMValueRef deinit_function;
 } llvm_static_variable_info_t;
 
+// ---------------- llvm_partition_plan_t ----------------
+// Which partition each function definition of an LLVM module belongs to
+// (used when generating machine code with multiple jobs)
+// NOTE: Global variable definitions always belong to partition zero
+typedef struct {
+    weak_cstr_t *function_names;
+    length_t *function_partitions;
+    length_t functions_length;
+} llvm_partition_plan_t;
+
+// ---------------- llvm_partition_job_t ----------------
+// Work for generating machine code for a single partition
+typedef struct {
+    compiler_t *compiler;
+    const char *bitcode;
+    size_t bitcode_size;
+    const llvm_partition_plan_t *plan;
+    length_t partition;
+    LLVMTargetMachineRef target_machine;
+    weak_cstr_t objfile_filename;
+    bool optimize;             // False when the module was already optimized before partitioning
+    errorcode_t errorcode;
+} llvm_partition_job_t;
+
 // ---------------- llvm_context_t ----------------
 // A general container for the LLVM exporting context
 typedef struct {
+    LLVMContextRef context; // Owned per compilation, so types don't pile up in the global context
     LLVMModuleRef module;
     LLVMBuilderRef builder;
     value_catalog_t *catalog;
@@ -107,6 +133,8 @@ typedef struct {
     llvm_static_variables_t static_variables;
     llvm_static_variable_info_t static_variable_info;
 
+    llvm_type_cache_t type_cache;
+
     LLVMTypeRef i64_type;
     LLVMTypeRef f64_type;
 } llvm_context_t;
@@ -160,6 +188,11 @@ void llvm_create_vtable_check(llvm_context_t *llvm, length_t func_skeleton_index
 // Converts optimization level to LLVM optimization constant
 LLVMCodeGenOptLevel ir_to_llvm_config_optlvl(compiler_t *compiler);
 
+// ---------------- ir_to_llvm_config_passes ----------------
+// Converts optimization level to LLVM mid-level optimization pipeline,
+// returns NULL if no passes should be run
+maybe_null_weak_cstr_t ir_to_llvm_config_passes(compiler_t *compiler);
+
 // ---------------- llvm_string_table_find ----------------
 // Finds the global variable data for an entry in the string table,
 // returns NULL if not found
@@ -0,0 +1,31 @@
+
+#ifndef _ISAAC_LLVM_JIT_H
+#define _ISAAC_LLVM_JIT_H
+
+/*
+    ================================ llvm_jit.h ================================
+    Module for executing finished LLVM modules in-process (see '--jit')
+
+    Instead of writing an object file, linking it, and then starting
+    the resulting executable, the module is handed to LLVM's ORC LLJIT,
+    and its 'main' function is called directly
+    ----------------------------------------------------------------------------
+*/
+
+#include <llvm-c/TargetMachine.h>
+#include <llvm-c/Types.h>
+
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "UTIL/ground.h"
+
+// ---------------- llvm_jit_execute ----------------
+// Executes the 'main' function of a finished LLVM module in-process
+// Global constructors and destructors are run before and after 'main',
+// and the exit code of 'main' is stored in 'compiler->result_exitcode'
+// Returns ALT_FAILURE if the module can't be executed in-process,
+// in which case it should be linked and executed normally instead
+// NOTE: Takes ownership of 'target_machine', but not of 'module'
+errorcode_t llvm_jit_execute(compiler_t *compiler, object_t *object, LLVMModuleRef module, LLVMTargetMachineRef target_machine);
+
+#endif // _ISAAC_LLVM_JIT_H
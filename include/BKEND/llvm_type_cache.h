@@ -0,0 +1,94 @@
+
+#ifndef _ISAAC_LLVM_TYPE_CACHE_H
+#define _ISAAC_LLVM_TYPE_CACHE_H
+
+/*
+    ============================ llvm_type_cache.h ============================
+    Module for caching the LLVM types of IR composite types
+
+    Each IR composite type is only converted to an LLVM type once. Structure
+    types are emitted as named (identified) LLVM struct types, and are uniqued
+    by their fields, so that IR types with the same layout keep mapping
+    to the same LLVM type, as they did with literal struct types
+    ---------------------------------------------------------------------------
+*/
+
+#include <llvm-c/Types.h>
+#include <stdbool.h>
+
+#include "IR/ir_type.h"
+#include "UTIL/ground.h"
+#include "UTIL/hash.h"
+
+// ---------------- llvm_type_cache_entry_t ----------------
+// Cached information about an IR type
+typedef struct {
+    ir_type_t *ir_type;
+    LLVMTypeRef llvm_type;     // NULL when not converted yet
+    maybe_null_strong_cstr_t name;
+} llvm_type_cache_entry_t;
+
+// ---------------- llvm_type_cache_struct_t ----------------
+// A named LLVM struct type, identified by its fields
+typedef struct {
+    LLVMTypeRef *fields;
+    length_t fields_length;
+    bool is_packed;
+    hash_t hash;
+    LLVMTypeRef llvm_type;
+} llvm_type_cache_struct_t;
+
+// ---------------- llvm_type_cache_t ----------------
+// Cache of LLVM types for IR composite types
+typedef struct {
+    // Context that named struct types are created in
+    LLVMContextRef context;
+
+    // Open-addressed by IR type pointer, empty when 'ir_type' is NULL
+    // NOTE: IR types used as keys must never live in a rolled-back pool region
+    // NOTE: 'entries_capacity' is always a power of two
+    llvm_type_cache_entry_t *entries;
+    length_t entries_length;
+    length_t entries_capacity;
+
+    llvm_type_cache_struct_t *structs;
+    length_t structs_length;
+    length_t structs_capacity;
+
+    // Open-addressed slots which contain (struct index + 1), or zero when empty
+    // NOTE: 'struct_slots_capacity' is always a power of two
+    length_t *struct_slots;
+    length_t struct_slots_capacity;
+} llvm_type_cache_t;
+
+// ---------------- llvm_type_cache_init ----------------
+// Initializes an LLVM type cache that creates struct types in 'context'
+void llvm_type_cache_init(llvm_type_cache_t *cache, LLVMContextRef context);
+
+// ---------------- llvm_type_cache_free ----------------
+// Frees an LLVM type cache
+void llvm_type_cache_free(llvm_type_cache_t *cache);
+
+// ---------------- llvm_type_cache_find ----------------
+// Finds the cache entry for an IR type
+// Returns NULL if the IR type doesn't have an entry
+// NOTE: The returned pointer is only valid until the next modification of the cache
+llvm_type_cache_entry_t *llvm_type_cache_find(llvm_type_cache_t *cache, ir_type_t *ir_type);
+
+// ---------------- llvm_type_cache_insert ----------------
+// Remembers the LLVM type that an IR type was converted to
+void llvm_type_cache_insert(llvm_type_cache_t *cache, ir_type_t *ir_type, LLVMTypeRef llvm_type);
+
+// ---------------- llvm_type_cache_name ----------------
+// Gives a name to the LLVM struct type that will be created for an IR type
+// Has no effect if the IR type already has a name
+// NOTE: Takes ownership of 'name'
+void llvm_type_cache_name(llvm_type_cache_t *cache, ir_type_t *ir_type, strong_cstr_t name);
+
+// ---------------- llvm_type_cache_struct ----------------
+// Gets the named LLVM struct type for a list of fields
+// If one doesn't exist yet, one will be created with the given name (or an unnamed one if 'name' is NULL)
+// NOTE: Does not take ownership of 'fields' or 'name'
+LLVMTypeRef llvm_type_cache_struct(llvm_type_cache_t *cache, LLVMTypeRef *fields, length_t fields_length, bool is_packed, maybe_null_weak_cstr_t name);
+
+#endif // _ISAAC_LLVM_TYPE_CACHE_H
@@ -31,7 +31,7 @@ extern "C" {
 #define BRIDGE_VAR_STATIC       TRAIT_4 // Variable is to static (global-like)
 
 typedef struct {
-    weak_cstr_t name;
+    weak_cstr_t name;        // Interned in the compiler's symbol table
     ast_type_t *ast_type;
 
     index_id_t id;           // ID of the variable within the function stack (only applies to non-static variables)
@@ -85,6 +85,7 @@ void bridge_scope_free(bridge_scope_t *scope);
 
 // ---------------- bridge_scope_find_var ----------------
 // Finds a variable within a bridge variable scope
+// NOTE: 'name' must be interned in the compiler's symbol table
 bridge_var_t* bridge_scope_find_var(bridge_scope_t *scope, const char *name);
 
 // ---------------- bridge_scope_find_var_by_id ----------------
@@ -95,6 +96,7 @@ bridge_var_t *bridge_scope_find_var_by_id(bridge_scope_t *scope, length_t id);
 // Checks to see if a variable with that name was already declared
 // within the variable list of the given scope.
 // NOTE: THIS DOESN'T CHECK PARENT SCOPES, ONLY THE SCOPE GIVEN IS CHECKED
+// NOTE: 'name' must be interned in the compiler's symbol table
 bool bridge_scope_var_already_in_list(bridge_scope_t *scope, const char *name);
 
 // ---------------- bridge_scope_var_nearest ----------------
@@ -0,0 +1,106 @@
+
+#ifndef _ISAAC_BUILD_CACHE_H
+#define _ISAAC_BUILD_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ============================== build_cache.h ==============================
+    Module for reusing the output of identical previous builds (see '--cache')
+
+    After all files have been parsed, the contents of every object, the
+    compiler options, and the compiler itself are hashed (with SHA-256)
+    into a key. If an
+    output was previously stored under that key, it is copied into place and
+    the rest of the compilation is skipped.
+
+    Cached outputs are stored in '$XDG_CACHE_HOME/adept/' if it's set,
+    otherwise they are stored in the 'cache/' folder of the compiler root.
+    The cache is bounded, the least recently used entries are evicted
+    whenever a new entry is stored
+    ---------------------------------------------------------------------------
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "UTIL/ground.h"
+#include "UTIL/sha256.h"
+
+// Bounds for the cache directory, see 'build_cache_evict'
+#define BUILD_CACHE_MAX_ENTRIES 64
+#define BUILD_CACHE_MAX_BYTES   (256ull * 1024 * 1024)
+
+// ---------------- build_cache_digest_t ----------------
+// Digest of data being hashed for a cache key
+// NOTE: Uses SHA-256, since a collision would silently reuse the wrong output
+typedef struct {
+    sha256_t sha256;
+} build_cache_digest_t;
+
+// ---------------- build_cache_key_t ----------------
+// 128-bit cache key (the first half of a finished digest)
+typedef struct {
+    uint64_t a;
+    uint64_t b;
+} build_cache_key_t;
+
+// ---------------- build_cache_t ----------------
+// Cache entry for the current build
+typedef struct {
+    strong_cstr_t directory;         // Cache directory (with /)
+    strong_cstr_t entry_filename;    // Where the cached output is stored
+    strong_cstr_t output_filename;   // Where the build leaves its output
+    length_t warnings_length;        // Number of warnings already reported when the key was made
+} build_cache_t;
+
+// ---------------- build_cache_init ----------------
+// Computes the cache entry for a build whose files have all been parsed
+// Returns FAILURE if the output of this build can't be cached
+errorcode_t build_cache_init(build_cache_t *cache, compiler_t *compiler, object_t *object);
+
+// ---------------- build_cache_free ----------------
+// Frees a cache entry
+void build_cache_free(build_cache_t *cache);
+
+// ---------------- build_cache_restore ----------------
+// Copies the previously cached output into place, and marks it as recently used
+// Returns false if no output is cached for this build
+bool build_cache_restore(build_cache_t *cache, compiler_t *compiler);
+
+// ---------------- build_cache_store ----------------
+// Stores the output of a successful build in the cache
+// Outputs of builds that reported new warnings aren't stored, since they wouldn't be shown again
+void build_cache_store(build_cache_t *cache, compiler_t *compiler);
+
+// ---------------- build_cache_evict ----------------
+// Removes the least recently used entries from a cache directory (with /)
+// until at most 'max_entries' entries and 'max_bytes' bytes remain
+// NOTE: The most recently used entry is always kept
+void build_cache_evict(weak_cstr_t directory, length_t max_entries, uint64_t max_bytes);
+
+// ---------------- build_cache_directory ----------------
+// Gets the directory that cached files are stored in (with /)
+// NOTE: The directory might not exist yet
+strong_cstr_t build_cache_directory(compiler_t *compiler);
+
+// ---------------- build_cache_digest_* ----------------
+// Adds data to a digest
+void build_cache_digest_init(build_cache_digest_t *digest);
+void build_cache_digest_bytes(build_cache_digest_t *digest, const void *data, length_t size);
+void build_cache_digest_u64(build_cache_digest_t *digest, uint64_t value);
+void build_cache_digest_string(build_cache_digest_t *digest, maybe_null_weak_cstr_t string);
+
+// ---------------- build_cache_digest_finish ----------------
+// Finishes a digest, and writes the resulting key to 'out_key'
+void build_cache_digest_finish(build_cache_digest_t *digest, build_cache_key_t *out_key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_BUILD_CACHE_H
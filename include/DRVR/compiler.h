@@ -20,8 +20,10 @@ extern "C" {
 #include "AST/ast_type_lean.h"
 #include "DRVR/config.h"
 #include "DRVR/object.h"
+#include "UTIL/filename.h"
 #include "UTIL/ground.h"
 #include "UTIL/index_id_list.h"
+#include "UTIL/intern.h"
 #include "UTIL/string_builder.h"
 #include "UTIL/string_list.h"
 #include "UTIL/trait.h"
@@ -47,6 +49,10 @@ extern "C" {
 #define COMPILER_TYPE_COLON               TRAIT_2_3
 #define COMPILER_WINDOWED                 TRAIT_2_4
 #define COMPILER_OUTPUT_DYNAMIC_LIBRARY   TRAIT_2_5
+#define COMPILER_DEMAND_IR                TRAIT_2_6
+#define COMPILER_JIT                      TRAIT_2_7
+#define COMPILER_CACHE                    TRAIT_2_8
+#define COMPILER_CACHE_VERBOSE            TRAIT_2_9
 
 // Possible compiler trait checks
 #define COMPILER_NULL_CHECKS      TRAIT_1
@@ -68,6 +74,8 @@ extern "C" {
 #define OPTIMIZATION_DEFAULT            0x02
 #define OPTIMIZATION_AGGRESSIVE         0x03
 #define OPTIMIZATION_ABSOLUTELY_NOTHING 0x04
+#define OPTIMIZATION_SIZE               0x05
+#define OPTIMIZATION_MIN_SIZE           0x06
 
 // Possible compiler debug trait options
 #define COMPILER_DEBUG_STAGES          TRAIT_1
@@ -87,6 +95,9 @@ typedef struct {
     source_t source;
 } adept_error_t, adept_warning_t;
 
+struct lex_pool;
+struct server;
+
 // ---------------- compiler_t ----------------
 // Structure that encapsulates the compiler
 typedef struct compiler {
@@ -104,8 +115,9 @@ typedef struct compiler {
     // Compiler command-line configuration options
     trait_t traits;            // COMPILER_* options
     char *output_filename;     // owned c-string
-    unsigned int optimization; // 0 - 3 using OPTIMIZATION_* constants
+    unsigned int optimization; // Using OPTIMIZATION_* constants
     trait_t result_flags;      // Results flag (for internal use)
+    int result_exitcode;       // Exit code of the executed result (for internal use)
     trait_t checks;
     trait_t ignore;
     troolean use_pic;          // Generate using PIC relocation model
@@ -124,14 +136,51 @@ typedef struct compiler {
 
     bool show_unused_variables_how_to_disable;
     unsigned int cross_compile_for;
+
+    // Target CPU and target features to generate code for
+    // If NULL, then use generic CPU / no additional features
+    // A target CPU of "native" means the host CPU and its features
+    maybe_null_strong_cstr_t target_cpu;
+    maybe_null_strong_cstr_t target_features;
+
+    // Number of threads to lex imports and generate machine code with (see '--jobs=N')
+    // When greater than one, the LLVM module is split into that many partitions
+    unsigned int jobs;
+
+    // Linker for the compiler driver to use when linking (see '--fuse-ld=<NAME>')
+    // If NULL, then the default linker of the compiler driver is used
+    maybe_null_strong_cstr_t fuse_ld;
     
     weak_cstr_t entry_point;
     string_builder_t user_linker_options;
+    strong_cstr_list_t user_linker_args; // Same as 'user_linker_options', but one item per argument
     strong_cstr_list_t user_search_paths;
     strong_cstr_list_t windows_resources;
 
+    // Files read by 'embed' expressions, recorded so they can be part of the build cache key
+    strong_cstr_list_t embedded_files;
+
     weak_cstr_t init_point;
     weak_cstr_t deinit_point;
+
+    // Interned identifiers shared by the token lists of all objects
+    // (word tokens point into this table rather than owning their strings)
+    intern_table_t symbols;
+
+    // Absolute filenames of objects, for quickly checking whether a file was already imported
+    // NOTE: Filled in lazily, only the first 'object_filenames_length' objects have been added
+    intern_table_t object_filenames;
+    length_t object_filenames_length;
+
+    // Remembered results of finding and resolving imports (see 'parse_find_import' and 'parse_resolve_import')
+    filename_memo_t import_locations;
+    filename_memo_t import_absolutes;
+
+    // Compile server that this compiler is running a request for (see '--server'), otherwise NULL
+    struct server *server;
+
+    // Threads lexing imported files while parsing (see '--jobs=N'), otherwise NULL
+    struct lex_pool *lex_pool;
 } compiler_t;
 
 #define CROSS_COMPILE_NONE    0x00
@@ -142,7 +191,9 @@ typedef struct compiler {
 
 // ---------------- compiler_run ----------------
 // Runs a compiler with the given arguments.
-errorcode_t compiler_run(compiler_t *compiler, int argc, char **argv);
+// Returns the exit code for the compiler process, which is the exit
+// code of the result when it was successfully compiled and executed
+int compiler_run(compiler_t *compiler, int argc, char **argv);
 
 // ---------------- compiler_invoke ----------------
 // Invokes a compiler with arguments.
@@ -208,10 +259,27 @@ void show_root(compiler_t *compiler);
 // Gets the string identifier of the compiler
 strong_cstr_t compiler_get_string(void);
 
+// ---------------- compiler_autofill_output_filename ----------------
+// Fills in the output filename if one wasn't given, and adds the
+// platform's executable or library extension if it's missing
+void compiler_autofill_output_filename(compiler_t *compiler, object_t *object);
+
+// ---------------- compiler_execute_result ----------------
+// Executes the resulting executable, and stores its exit code in 'compiler->result_exitcode'
+void compiler_execute_result(compiler_t *compiler);
+
 // ---------------- compiler_add_user_linker_option ----------------
 // Adds user-supplied linker option
 void compiler_add_user_linker_option(compiler_t *compiler, weak_cstr_t option);
 
+// ---------------- compiler_set_target_cpu ----------------
+// Sets the CPU to generate code for ("native" for host CPU)
+void compiler_set_target_cpu(compiler_t *compiler, weak_cstr_t cpu);
+
+// ---------------- compiler_set_target_features ----------------
+// Sets the target features to generate code for (e.g. "+avx2,+fma")
+void compiler_set_target_features(compiler_t *compiler, weak_cstr_t features);
+
 // ---------------- compiler_add_user_search_path ----------------
 // Adds user-supplied search path
 void compiler_add_user_search_path(compiler_t *compiler, weak_cstr_t search_path, maybe_null_weak_cstr_t current_file);
@@ -38,6 +38,9 @@ typedef struct object {
     strong_cstr_t full_filename; // Absolute filename (used for testing duplicate imports)
     strong_cstr_t buffer;        // Text buffer
     length_t buffer_length;      // Length of text buffer
+    bool buffer_is_mapped;       // Whether text buffer is memory-mapped (see 'file_text_map')
+    length_t *line_offsets;      // Offset in text buffer of the first character of each line
+    length_t line_offsets_length;
     tokenlist_t tokenlist;       // Token list
     ast_t ast;                   // Abstract syntax tree
 
@@ -0,0 +1,68 @@
+
+#ifndef _ISAAC_SERVER_H
+#define _ISAAC_SERVER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ================================= server.h =================================
+    Module for running a persistent compile server (see '--server')
+
+    The server reads the config, initializes LLVM, and then waits for
+    requests from 'adept-client' on a local socket. Each request is compiled
+    in a child process forked from the server, so every compilation starts
+    from a clean state while inheriting everything the server has warmed up.
+    Requests from multiple clients are compiled concurrently. Only clients
+    running as the same user as the server are served.
+
+    After a request, the server lexes every file the compilation read, and
+    keeps the resulting token lists. Later compilations take these instead of
+    lexing again, as long as the files haven't changed on disk.
+    ----------------------------------------------------------------------------
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "UTIL/ground.h"
+
+// ---------------- server_file_stamp_t ----------------
+// Identifies the version of a file on disk
+typedef struct {
+    uint64_t device;
+    uint64_t inode;
+    uint64_t size;
+    int64_t mtime_seconds;
+    int64_t mtime_nanoseconds;
+} server_file_stamp_t;
+
+// ---------------- server_t ----------------
+// State kept warm by a compile server
+typedef struct server {
+    compiler_t *compiler;        // Compiler that started the server (has the config, location, etc.)
+    compiler_t warm;             // Objects holding pre-lexed files, and the identifiers they use
+    server_file_stamp_t *stamps; // Stamps of files when they were lexed (parallel to 'warm.objects')
+    length_t stamps_capacity;
+    strong_cstr_t socket_filename;
+    int listener;
+} server_t;
+
+// ---------------- handle_server ----------------
+// Handles '--server' and '--server=<SOCKET>'
+// Returns true if the compile server was invoked by user
+bool handle_server(compiler_t *compiler, int argc, char **argv);
+
+// ---------------- server_take_warm_object ----------------
+// Gives an object the pre-lexed token list for its file, if the server has
+// an up-to-date one. Returns false if the file must be lexed normally.
+bool server_take_warm_object(server_t *server, object_t *object);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_SERVER_H
@@ -0,0 +1,102 @@
+
+#ifndef _ISAAC_SERVER_PROTOCOL_H
+#define _ISAAC_SERVER_PROTOCOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ============================ server_protocol.h ============================
+    Module for talking to a compile server over a local socket (see '--server')
+
+    A request carries the working directory, program arguments, and
+    environment of the client, along with its standard input, output, and
+    error file descriptors. The server compiles using those file descriptors
+    directly, so diagnostics appear exactly as if the client compiled by
+    itself. Once finished, the server replies with the exit code.
+
+    NOTE: Only depends on the C standard library and POSIX, so that it can
+    be used by the thin 'adept-client' executable
+    ---------------------------------------------------------------------------
+*/
+
+#include <stdint.h>
+
+#include "UTIL/ground.h"
+
+#define SERVER_PROTOCOL_MAGIC 0x53504441 // "ADPS"
+#define SERVER_PROTOCOL_VERSION 1
+
+// Largest request body a server will accept
+#define SERVER_PROTOCOL_MAX_BODY_SIZE (16 * 1024 * 1024)
+
+// Environment variable that overrides the default socket filename
+#define SERVER_SOCKET_ENVIRONMENT_VARIABLE "ADEPT_SERVER_SOCKET"
+
+// ---------------- server_request_header_t ----------------
+// Fixed-size beginning of a request
+// Followed by 'body_size' bytes of null-terminated strings:
+// the working directory, then 'argc' arguments, then 'envc' environment variables
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t argc;
+    uint32_t envc;
+    uint64_t body_size;
+} server_request_header_t;
+
+// ---------------- server_request_t ----------------
+// Request received by a compile server
+typedef struct {
+    strong_cstr_t body;              // Storage for all strings of the request
+    weak_cstr_t working_directory;
+    int argc;
+    weak_cstr_t *argv;               // Null-terminated
+    weak_cstr_t *envp;               // Null-terminated
+    int fds[3];                      // Standard input, output, and error of the client
+} server_request_t;
+
+// ---------------- server_socket_filename ----------------
+// Gets the filename of the socket that the compile server listens on
+// Uses '$ADEPT_SERVER_SOCKET' if set, otherwise a per-user default
+// Returns NULL if the platform doesn't support compile servers
+maybe_null_strong_cstr_t server_socket_filename(void);
+
+// ---------------- server_connect ----------------
+// Connects to the compile server listening on a socket
+// Returns the connection, or -1 if no server is listening
+int server_connect(weak_cstr_t socket_filename);
+
+// ---------------- server_listen ----------------
+// Creates the socket that a compile server accepts connections on
+// Only the current user is allowed to connect to it
+// Returns -1 on failure
+int server_listen(weak_cstr_t socket_filename);
+
+// ---------------- server_send_request ----------------
+// Sends a request for the server to compile using the given arguments and environment
+// The current working directory and standard file descriptors are sent along with it
+errorcode_t server_send_request(int connection, int argc, char **argv, char **envp);
+
+// ---------------- server_receive_request ----------------
+// Receives a request from a client
+errorcode_t server_receive_request(int connection, server_request_t *out_request);
+
+// ---------------- server_request_free ----------------
+// Frees a request and closes the file descriptors it came with
+void server_request_free(server_request_t *request);
+
+// ---------------- server_send_exit_code ----------------
+// Replies to a request with the exit code of the compilation
+errorcode_t server_send_exit_code(int connection, int exit_code);
+
+// ---------------- server_receive_exit_code ----------------
+// Waits for the exit code of a request
+errorcode_t server_receive_exit_code(int connection, int *out_exit_code);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_SERVER_PROTOCOL_H
@@ -222,6 +222,34 @@ for i in range(0, len(tokens)):
         beginning_of_keywords = i
         break
 
+# Find a perfect hash for keywords, so the lexer can recognize them
+# with a single table lookup instead of a binary search
+# NOTE: This must match 'keyword_hash()' in 'src/LEX/lex.c'
+keywords_hash_bits = 9
+
+def keyword_hash(seed, name):
+    h = seed
+    for c in name.encode():
+        h = ((h ^ c) * 0x01000193) & 0xFFFFFFFF
+    return h >> (32 - keywords_hash_bits)
+
+def find_keywords_perfect_hash():
+    keywords = [token.short_name for token in tokens if token.token_type == TokenType.KEYWORD]
+    seed = 0x811C9DC5
+
+    while True:
+        table = [0] * (1 << keywords_hash_bits)
+        for i in range(0, len(keywords)):
+            slot = keyword_hash(seed, keywords[i])
+            if table[slot] != 0:
+                break
+            table[slot] = i + 1
+        else:
+            return (seed, table)
+        seed = (seed + 1) & 0xFFFFFFFF
+
+keywords_hash_seed, keywords_hash_table = find_keywords_perfect_hash()
+
 class TokenAlias:
     def __init__(self, short_name, long_name, points_to):
         self.short_name = short_name
@@ -267,6 +295,12 @@ def generate_header(filename):
     f.write("\n");
     f.write("extern const char *global_token_keywords_list[];\n");
     f.write("extern unsigned long long global_token_keywords_list_length;\n");
+    f.write("\n");
+    f.write("#define TOKEN_KEYWORDS_HASH_SEED 0x%0.8X\n" % keywords_hash_seed)
+    f.write("#define TOKEN_KEYWORDS_HASH_BITS %d\n" % keywords_hash_bits)
+    f.write("\n");
+    f.write("// Maps perfect hash of keyword to (index in 'global_token_keywords_list' + 1), or zero if not a keyword\n");
+    f.write("extern const unsigned char global_token_keywords_hash_table[];\n");
     f.write(tail)
     f.close()
     print("[done] Generated token_data.h")
@@ -307,6 +341,11 @@ def generate_source(filename):
     f.write("};\n");
     f.write("\n");
     f.write("unsigned long long global_token_keywords_list_length = {0};\n".format(num_keywords));
+    f.write("\n");
+    f.write("const unsigned char global_token_keywords_hash_table[] = {\n");
+    for i in range(0, len(keywords_hash_table), 16):
+        f.write("    " + ", ".join("%3d" % value for value in keywords_hash_table[i:i + 16]) + ",\n")
+    f.write("};\n");
     f.close()
     print("[done] Generated token_data.c")
 
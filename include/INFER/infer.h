@@ -24,7 +24,7 @@
 // ---------------- infer_var_t ----------------
 // Variable mapping used for inference stage
 typedef struct {
-    weak_cstr_t name;
+    weak_cstr_t name; // Interned in the compiler's symbol table
     ast_type_t *type;
     source_t source;
     bool used;
@@ -162,7 +162,7 @@ void infer_var_scope_free(compiler_t *compiler, infer_var_scope_t *scope);
 
 // ---------------- infer_var_scope_find ----------------
 // Finds a variable mapping within an inference variable scope
-infer_var_t* infer_var_scope_find(infer_var_scope_t *scope, const char *name);
+infer_var_t* infer_var_scope_find(compiler_t *compiler, infer_var_scope_t *scope, const char *name);
 
 // ---------------- infer_var_scope_find_named_expression ----------------
 // Finds a named expression mapping within an inference variable scope
@@ -170,7 +170,7 @@ ast_named_expression_t* infer_var_scope_find_named_expression(infer_var_scope_t
 
 // ---------------- infer_var_scope_ir_builder_add_variable ----------------
 // Adds a variables to an inference variable scope
-void infer_var_scope_ir_builder_add_variable(infer_var_scope_t *scope, weak_cstr_t name, ast_type_t *type, source_t source, bool force_used, bool is_const);
+void infer_var_scope_ir_builder_add_variable(compiler_t *compiler, infer_var_scope_t *scope, weak_cstr_t name, ast_type_t *type, source_t source, bool force_used, bool is_const);
 
 // ---------------- infer_var_scope_add_named_expression ----------------
 // Adds a named expression mapping to an inference variable scope
@@ -479,6 +479,7 @@ typedef struct {
     bridge_scope_t *scope;
     length_t variable_count;
     weak_cstr_t export_as;
+    func_id_t deferred_ast_func_id; // Only valid when IR_FUNC_DEFERRED
 } ir_func_t;
 
 // Possible traits for ir_func_t
@@ -490,6 +491,7 @@ typedef struct {
 #define IR_FUNC_VALIDATE_VTABLE TRAIT_6
 #define IR_FUNC_INIT            TRAIT_7
 #define IR_FUNC_DEINIT          TRAIT_8
+#define IR_FUNC_DEFERRED        TRAIT_9 // Body will only be generated if the function is reached
 
 // ---------------- ir_job_list_t ----------------
 // List of jobs required during IR generation
@@ -10,6 +10,7 @@
 
 #include <stdbool.h>
 
+#include "AST/TYPE/ast_type_intern.h"
 #include "BRIDGE/rtti_collector.h"
 #include "BRIDGEIR/rtti_table.h"
 #include "IR/ir.h"
@@ -25,6 +26,7 @@
 typedef struct ir_module {
     ir_shared_common_t common;
     ir_pool_t pool;
+    ir_pool_t type_pool; // For IR types that are cached, never rolled back by pool snapshots
     ir_type_map_t type_map;
     ir_funcs_t funcs;
     ir_proc_map_t func_map;
@@ -32,7 +34,9 @@ typedef struct ir_module {
     ir_global_t *globals;
     length_t globals_length;
     ir_anon_globals_t anon_globals;
+    ast_type_intern_table_t canonical_types;
     ir_gen_sf_cache_t sf_cache;
+    ir_gen_poly_cache_t poly_cache;
     rtti_collector_t *rtti_collector;
     rtti_table_t *rtti_table;
     rtti_relocations_t rtti_relocations;
@@ -57,6 +61,11 @@ void ir_module_free(ir_module_t *ir_module);
 // Creates a new function mapping
 void ir_module_create_func_mapping(ir_module_t *module, weak_cstr_t function_name, ir_func_endpoint_t endpoint, bool add_to_job_list);
 
+// ---------------- ir_module_request_func ----------------
+// Marks an IR function as reached, so that its body will be generated
+// Only has an effect on functions with deferred bodies (see COMPILER_DEMAND_IR)
+void ir_module_request_func(ir_module_t *module, func_id_t ir_func_id);
+
 // ---------------- ir_module_create_method_mapping ----------------
 // Create a new method mapping
 void ir_module_create_method_mapping(ir_module_t *module, weak_cstr_t struct_name, weak_cstr_t method_name, ir_func_endpoint_t endpoint);
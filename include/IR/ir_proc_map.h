@@ -15,10 +15,28 @@ extern "C" {
 #include "IR/ir_pool.h"
 #include "IR/ir_func_endpoint.h"
 #include "UTIL/ground.h"
+#include "UTIL/hash.h"
+
+// ---------------- ir_proc_map_hash_func_t ----------------
+// A function that a procedure map uses to hash its keys
+typedef hash_t (*ir_proc_map_hash_func_t)(const void *key);
+
+// ---------------- ir_proc_map_equals_func_t ----------------
+// A function that a procedure map uses to determine if two keys are equal
+typedef bool (*ir_proc_map_equals_func_t)(const void *a, const void *b);
+
+// ---------------- ir_proc_map_slot_t ----------------
+// Slot in the hash index of an 'ir_proc_map_t'
+typedef struct {
+    length_t index_plus_one; // Zero if the slot is empty
+    hash_t hash;
+} ir_proc_map_slot_t;
 
 // ---------------- ir_proc_map_t ----------------
 // IR procedure map, used to map a value of a generic 'key'
 // type to a list of possible function endpoints
+// Keys and endpoint lists are stored in insertion order,
+// and are looked up through an open-addressed hash index
 typedef struct {
     void *keys;
     ir_func_endpoint_list_t **endpoint_lists;
@@ -26,12 +44,17 @@ typedef struct {
     length_t capacity;
 
     // Implementation details
+    ir_proc_map_slot_t *slots;
+    length_t slots_capacity; // Always a power of two
+    length_t sizeof_key;
+    ir_proc_map_hash_func_t hash_func;
+    ir_proc_map_equals_func_t equals_func;
     ir_pool_t endpoint_pool;
 } ir_proc_map_t;
 
 // ---------------- ir_proc_map_init ----------------
 // Initializes a procedure map
-void ir_proc_map_init(ir_proc_map_t *map, length_t sizeof_key, length_t estimated_keys);
+void ir_proc_map_init(ir_proc_map_t *map, length_t sizeof_key, length_t estimated_keys, ir_proc_map_hash_func_t hash_func, ir_proc_map_equals_func_t equals_func);
 
 // ---------------- ir_proc_map_free ----------------
 // Frees a procedure map
@@ -41,14 +64,14 @@ void ir_proc_map_free(ir_proc_map_t *map);
 // ---------------- ir_proc_map_insert ----------------
 // Inserts an endpoint into the endpoint list for a given key
 // If the given key doesn't already exist in the map, it will be created
-void ir_proc_map_insert(ir_proc_map_t *map, const void *key, length_t sizeof_key, ir_func_endpoint_t endpoint, int (*key_compare)(const void*, const void*));
+void ir_proc_map_insert(ir_proc_map_t *map, const void *key, ir_func_endpoint_t endpoint);
 
 // ---------------- ir_proc_map_find ----------------
 // Looks up a key inside of the map and returns a stable pointer
 // to its corresponding endpoint list. Returns NULL if the supplied
 // key doesn't exist in the map
 // NOTE: Guaranteed to return a stable pointer (the pointer will be valid until 'map' is freed)
-ir_func_endpoint_list_t *ir_proc_map_find(ir_proc_map_t *map, const void *key, length_t sizeof_key, int (*key_compare)(const void*, const void*));
+ir_func_endpoint_list_t *ir_proc_map_find(ir_proc_map_t *map, const void *key);
 
 // ---------------- ir_func_key_t ----------------
 typedef struct {
@@ -62,13 +85,21 @@ typedef struct {
     weak_cstr_t method_name;
 } ir_method_key_t;
 
-// ---------------- compare_ir_func_key ----------------
-// Compare function for ir_func_key_t
-int compare_ir_func_key(const void*, const void*);
+// ---------------- hash_ir_func_key ----------------
+// Hash function for ir_func_key_t
+hash_t hash_ir_func_key(const void*);
+
+// ---------------- hash_ir_method_key ----------------
+// Hash function for ir_method_key_t
+hash_t hash_ir_method_key(const void*);
+
+// ---------------- equals_ir_func_key ----------------
+// Equals function for ir_func_key_t
+bool equals_ir_func_key(const void*, const void*);
 
-// ---------------- compare_ir_method_key ----------------
-// Compare function for ir_method_key_t
-int compare_ir_method_key(const void*, const void*);
+// ---------------- equals_ir_method_key ----------------
+// Equals function for ir_method_key_t
+bool equals_ir_method_key(const void*, const void*);
 
 #ifdef __cplusplus
 }
@@ -138,6 +138,16 @@ void ir_builder_pop_loop_label(ir_builder_t *builder);
 // Returns a temporary pointer to the constructed variable
 bridge_var_t *ir_builder_add_variable(ir_builder_t *builder, weak_cstr_t name, ast_type_t *ast_type, ir_type_t *ir_type, trait_t traits);
 
+// ---------------- ir_builder_find_variable ----------------
+// Finds a variable by name in the current bridge_scope_t or any of its parents
+// Returns NULL if no variable with that name exists
+bridge_var_t *ir_builder_find_variable(ir_builder_t *builder, const char *name);
+
+// ---------------- ir_builder_variable_already_declared ----------------
+// Returns whether a variable with that name was already declared in the current bridge_scope_t
+// NOTE: Parent scopes aren't checked
+bool ir_builder_variable_already_declared(ir_builder_t *builder, const char *name);
+
 // ---------------- handle_deference_for_variables ----------------
 // Handles deference for variables in a variable list
 // Returns FAILURE on compile time error
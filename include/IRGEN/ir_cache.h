@@ -12,26 +12,27 @@
     - __pass__
     - __defer__
     - __assign__
+
+    It also contains the polymorphic composite cache, which remembers the
+    IR type built for each instance of a polymorphic composite, such as
+    '<int> List', so that the layout is only lowered once per module
     --------------------------------------------------------------------------
 */
 
 #include <stdio.h>
 
+#include "AST/TYPE/ast_type_intern.h"
 #include "AST/ast.h"
 #include "AST/ast_type_lean.h"
+#include "IR/ir_type.h"
 #include "UTIL/func_pair.h"
 #include "UTIL/ground.h"
-
-#define IR_GEN_SF_CACHE_SUGGESTED_NUM_BUCKETS 1024
+#include "UTIL/hash.h"
 
 // ---------------- ir_gen_sf_cache_entry_t ----------------
-// Special Functions cache entry.
-// The structural layout is squished together tightly, since we
-// know that there will be a huge array of them
-#define ir_gen_sf_cache_entry_is_occupied(a) ((a)->ast_type.elements_length != 0)
-
-typedef struct ir_gen_sf_cache_entry {
-    ast_type_t ast_type;
+// Special Functions cache entry
+typedef struct {
+    const ast_canonical_type_t *canonical;
 
     troolean has_pass : 2,
              has_defer : 2,
@@ -40,20 +41,24 @@ typedef struct ir_gen_sf_cache_entry {
     func_pair_t pass;   // __pass__
     func_pair_t defer;  // __defer__
     func_pair_t assign; // __assign__
-    
-    struct ir_gen_sf_cache_entry *next;
 } ir_gen_sf_cache_entry_t;
 
 // ---------------- ir_gen_sf_cache_t ----------------
 // Special functions cache
 typedef struct {
-    ir_gen_sf_cache_entry_t *storage;
-    length_t capacity;
+    // Indexed by the id of each entry's canonical type, NULL when not cached yet
+    // NOTE: Entries are separately heap allocated, so they never move
+    ir_gen_sf_cache_entry_t **entries;
+    length_t entries_capacity;
+
+    // Entries are keyed by the canonical types from this table
+    ast_type_intern_table_t *canonical_types;
 } ir_gen_sf_cache_t;
 
 // ---------------- ir_gen_sf_cache_init ----------------
 // Initializes special functions cache
-void ir_gen_sf_cache_init(ir_gen_sf_cache_t *cache, length_t num_buckets);
+// NOTE: 'canonical_types' must outlive the cache
+void ir_gen_sf_cache_init(ir_gen_sf_cache_t *cache, ast_type_intern_table_t *canonical_types);
 
 // ---------------- ir_gen_sf_cache_free ----------------
 // Frees special functions cache
@@ -75,4 +80,47 @@ ir_gen_sf_cache_entry_t *ir_gen_sf_cache_locate_or_insert(ir_gen_sf_cache_t *cac
 // Dumps a visual representation of an special function cache
 void ir_gen_sf_cache_dump(FILE *file, ir_gen_sf_cache_t *sf_cache);
 
+// ---------------- ir_gen_poly_cache_entry_t ----------------
+// Polymorphic composite cache entry
+typedef struct {
+    strong_cstr_t name;
+    ast_type_t *generics;
+    length_t generics_length;
+    hash_t hash;
+    ir_type_t *ir_type;
+} ir_gen_poly_cache_entry_t;
+
+// ---------------- ir_gen_poly_cache_t ----------------
+// Polymorphic composite cache
+typedef struct {
+    ir_gen_poly_cache_entry_t *entries;
+    length_t length;
+    length_t capacity;
+
+    // Open-addressed slots which contain (entry index + 1), or zero when empty
+    // NOTE: 'slots_capacity' is always a power of two
+    length_t *slots;
+    length_t slots_capacity;
+} ir_gen_poly_cache_t;
+
+// ---------------- ir_gen_poly_cache_init ----------------
+// Initializes polymorphic composite cache
+void ir_gen_poly_cache_init(ir_gen_poly_cache_t *cache);
+
+// ---------------- ir_gen_poly_cache_free ----------------
+// Frees polymorphic composite cache
+void ir_gen_poly_cache_free(ir_gen_poly_cache_t *cache);
+
+// ---------------- ir_gen_poly_cache_find ----------------
+// Finds the IR type previously built for an instance of a polymorphic composite
+// Returns NULL if the instance isn't in the cache
+ir_type_t *ir_gen_poly_cache_find(ir_gen_poly_cache_t *cache, weak_cstr_t name, ast_type_t *generics, length_t generics_length);
+
+// ---------------- ir_gen_poly_cache_insert ----------------
+// Remembers the IR type built for an instance of a polymorphic composite
+// NOTE: Does not take any ownership of 'name' or 'generics'
+// NOTE: 'ir_type' must be allocated from the IR module's 'type_pool',
+// since memory in the regular pool can be rolled back by snapshots
+void ir_gen_poly_cache_insert(ir_gen_poly_cache_t *cache, weak_cstr_t name, ast_type_t *generics, length_t generics_length, ir_type_t *ir_type);
+
 #endif // _ISAAC_IR_GEN_CACHE_H
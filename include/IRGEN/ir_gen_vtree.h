@@ -12,6 +12,7 @@ extern "C" {
     ----------------------------------------------------------------------------
 */
 
+#include "AST/TYPE/ast_type_intern.h"
 #include "AST/ast_type_lean.h"
 #include "DRVR/compiler.h"
 #include "DRVR/object.h"
@@ -72,6 +73,7 @@ errorcode_t ir_gen_vtree_search_for_single_override(
 errorcode_t ir_gen_vtree_link_up_nodes(
     compiler_t *compiler,
     ast_t *ast,
+    ast_type_intern_table_t *canonical_types,
     vtree_list_t *vtree_list,
     length_t starting_index
 );
@@ -12,6 +12,7 @@ extern "C" {
     ----------------------------------------------------------------------------
 */
 
+#include "AST/TYPE/ast_type_intern.h"
 #include "AST/ast_type_lean.h"
 #include "IR/ir_func_endpoint.h"
 #include "IR/ir_value.h"
@@ -30,7 +31,8 @@ typedef listof(struct vtree*, vtrees) vtree_list_t;
 // Tree used to help generate virtual dispatch tables
 typedef struct vtree {
     struct vtree *parent;
-    ast_type_t signature;
+    const ast_canonical_type_t *canonical;
+    ast_type_t signature; // (view of 'canonical' with the source of the first mention)
     ir_func_endpoint_list_t virtuals;
     ir_func_endpoint_list_t table;
     vtree_list_t children;
@@ -59,11 +61,11 @@ void vtree_list_free(vtree_list_t *vtree_list);
 // Finds a vtree in a vtree list that has the given signature type,
 // If none exists, a new vtree will be created and inserted.
 // Will always return a vtree with a matching signature.
-vtree_t *vtree_list_find_or_append(vtree_list_t *vtree_list, const ast_type_t *signature, length_t instantiation_depth);
+vtree_t *vtree_list_find_or_append(vtree_list_t *vtree_list, ast_type_intern_table_t *canonical_types, const ast_type_t *signature, length_t instantiation_depth);
 
 // ---------------- vtree_list_find ----------------
 // Finds a vtree in a vtree list that has the given signature
-vtree_t *vtree_list_find(vtree_list_t *vtree_list, const ast_type_t *signature);
+vtree_t *vtree_list_find(vtree_list_t *vtree_list, ast_type_intern_table_t *canonical_types, const ast_type_t *signature);
 
 // ---------------- vtree_print ----------------
 // Prints a vtree
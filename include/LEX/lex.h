@@ -17,6 +17,7 @@ extern "C" {
 #include "DRVR/compiler.h"
 #include "DRVR/object.h"
 #include "UTIL/ground.h"
+#include "UTIL/intern.h"
 
 // ---------------- lex ----------------
 // Entry point for lexical analysis
@@ -28,10 +29,31 @@ errorcode_t lex(compiler_t *compiler, object_t *object);
 // NOTE: The final \0 is not included in the 'object->buffer_size'
 errorcode_t lex_buffer(compiler_t *compiler, object_t *object);
 
+// ---------------- lex_buffer_quietly ----------------
+// Same as 'lex_buffer', except that errors aren't reported,
+// and identifiers are interned into the given table
+// NOTE: Doesn't use any compiler state, so it can be called from other threads
+errorcode_t lex_buffer_quietly(intern_table_t *symbols, object_t *object);
+
 // ---------------- lex_get_location ----------------
 // Retrieves line and column of an index in a buffer
+// NOTE: Scans the buffer from the beginning, prefer 'lex_get_object_location'
 void lex_get_location(const char *buffer, length_t i, int *line, int *column);
 
+// ---------------- lex_build_line_offsets ----------------
+// Creates the line offset table for the text buffer of an object
+// NOTE: Called automatically by 'lex_buffer'
+void lex_build_line_offsets(object_t *object);
+
+// ---------------- lex_get_object_location ----------------
+// Retrieves line and column of an index in the text buffer of an object
+// using the line offset table of the object (if it has one)
+void lex_get_object_location(object_t *object, length_t i, int *line, int *column);
+
+// ---------------- lex_get_line_offset ----------------
+// Retrieves the index in the text buffer of an object that a line starts at
+length_t lex_get_line_offset(object_t *object, int line);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,58 @@
+
+#ifndef _ISAAC_LEX_POOL_H
+#define _ISAAC_LEX_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    =============================== lex_pool.h ===============================
+    Module for lexing imported files on other threads (see '--jobs=N')
+
+    While the main thread parses a file, the files it imports are read and
+    lexed by worker threads. When an import is reached, the main thread takes
+    the finished token list instead of lexing the file itself.
+
+    Worker threads never report errors. Files that fail to lex are lexed
+    again by the main thread, so diagnostics are the same as without threads.
+    Objects are still created in import order by the main thread, so object
+    indices don't change either.
+    ---------------------------------------------------------------------------
+*/
+
+#include <stdbool.h>
+
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "UTIL/ground.h"
+
+// ---------------- lex_pool_t ----------------
+// Pool of threads that lex files ahead of time
+typedef struct lex_pool lex_pool_t;
+
+// ---------------- lex_pool_create ----------------
+// Starts a pool with the given number of worker threads
+// Returns NULL if threads aren't available
+lex_pool_t *lex_pool_create(length_t threads_length);
+
+// ---------------- lex_pool_free ----------------
+// Stops the worker threads of a pool and frees it,
+// along with any token lists that were never taken
+void lex_pool_free(lex_pool_t *pool);
+
+// ---------------- lex_pool_submit ----------------
+// Queues a file to be lexed, unless it has already been queued
+void lex_pool_submit(lex_pool_t *pool, strong_cstr_t full_filename);
+
+// ---------------- lex_pool_take ----------------
+// Gives an object the token list lexed for its file, waiting for it if necessary
+// Returns false if the file wasn't lexed successfully ahead of time,
+// in which case it must be lexed normally
+bool lex_pool_take(lex_pool_t *pool, compiler_t *compiler, object_t *object);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_LEX_POOL_H
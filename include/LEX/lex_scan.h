@@ -0,0 +1,198 @@
+
+#ifndef _ISAAC_LEX_SCAN_H
+#define _ISAAC_LEX_SCAN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    =============================== lex_scan.h ===============================
+    Module for quickly scanning over runs of characters while lexing
+
+    Uses SSE2 when the compiler targets it, otherwise falls back to scanning
+    one character at a time. On x86, runs that are longer than a single SSE2
+    vector continue with AVX2 when the processor supports it. Support is
+    detected at runtime, so '-mavx2' isn't required. Wide reads are only
+    done when there's a full vector of characters left before 'end', so
+    these never read outside of the given range.
+
+    Since most runs are short, the first few characters are always checked
+    one at a time before switching to vectors.
+    ---------------------------------------------------------------------------
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Number of characters to check one at a time before using vectors
+#define LEX_SCAN_SCALAR_PREFIX 8
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(__EMSCRIPTEN__)
+#define LEX_SCAN_AVX2
+#endif
+
+#if defined(__GNUC__) && defined(__SSE2__)
+#define LEX_SCAN_SSE2
+#include <emmintrin.h>
+#endif
+
+#define LEX_SCAN_IS_BLANK(c) ((c) == ' ' || (c) == '\t')
+#define LEX_SCAN_IS_IDENTIFIER(c) (((c) >= 'a' && (c) <= 'z') || ((c) >= 'A' && (c) <= 'Z') || ((c) >= '0' && (c) <= '9') || (c) == '_')
+#define LEX_SCAN_IS_EITHER(c, a, b) ((c) == (a) || (c) == (b))
+
+static inline const char *lex_scan_prefix_end(const char *p, const char *end){
+    return end - p > LEX_SCAN_SCALAR_PREFIX ? p + LEX_SCAN_SCALAR_PREFIX : end;
+}
+
+#ifdef LEX_SCAN_AVX2
+// ---------------- lex_scan_*_avx2 ----------------
+// AVX2 versions of the scanning loops (see lex_scan.c)
+// Each returns either the character that was found, or where fewer than 32 characters remain before 'end'
+// NOTE: Must only be called when 'lex_scan_has_avx2' is true
+const char *lex_scan_blanks_avx2(const char *p, const char *end);
+const char *lex_scan_identifier_avx2(const char *p, const char *end);
+const char *lex_scan_either_avx2(const char *p, const char *end, char a, char b);
+
+// ---------------- lex_scan_has_avx2 ----------------
+// Returns whether the AVX2 scanning loops can be used
+static inline bool lex_scan_has_avx2(void){
+    #ifdef __AVX2__
+    return true;
+    #else
+    return __builtin_cpu_supports("avx2");
+    #endif
+}
+#endif
+
+#ifdef LEX_SCAN_SSE2
+static inline uint32_t lex_scan_blanks_stop_sse2(const char *p){
+    __m128i chunk = _mm_loadu_si128((const __m128i*) p);
+    __m128i blank = _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t')));
+    return ~(uint32_t) _mm_movemask_epi8(blank) & 0xFFFF;
+}
+
+static inline uint32_t lex_scan_identifier_stop_sse2(const char *p){
+    __m128i chunk = _mm_loadu_si128((const __m128i*) p);
+    __m128i lower = _mm_or_si128(chunk, _mm_set1_epi8(0x20));
+    __m128i is_letter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('z' + 1), lower));
+    __m128i is_digit = _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8('0' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), chunk));
+    __m128i is_underscore = _mm_cmpeq_epi8(chunk, _mm_set1_epi8('_'));
+    __m128i is_identifier = _mm_or_si128(_mm_or_si128(is_letter, is_digit), is_underscore);
+    return ~(uint32_t) _mm_movemask_epi8(is_identifier) & 0xFFFF;
+}
+
+static inline uint32_t lex_scan_either_stop_sse2(const char *p, char a, char b){
+    __m128i chunk = _mm_loadu_si128((const __m128i*) p);
+    __m128i found = _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(a)), _mm_cmpeq_epi8(chunk, _mm_set1_epi8(b)));
+    return (uint32_t) _mm_movemask_epi8(found);
+}
+#endif
+
+// ---------------- lex_scan_blanks ----------------
+// Returns the first character in [p, end) that isn't a space or tab,
+// or 'end' if there is none
+static inline const char *lex_scan_blanks(const char *p, const char *end){
+    for(const char *prefix_end = lex_scan_prefix_end(p, end); p != prefix_end; p++){
+        if(!LEX_SCAN_IS_BLANK(*p)) return p;
+    }
+
+    #ifdef LEX_SCAN_SSE2
+    if(end - p >= 16){
+        uint32_t stop = lex_scan_blanks_stop_sse2(p);
+        if(stop) return p + __builtin_ctz(stop);
+        p += 16;
+    }
+    #endif
+
+    #ifdef LEX_SCAN_AVX2
+    if(end - p >= 32 && lex_scan_has_avx2()){
+        p = lex_scan_blanks_avx2(p, end);
+    }
+    #endif
+
+    #ifdef LEX_SCAN_SSE2
+    while(end - p >= 16){
+        uint32_t stop = lex_scan_blanks_stop_sse2(p);
+        if(stop) return p + __builtin_ctz(stop);
+        p += 16;
+    }
+    #endif
+
+    while(p < end && LEX_SCAN_IS_BLANK(*p)) p++;
+    return p;
+}
+
+// ---------------- lex_scan_identifier ----------------
+// Returns the first character in [p, end) that isn't one of [A-Za-z0-9_],
+// or 'end' if there is none
+static inline const char *lex_scan_identifier(const char *p, const char *end){
+    for(const char *prefix_end = lex_scan_prefix_end(p, end); p != prefix_end; p++){
+        if(!LEX_SCAN_IS_IDENTIFIER(*p)) return p;
+    }
+
+    #ifdef LEX_SCAN_SSE2
+    if(end - p >= 16){
+        uint32_t stop = lex_scan_identifier_stop_sse2(p);
+        if(stop) return p + __builtin_ctz(stop);
+        p += 16;
+    }
+    #endif
+
+    #ifdef LEX_SCAN_AVX2
+    if(end - p >= 32 && lex_scan_has_avx2()){
+        p = lex_scan_identifier_avx2(p, end);
+    }
+    #endif
+
+    #ifdef LEX_SCAN_SSE2
+    while(end - p >= 16){
+        uint32_t stop = lex_scan_identifier_stop_sse2(p);
+        if(stop) return p + __builtin_ctz(stop);
+        p += 16;
+    }
+    #endif
+
+    while(p < end && LEX_SCAN_IS_IDENTIFIER(*p)) p++;
+    return p;
+}
+
+// ---------------- lex_scan_either ----------------
+// Returns the first occurrence of either 'a' or 'b' in [p, end),
+// or 'end' if neither occur
+static inline const char *lex_scan_either(const char *p, const char *end, char a, char b){
+    for(const char *prefix_end = lex_scan_prefix_end(p, end); p != prefix_end; p++){
+        if(LEX_SCAN_IS_EITHER(*p, a, b)) return p;
+    }
+
+    #ifdef LEX_SCAN_SSE2
+    if(end - p >= 16){
+        uint32_t stop = lex_scan_either_stop_sse2(p, a, b);
+        if(stop) return p + __builtin_ctz(stop);
+        p += 16;
+    }
+    #endif
+
+    #ifdef LEX_SCAN_AVX2
+    if(end - p >= 32 && lex_scan_has_avx2()){
+        p = lex_scan_either_avx2(p, end, a, b);
+    }
+    #endif
+
+    #ifdef LEX_SCAN_SSE2
+    while(end - p >= 16){
+        uint32_t stop = lex_scan_either_stop_sse2(p, a, b);
+        if(stop) return p + __builtin_ctz(stop);
+        p += 16;
+    }
+    #endif
+
+    while(p < end && !LEX_SCAN_IS_EITHER(*p, a, b)) p++;
+    return p;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_LEX_SCAN_H
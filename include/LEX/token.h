@@ -33,6 +33,13 @@ typedef struct {
     length_t length;
 } token_string_data_t;
 
+// ---------------- wide_stride_t ----------------
+// Actual stride of a source whose stride doesn't fit in a 'source_t'
+typedef struct {
+    length_t index;
+    length_t stride;
+} wide_stride_t;
+
 // ---------------- tokenlist_t ----------------
 // List of tokens and their sources
 typedef struct {
@@ -40,8 +47,51 @@ typedef struct {
     length_t length;
     length_t capacity;
     source_t *sources;
+
+    // Side table of strides that are too wide for 'source_t', sorted by index
+    wide_stride_t *wide_strides;
+    length_t wide_strides_length;
+    length_t wide_strides_capacity;
+
+    // Cached image that token data points into (see 'token_cache_load'), or NULL
+    // Token data isn't owned by individual tokens when the token list has an image
+    void *image;
+    length_t image_size;
+    bool image_is_mapped;
 } tokenlist_t;
 
+// ---------------- token_has_interned_data ----------------
+// Returns whether tokens of a kind carry an interned identifier as their data
+// Interned data is owned by the compiler's symbol table, not by the token
+static inline bool token_has_interned_data(tokenid_t id){
+    return id == TOKEN_WORD || id == TOKEN_POLYMORPH || id == TOKEN_POLYCOUNT || id == TOKEN_META;
+}
+
+// ---------------- tokenlist_add_wide_stride ----------------
+// Records the actual stride of a source that is too wide for 'source_t'
+// NOTE: Must be called in order of increasing index
+void tokenlist_add_wide_stride(tokenlist_t *tokenlist, length_t index, length_t stride);
+
+// ---------------- tokenlist_source ----------------
+// Creates a source for some code in the file of a token list,
+// using the side table of the token list if the stride is too wide
+static inline source_t tokenlist_source(tokenlist_t *tokenlist, length_t index, length_t stride, length_t object_index){
+    if(stride >= SOURCE_WIDE_STRIDE){
+        tokenlist_add_wide_stride(tokenlist, index, stride);
+        stride = SOURCE_WIDE_STRIDE;
+    }
+
+    return (source_t){
+        .index = (uint32_t) index,
+        .stride = (uint16_t) stride,
+        .object_index = (uint16_t) object_index,
+    };
+}
+
+// ---------------- tokenlist_source_stride ----------------
+// Gets the actual stride of a source in the file of a token list
+length_t tokenlist_source_stride(tokenlist_t *tokenlist, source_t source);
+
 // ---------------- tokenlist_print ----------------
 // Prints a tokenlist to the terminal
 void tokenlist_print(tokenlist_t *tokenlist, const char *buffer);
@@ -0,0 +1,93 @@
+
+#ifndef _ISAAC_TOKEN_CACHE_H
+#define _ISAAC_TOKEN_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ============================== token_cache.h ==============================
+    Module for caching the token lists of source files (see '--cache')
+
+    Token lists are stored in a compact binary image in the build cache
+    directory. Each source file has a single image named after its path,
+    which records the metadata (size, modification time, inode) of the
+    file it was lexed from, so that checking a token list never requires
+    hashing the file's contents. Once the file changes, its image is
+    overwritten instead of a new one being added.
+
+    Cached images are memory-mapped (privately) when loaded, and the data
+    of string and literal tokens points directly into the image instead
+    of being copied. Each distinct identifier is only interned once per image.
+    ---------------------------------------------------------------------------
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "DRVR/build_cache.h"
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "LEX/token.h"
+#include "UTIL/ground.h"
+
+#define TOKEN_CACHE_MAGIC 0x4B544441 // "ADTK"
+#define TOKEN_CACHE_FORMAT_VERSION 3
+
+// ---------------- token_cache_header_t ----------------
+// Header at the beginning of a cached token list image
+// Followed by 'tokens_length' records, then 'symbols_size' bytes of identifiers,
+// and then 'data_size' bytes of token data
+// NOTE: 'symbols_size' is always a multiple of 8, so token data is 8-byte aligned
+typedef struct {
+    uint32_t magic;
+    uint32_t format_version;
+    uint32_t token_iteration_version;
+    uint32_t string_data_size; // sizeof(token_string_data_t) of the writer
+    uint64_t source_key_a;     // Digest of the metadata of the source file
+    uint64_t source_key_b;
+    uint64_t buffer_length;
+    uint64_t tokens_length;
+    uint64_t symbols_length;
+    uint64_t symbols_size;
+    uint64_t data_size;
+} token_cache_header_t;
+
+// ---------------- token_cache_record_t ----------------
+// Cached token and its source within the file
+// 'payload' is the symbol index for identifiers, or the offset
+// of the token's data for strings and literals
+typedef struct {
+    uint16_t id;
+    uint16_t reserved;
+    uint32_t index;
+    uint32_t stride;
+    uint32_t payload;
+} token_cache_record_t;
+
+// ---------------- token_cache_lex ----------------
+// Same as 'lex_buffer', except that the token list is loaded from
+// the cache when possible, and is otherwise stored in the cache
+errorcode_t token_cache_lex(compiler_t *compiler, object_t *object);
+
+// ---------------- token_cache_load ----------------
+// Loads the cached token list for the text buffer attached to an object
+// Returns FAILURE if the token list isn't cached, or the cached copy is invalid
+// or was lexed from a different version of the file than 'source_key' describes
+errorcode_t token_cache_load(compiler_t *compiler, object_t *object, weak_cstr_t cache_filename, const build_cache_key_t *source_key);
+
+// ---------------- token_cache_store ----------------
+// Stores the token list of an object in the cache
+// NOTE: Identifiers of the token list must be interned in 'compiler->symbols'
+void token_cache_store(compiler_t *compiler, object_t *object, weak_cstr_t cache_filename, const build_cache_key_t *source_key);
+
+// ---------------- token_cache_release_image ----------------
+// Releases the image that a cached token list was loaded from
+void token_cache_release_image(void *image, length_t size, bool is_mapped);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_TOKEN_CACHE_H
@@ -166,6 +166,7 @@ void *parse_ctx_peek_data(parse_ctx_t *ctx);
 //     ctx->tokenlist->tokens[*ctx->i].data = NULL;
 //     tmp
 // }
+// except for interned identifier tokens, for which an owned copy is returned
 void *parse_ctx_peek_data_take(parse_ctx_t *ctx);
 
 // ------------------ parse_ctx_at_end ------------------
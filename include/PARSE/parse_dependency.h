@@ -32,6 +32,11 @@ errorcode_t parse_import_object(parse_ctx_t *ctx, strong_cstr_t relative_filenam
 // NOTE: Returns NULL on error
 maybe_null_strong_cstr_t parse_find_import(parse_ctx_t *ctx, weak_cstr_t filename, source_t source, bool allow_local_import);
 
+// ------------------ parse_find_import_quietly ------------------
+// Same as 'parse_find_import', except that no error is reported
+// NOTE: Returns NULL if the file couldn't be found
+maybe_null_strong_cstr_t parse_find_import_quietly(compiler_t *compiler, object_t *object, weak_cstr_t filename, bool allow_local_import);
+
 // ------------------ parse_standard_library_component ------------------
 // Parses a standard library component such as "a/b/c/d" into a string
 maybe_null_strong_cstr_t parse_standard_library_component(parse_ctx_t *ctx, source_t *out_source);
@@ -45,6 +50,11 @@ maybe_null_strong_cstr_t parse_resolve_import(parse_ctx_t *ctx, weak_cstr_t file
 // Returns whether or not the file has already been imported
 bool already_imported(parse_ctx_t *ctx, weak_cstr_t filename);
 
+// ------------------ parse_prefetch_imports ------------------
+// Queues the files imported by the current object to be lexed
+// ahead of time, if there is a lex pool (see '--jobs=N')
+void parse_prefetch_imports(parse_ctx_t *ctx);
+
 #ifdef __cplusplus
 }
 #endif
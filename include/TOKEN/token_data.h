@@ -4,7 +4,7 @@
 #ifndef _ISAAC_TOKEN_DATA_H
 #define _ISAAC_TOKEN_DATA_H
 
-#define TOKEN_ITERATION_VERSION 0x67EAAACA
+#define TOKEN_ITERATION_VERSION 0x6AD2D94A
 
 #define TOKEN_NONE                  0x00000000
 #define TOKEN_WORD                  0x00000001
@@ -171,4 +171,10 @@ extern const char global_token_extra_format_table[];
 extern const char *global_token_keywords_list[];
 extern unsigned long long global_token_keywords_list_length;
 
+#define TOKEN_KEYWORDS_HASH_SEED 0x811C9DFF
+#define TOKEN_KEYWORDS_HASH_BITS 9
+
+// Maps perfect hash of keyword to (index in 'global_token_keywords_list' + 1), or zero if not a keyword
+extern const unsigned char global_token_keywords_hash_table[];
+
 #endif // _ISAAC_TOKEN_DATA_H
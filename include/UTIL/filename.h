@@ -13,6 +13,7 @@ extern "C" {
 */
 
 #include "UTIL/ground.h"
+#include "UTIL/intern.h"
 
 // ---------------- filename_name ----------------
 // Gets the string in a filename after a slash
@@ -68,6 +69,33 @@ char *filename_without_ext(char *filename);
 // ---------------- filename_prepend_dotslash_if_needed ----------------
 void filename_prepend_dotslash_if_needed(strong_cstr_t *filename);
 
+// ---------------- filename_memo_t ----------------
+// Remembers filenames that were computed from keys,
+// so that expensive filesystem lookups only happen once
+typedef struct {
+    intern_table_t keys;
+    strong_cstr_t *values; // Indexed by symbol id of key
+    length_t values_capacity;
+} filename_memo_t;
+
+// ---------------- filename_memo_init ----------------
+// Initializes a filename memo
+void filename_memo_init(filename_memo_t *memo);
+
+// ---------------- filename_memo_free ----------------
+// Frees a filename memo and all filenames it remembers
+void filename_memo_free(filename_memo_t *memo);
+
+// ---------------- filename_memo_get ----------------
+// Gets the filename remembered for a key of 'key_length' bytes
+// Returns NULL if nothing is remembered for the key
+maybe_null_weak_cstr_t filename_memo_get(filename_memo_t *memo, const char *key, length_t key_length);
+
+// ---------------- filename_memo_set ----------------
+// Remembers a filename for a key of 'key_length' bytes
+// Ownership of 'filename' is taken
+void filename_memo_set(filename_memo_t *memo, const char *key, length_t key_length, strong_cstr_t filename);
+
 #ifdef __cplusplus
 }
 #endif
@@ -69,14 +69,21 @@ typedef char *maybe_null_weak_cstr_t; // Maybe NULL Variant
 typedef size_t length_t;
 
 // ---------------- source_t ----------------
+// Packed location of some source code (8 bytes)
+// Strides that don't fit are stored as SOURCE_WIDE_STRIDE, with the
+// actual stride kept in the side table of the token list (see 'tokenlist_source')
 typedef struct {
-    length_t index;
-    length_t stride;
-    length_t object_index;
+    uint32_t index;
+    uint16_t stride;
+    uint16_t object_index;
 } source_t;
 
 #define NULL_SOURCE (source_t){0, 0, 0}
 
+#define SOURCE_MAX_INDEX        UINT32_MAX
+#define SOURCE_MAX_OBJECT_INDEX UINT16_MAX
+#define SOURCE_WIDE_STRIDE      UINT16_MAX
+
 // ---------------- index_id_t ----------------
 // Used as a general-purpose ID
 #define MAX_INDEX_ID     0xFFFFFFFE
@@ -0,0 +1,93 @@
+
+#ifndef _ISAAC_INTERN_H
+#define _ISAAC_INTERN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ================================ intern.h ================================
+    Module for interning identifier strings
+
+    Each distinct string inserted into an 'intern_table_t' is stored exactly
+    once, and is given a stable pointer and a 32-bit symbol id. Interned
+    strings can be compared by pointer or by symbol id instead of 'streq'.
+    ---------------------------------------------------------------------------
+*/
+
+#include <stdint.h>
+
+#include "UTIL/ground.h"
+#include "UTIL/hash.h"
+
+// ---------------- symbol_id_t ----------------
+// Identifier for an interned string
+typedef uint32_t symbol_id_t;
+
+// ---------------- intern_entry_t ----------------
+// Information about an interned string
+typedef struct {
+    weak_cstr_t name; // Points into the string storage of the owning 'intern_table_t'
+    length_t length;
+    hash_t hash;
+} intern_entry_t;
+
+// ---------------- intern_table_t ----------------
+// A table of interned strings
+typedef struct {
+    // Indexed by symbol id
+    intern_entry_t *entries;
+    length_t length;
+    length_t capacity;
+
+    // Open-addressed slots which contain (symbol id + 1), or zero when empty
+    // NOTE: 'slots_capacity' is always a power of two
+    symbol_id_t *slots;
+    length_t slots_capacity;
+
+    // Chunked storage for string contents, chunks are never moved
+    char **chunks;
+    length_t chunks_length;
+    length_t chunks_capacity;
+    length_t chunk_used;
+    length_t chunk_capacity;
+} intern_table_t;
+
+// ---------------- intern_table_init ----------------
+// Initializes an intern table
+void intern_table_init(intern_table_t *table);
+
+// ---------------- intern_table_free ----------------
+// Frees an intern table and all strings interned by it
+void intern_table_free(intern_table_t *table);
+
+// ---------------- intern_table_insert ----------------
+// Interns a string of 'length' characters (which doesn't need to be null-terminated)
+// Returns the canonical null-terminated copy of the string, which lives as long as the table
+// The symbol id of the string will be written to 'out_id' if it is non-NULL
+weak_cstr_t intern_table_insert(intern_table_t *table, const char *string, length_t length, symbol_id_t *out_id);
+
+// ---------------- intern_table_find ----------------
+// Finds the symbol id of an already interned string
+// Returns false if the string isn't interned
+bool intern_table_find(intern_table_t *table, const char *string, length_t length, symbol_id_t *out_id);
+
+// ---------------- intern_table_insert_cstr ----------------
+// Interns a null-terminated string, see 'intern_table_insert'
+weak_cstr_t intern_table_insert_cstr(intern_table_t *table, const char *string);
+
+// ---------------- intern_table_find_cstr ----------------
+// Returns the canonical copy of an already interned null-terminated string,
+// or NULL if the string isn't interned
+maybe_null_weak_cstr_t intern_table_find_cstr(intern_table_t *table, const char *string);
+
+// ---------------- intern_table_name ----------------
+// Gets the canonical string for a symbol id
+weak_cstr_t intern_table_name(intern_table_t *table, symbol_id_t id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_INTERN_H
@@ -0,0 +1,82 @@
+
+#ifndef _ISAAC_MAP_H
+#define _ISAAC_MAP_H
+
+#include "UTIL/ground.h"
+#include "UTIL/hash.h"
+
+// ---------------- map_hash_func_t ----------------
+// A function that a map collection uses to hash its keys
+typedef hash_t (*map_hash_func_t)(const void *key);
+
+// ---------------- map_equals_func_t ----------------
+// A function that a map collection uses to determine if two keys are equal
+typedef bool (*map_equals_func_t)(const void *a, const void *b);
+
+// ---------------- map_free_entry_func_t ----------------
+// A function that a map collection uses to free a key and its value
+typedef void (*map_free_entry_func_t)(void *key, void *value);
+
+// ---------------- map_collect_func_t ----------------
+// A function that can be run when collecting over a map collection
+typedef void (*map_collect_func_t)(void *key, void *value, void *user_pointer);
+
+// ---------------- map_entry_t ----------------
+// An entry in a map collection
+// NOTE: Empty entries have NULL 'key'
+typedef struct {
+    void *key;
+    void *value;
+    hash_t hash;
+} map_entry_t;
+
+// ---------------- map_t ----------------
+// A map collection
+// Entries are stored in a single open-addressed array, which grows
+// to keep the load factor at or below 1/2
+// NOTE: Keys cannot be NULL
+typedef struct {
+    map_entry_t *entries;
+    length_t capacity; // (zero or a power of two)
+    length_t count;
+
+    map_hash_func_t hash_func;
+    map_equals_func_t equals_func;
+} map_t;
+
+// ---------------- map_init ----------------
+// Initializes a map collection
+// `starting_capacity` is how many entries the map can hold before growing (can be zero)
+void map_init(map_t *map, length_t starting_capacity, map_hash_func_t hash_func, map_equals_func_t equals_func);
+
+// ---------------- map_free ----------------
+// Frees a map collection
+// `optional_free_func` may be non-NULL to indicate how to clean up individual keys and values
+void map_free(map_t *map, map_free_entry_func_t optional_free_func);
+
+// ---------------- map_insert ----------------
+// Inserts a key and value into a map
+// Returns false if the key was already in the map, in which case nothing is changed
+// NOTE: Pointers `key` and `value` are taken as-is
+bool map_insert(map_t *map, void *key, void *value);
+
+// ---------------- map_set ----------------
+// Sets the value for a key in a map, inserting the key if necessary
+// Returns the previous value, or NULL if the key is new
+// NOTE: When the key is already in the map, the existing key is kept
+void *map_set(map_t *map, void *key, void *value);
+
+// ---------------- map_find ----------------
+// Finds the value for a key in a map
+// Returns NULL if the key isn't in the map
+void *map_find(map_t *map, const void *key);
+
+// ---------------- map_has ----------------
+// Returns whether a key is in a map
+bool map_has(map_t *map, const void *key);
+
+// ---------------- map_collect ----------------
+// Traverses the entries of a map with access to an outside influence `user_pointer`
+void map_collect(map_t *map, map_collect_func_t collect_func, void *user_pointer);
+
+#endif // _ISAAC_MAP_H
@@ -31,16 +31,20 @@ typedef void (*set_collect_func_t)(void *item, void *user_pointer);
 
 // ---------------- set_entry_t ----------------
 // An entry in a set collection
-typedef struct set_entry {
+// NOTE: Empty entries have NULL 'data'
+typedef struct {
     void *data;
-    struct set_entry *next;
+    hash_t hash;
 } set_entry_t;
 
 // ---------------- set_t ----------------
 // A set collection
+// Items are stored in a single open-addressed array, which grows
+// to keep the load factor at or below 1/2
+// NOTE: Items cannot be NULL
 typedef struct {
-    set_entry_t **entries;
-    length_t capacity;
+    set_entry_t *entries;
+    length_t capacity; // (zero or a power of two)
     length_t count;
 
     set_hash_func_t hash_func;
@@ -50,6 +54,7 @@ typedef struct {
 
 // ---------------- set_init ----------------
 // Initializes a set collection
+// `starting_capacity` is how many items the set can hold before growing (can be zero)
 void set_init(
     set_t *set,
     length_t starting_capacity,
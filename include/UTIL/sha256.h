@@ -0,0 +1,50 @@
+
+#ifndef _ISAAC_SHA256_H
+#define _ISAAC_SHA256_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    =============================== sha256.h ===============================
+    Module for computing SHA-256 digests
+
+    Used where a collision would silently produce wrong results, such as
+    the keys of the build cache (see 'build_cache.h'). For hash tables,
+    use the much faster functions in 'hash.h' instead.
+    ---------------------------------------------------------------------------
+*/
+
+#include <stdint.h>
+
+#include "UTIL/ground.h"
+
+#define SHA256_DIGEST_SIZE 32
+
+// ---------------- sha256_t ----------------
+// State of a SHA-256 digest being computed
+typedef struct {
+    uint32_t state[8];
+    uint64_t length;       // Total number of bytes added
+    uint8_t block[64];     // Bytes of the current partial block
+} sha256_t;
+
+// ---------------- sha256_init ----------------
+// Starts a new SHA-256 digest
+void sha256_init(sha256_t *sha256);
+
+// ---------------- sha256_update ----------------
+// Adds data to a SHA-256 digest
+void sha256_update(sha256_t *sha256, const void *data, length_t size);
+
+// ---------------- sha256_finish ----------------
+// Finishes a SHA-256 digest, and writes it to 'out_digest'
+// NOTE: 'sha256' must be re-initialized before being used again
+void sha256_finish(sha256_t *sha256, uint8_t out_digest[SHA256_DIGEST_SIZE]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_SHA256_H
@@ -56,6 +56,18 @@ bool file_exists(weak_cstr_t filename);
 // Returns whether successful
 bool file_text_contents(weak_cstr_t filename, strong_cstr_t *out_contents, length_t *out_length, bool append_newline);
 
+// ---------------- file_text_map ----------------
+// Same as 'file_text_contents' with 'append_newline', except that
+// large files are mapped into memory as read-only instead of being copied.
+// 'out_is_mapped' will be whether the contents were mapped into memory.
+// The contents must be released using 'file_text_release'
+// Returns whether successful
+bool file_text_map(weak_cstr_t filename, strong_cstr_t *out_contents, length_t *out_length, bool *out_is_mapped);
+
+// ---------------- file_text_release ----------------
+// Releases the text contents of a file obtained from 'file_text_map'
+void file_text_release(strong_cstr_t contents, length_t length, bool is_mapped);
+
 // ---------------- file_binary_contents ----------------
 // Reads binary contents of a file.
 // When successful, 'out_contents' will be a newly allocated
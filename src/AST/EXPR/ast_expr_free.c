@@ -30,7 +30,6 @@ static void ast_expr_super_free(ast_expr_super_t *expr){
 
 static void ast_expr_member_free(ast_expr_member_t *expr){
     ast_expr_free_fully(expr->value);
-    free(expr->member);
 }
 
 static void ast_expr_array_access_free(ast_expr_array_access_t *expr){
@@ -5,6 +5,7 @@
 
 #include "AST/ast_expr.h"
 #include "AST/ast_layout.h"
+#include "AST/ast_pool.h"
 #include "AST/ast_type.h"
 #include "UTIL/color.h"
 #include "UTIL/ground.h"
@@ -76,14 +77,14 @@ ast_elem_t *ast_elem_clone(const ast_elem_t *original){
 
 static ast_elem_t *ast_elem_empty_clone(const ast_elem_t *original){
     return (ast_elem_t*) memcpy(
-        malloc(sizeof(ast_elem_t)),
+        ast_alloc(sizeof(ast_elem_t)),
         original,
         sizeof(ast_elem_t)
     );
 }
 
 static ast_elem_t *ast_elem_pointer_clone(const ast_elem_pointer_t *original){
-    ast_elem_pointer_t *clone = malloc(sizeof *original);
+    ast_elem_pointer_t *clone = ast_alloc(sizeof *original);
 
     *clone = (ast_elem_pointer_t){
         .id = AST_ELEM_POINTER,
@@ -95,7 +96,7 @@ static ast_elem_t *ast_elem_pointer_clone(const ast_elem_pointer_t *original){
 }
 
 static ast_elem_t *ast_elem_base_clone(const ast_elem_base_t *original){
-    ast_elem_base_t *clone = malloc(sizeof *original);
+    ast_elem_base_t *clone = ast_alloc(sizeof *original);
 
     *clone = (ast_elem_base_t){
         .id = AST_ELEM_BASE,
@@ -107,7 +108,7 @@ static ast_elem_t *ast_elem_base_clone(const ast_elem_base_t *original){
 }
 
 static ast_elem_t *ast_elem_fixed_array_clone(const ast_elem_fixed_array_t *original){
-    ast_elem_fixed_array_t *clone = malloc(sizeof *original);
+    ast_elem_fixed_array_t *clone = ast_alloc(sizeof *original);
 
     *clone = (ast_elem_fixed_array_t){
         .id = AST_ELEM_FIXED_ARRAY,
@@ -119,7 +120,7 @@ static ast_elem_t *ast_elem_fixed_array_clone(const ast_elem_fixed_array_t *orig
 }
 
 static ast_elem_t *ast_elem_var_fixed_array_clone(const ast_elem_var_fixed_array_t *original){
-    ast_elem_var_fixed_array_t *clone = malloc(sizeof *original);
+    ast_elem_var_fixed_array_t *clone = ast_alloc(sizeof *original);
 
     *clone = (ast_elem_var_fixed_array_t){
         .id = AST_ELEM_VAR_FIXED_ARRAY,
@@ -131,7 +132,7 @@ static ast_elem_t *ast_elem_var_fixed_array_clone(const ast_elem_var_fixed_array
 }
 
 static ast_elem_t *ast_elem_polycount_clone(const ast_elem_polycount_t *original){
-    ast_elem_polycount_t *clone = malloc(sizeof *original);
+    ast_elem_polycount_t *clone = ast_alloc(sizeof *original);
 
     *clone = (ast_elem_polycount_t){
         .id = AST_ELEM_POLYCOUNT,
@@ -143,7 +144,7 @@ static ast_elem_t *ast_elem_polycount_clone(const ast_elem_polycount_t *original
 }
 
 static ast_elem_t *ast_elem_func_clone(const ast_elem_func_t *original){
-    ast_elem_func_t *clone = malloc(sizeof *original);
+    ast_elem_func_t *clone = ast_alloc(sizeof *original);
 
     *clone = (ast_elem_func_t){
         .id = AST_ELEM_FUNC,
@@ -159,7 +160,7 @@ static ast_elem_t *ast_elem_func_clone(const ast_elem_func_t *original){
 }
 
 static ast_elem_t *ast_elem_polymorph_clone(const ast_elem_polymorph_t *original){
-    ast_elem_polymorph_t *clone = malloc(sizeof *original);
+    ast_elem_polymorph_t *clone = ast_alloc(sizeof *original);
 
     *clone = (ast_elem_polymorph_t){
         .id = AST_ELEM_POLYMORPH,
@@ -172,7 +173,7 @@ static ast_elem_t *ast_elem_polymorph_clone(const ast_elem_polymorph_t *original
 }
 
 static ast_elem_t *ast_elem_polymorph_prereq_clone(const ast_elem_polymorph_prereq_t *original){
-    ast_elem_polymorph_prereq_t *clone = malloc(sizeof *original);
+    ast_elem_polymorph_prereq_t *clone = ast_alloc(sizeof *original);
 
     *clone = (ast_elem_polymorph_prereq_t){
         .id = AST_ELEM_POLYMORPH_PREREQ,
@@ -187,7 +188,7 @@ static ast_elem_t *ast_elem_polymorph_prereq_clone(const ast_elem_polymorph_prer
 }
 
 static ast_elem_t *ast_elem_generic_base_clone(const ast_elem_generic_base_t *original){
-    ast_elem_generic_base_t *clone = malloc(sizeof *original);
+    ast_elem_generic_base_t *clone = ast_alloc(sizeof *original);
 
     *clone = (ast_elem_generic_base_t){
         .id = AST_ELEM_GENERIC_BASE,
@@ -202,7 +203,7 @@ static ast_elem_t *ast_elem_generic_base_clone(const ast_elem_generic_base_t *or
 }
 
 static ast_elem_t *ast_elem_layout_clone(const ast_elem_layout_t *original){
-    ast_elem_layout_t *clone = malloc(sizeof *original);
+    ast_elem_layout_t *clone = ast_alloc(sizeof *original);
 
     *clone = (ast_elem_layout_t){
         .id = AST_ELEM_LAYOUT,
@@ -214,7 +215,7 @@ static ast_elem_t *ast_elem_layout_clone(const ast_elem_layout_t *original){
 }
 
 static ast_elem_t *ast_elem_unknown_enum_clone(const ast_elem_unknown_enum_t *original){
-    return (ast_elem_t*) malloc_init(ast_elem_unknown_enum_t, {
+    return (ast_elem_t*) ast_alloc_init(ast_elem_unknown_enum_t, {
         .id = AST_ELEM_UNKNOWN_ENUM,
         .source = original->source,
         .kind_name = original->kind_name,
@@ -222,7 +223,7 @@ static ast_elem_t *ast_elem_unknown_enum_clone(const ast_elem_unknown_enum_t *or
 }
 
 static ast_elem_t *ast_elem_unknown_plural_enum_clone(const ast_elem_unknown_plural_enum_t *original){
-    return (ast_elem_t*) malloc_init(ast_elem_unknown_plural_enum_t, {
+    return (ast_elem_t*) ast_alloc_init(ast_elem_unknown_plural_enum_t, {
         .id = AST_ELEM_UNKNOWN_PLURAL_ENUM,
         .source = original->source,
         .kinds = strong_cstr_list_clone(&original->kinds),
@@ -230,7 +231,7 @@ static ast_elem_t *ast_elem_unknown_plural_enum_clone(const ast_elem_unknown_plu
 }
 
 static ast_elem_t *ast_elem_anonymous_enum_clone(const ast_elem_anonymous_enum_t *original){
-    return (ast_elem_t*) malloc_init(ast_elem_anonymous_enum_t, {
+    return (ast_elem_t*) ast_alloc_init(ast_elem_anonymous_enum_t, {
         .id = AST_ELEM_ANONYMOUS_ENUM,
         .source = original->source,
         .kinds = strong_cstr_list_clone(&original->kinds),
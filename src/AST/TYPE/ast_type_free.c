@@ -3,6 +3,7 @@
 
 #include "AST/ast_expr.h"
 #include "AST/ast_layout.h"
+#include "AST/ast_pool.h"
 #include "AST/ast_type.h"
 #include "UTIL/color.h"
 #include "UTIL/ground.h"
@@ -89,7 +90,7 @@ void ast_elems_free(ast_elem_t **elements, length_t elements_length){
             die("ast_elems_free() - Unrecognized type element ID %zu at index %zu\n", (size_t) elem->id, i);
         }
 
-        free(elem);
+        ast_release(elem);
     }
 }
 
@@ -0,0 +1,97 @@
+
+#include <stdlib.h>
+
+#include "AST/TYPE/ast_type_hash.h"
+#include "AST/TYPE/ast_type_identical.h"
+#include "AST/TYPE/ast_type_intern.h"
+#include "AST/ast_type.h"
+#include "UTIL/ground.h"
+#include "UTIL/hash.h"
+#include "UTIL/util.h"
+
+#define AST_TYPE_INTERN_TABLE_INITIAL_SLOTS 256
+
+void ast_type_intern_table_init(ast_type_intern_table_t *table){
+    *table = (ast_type_intern_table_t){
+        .types = NULL,
+        .length = 0,
+        .capacity = 0,
+        .slots = calloc(AST_TYPE_INTERN_TABLE_INITIAL_SLOTS, sizeof(length_t)),
+        .slots_capacity = AST_TYPE_INTERN_TABLE_INITIAL_SLOTS,
+    };
+}
+
+void ast_type_intern_table_free(ast_type_intern_table_t *table){
+    for(length_t i = 0; i != table->length; i++){
+        ast_type_free(&table->types[i]->type);
+        free(table->types[i]);
+    }
+
+    free(table->types);
+    free(table->slots);
+}
+
+// Returns the slot that either contains the type, or is where it should be inserted
+static length_t ast_type_intern_probe(ast_type_intern_table_t *table, const ast_type_t *type, hash_t hash){
+    length_t slot = hash & (table->slots_capacity - 1);
+
+    while(table->slots[slot] != 0){
+        ast_canonical_type_t *canonical = table->types[table->slots[slot] - 1];
+        if(canonical->hash == hash && ast_types_identical(&canonical->type, type)) break;
+
+        slot = (slot + 1) & (table->slots_capacity - 1);
+    }
+
+    return slot;
+}
+
+static void ast_type_intern_grow_slots(ast_type_intern_table_t *table){
+    length_t new_capacity = table->slots_capacity * 2;
+    length_t *new_slots = calloc(new_capacity, sizeof(length_t));
+
+    for(length_t i = 0; i != table->length; i++){
+        length_t slot = table->types[i]->hash & (new_capacity - 1);
+
+        while(new_slots[slot] != 0){
+            slot = (slot + 1) & (new_capacity - 1);
+        }
+
+        new_slots[slot] = i + 1;
+    }
+
+    free(table->slots);
+    table->slots = new_slots;
+    table->slots_capacity = new_capacity;
+}
+
+const ast_canonical_type_t *ast_type_intern(ast_type_intern_table_t *table, const ast_type_t *type){
+    hash_t hash = ast_type_hash(type);
+    length_t slot = ast_type_intern_probe(table, type, hash);
+
+    if(table->slots[slot] != 0){
+        return table->types[table->slots[slot] - 1];
+    }
+
+    expand((void**) &table->types, sizeof(ast_canonical_type_t*), table->length, &table->capacity, 1, 64);
+
+    ast_canonical_type_t *canonical = malloc_init(ast_canonical_type_t, {
+        .type = ast_type_clone(type),
+        .hash = hash,
+        .id = table->length,
+    });
+
+    table->types[table->length++] = canonical;
+    table->slots[slot] = table->length;
+
+    // Keep load factor at or below 1/2
+    if(table->length * 2 > table->slots_capacity){
+        ast_type_intern_grow_slots(table);
+    }
+
+    return canonical;
+}
+
+const ast_canonical_type_t *ast_type_intern_find(ast_type_intern_table_t *table, const ast_type_t *type){
+    length_t slot = ast_type_intern_probe(table, type, ast_type_hash(type));
+    return table->slots[slot] != 0 ? table->types[table->slots[slot] - 1] : NULL;
+}
@@ -3,6 +3,7 @@
 #include <stdlib.h>
 
 #include "AST/TYPE/ast_type_make.h"
+#include "AST/ast_pool.h"
 #include "AST/ast_type.h"
 #include "UTIL/ground.h"
 #include "UTIL/string.h"
@@ -13,14 +14,14 @@
 // =====================================================================
 
 ast_elem_t *ast_elem_empty_make(unsigned int id, source_t source){
-    return (ast_elem_t*) malloc_init(ast_elem_t, {
+    return (ast_elem_t*) ast_alloc_init(ast_elem_t, {
         .id = id,
         .source = source,
     });
 }
 
 ast_elem_t *ast_elem_pointer_make(source_t source, bool is_volatile){
-    return (ast_elem_t*) malloc_init(ast_elem_pointer_t, {
+    return (ast_elem_t*) ast_alloc_init(ast_elem_pointer_t, {
         .id = AST_ELEM_POINTER,
         .source = source,
         .is_volatile = is_volatile,
@@ -28,7 +29,7 @@ ast_elem_t *ast_elem_pointer_make(source_t source, bool is_volatile){
 }
 
 ast_elem_t *ast_elem_base_make(strong_cstr_t base, source_t source){
-    return (ast_elem_t*) malloc_init(ast_elem_base_t, {
+    return (ast_elem_t*) ast_alloc_init(ast_elem_base_t, {
         .id = AST_ELEM_BASE,
         .source = source,
         .base = base,
@@ -36,7 +37,7 @@ ast_elem_t *ast_elem_base_make(strong_cstr_t base, source_t source){
 }
 
 ast_elem_t *ast_elem_generic_base_make(strong_cstr_t base, source_t source, ast_type_t *generics, length_t generics_length){
-    return (ast_elem_t*) malloc_init(ast_elem_generic_base_t, {
+    return (ast_elem_t*) ast_alloc_init(ast_elem_generic_base_t, {
         .id = AST_ELEM_GENERIC_BASE,
         .source = source,
         .name = base,
@@ -47,7 +48,7 @@ ast_elem_t *ast_elem_generic_base_make(strong_cstr_t base, source_t source, ast_
 }
 
 ast_elem_t *ast_elem_polymorph_make(strong_cstr_t name, source_t source, bool allow_auto_conversion){
-    return (ast_elem_t*) malloc_init(ast_elem_polymorph_t, {
+    return (ast_elem_t*) ast_alloc_init(ast_elem_polymorph_t, {
         .id = AST_ELEM_POLYMORPH,
         .source = source,
         .name = name,
@@ -56,7 +57,7 @@ ast_elem_t *ast_elem_polymorph_make(strong_cstr_t name, source_t source, bool al
 }
 
 ast_elem_t *ast_elem_polymorph_prereq_make(strong_cstr_t name, source_t source, bool allow_auto_conversion, maybe_null_strong_cstr_t similarity_prerequisite, ast_type_t extends){
-    return (ast_elem_t*) malloc_init(ast_elem_polymorph_prereq_t, {
+    return (ast_elem_t*) ast_alloc_init(ast_elem_polymorph_prereq_t, {
         .id = AST_ELEM_POLYMORPH_PREREQ,
         .source = source,
         .name = name,
@@ -67,7 +68,7 @@ ast_elem_t *ast_elem_polymorph_prereq_make(strong_cstr_t name, source_t source,
 }
 
 ast_elem_t *ast_elem_func_make(source_t source, ast_type_t *arg_types, length_t arity, ast_type_t *return_type, trait_t traits, bool have_ownership){
-    return (ast_elem_t*) malloc_init(ast_elem_func_t, {
+    return (ast_elem_t*) ast_alloc_init(ast_elem_func_t, {
         .id = AST_ELEM_FUNC,
         .source = source,
         .arg_types = arg_types,
@@ -79,7 +80,7 @@ ast_elem_t *ast_elem_func_make(source_t source, ast_type_t *arg_types, length_t
 }
 
 ast_elem_t *ast_elem_fixed_array_make(source_t source, length_t count){
-    return (ast_elem_t*) malloc_init(ast_elem_fixed_array_t, {
+    return (ast_elem_t*) ast_alloc_init(ast_elem_fixed_array_t, {
         .id = AST_ELEM_FIXED_ARRAY,
         .source = source,
         .length = count,
@@ -87,7 +88,7 @@ ast_elem_t *ast_elem_fixed_array_make(source_t source, length_t count){
 }
 
 ast_elem_t *ast_elem_var_fixed_array_make(source_t source, ast_expr_t *length){
-    return (ast_elem_t*) malloc_init(ast_elem_var_fixed_array_t, {
+    return (ast_elem_t*) ast_alloc_init(ast_elem_var_fixed_array_t, {
         .id = AST_ELEM_VAR_FIXED_ARRAY,
         .source = source,
         .length = length,
@@ -95,7 +96,7 @@ ast_elem_t *ast_elem_var_fixed_array_make(source_t source, ast_expr_t *length){
 }
 
 ast_elem_t *ast_elem_unknown_enum_make(source_t source, weak_cstr_t kind_name){
-    return (ast_elem_t*) malloc_init(ast_elem_unknown_enum_t, {
+    return (ast_elem_t*) ast_alloc_init(ast_elem_unknown_enum_t, {
         .id = AST_ELEM_UNKNOWN_ENUM,
         .source = source,
         .kind_name = kind_name,
@@ -103,7 +104,7 @@ ast_elem_t *ast_elem_unknown_enum_make(source_t source, weak_cstr_t kind_name){
 }
 
 ast_elem_t *ast_elem_unknown_plural_enum_make(source_t source, strong_cstr_list_t kinds){
-    return (ast_elem_t*) malloc_init(ast_elem_unknown_plural_enum_t, {
+    return (ast_elem_t*) ast_alloc_init(ast_elem_unknown_plural_enum_t, {
         .id = AST_ELEM_UNKNOWN_PLURAL_ENUM,
         .source = source,
         .kinds = kinds,
@@ -127,7 +128,7 @@ ast_elem_t *ast_elem_anonymous_enum_make(source_t source, const char **raw_kinds
     strong_cstr_list_sort(&kinds);
 
     // Return completed anonymous enum type element
-    return (ast_elem_t*) malloc_init(ast_elem_anonymous_enum_t, {
+    return (ast_elem_t*) ast_alloc_init(ast_elem_anonymous_enum_t, {
         .id = AST_ELEM_ANONYMOUS_ENUM,
         .source = source,
         .kinds = kinds,
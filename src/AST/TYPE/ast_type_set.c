@@ -26,8 +26,8 @@ static void ast_type_set_free_function(void *value){
     ast_type_free_fully((ast_type_t*) value);
 }
 
-void ast_type_set_init(ast_type_set_t *set, length_t num_buckets){
-    set_init(&set->impl, num_buckets, &ast_type_set_hash_function, &ast_type_set_equals_function, &ast_type_set_preinsert_clone_function);
+void ast_type_set_init(ast_type_set_t *set, length_t starting_capacity){
+    set_init(&set->impl, starting_capacity, &ast_type_set_hash_function, &ast_type_set_equals_function, &ast_type_set_preinsert_clone_function);
 }
 
 bool ast_type_set_insert(ast_type_set_t *set, ast_type_t *type){
@@ -11,6 +11,8 @@
 #include "AST/ast_expr.h"
 #include "AST/ast_type.h"
 #include "DRVR/compiler.h"
+#include "UTIL/hash.h"
+#include "UTIL/map.h"
 #include "UTIL/string.h"
 #include "UTIL/string_builder.h"
 #include "UTIL/util.h"
@@ -19,7 +21,37 @@
 #include <emscripten/emscripten.h>
 #endif
 
+// Key for finding polymorphic composites by name and number of generics
+typedef struct {
+    weak_cstr_t name;
+    length_t generics_length;
+} ast_poly_composite_key_t;
+
+static hash_t ast_composite_name_hash(const void *name){
+    return hash_string((const char*) name);
+}
+
+static bool ast_composite_name_equals(const void *a, const void *b){
+    return streq((const char*) a, (const char*) b);
+}
+
+static hash_t ast_poly_composite_key_hash(const void *key){
+    const ast_poly_composite_key_t *poly_key = key;
+    return hash_combine(hash_string(poly_key->name), poly_key->generics_length);
+}
+
+static bool ast_poly_composite_key_equals(const void *a, const void *b){
+    const ast_poly_composite_key_t *poly_a = a, *poly_b = b;
+    return poly_a->generics_length == poly_b->generics_length && streq(poly_a->name, poly_b->name);
+}
+
+static void ast_poly_composite_key_free(void *key, void *value){
+    (void) value;
+    free(key);
+}
+
 void ast_init(ast_t *ast, unsigned int cross_compile_for){
+    ast_pool_init(&ast->pool);
     ast->funcs = malloc(sizeof(ast_func_t) * 8);
     ast->funcs_length = 0;
     ast->funcs_capacity = 8;
@@ -60,6 +92,8 @@ void ast_init(ast_t *ast, unsigned int cross_compile_for){
     ast->poly_composites = NULL;
     ast->poly_composites_length = 0;
     ast->poly_composites_capacity = 0;
+    map_init(&ast->composites_by_name, 0, &ast_composite_name_hash, &ast_composite_name_equals);
+    map_init(&ast->poly_composites_by_name, 0, &ast_poly_composite_key_hash, &ast_poly_composite_key_equals);
 
     // Add relevant standard meta definitions
 
@@ -291,6 +325,9 @@ void ast_free(ast_t *ast){
     }
 
     free(ast->poly_composites);
+    map_free(&ast->composites_by_name, NULL);
+    map_free(&ast->poly_composites_by_name, &ast_poly_composite_key_free);
+    ast_pool_free(&ast->pool);
 }
 
 void ast_free_functions(ast_func_t *functions, length_t functions_length){
@@ -519,13 +556,8 @@ void ast_enum_init(ast_enum_t *enum_definition,  weak_cstr_t name, weak_cstr_t *
 }
 
 ast_composite_t *ast_composite_find_exact(ast_t *ast, const char *name){
-    // TODO: CLEANUP: SPEED: Maybe sort and do a binary search or something
-    for(length_t i = 0; i != ast->composites_length; i++){
-        if(streq(ast->composites[i].name, name)){
-            return &ast->composites[i];
-        }
-    }
-    return NULL;
+    length_t index_plus_one = (length_t) (uintptr_t) map_find(&ast->composites_by_name, name);
+    return index_plus_one ? &ast->composites[index_plus_one - 1] : NULL;
 }
 
 successful_t ast_composite_find_exact_field(ast_composite_t *composite, const char *name, ast_layout_endpoint_t *out_endpoint, ast_layout_endpoint_path_t *out_path){
@@ -539,47 +571,25 @@ ast_poly_composite_t *ast_poly_composite_find_exact_from_elem(ast_t *ast, ast_el
 }
 
 ast_poly_composite_t *ast_poly_composite_find_exact(ast_t *ast, const char *name, length_t num_generics){
-    // TODO: Maybe sort and do a binary search or something
-    for(length_t i = 0; i != ast->poly_composites_length; i++){
-        ast_poly_composite_t *poly_composite = &ast->poly_composites[i];
-        if(streq(poly_composite->name, name) && poly_composite->generics_length == num_generics){
-            return poly_composite;
-        }
-    }
-    return NULL;
+    ast_poly_composite_key_t key = (ast_poly_composite_key_t){
+        .name = (char*) name, // (key is only read)
+        .generics_length = num_generics,
+    };
+
+    length_t index_plus_one = (length_t) (uintptr_t) map_find(&ast->poly_composites_by_name, &key);
+    return index_plus_one ? &ast->poly_composites[index_plus_one - 1] : NULL;
 }
 
 ast_composite_t *ast_find_composite(ast_t *ast, const ast_type_t *type){
     if(type->elements_length != 1) return NULL;
 
     switch(type->elements[0]->id){
-    case AST_ELEM_BASE: {
-            const char *target_name = ((ast_elem_base_t*) type->elements[0])->base;
-
-            for(length_t i = 0; i != ast->composites_length; i++){
-                ast_composite_t *composite = &ast->composites[i];
-
-                if(streq(composite->name, target_name)){
-                    return composite;
-                }
-            }
-        }
-        break;
+    case AST_ELEM_BASE:
+        return ast_composite_find_exact(ast, ((ast_elem_base_t*) type->elements[0])->base);
     case AST_ELEM_GENERIC_BASE: {
             ast_elem_generic_base_t *generic_base_elem = (ast_elem_generic_base_t*) type->elements[0];
-
-            const char *target_name = generic_base_elem->name;
-            length_t generics_count = generic_base_elem->generics_length;
-
-            for(length_t i = 0; i != ast->poly_composites_length; i++){
-                ast_poly_composite_t *poly_composite = &ast->poly_composites[i];
-
-                if(streq(poly_composite->name, target_name) && poly_composite->generics_length == generics_count){
-                    return (ast_composite_t*) poly_composite;
-                }
-            }
+            return (ast_composite_t*) ast_poly_composite_find_exact(ast, generic_base_elem->name, generic_base_elem->generics_length);
         }
-        break;
     }
 
     return NULL;
@@ -735,6 +745,9 @@ ast_composite_t *ast_add_composite(
 
     ast_composite_t *composite = &ast->composites[ast->composites_length++];
 
+    // Earlier composites with the same name take precedence
+    map_insert(&ast->composites_by_name, name, (void*) (uintptr_t) ast->composites_length);
+
     *composite = (ast_composite_t){
         .name = name,
         .layout = layout,
@@ -762,6 +775,16 @@ ast_poly_composite_t *ast_add_poly_composite(
 
     ast_poly_composite_t *poly_composite = &ast->poly_composites[ast->poly_composites_length++];
 
+    ast_poly_composite_key_t *key = malloc_init(ast_poly_composite_key_t, {
+        .name = name,
+        .generics_length = generics_length,
+    });
+
+    // Earlier polymorphic composites with the same name and number of generics take precedence
+    if(!map_insert(&ast->poly_composites_by_name, key, (void*) (uintptr_t) ast->poly_composites_length)){
+        free(key);
+    }
+
     *poly_composite = (ast_poly_composite_t){
         .name = name,
         .layout = layout,
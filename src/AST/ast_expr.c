@@ -6,6 +6,7 @@
 
 #include "AST/ast_expr.h"
 #include "AST/ast_named_expression.h"
+#include "AST/ast_pool.h"
 #include "AST/ast_type.h"
 #include "UTIL/color.h"
 #include "UTIL/datatypes.h"
@@ -34,7 +35,7 @@ bool expr_is_mutable(ast_expr_t *expr){
 
 void ast_expr_free_fully(ast_expr_t *expr){
     ast_expr_free(expr);
-    free(expr);
+    ast_release(expr);
 }
 
 void ast_exprs_free(ast_expr_t **exprs, length_t length){
@@ -62,39 +63,39 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_BREAK:
     case EXPR_CONTINUE:
     case EXPR_FALLTHROUGH:
-        return memclone(expr, sizeof(ast_expr_t));
+        return ast_memclone(expr, sizeof(ast_expr_t));
     case EXPR_BYTE:
-        return memclone(expr, sizeof(ast_expr_byte_t));
+        return ast_memclone(expr, sizeof(ast_expr_byte_t));
     case EXPR_UBYTE:
-        return memclone(expr, sizeof(ast_expr_ubyte_t));
+        return ast_memclone(expr, sizeof(ast_expr_ubyte_t));
     case EXPR_SHORT:
-        return memclone(expr, sizeof(ast_expr_short_t));
+        return ast_memclone(expr, sizeof(ast_expr_short_t));
     case EXPR_USHORT:
-        return memclone(expr, sizeof(ast_expr_ushort_t));
+        return ast_memclone(expr, sizeof(ast_expr_ushort_t));
     case EXPR_INT:
-        return memclone(expr, sizeof(ast_expr_int_t));
+        return ast_memclone(expr, sizeof(ast_expr_int_t));
     case EXPR_UINT:
-        return memclone(expr, sizeof(ast_expr_uint_t));
+        return ast_memclone(expr, sizeof(ast_expr_uint_t));
     case EXPR_LONG:
-        return memclone(expr, sizeof(ast_expr_long_t));
+        return ast_memclone(expr, sizeof(ast_expr_long_t));
     case EXPR_ULONG:
-        return memclone(expr, sizeof(ast_expr_ulong_t));
+        return ast_memclone(expr, sizeof(ast_expr_ulong_t));
     case EXPR_USIZE:
-        return memclone(expr, sizeof(ast_expr_usize_t));
+        return ast_memclone(expr, sizeof(ast_expr_usize_t));
     case EXPR_FLOAT:
-        return memclone(expr, sizeof(ast_expr_float_t));
+        return ast_memclone(expr, sizeof(ast_expr_float_t));
     case EXPR_DOUBLE:
-        return memclone(expr, sizeof(ast_expr_double_t));
+        return ast_memclone(expr, sizeof(ast_expr_double_t));
     case EXPR_BOOLEAN:
-        return memclone(expr, sizeof(ast_expr_boolean_t));
+        return ast_memclone(expr, sizeof(ast_expr_boolean_t));
     case EXPR_GENERIC_INT:
-        return memclone(expr, sizeof(ast_expr_generic_int_t));
+        return ast_memclone(expr, sizeof(ast_expr_generic_int_t));
     case EXPR_GENERIC_FLOAT:
-        return memclone(expr, sizeof(ast_expr_generic_float_t));
+        return ast_memclone(expr, sizeof(ast_expr_generic_float_t));
     case EXPR_CSTR:
-        return memclone(expr, sizeof(ast_expr_cstr_t));
+        return ast_memclone(expr, sizeof(ast_expr_cstr_t));
     case EXPR_STR:
-        return memclone(expr, sizeof(ast_expr_str_t));
+        return ast_memclone(expr, sizeof(ast_expr_str_t));
     case EXPR_ADD:
     case EXPR_SUBTRACT:
     case EXPR_MULTIPLY:
@@ -117,7 +118,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_BIT_LGC_RSHIFT: {
             ast_expr_math_t *original = (ast_expr_math_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_math_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_math_t, {
                 .id = original->id,
                 .source = original->source,
                 .a = ast_expr_clone(original->a),
@@ -127,7 +128,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_CALL: {
             ast_expr_call_t *original = (ast_expr_call_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_call_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_call_t, {
                 .id = original->id,
                 .source = original->source,
                 .name = strclone(original->name),
@@ -142,7 +143,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_SUPER: {
             ast_expr_super_t *original = (ast_expr_super_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_super_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_super_t, {
                 .id = original->id,
                 .source = original->source,
                 .args = ast_exprs_clone(original->args, original->arity),
@@ -153,7 +154,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_VARIABLE: {
             ast_expr_variable_t *original = (ast_expr_variable_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_variable_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_variable_t, {
                 .id = original->id,
                 .source = original->source,
                 .name = original->name,
@@ -162,11 +163,11 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_MEMBER: {
             ast_expr_member_t *original = (ast_expr_member_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_member_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_member_t, {
                 .id = original->id,
                 .source = original->source,
                 .value = ast_expr_clone(original->value),
-                .member = strclone(original->member),
+                .member = original->member,
             });
         }
     case EXPR_ADDRESS:
@@ -184,7 +185,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_VA_END: {
             ast_expr_unary_t *original = (ast_expr_unary_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_unary_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_unary_t, {
                 .id = original->id,
                 .source = original->source,
                 .value = ast_expr_clone(original->value),
@@ -194,7 +195,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_FUNC_ADDR: {
             ast_expr_func_addr_t *original = (ast_expr_func_addr_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_func_addr_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_func_addr_t, {
                 .id = original->id,
                 .source = original->source,
                 .name = original->name,
@@ -210,7 +211,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_ARRAY_ACCESS: {
             ast_expr_array_access_t *original = (ast_expr_array_access_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_array_access_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_array_access_t, {
                 .id = original->id,
                 .source = original->source,
                 .value = ast_expr_clone(original->value),
@@ -220,7 +221,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_CAST: {
             ast_expr_cast_t *original = (ast_expr_cast_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_cast_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_cast_t, {
                 .id = original->id,
                 .source = original->source,
                 .from = ast_expr_clone(original->from),
@@ -233,7 +234,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_TYPENAMEOF: {
             ast_expr_unary_type_t *original = (ast_expr_unary_type_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_unary_type_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_unary_type_t, {
                 .id = original->id,
                 .source = original->source,
                 .type = ast_type_clone(&original->type),
@@ -242,7 +243,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_SIZEOF_VALUE: {
             ast_expr_sizeof_value_t *original = (ast_expr_sizeof_value_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_sizeof_value_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_sizeof_value_t, {
                 .id = original->id,
                 .source = original->source,
                 .value = ast_expr_clone(original->value),
@@ -251,7 +252,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_PHANTOM: {
             ast_expr_phantom_t *original = (ast_expr_phantom_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_phantom_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_phantom_t, {
                 .id = original->id,
                 .source = original->source,
                 .type = ast_type_clone(&original->type),
@@ -261,7 +262,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_CALL_METHOD: {
             ast_expr_call_method_t *original = (ast_expr_call_method_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_call_method_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_call_method_t, {
                 .id = original->id,
                 .source = original->source,
                 .name = strclone(original->name),
@@ -276,7 +277,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_NEW: {
             ast_expr_new_t *original = (ast_expr_new_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_new_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_new_t, {
                 .id = original->id,
                 .source = original->source,
                 .type = ast_type_clone(&original->type),
@@ -286,12 +287,12 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
             });
         }
     case EXPR_NEW_CSTRING:
-        return memclone(expr, sizeof(ast_expr_new_cstring_t));
+        return ast_memclone(expr, sizeof(ast_expr_new_cstring_t));
     case EXPR_STATIC_ARRAY:
     case EXPR_STATIC_STRUCT: {
             ast_expr_static_data_t *original = (ast_expr_static_data_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_static_data_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_static_data_t, {
                 .id = original->id,
                 .source = original->source,
                 .type = ast_type_clone(&original->type),
@@ -301,13 +302,13 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
         }
         break;
     case EXPR_ENUM_VALUE:
-        return memclone(expr, sizeof(ast_expr_enum_value_t));
+        return ast_memclone(expr, sizeof(ast_expr_enum_value_t));
     case EXPR_GENERIC_ENUM_VALUE:
-        return memclone(expr, sizeof(ast_expr_generic_enum_value_t));
+        return ast_memclone(expr, sizeof(ast_expr_generic_enum_value_t));
     case EXPR_TERNARY: {
             ast_expr_ternary_t *original = (ast_expr_ternary_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_ternary_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_ternary_t, {
                 .id = original->id,
                 .source = original->source,
                 .condition = ast_expr_clone(original->condition),
@@ -318,7 +319,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_VA_ARG: {
             ast_expr_va_arg_t *original = (ast_expr_va_arg_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_va_arg_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_va_arg_t, {
                 .id = original->id,
                 .source = original->source,
                 .va_list = ast_expr_clone(original->va_list),
@@ -328,7 +329,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_INITLIST: {
             ast_expr_initlist_t *original = (ast_expr_initlist_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_initlist_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_initlist_t, {
                 .id = original->id,
                 .source = original->source,
                 .elements = ast_exprs_clone(original->elements, original->length),
@@ -338,7 +339,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_POLYCOUNT: {
             ast_expr_polycount_t *original = (ast_expr_polycount_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_polycount_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_polycount_t, {
                 .id = original->id,
                 .source = original->source,
                 .name = strclone(original->name),
@@ -347,7 +348,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_LLVM_ASM: {
             ast_expr_llvm_asm_t *original = (ast_expr_llvm_asm_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_llvm_asm_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_llvm_asm_t, {
                 .id = original->id,
                 .source = original->source,
                 .assembly = strclone(original->assembly),
@@ -362,7 +363,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_EMBED: {
             ast_expr_embed_t *original = (ast_expr_embed_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_embed_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_embed_t, {
                 .id = original->id,
                 .source = original->source,
                 .filename = strclone(original->filename),
@@ -374,7 +375,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_ILDECLAREUNDEF: {
             ast_expr_declare_t *original = (ast_expr_declare_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_declare_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_declare_t, {
                 .id = original->id,
                 .source = original->source,
                 .name = original->name,
@@ -399,7 +400,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_LGC_RSHIFT_ASSIGN: {
             ast_expr_assign_t *original = (ast_expr_assign_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_assign_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_assign_t, {
                 .id = original->id,
                 .source = original->source,
                 .destination = ast_expr_clone_if_not_null(original->destination),
@@ -410,7 +411,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_RETURN: {
             ast_expr_return_t *original = (ast_expr_return_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_return_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_return_t, {
                 .id = original->id,
                 .source = original->source,
                 .value = ast_expr_clone_if_not_null(original->value),
@@ -425,7 +426,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_UNTILBREAK: {
             ast_expr_if_t *original = (ast_expr_if_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_if_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_if_t, {
                 .id = original->id,
                 .source = original->source,
                 .label = original->label,
@@ -437,7 +438,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_UNLESSELSE: {
             ast_expr_ifelse_t *original = (ast_expr_ifelse_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_ifelse_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_ifelse_t, {
                 .id = original->id,
                 .source = original->source,
                 .label = original->label,
@@ -449,7 +450,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_EACH_IN: {
             ast_expr_each_in_t *original = (ast_expr_each_in_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_each_in_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_each_in_t, {
                 .id = original->id,
                 .source = original->source,
                 .label = original->label,
@@ -465,7 +466,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_REPEAT: {
             ast_expr_repeat_t *original = (ast_expr_repeat_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_repeat_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_repeat_t, {
                 .id = original->id,
                 .source = original->source,
                 .label = original->label,
@@ -477,11 +478,11 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
         }
     case EXPR_BREAK_TO:
     case EXPR_CONTINUE_TO:
-        return memclone(expr, sizeof(ast_expr_break_to_t));
+        return ast_memclone(expr, sizeof(ast_expr_break_to_t));
     case EXPR_SWITCH: {
             ast_expr_switch_t *original = (ast_expr_switch_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_switch_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_switch_t, {
                 .id = original->id,
                 .source = original->source,
                 .value = ast_expr_clone(original->value),
@@ -493,7 +494,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_VA_COPY: {
             ast_expr_va_copy_t *original = (ast_expr_va_copy_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_va_copy_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_va_copy_t, {
                 .id = original->id,
                 .source = original->source,
                 .src_value = ast_expr_clone(original->src_value),
@@ -503,7 +504,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_FOR: {
             ast_expr_for_t *original = (ast_expr_for_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_for_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_for_t, {
                 .id = original->id,
                 .source = original->source,
                 .label = original->label,
@@ -516,7 +517,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_DECLARE_NAMED_EXPRESSION: {
             ast_expr_declare_named_expression_t *original = (ast_expr_declare_named_expression_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_declare_named_expression_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_declare_named_expression_t, {
                 .id = original->id,
                 .source = original->source,
                 .named_expression = ast_named_expression_clone(&original->named_expression),
@@ -525,7 +526,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_CONDITIONLESS_BLOCK: {
             ast_expr_conditionless_block_t *original = (ast_expr_conditionless_block_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_conditionless_block_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_conditionless_block_t, {
                 .id = original->id,
                 .source = original->source,
                 .statements = ast_expr_list_clone(&original->statements),
@@ -534,7 +535,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_ASSERT: {
             ast_expr_assert_t *original = (ast_expr_assert_t*) expr;
 
-            return (ast_expr_t*) malloc_init(ast_expr_assert_t, {
+            return (ast_expr_t*) ast_alloc_init(ast_expr_assert_t, {
                 .id = original->id,
                 .source = original->source,
                 .assertion = ast_expr_clone(original->assertion),
@@ -548,7 +549,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
 }
 
 ast_expr_t *ast_expr_create_bool(adept_bool value, source_t source){
-    return (ast_expr_t*) malloc_init(ast_expr_boolean_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_boolean_t, {
         .id = EXPR_BOOLEAN,
         .source = source,
         .value = value,
@@ -556,7 +557,7 @@ ast_expr_t *ast_expr_create_bool(adept_bool value, source_t source){
 }
 
 ast_expr_t *ast_expr_create_long(adept_long value, source_t source){
-    return (ast_expr_t*) malloc_init(ast_expr_long_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_long_t, {
         .id = EXPR_LONG,
         .source = source,
         .value = value,
@@ -564,7 +565,7 @@ ast_expr_t *ast_expr_create_long(adept_long value, source_t source){
 }
 
 ast_expr_t *ast_expr_create_double(adept_double value, source_t source){
-    return (ast_expr_t*) malloc_init(ast_expr_double_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_double_t, {
         .id = EXPR_DOUBLE,
         .source = source,
         .value = value,
@@ -572,7 +573,7 @@ ast_expr_t *ast_expr_create_double(adept_double value, source_t source){
 }
 
 ast_expr_t *ast_expr_create_string(char *array, length_t length, source_t source){
-    return (ast_expr_t*) malloc_init(ast_expr_str_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_str_t, {
         .id = EXPR_STR,
         .source = source,
         .array = array,
@@ -581,7 +582,7 @@ ast_expr_t *ast_expr_create_string(char *array, length_t length, source_t source
 }
 
 ast_expr_t *ast_expr_create_cstring(char *array, source_t source){
-    return (ast_expr_t*) malloc_init(ast_expr_cstr_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_cstr_t, {
         .id = EXPR_CSTR,
         .source = source,
         .array = array,
@@ -590,7 +591,7 @@ ast_expr_t *ast_expr_create_cstring(char *array, source_t source){
 }
 
 ast_expr_t *ast_expr_create_cstring_of_length(char *array, length_t length, source_t source){
-    return (ast_expr_t*) malloc_init(ast_expr_cstr_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_cstr_t, {
         .id = EXPR_CSTR,
         .source = source,
         .array = array,
@@ -599,14 +600,14 @@ ast_expr_t *ast_expr_create_cstring_of_length(char *array, length_t length, sour
 }
 
 ast_expr_t *ast_expr_create_null(source_t source){
-    return (ast_expr_t*) malloc_init(ast_expr_null_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_null_t, {
         .id = EXPR_NULL,
         .source = source,
     });
 }
 
 ast_expr_t *ast_expr_create_variable(weak_cstr_t name, source_t source){
-    return (ast_expr_t*) malloc_init(ast_expr_variable_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_variable_t, {
         .id = EXPR_VARIABLE,
         .source = source,
         .name = name,
@@ -614,7 +615,7 @@ ast_expr_t *ast_expr_create_variable(weak_cstr_t name, source_t source){
 }
 
 ast_expr_t *ast_expr_create_call(strong_cstr_t name, length_t arity, ast_expr_t **args, bool is_tentative, ast_type_t *gives, source_t source){
-    ast_expr_call_t *expr = malloc(sizeof(ast_expr_call_t));
+    ast_expr_call_t *expr = ast_alloc(sizeof(ast_expr_call_t));
     ast_expr_create_call_in_place(expr, name, arity, args, is_tentative, gives, source);
     return (ast_expr_t*) expr;
 }
@@ -635,7 +636,7 @@ void ast_expr_create_call_in_place(ast_expr_call_t *out_expr, strong_cstr_t name
 }
 
 ast_expr_t *ast_expr_create_super(ast_expr_t **args, length_t arity, bool is_tentative, source_t source){
-    return (ast_expr_t*) malloc_init(ast_expr_super_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_super_t, {
         .id = EXPR_SUPER,
         .source = source,
         .args = args,
@@ -645,7 +646,7 @@ ast_expr_t *ast_expr_create_super(ast_expr_t **args, length_t arity, bool is_ten
 }
 
 ast_expr_t *ast_expr_create_call_method(strong_cstr_t name, ast_expr_t *value, length_t arity, ast_expr_t **args, bool is_tentative, bool allow_drop, ast_type_t *gives, source_t source){
-    ast_expr_call_method_t *expr = malloc(sizeof(ast_expr_call_method_t));
+    ast_expr_call_method_t *expr = ast_alloc(sizeof(ast_expr_call_method_t));
     ast_expr_create_call_method_in_place(expr, name, value, arity, args, is_tentative, allow_drop, gives, source);
     return (ast_expr_t*) expr;
 }
@@ -665,7 +666,7 @@ void ast_expr_create_call_method_in_place(ast_expr_call_method_t *out_expr, stro
 }
 
 ast_expr_t *ast_expr_create_enum_value(weak_cstr_t name, weak_cstr_t kind, source_t source){
-    return (ast_expr_t*) malloc_init(ast_expr_enum_value_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_enum_value_t, {
         .id = EXPR_ENUM_VALUE,
         .source = source,
         .enum_name = name,
@@ -674,7 +675,7 @@ ast_expr_t *ast_expr_create_enum_value(weak_cstr_t name, weak_cstr_t kind, sourc
 }
 
 ast_expr_t *ast_expr_create_generic_enum_value(weak_cstr_t kind, source_t source){
-    return (ast_expr_t*) malloc_init(ast_expr_generic_enum_value_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_generic_enum_value_t, {
         .id = EXPR_GENERIC_ENUM_VALUE,
         .source = source,
         .kind_name = kind,
@@ -682,7 +683,7 @@ ast_expr_t *ast_expr_create_generic_enum_value(weak_cstr_t kind, source_t source
 }
 
 ast_expr_t *ast_expr_create_ternary(ast_expr_t *condition, ast_expr_t *if_true, ast_expr_t *if_false, source_t source){
-    return (ast_expr_t*) malloc_init(ast_expr_ternary_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_ternary_t, {
         .id = EXPR_TERNARY,
         .source = source,
         .condition = condition,
@@ -692,7 +693,7 @@ ast_expr_t *ast_expr_create_ternary(ast_expr_t *condition, ast_expr_t *if_true,
 }
 
 ast_expr_t *ast_expr_create_cast(ast_type_t to, ast_expr_t *from, source_t source){
-    return (ast_expr_t*) malloc_init(ast_expr_cast_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_cast_t, {
         .id = EXPR_CAST,
         .to = to,
         .from = from,
@@ -701,7 +702,7 @@ ast_expr_t *ast_expr_create_cast(ast_type_t to, ast_expr_t *from, source_t sourc
 }
 
 ast_expr_t *ast_expr_create_phantom(ast_type_t ast_type, void *ir_value, source_t source, bool is_mutable){
-    return (ast_expr_t*) malloc_init(ast_expr_phantom_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_phantom_t, {
         .id = EXPR_PHANTOM,
         .source = source,
         .type = ast_type,
@@ -711,7 +712,7 @@ ast_expr_t *ast_expr_create_phantom(ast_type_t ast_type, void *ir_value, source_
 }
 
 ast_expr_t *ast_expr_create_typenameof(ast_type_t strong_type, source_t source){
-    return (ast_expr_t*) malloc_init(ast_expr_typenameof_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_typenameof_t, {
         .id = EXPR_TYPENAMEOF,
         .source = source,
         .type = strong_type,
@@ -719,7 +720,7 @@ ast_expr_t *ast_expr_create_typenameof(ast_type_t strong_type, source_t source){
 }
 
 ast_expr_t *ast_expr_create_embed(strong_cstr_t filename, source_t source){
-    return (ast_expr_t*) malloc_init(ast_expr_embed_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_embed_t, {
         .id = EXPR_EMBED,
         .source = source,
         .filename = filename,
@@ -735,7 +736,7 @@ ast_expr_t *ast_expr_create_declaration(
     ast_expr_t *value,
     optional_ast_expr_list_t inputs
 ){
-    return (ast_expr_t*) malloc_init(ast_expr_declare_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_declare_t, {
         .id = expr_id,
         .source = source,
         .name = name,
@@ -747,7 +748,7 @@ ast_expr_t *ast_expr_create_declaration(
 }
 
 ast_expr_t *ast_expr_create_assignment(unsigned int stmt_id, source_t source, ast_expr_t *mutable_expression, ast_expr_t *value, bool is_pod){
-    return (ast_expr_t*) malloc_init(ast_expr_assign_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_assign_t, {
         .id = stmt_id,
         .source = source,
         .destination = mutable_expression,
@@ -757,7 +758,7 @@ ast_expr_t *ast_expr_create_assignment(unsigned int stmt_id, source_t source, as
 }
 
 ast_expr_t *ast_expr_create_return(source_t source, ast_expr_t *value, ast_expr_list_t last_minute){
-    return (ast_expr_t*) malloc_init(ast_expr_return_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_return_t, {
         .id = EXPR_RETURN,
         .source = source,
         .value = value,
@@ -765,8 +766,8 @@ ast_expr_t *ast_expr_create_return(source_t source, ast_expr_t *value, ast_expr_
     });
 }
 
-ast_expr_t *ast_expr_create_member(ast_expr_t *value, strong_cstr_t member_name, source_t source){
-    return (ast_expr_t*) malloc_init(ast_expr_member_t, {
+ast_expr_t *ast_expr_create_member(ast_expr_t *value, weak_cstr_t member_name, source_t source){
+    return (ast_expr_t*) ast_alloc_init(ast_expr_member_t, {
         .id = EXPR_MEMBER,
         .value = value,
         .member = member_name,
@@ -775,7 +776,7 @@ ast_expr_t *ast_expr_create_member(ast_expr_t *value, strong_cstr_t member_name,
 }
                 
 ast_expr_t *ast_expr_create_access(ast_expr_t *value, ast_expr_t *index, source_t source){
-    return (ast_expr_t*) malloc_init(ast_expr_array_access_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_array_access_t, {
         .id = EXPR_ARRAY_ACCESS,
         .source = source,
         .value = value,
@@ -784,7 +785,7 @@ ast_expr_t *ast_expr_create_access(ast_expr_t *value, ast_expr_t *index, source_
 }
 
 ast_expr_t *ast_expr_create_va_arg(source_t source, ast_expr_t *va_list_value, ast_type_t arg_type){
-    return (ast_expr_t*) malloc_init(ast_expr_va_arg_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_va_arg_t, {
         .id = EXPR_VA_ARG,
         .source = source,
         .va_list = va_list_value,
@@ -793,7 +794,7 @@ ast_expr_t *ast_expr_create_va_arg(source_t source, ast_expr_t *va_list_value, a
 }
 
 ast_expr_t *ast_expr_create_polycount(source_t source, strong_cstr_t name){
-    return (ast_expr_t*) malloc_init(ast_expr_polycount_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_polycount_t, {
         .id = EXPR_POLYCOUNT,
         .source = source,
         .name = name,
@@ -801,7 +802,7 @@ ast_expr_t *ast_expr_create_polycount(source_t source, strong_cstr_t name){
 }
 
 ast_expr_t *ast_expr_create_va_copy(source_t source, ast_expr_t *dest_value, ast_expr_t *src_value){
-    return (ast_expr_t*) malloc_init(ast_expr_va_copy_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_va_copy_t, {
         .id = EXPR_VA_COPY,
         .source = source,
         .dest_value = dest_value,
@@ -810,7 +811,7 @@ ast_expr_t *ast_expr_create_va_copy(source_t source, ast_expr_t *dest_value, ast
 }
 
 ast_expr_t *ast_expr_create_simple_conditional(source_t source, unsigned int conditional_type, maybe_null_weak_cstr_t label, ast_expr_t *condition, ast_expr_list_t statements){
-    return (ast_expr_t*) malloc_init(ast_expr_conditional_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_conditional_t, {
         .id = conditional_type,
         .source = source,
         .label = label,
@@ -820,7 +821,7 @@ ast_expr_t *ast_expr_create_simple_conditional(source_t source, unsigned int con
 }
 
 ast_expr_t *ast_expr_create_for(source_t source, weak_cstr_t label, ast_expr_list_t before, ast_expr_list_t after, ast_expr_t *condition, ast_expr_list_t statements){
-    return (ast_expr_t*) malloc_init(ast_expr_for_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_for_t, {
         .id = EXPR_FOR,
         .source = source,
         .label = label,
@@ -832,7 +833,7 @@ ast_expr_t *ast_expr_create_for(source_t source, weak_cstr_t label, ast_expr_lis
 }
 
 ast_expr_t *ast_expr_create_unary(unsigned int expr_id, source_t source, ast_expr_t *value){
-    return (ast_expr_t*) malloc_init(ast_expr_unary_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_unary_t, {
         .id = expr_id,
         .source = source,
         .value = value,
@@ -840,7 +841,7 @@ ast_expr_t *ast_expr_create_unary(unsigned int expr_id, source_t source, ast_exp
 }
 
 ast_expr_t *ast_expr_create_initlist(source_t source, ast_expr_t **values, length_t length){
-    return (ast_expr_t*) malloc_init(ast_expr_initlist_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_initlist_t, {
         .id = EXPR_INITLIST,
         .source = source,
         .elements = values,
@@ -849,7 +850,7 @@ ast_expr_t *ast_expr_create_initlist(source_t source, ast_expr_t **values, lengt
 }
 
 ast_expr_t *ast_expr_create_math(source_t source, unsigned int expr_id, ast_expr_t *left, ast_expr_t *right){
-    return (ast_expr_t*) malloc_init(ast_expr_math_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_math_t, {
         .id = expr_id,
         .source = source,
         .a = left,
@@ -858,7 +859,7 @@ ast_expr_t *ast_expr_create_math(source_t source, unsigned int expr_id, ast_expr
 }
 
 ast_expr_t *ast_expr_create_switch(source_t source, ast_expr_t *value, ast_case_list_t cases, ast_expr_list_t or_default, bool is_exhaustive){
-    return (ast_expr_t*) malloc_init(ast_expr_switch_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_switch_t, {
         .id = EXPR_SWITCH,
         .source = source,
         .value = value,
@@ -869,7 +870,7 @@ ast_expr_t *ast_expr_create_switch(source_t source, ast_expr_t *value, ast_case_
 }
 
 ast_expr_t *ast_expr_create_declare_named_expression(source_t source, ast_named_expression_t named_expression){
-    return (ast_expr_t*) malloc_init(ast_expr_declare_named_expression_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_declare_named_expression_t, {
         .id = EXPR_DECLARE_NAMED_EXPRESSION,
         .source = source,
         .named_expression = named_expression,
@@ -877,7 +878,7 @@ ast_expr_t *ast_expr_create_declare_named_expression(source_t source, ast_named_
 }
 
 ast_expr_t *ast_expr_create_assert(source_t source, ast_expr_t *assertion){
-    return (ast_expr_t*) malloc_init(ast_expr_assert_t, {
+    return (ast_expr_t*) ast_alloc_init(ast_expr_assert_t, {
         .id = EXPR_ASSERT,
         .source = source,
         .assertion = assertion,
@@ -12,6 +12,7 @@
 #include "AST/ast_type.h"
 #include "UTIL/color.h"
 #include "UTIL/ground.h"
+#include "UTIL/hash.h"
 #include "UTIL/string.h"
 #include "UTIL/string_builder.h"
 #include "UTIL/trait.h"
@@ -525,11 +526,39 @@ ast_type_t *ast_layout_skeleton_get_type_at_index(ast_layout_skeleton_t *skeleto
     return &bone->type;
 }
 
+static void ast_field_map_index_insert(ast_field_map_t *field_map, length_t arrow_index){
+    // NOTE: Earlier arrows take priority over later arrows with the same name,
+    // the same as when searching linearly
+
+    weak_cstr_t name = field_map->arrows[arrow_index].name;
+    length_t mask = field_map->slots_capacity - 1;
+    length_t slot = hash_string(name) & mask;
+
+    while(field_map->slots[slot] != 0){
+        if(streq(field_map->arrows[field_map->slots[slot] - 1].name, name)) return;
+        slot = (slot + 1) & mask;
+    }
+
+    field_map->slots[slot] = arrow_index + 1;
+}
+
+static void ast_field_map_rebuild_index(ast_field_map_t *field_map, length_t capacity){
+    free(field_map->slots);
+    field_map->slots = calloc(capacity, sizeof(length_t));
+    field_map->slots_capacity = capacity;
+
+    for(length_t i = 0; i != field_map->arrows_length; i++){
+        ast_field_map_index_insert(field_map, i);
+    }
+}
+
 void ast_field_map_init(ast_field_map_t *field_map){
     field_map->arrows = NULL;
     field_map->arrows_length = 0;
     field_map->arrows_capacity = 0;
     field_map->is_simple = true;
+    field_map->slots = NULL;
+    field_map->slots_capacity = 0;
 }
 
 void ast_field_map_free(ast_field_map_t *field_map){
@@ -537,6 +566,7 @@ void ast_field_map_free(ast_field_map_t *field_map){
         free(field_map->arrows[i].name);
     }
     free(field_map->arrows);
+    free(field_map->slots);
 }
 
 ast_field_map_t ast_field_map_clone(const ast_field_map_t *field_map){
@@ -554,6 +584,15 @@ ast_field_map_t ast_field_map_clone(const ast_field_map_t *field_map){
         clone_arrow->endpoint = original_arrow->endpoint;
     }
 
+    if(field_map->slots){
+        clone.slots = malloc(sizeof(length_t) * field_map->slots_capacity);
+        clone.slots_capacity = field_map->slots_capacity;
+        memcpy(clone.slots, field_map->slots, sizeof(length_t) * field_map->slots_capacity);
+    } else {
+        clone.slots = NULL;
+        clone.slots_capacity = 0;
+    }
+
     return clone;
 }
 
@@ -590,9 +629,48 @@ void ast_field_map_add(ast_field_map_t *field_map, strong_cstr_t name, ast_layou
     ast_field_arrow_t *arrow = &field_map->arrows[field_map->arrows_length++];
     arrow->name = name;
     arrow->endpoint = endpoint;
+
+    if(field_map->slots){
+        ast_field_map_index_insert(field_map, field_map->arrows_length - 1);
+
+        // Keep load factor at or below 1/2
+        if(field_map->arrows_length * 2 > field_map->slots_capacity){
+            ast_field_map_rebuild_index(field_map, field_map->slots_capacity * 2);
+        }
+    }
+}
+
+void ast_field_map_build_index(ast_field_map_t *field_map){
+    if(field_map->slots || field_map->arrows_length < AST_FIELD_MAP_INDEX_THRESHOLD) return;
+
+    length_t capacity = 32;
+
+    while(capacity < field_map->arrows_length * 2){
+        capacity *= 2;
+    }
+
+    ast_field_map_rebuild_index(field_map, capacity);
 }
 
 successful_t ast_field_map_find(ast_field_map_t *field_map, const char *name, ast_layout_endpoint_t *out_endpoint){
+    if(field_map->slots){
+        length_t mask = field_map->slots_capacity - 1;
+        length_t slot = hash_string(name) & mask;
+
+        while(field_map->slots[slot] != 0){
+            ast_field_arrow_t *arrow = &field_map->arrows[field_map->slots[slot] - 1];
+
+            if(streq(arrow->name, name)){
+                *out_endpoint = arrow->endpoint;
+                return true;
+            }
+
+            slot = (slot + 1) & mask;
+        }
+
+        return false;
+    }
+
     for(length_t i = 0; i != field_map->arrows_length; i++){
         ast_field_arrow_t *arrow = &field_map->arrows[i];
 
@@ -0,0 +1,127 @@
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "AST/ast_pool.h"
+#include "UTIL/ground.h"
+#include "UTIL/util.h"
+
+#define AST_POOL_FIRST_FRAGMENT_SIZE (64 * 1024)
+
+// Pool that the current thread allocates new AST nodes from
+static _Thread_local ast_pool_t *ast_pool_in_use = NULL;
+
+void ast_pool_init(ast_pool_t *pool){
+    *pool = (ast_pool_t){
+        .fragments = NULL,
+        .length = 0,
+        .capacity = 0,
+    };
+}
+
+void ast_pool_free(ast_pool_t *pool){
+    if(ast_pool_in_use == pool){
+        ast_pool_in_use = NULL;
+    }
+
+    for(length_t i = 0; i != pool->length; i++){
+        free(pool->fragments[i].memory);
+    }
+
+    free(pool->fragments);
+    ast_pool_init(pool);
+}
+
+static length_t ast_pool_round_size(length_t bytes){
+    // Force alignment of every allocation to have alignment AST_POOL_ALLOCATION_ALIGNMENT
+    if(bytes % AST_POOL_ALLOCATION_ALIGNMENT != 0) bytes += AST_POOL_ALLOCATION_ALIGNMENT - bytes % AST_POOL_ALLOCATION_ALIGNMENT;
+    return bytes;
+}
+
+void *ast_pool_alloc(ast_pool_t *pool, length_t bytes){
+    bytes = ast_pool_round_size(bytes);
+
+    // Reuse a released node of the same size if there is one
+    if(bytes <= AST_POOL_MAX_REUSED_SIZE){
+        void **free_list = &pool->free_lists[bytes / AST_POOL_ALLOCATION_ALIGNMENT];
+
+        if(*free_list){
+            void *memory = *free_list;
+            *free_list = *(void**) memory;
+            return memory;
+        }
+    }
+
+    length_t total = sizeof(ast_alloc_header_t) + bytes;
+    ast_pool_fragment_t *recent_fragment = pool->length ? &pool->fragments[pool->length - 1] : NULL;
+
+    if(recent_fragment == NULL || recent_fragment->used + total > recent_fragment->capacity){
+        length_t capacity = recent_fragment ? recent_fragment->capacity * 2 : AST_POOL_FIRST_FRAGMENT_SIZE;
+        while(capacity < total) capacity *= 2;
+
+        expand((void**) &pool->fragments, sizeof(ast_pool_fragment_t), pool->length, &pool->capacity, 1, 4);
+
+        recent_fragment = &pool->fragments[pool->length++];
+        *recent_fragment = (ast_pool_fragment_t){
+            .memory = malloc(capacity),
+            .used = 0,
+            .capacity = capacity,
+        };
+    }
+
+    ast_alloc_header_t *header = (ast_alloc_header_t*) &recent_fragment->memory[recent_fragment->used];
+    recent_fragment->used += total;
+
+    *header = (ast_alloc_header_t){
+        .pool = pool,
+        .size = bytes,
+    };
+
+    return header + 1;
+}
+
+bool ast_pool_owns(ast_pool_t *pool, const void *memory){
+    return memory != NULL && ((const ast_alloc_header_t*) memory)[-1].pool == pool;
+}
+
+ast_pool_t *ast_pool_use(ast_pool_t *pool){
+    ast_pool_t *previous = ast_pool_in_use;
+    ast_pool_in_use = pool;
+    return previous;
+}
+
+void *ast_alloc(length_t bytes){
+    if(ast_pool_in_use) return ast_pool_alloc(ast_pool_in_use, bytes);
+
+    ast_alloc_header_t *header = malloc(sizeof(ast_alloc_header_t) + bytes);
+
+    *header = (ast_alloc_header_t){
+        .pool = NULL,
+        .size = ast_pool_round_size(bytes),
+    };
+
+    return header + 1;
+}
+
+void *ast_memclone(const void *memory, length_t bytes){
+    return memcpy(ast_alloc(bytes), memory, bytes);
+}
+
+void ast_release(void *memory){
+    if(memory == NULL) return;
+
+    ast_alloc_header_t *header = (ast_alloc_header_t*) memory - 1;
+    ast_pool_t *pool = header->pool;
+
+    if(pool == NULL){
+        free(header);
+        return;
+    }
+
+    // Larger nodes are left until the pool is freed
+    if(header->size <= AST_POOL_MAX_REUSED_SIZE){
+        void **free_list = &pool->free_lists[header->size / AST_POOL_ALLOCATION_ALIGNMENT];
+        *(void**) memory = *free_list;
+        *free_list = memory;
+    }
+}
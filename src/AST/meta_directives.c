@@ -647,7 +647,7 @@ meta_expr_t *meta_get_special_variable(compiler_t *compiler, object_t *object, w
     switch(special_index){
     case 0: { // __column__
             int line, column;
-            lex_get_location(compiler->objects[variable_source.object_index]->buffer, variable_source.index, &line, &column);
+            lex_get_object_location(compiler->objects[variable_source.object_index], variable_source.index, &line, &column);
             
             result = malloc(sizeof(meta_expr_int_t));
             ((meta_expr_int_t*) result)->id = META_EXPR_INT;
@@ -662,7 +662,7 @@ meta_expr_t *meta_get_special_variable(compiler_t *compiler, object_t *object, w
         break;
     case 2: { // __line__
             int line, column;
-            lex_get_location(compiler->objects[variable_source.object_index]->buffer, variable_source.index, &line, &column);
+            lex_get_object_location(compiler->objects[variable_source.object_index], variable_source.index, &line, &column);
             
             result = malloc(sizeof(meta_expr_int_t));
             ((meta_expr_int_t*) result)->id = META_EXPR_INT;
@@ -1,5 +1,8 @@
 
 #include <ctype.h>
+#include <errno.h>
+#include <llvm-c/BitReader.h>
+#include <llvm-c/BitWriter.h>
 #include <llvm-c/Core.h>
 #include <llvm-c/Target.h>
 #include <stdbool.h>
@@ -7,21 +10,35 @@
 #include <stdlib.h>
 #include <string.h>
 
+#ifndef _WIN32
+#include <pthread.h>
+#include <spawn.h>
+#include <sys/wait.h>
+
+extern char **environ;
+#endif
+
 #include "AST/ast.h"
+#include "AST/ast_type.h"
 #include "BKEND/ir_to_llvm.h"
+#include "BKEND/llvm_jit.h"
 #include "DBG/debug.h"
 #include "DRVR/compiler.h"
 #include "DRVR/object.h"
 #include "IR/ir.h"
 #include "IR/ir_module.h"
+#include "IR/ir_type.h"
 #include "UTIL/color.h"
 #include "UTIL/filename.h"
 #include "UTIL/ground.h"
 #include "UTIL/string.h"
 #include "UTIL/string_builder.h"
+#include "UTIL/string_list.h"
 #include "UTIL/util.h"
 #include "llvm-c/Analysis.h" // IWYU pragma: keep
+#include "llvm-c/Error.h"
 #include "llvm-c/TargetMachine.h"
+#include "llvm-c/Transforms/PassBuilder.h"
 #include "llvm-c/Types.h"
 
 static char *sanitize_in_place(char *string){
@@ -54,6 +71,47 @@ static void create_static_variables(llvm_context_t *llvm){
     }
 }
 
+static void name_composite_types(llvm_context_t *llvm){
+    ir_module_t *ir_module = &llvm->object->ir_module;
+    ir_type_map_t *type_map = &ir_module->type_map;
+
+    // Named composites
+    for(length_t i = 0; i != type_map->length; i++){
+        ir_type_t *type = type_map->mappings[i].type;
+
+        if(type->kind == TYPE_KIND_STRUCTURE){
+            llvm_type_cache_name(&llvm->type_cache, type, strclone(type_map->mappings[i].name));
+        }
+    }
+
+    // Instances of polymorphic composites, named like '<int> List'
+    ir_gen_poly_cache_t *poly_cache = &ir_module->poly_cache;
+
+    for(length_t i = 0; i != poly_cache->length; i++){
+        ir_gen_poly_cache_entry_t *entry = &poly_cache->entries[i];
+        if(entry->ir_type->kind != TYPE_KIND_STRUCTURE) continue;
+
+        ast_elem_generic_base_t generic_base = (ast_elem_generic_base_t){
+            .id = AST_ELEM_GENERIC_BASE,
+            .source = NULL_SOURCE,
+            .name = entry->name,
+            .generics = entry->generics,
+            .generics_length = entry->generics_length,
+            .name_is_polymorphic = false,
+        };
+
+        ast_elem_t *elements[] = {(ast_elem_t*) &generic_base};
+
+        ast_type_t instance_type = (ast_type_t){
+            .elements = elements,
+            .elements_length = 1,
+            .source = NULL_SOURCE,
+        };
+
+        llvm_type_cache_name(&llvm->type_cache, entry->ir_type, ast_type_str(&instance_type));
+    }
+}
+
 static char *get_triple(compiler_t *compiler){
     switch(compiler->cross_compile_for){
     case CROSS_COMPILE_WINDOWS:
@@ -90,25 +148,62 @@ static errorcode_t get_target_from_triple(char *triple, LLVMTargetRef *out_targe
     return SUCCESS;
 }
 
-static void autofill_output_filename(compiler_t *compiler, object_t *object){
-    // Auto specify output filename for compiler if one wasn't already given
-    if(compiler->output_filename == NULL){
-        compiler->output_filename = filename_without_ext(object->filename);
+static void get_cpu_and_features(compiler_t *compiler, char **out_cpu, char **out_features){
+    // NOTE: Both results must be freed with LLVMDisposeMessage()
+    maybe_null_weak_cstr_t cpu = compiler->target_cpu;
+    maybe_null_weak_cstr_t features = compiler->target_features;
+
+    if(cpu == NULL || streq(cpu, "") || streq(cpu, "generic")){
+        *out_cpu = LLVMCreateMessage("generic");
+        *out_features = LLVMCreateMessage(features ? features : "");
+        return;
     }
-    
-    filename_auto_ext(&compiler->output_filename, compiler->cross_compile_for, FILENAME_AUTO_EXECUTABLE, compiler->traits & COMPILER_OUTPUT_DYNAMIC_LIBRARY);
+
+    if(!streq(cpu, "native")){
+        *out_cpu = LLVMCreateMessage(cpu);
+        *out_features = LLVMCreateMessage(features ? features : "");
+        return;
+    }
+
+    if(compiler->cross_compile_for == CROSS_COMPILE_WASM32){
+        warningprintf("Target CPU 'native' is not applicable when cross compiling for WebAssembly, using 'generic' instead\n");
+        *out_cpu = LLVMCreateMessage("generic");
+        *out_features = LLVMCreateMessage(features ? features : "");
+        return;
+    }
+
+    *out_cpu = LLVMGetHostCPUName();
+    char *host_features = LLVMGetHostCPUFeatures();
+
+    if(features == NULL || streq(features, "")){
+        *out_features = host_features;
+        return;
+    }
+
+    // Explicit features are appended after host features so they take precedence
+    strong_cstr_t combined = mallocandsprintf("%s,%s", host_features, features);
+    *out_features = LLVMCreateMessage(combined);
+    free(combined);
+    LLVMDisposeMessage(host_features);
 }
 
 static strong_cstr_t get_objfile_filename(compiler_t *compiler){
     return filename_ext(compiler->output_filename, "o");
 }
 
+static void append_objfile_filenames(string_builder_t *builder, const strong_cstr_list_t *objfile_filenames){
+    for(length_t i = 0; i != objfile_filenames->length; i++){
+        if(i != 0) string_builder_append_char(builder, ' ');
+        string_builder_append_quoted(builder, objfile_filenames->items[i]);
+    }
+}
+
 static strong_cstr_t create_windows_link_command(
     compiler_t *compiler,
     const char *bin_root,
     const char *linker,
     const char *windres,
-    const char *objfile_filename,
+    const strong_cstr_list_t *objfile_filenames,
     const char *linker_additional,
     const char *include,
     bool cmd_shell
@@ -167,7 +262,7 @@ static strong_cstr_t create_windows_link_command(
     string_builder_append_char(&builder, ' ');
 
     // location/of/object/file.o
-    string_builder_append_quoted(&builder, objfile_filename);
+    append_objfile_filenames(&builder, objfile_filenames);
     string_builder_append_char(&builder, ' ');
 
     // each.rc.o windows.rc.o resource.rc.o file.rc.o
@@ -207,7 +302,7 @@ static strong_cstr_t create_windows_link_command(
 static strong_cstr_t create_unix_link_command(
     compiler_t *compiler,
     const char *linker,
-    const char *objfile_filename,
+    const strong_cstr_list_t *objfile_filenames,
     const char *linker_additional
 ){
     string_builder_t builder;
@@ -215,7 +310,14 @@ static strong_cstr_t create_unix_link_command(
 
     string_builder_append(&builder, linker);
     string_builder_append_char(&builder, ' ');
-    string_builder_append_quoted(&builder, objfile_filename);
+
+    if(compiler->fuse_ld){
+        string_builder_append(&builder, "-fuse-ld=");
+        string_builder_append(&builder, compiler->fuse_ld);
+        string_builder_append_char(&builder, ' ');
+    }
+
+    append_objfile_filenames(&builder, objfile_filenames);
     string_builder_append_char(&builder, ' ');
     string_builder_append(&builder, linker_additional);
 
@@ -229,9 +331,11 @@ static strong_cstr_t create_unix_link_command(
     return string_builder_finalize(&builder);
 }
 
-static strong_cstr_t create_linker_additional(llvm_context_t *llvm){
-    string_builder_t builder;
-    string_builder_init(&builder);
+static strong_cstr_list_t create_linker_additional_args(llvm_context_t *llvm){
+    // Libraries, user linker options, and output kind options for the linker,
+    // shared by the link command and the arguments used to invoke it directly
+
+    strong_cstr_list_t args = {0};
 
     compiler_t *compiler = llvm->compiler;
     object_t *object = llvm->object;
@@ -245,37 +349,47 @@ static strong_cstr_t create_linker_additional(llvm_context_t *llvm){
 
         switch(library_kinds[i]){
         case LIBRARY_KIND_NONE:
-            string_builder_append_quoted(&builder, library);
+            strong_cstr_list_append(&args, strclone(library));
             break;
         case LIBRARY_KIND_LIBRARY:
-            string_builder_append(&builder, "-l");
-            string_builder_append(&builder, sanitize_in_place(library));
+            strong_cstr_list_append(&args, mallocandsprintf("-l%s", sanitize_in_place(library)));
             break;
         case LIBRARY_KIND_FRAMEWORK:
-            string_builder_append(&builder, "-framework ");
-            string_builder_append_quoted(&builder, library);
+            strong_cstr_list_append(&args, strclone("-framework"));
+            strong_cstr_list_append(&args, strclone(library));
             break;
         default:
-            die("create_linker_additional() - Unrecognized library kind %d\n", (int) library_kinds[i]);
-        }
-
-        if(i + 1 != libraries_length){
-            string_builder_append_char(&builder, ' ');
+            die("create_linker_additional_args() - Unrecognized library kind %d\n", (int) library_kinds[i]);
         }
     }
 
-    if(compiler->user_linker_options.length != 0){
-        string_builder_append(&builder, compiler->user_linker_options.buffer);
+    for(length_t i = 0; i != compiler->user_linker_args.length; i++){
+        strong_cstr_list_append(&args, strclone(compiler->user_linker_args.items[i]));
     }
 
     if(compiler->traits & COMPILER_OUTPUT_DYNAMIC_LIBRARY){
-        string_builder_append(&builder, "-shared ");
+        strong_cstr_list_append(&args, strclone("-shared"));
+    }
+
+    return args;
+}
+
+static strong_cstr_t create_linker_additional(llvm_context_t *llvm){
+    strong_cstr_list_t args = create_linker_additional_args(llvm);
+
+    string_builder_t builder;
+    string_builder_init(&builder);
+
+    for(length_t i = 0; i != args.length; i++){
+        if(i != 0) string_builder_append_char(&builder, ' ');
+        string_builder_append_quoted(&builder, args.items[i]);
     }
 
+    strong_cstr_list_free(&args);
     return strong_cstr_empty_if_null(string_builder_finalize(&builder));
 }
 
-static maybe_null_strong_cstr_t create_link_command_from_parts(llvm_context_t *llvm, const char *objfile_filename, const char *linker_additional){
+static maybe_null_strong_cstr_t create_link_command_from_parts(llvm_context_t *llvm, const strong_cstr_list_t *objfile_filenames, const char *linker_additional){
     #ifdef _WIN32
     // Windows -> ???
 
@@ -283,12 +397,12 @@ static maybe_null_strong_cstr_t create_link_command_from_parts(llvm_context_t *l
         // Windows -> MacOS
         // Even though we can't link it,
         // we will give the user the link command needed to link it on a MacOS machine.
-        return create_unix_link_command(llvm->compiler, "gcc", objfile_filename, linker_additional);
+        return create_unix_link_command(llvm->compiler, "gcc", objfile_filenames, linker_additional);
     }
 
     // Windows -> Windows
     strong_cstr_t include = mallocandsprintf("%sinclude", llvm->compiler->root);
-    strong_cstr_t result = create_windows_link_command(llvm->compiler, llvm->compiler->root, "bin\\ld.exe", "bin\\windres.exe", objfile_filename, linker_additional, include, true);
+    strong_cstr_t result = create_windows_link_command(llvm->compiler, llvm->compiler->root, "bin\\ld.exe", "bin\\windres.exe", objfile_filenames, linker_additional, include, true);
 
     free(include);
     return result;
@@ -306,7 +420,7 @@ static maybe_null_strong_cstr_t create_link_command_from_parts(llvm_context_t *l
         strong_cstr_t result = NULL;
 
         if(file_exists(cross_linker) && file_exists(cross_windres)){
-            result = create_windows_link_command(llvm->compiler, alt_bin_root, linker, windres, objfile_filename, linker_additional, include, false);
+            result = create_windows_link_command(llvm->compiler, alt_bin_root, linker, windres, objfile_filenames, linker_additional, include, false);
         } else {
             printf("\n");
             redprintf("Cross compiling for Windows requires the 'cross-compile-windows' for v2.8+ extension!\n");
@@ -322,47 +436,122 @@ static maybe_null_strong_cstr_t create_link_command_from_parts(llvm_context_t *l
     }
 
     // Unix -> Unix
-    return create_unix_link_command(llvm->compiler, "gcc", objfile_filename, linker_additional);
+    return create_unix_link_command(llvm->compiler, "gcc", objfile_filenames, linker_additional);
     #endif
 }
 
-static maybe_null_strong_cstr_t create_link_command(llvm_context_t *llvm, const char *objfile_filename){
+static maybe_null_strong_cstr_t create_link_command(llvm_context_t *llvm, const strong_cstr_list_t *objfile_filenames){
     strong_cstr_t linker_additional = create_linker_additional(llvm);
 
-    maybe_null_strong_cstr_t result = create_link_command_from_parts(llvm, objfile_filename, linker_additional);
+    maybe_null_strong_cstr_t result = create_link_command_from_parts(llvm, objfile_filenames, linker_additional);
 
     free(linker_additional);
     return result;
 }
 
-static void execute_result(weak_cstr_t output_filename){
-    strong_cstr_t executable = strclone(output_filename);
+#ifndef _WIN32
+static strong_cstr_list_t create_unix_link_args(llvm_context_t *llvm, const char *linker, const strong_cstr_list_t *objfile_filenames){
+    // Same as 'create_unix_link_command', but as separate arguments that don't need a shell
+    // NOTE: The resulting list is terminated by a NULL item
 
-    #ifdef _WIN32
-        // For windows, make sure we change all '/' to '\' before invoking
-        length_t executable_length = strlen(executable);
-    
-        for(length_t i = 0; i != executable_length; i++){
-            if(executable[i] == '/') executable[i] = '\\';
-        }
+    compiler_t *compiler = llvm->compiler;
+
+    strong_cstr_list_t args = {0};
+    strong_cstr_list_append(&args, strclone(linker));
+
+    if(compiler->fuse_ld){
+        strong_cstr_list_append(&args, mallocandsprintf("-fuse-ld=%s", compiler->fuse_ld));
+    }
+
+    for(length_t i = 0; i != objfile_filenames->length; i++){
+        strong_cstr_list_append(&args, strclone(objfile_filenames->items[i]));
+    }
+
+    strong_cstr_list_t linker_additional_args = create_linker_additional_args(llvm);
+
+    for(length_t i = 0; i != linker_additional_args.length; i++){
+        // Ownership of each argument is transferred
+        strong_cstr_list_append(&args, linker_additional_args.items[i]);
+    }
+
+    free(linker_additional_args.items);
+
+    if(compiler->use_libm){
+        strong_cstr_list_append(&args, strclone("-lm"));
+    }
+
+    strong_cstr_list_append(&args, strclone("-o"));
+    strong_cstr_list_append(&args, strclone(compiler->output_filename));
+    strong_cstr_list_append(&args, NULL);
+    return args;
+}
+
+static errorcode_t spawn_and_wait(strong_cstr_list_t *args){
+    pid_t pid;
+    int status;
+
+    if(posix_spawnp(&pid, args->items[0], NULL, NULL, args->items, environ) != 0){
+        return FAILURE;
+    }
+
+    while(waitpid(pid, &status, 0) == -1){
+        if(errno != EINTR) return FAILURE;
+    }
+
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0 ? SUCCESS : FAILURE;
+}
+#endif
+
+static errorcode_t link_result(llvm_context_t *llvm, const strong_cstr_list_t *objfile_filenames, weak_cstr_t link_command){
+    #ifndef _WIN32
+    if(llvm->compiler->cross_compile_for == CROSS_COMPILE_NONE){
+        // Invoke the compiler driver directly instead of going through a shell
+        strong_cstr_list_t args = create_unix_link_args(llvm, "gcc", objfile_filenames);
+        errorcode_t errorcode = spawn_and_wait(&args);
+
+        strong_cstr_list_free(&args);
+        return errorcode;
+    }
     #else
-        filename_prepend_dotslash_if_needed(&executable);
+    (void) llvm;
+    (void) objfile_filenames;
     #endif
 
-    system(executable);
-    free(executable);	
+    return system(link_command) == 0 ? SUCCESS : FAILURE;
+}
+
+static errorcode_t optimize_module(compiler_t *compiler, LLVMModuleRef module, LLVMTargetMachineRef target_machine){
+    maybe_null_weak_cstr_t passes = ir_to_llvm_config_passes(compiler);
+    if(passes == NULL) return SUCCESS;
+
+    LLVMPassBuilderOptionsRef options = LLVMCreatePassBuilderOptions();
+    bool vectorize = compiler->optimization != OPTIMIZATION_NONE && compiler->optimization != OPTIMIZATION_LESS;
+
+    LLVMPassBuilderOptionsSetLoopVectorization(options, vectorize);
+    LLVMPassBuilderOptionsSetSLPVectorization(options, vectorize);
+    LLVMPassBuilderOptionsSetLoopInterleaving(options, vectorize);
+    LLVMPassBuilderOptionsSetLoopUnrolling(options, vectorize);
+
+    LLVMErrorRef error = LLVMRunPasses(module, passes, target_machine, options);
+    LLVMDisposePassBuilderOptions(options);
+
+    if(error){
+        char *llvm_error = LLVMGetErrorMessage(error);
+        internalerrorprintf("ir_to_llvm() - LLVMRunPasses() failed with message: %s\n", llvm_error);
+        LLVMDisposeErrorMessage(llvm_error);
+        return FAILURE;
+    }
+
+    return SUCCESS;
 }
 
 static errorcode_t emit_to_file(
     LLVMModuleRef module,
     LLVMTargetMachineRef target_machine,
-    LLVMPassManagerRef pass_manager,
     weak_cstr_t objfile_filename
 ){
     LLVMCodeGenFileType codegen = LLVMObjectFile;
 
-    (void) pass_manager;
-
     char *llvm_error;
     if(LLVMTargetMachineEmitToFile(target_machine, module, objfile_filename, codegen, &llvm_error)){
         internalerrorprintf("ir_to_llvm() - LLVMTargetMachineEmitToFile() failed with message: %s\n", llvm_error);
@@ -373,6 +562,313 @@ static errorcode_t emit_to_file(
     return SUCCESS;
 }
 
+static length_t count_instructions(LLVMValueRef func){
+    length_t count = 0;
+
+    for(LLVMBasicBlockRef block = LLVMGetFirstBasicBlock(func); block; block = LLVMGetNextBasicBlock(block)){
+        for(LLVMValueRef instr = LLVMGetFirstInstruction(block); instr; instr = LLVMGetNextInstruction(instr)){
+            count++;
+        }
+    }
+
+    return count;
+}
+
+static length_t get_partitions_length(compiler_t *compiler, LLVMModuleRef module){
+    // A single object file was explicitly requested
+    if(compiler->jobs <= 1 || compiler->traits & COMPILER_EMIT_OBJECT) return 1;
+
+    // Splitting hides definitions from each other (no cross-partition inlining or
+    // internalization), so keep a single partition when optimizing for speed or size
+    switch(compiler->optimization){
+    case OPTIMIZATION_DEFAULT:
+    case OPTIMIZATION_AGGRESSIVE:
+    case OPTIMIZATION_SIZE:
+    case OPTIMIZATION_MIN_SIZE:
+        return 1;
+    }
+
+    length_t definitions = 0;
+
+    for(LLVMValueRef func = LLVMGetFirstFunction(module); func; func = LLVMGetNextFunction(func)){
+        if(LLVMCountBasicBlocks(func) != 0) definitions++;
+    }
+
+    if(definitions <= 1) return 1;
+
+    // Partitions are created by round-tripping the module through bitcode,
+    // which requires the module to be valid
+    if(LLVMVerifyModule(module, LLVMReturnStatusAction, NULL)) return 1;
+
+    return definitions < compiler->jobs ? definitions : compiler->jobs;
+}
+
+static strong_cstr_list_t create_objfile_filenames(weak_cstr_t objfile_filename, length_t partitions_length){
+    strong_cstr_list_t objfile_filenames = (strong_cstr_list_t){0};
+
+    if(partitions_length <= 1){
+        strong_cstr_list_append(&objfile_filenames, strclone(objfile_filename));
+        return objfile_filenames;
+    }
+
+    // Each partition gets its own object file, e.g. 'main.0.o', 'main.1.o', ...
+    strong_cstr_t objfile_filename_without_ext = filename_without_ext((char*) objfile_filename);
+
+    for(length_t i = 0; i != partitions_length; i++){
+        strong_cstr_list_append(&objfile_filenames, mallocandsprintf("%s.%d.o", objfile_filename_without_ext, (int) i));
+    }
+
+    free(objfile_filename_without_ext);
+    return objfile_filenames;
+}
+
+static void externalize_definition(LLVMValueRef value){
+    // Makes a definition referencable from other partitions,
+    // without exposing it outside of the final executable/library
+
+    LLVMLinkage linkage = LLVMGetLinkage(value);
+
+    size_t name_length;
+    const char *name = LLVMGetValueName2(value, &name_length);
+
+    if(linkage == LLVMPrivateLinkage || linkage == LLVMInternalLinkage){
+        strong_cstr_t new_name = mallocandsprintf("__adept_local.%s", name);
+        LLVMSetValueName2(value, new_name, strlen(new_name));
+        free(new_name);
+
+        LLVMSetLinkage(value, LLVMExternalLinkage);
+        LLVMSetVisibility(value, LLVMHiddenVisibility);
+    } else if(linkage == LLVMExternalLinkage && name_length == 0){
+        LLVMSetValueName2(value, "__adept_unnamed", strlen("__adept_unnamed"));
+        LLVMSetVisibility(value, LLVMHiddenVisibility);
+    }
+}
+
+static void plan_partitions(LLVMModuleRef module, length_t partitions_length, llvm_partition_plan_t *out_plan){
+    length_t functions_capacity = 0;
+    length_t loads[partitions_length];
+    memset(loads, 0, sizeof loads);
+
+    for(LLVMValueRef func = LLVMGetFirstFunction(module); func; func = LLVMGetNextFunction(func)){
+        if(LLVMCountBasicBlocks(func) != 0) functions_capacity++;
+    }
+
+    *out_plan = (llvm_partition_plan_t){
+        .function_names = malloc(sizeof(weak_cstr_t) * length_max(1, functions_capacity)),
+        .function_partitions = malloc(sizeof(length_t) * length_max(1, functions_capacity)),
+        .functions_length = 0,
+    };
+
+    for(LLVMValueRef func = LLVMGetFirstFunction(module); func; func = LLVMGetNextFunction(func)){
+        if(LLVMCountBasicBlocks(func) == 0) continue;
+
+        // Put each function into the partition with the least amount of work so far
+        length_t partition = 0;
+
+        for(length_t i = 1; i != partitions_length; i++){
+            if(loads[i] < loads[partition]) partition = i;
+        }
+
+        loads[partition] += count_instructions(func) + 1;
+
+        size_t name_length;
+        out_plan->function_names[out_plan->functions_length] = (weak_cstr_t) LLVMGetValueName2(func, &name_length);
+        out_plan->function_partitions[out_plan->functions_length] = partition;
+        out_plan->functions_length++;
+    }
+}
+
+static void strip_function_body(LLVMValueRef func){
+    // Turns a function definition into a declaration
+
+    // Remove all uses of instructions
+    for(LLVMBasicBlockRef block = LLVMGetFirstBasicBlock(func); block; block = LLVMGetNextBasicBlock(block)){
+        for(LLVMValueRef instr = LLVMGetFirstInstruction(block); instr; instr = LLVMGetNextInstruction(instr)){
+            LLVMTypeRef type = LLVMTypeOf(instr);
+
+            if(LLVMGetTypeKind(type) != LLVMVoidTypeKind){
+                LLVMReplaceAllUsesWith(instr, LLVMGetUndef(type));
+            }
+        }
+    }
+
+    // Remove all instructions, which removes all uses of basic blocks
+    for(LLVMBasicBlockRef block = LLVMGetFirstBasicBlock(func); block; block = LLVMGetNextBasicBlock(block)){
+        LLVMValueRef instr = LLVMGetFirstInstruction(block);
+
+        while(instr){
+            LLVMValueRef next = LLVMGetNextInstruction(instr);
+            LLVMInstructionEraseFromParent(instr);
+            instr = next;
+        }
+    }
+
+    // Remove all basic blocks
+    LLVMBasicBlockRef block = LLVMGetFirstBasicBlock(func);
+
+    while(block){
+        LLVMBasicBlockRef next = LLVMGetNextBasicBlock(block);
+        LLVMDeleteBasicBlock(block);
+        block = next;
+    }
+
+    LLVMSetLinkage(func, LLVMExternalLinkage);
+}
+
+static void keep_only_partition(LLVMModuleRef module, const llvm_partition_plan_t *plan, length_t partition){
+    for(length_t i = 0; i != plan->functions_length; i++){
+        if(plan->function_partitions[i] == partition) continue;
+
+        LLVMValueRef func = LLVMGetNamedFunction(module, plan->function_names[i]);
+        if(func) strip_function_body(func);
+    }
+
+    if(partition == 0) return;
+
+    LLVMValueRef global = LLVMGetFirstGlobal(module);
+
+    while(global){
+        LLVMValueRef next = LLVMGetNextGlobal(global);
+
+        if(LLVMGetLinkage(global) == LLVMAppendingLinkage){
+            // Special globals like 'llvm.global_ctors' only live in partition zero
+            LLVMDeleteGlobal(global);
+        } else if(LLVMGetInitializer(global) != NULL){
+            LLVMSetInitializer(global, NULL);
+        }
+
+        global = next;
+    }
+}
+
+static errorcode_t emit_partition(llvm_partition_job_t *job){
+    LLVMContextRef context = LLVMContextCreate();
+    LLVMMemoryBufferRef buffer = LLVMCreateMemoryBufferWithMemoryRange(job->bitcode, job->bitcode_size, "partition", false);
+    LLVMModuleRef module;
+
+    bool failed_to_load = LLVMParseBitcodeInContext2(context, buffer, &module);
+    LLVMDisposeMemoryBuffer(buffer);
+
+    if(failed_to_load){
+        internalerrorprintf("ir_to_llvm() - Failed to load partition %d\n", (int) job->partition);
+        LLVMContextDispose(context);
+        return FAILURE;
+    }
+
+    keep_only_partition(module, job->plan, job->partition);
+
+    errorcode_t errorcode = (job->optimize && optimize_module(job->compiler, module, job->target_machine))
+                         || emit_to_file(module, job->target_machine, job->objfile_filename);
+
+    LLVMDisposeModule(module);
+    LLVMContextDispose(context);
+    return errorcode;
+}
+
+#ifndef _WIN32
+static void *emit_partition_thread(void *raw_job){
+    llvm_partition_job_t *job = raw_job;
+    job->errorcode = emit_partition(job);
+    return NULL;
+}
+#endif
+
+static LLVMTargetMachineRef create_similar_target_machine(compiler_t *compiler, LLVMTargetMachineRef target_machine){
+    char *triple = LLVMGetTargetMachineTriple(target_machine);
+    char *cpu = LLVMGetTargetMachineCPU(target_machine);
+    char *features = LLVMGetTargetMachineFeatureString(target_machine);
+
+    LLVMCodeGenOptLevel level = ir_to_llvm_config_optlvl(compiler);
+    LLVMRelocMode reloc = compiler->use_pic ? LLVMRelocPIC : LLVMRelocDefault;
+    LLVMTargetMachineRef result = LLVMCreateTargetMachine(LLVMGetTargetMachineTarget(target_machine), triple, cpu, features, level, reloc, LLVMCodeModelDefault);
+
+    LLVMDisposeMessage(triple);
+    LLVMDisposeMessage(cpu);
+    LLVMDisposeMessage(features);
+    return result;
+}
+
+static errorcode_t emit_partitioned(compiler_t *compiler, LLVMModuleRef module, LLVMTargetMachineRef target_machine, const strong_cstr_list_t *objfile_filenames, bool optimize){
+    // Splits the module into one partition per object file, and then
+    // optimizes and emits each partition in its own LLVM context on its own thread
+
+    length_t partitions_length = objfile_filenames->length;
+
+    for(LLVMValueRef func = LLVMGetFirstFunction(module); func; func = LLVMGetNextFunction(func)){
+        if(LLVMCountBasicBlocks(func) != 0) externalize_definition(func);
+    }
+
+    for(LLVMValueRef global = LLVMGetFirstGlobal(module); global; global = LLVMGetNextGlobal(global)){
+        if(LLVMGetInitializer(global) != NULL) externalize_definition(global);
+    }
+
+    llvm_partition_plan_t plan;
+    plan_partitions(module, partitions_length, &plan);
+
+    LLVMMemoryBufferRef bitcode = LLVMWriteBitcodeToMemoryBuffer(module);
+    llvm_partition_job_t *jobs = malloc(sizeof(llvm_partition_job_t) * partitions_length);
+
+    for(length_t i = 0; i != partitions_length; i++){
+        jobs[i] = (llvm_partition_job_t){
+            .compiler = compiler,
+            .bitcode = LLVMGetBufferStart(bitcode),
+            .bitcode_size = LLVMGetBufferSize(bitcode),
+            .plan = &plan,
+            .partition = i,
+            .target_machine = create_similar_target_machine(compiler, target_machine),
+            .objfile_filename = objfile_filenames->items[i],
+            .optimize = optimize,
+            .errorcode = FAILURE,
+        };
+    }
+
+    #ifdef _WIN32
+    for(length_t i = 0; i != partitions_length; i++){
+        jobs[i].errorcode = emit_partition(&jobs[i]);
+    }
+    #else
+    pthread_t *threads = malloc(sizeof(pthread_t) * partitions_length);
+    bool *is_running = calloc(partitions_length, sizeof(bool));
+
+    // Partition zero is done on this thread
+    for(length_t i = 1; i != partitions_length; i++){
+        is_running[i] = LLVMIsMultithreaded() && pthread_create(&threads[i], NULL, &emit_partition_thread, &jobs[i]) == 0;
+    }
+
+    for(length_t i = 0; i != partitions_length; i++){
+        if(!is_running[i]) jobs[i].errorcode = emit_partition(&jobs[i]);
+    }
+
+    for(length_t i = 1; i != partitions_length; i++){
+        if(is_running[i]) pthread_join(threads[i], NULL);
+    }
+
+    free(threads);
+    free(is_running);
+    #endif
+
+    errorcode_t errorcode = SUCCESS;
+
+    for(length_t i = 0; i != partitions_length; i++){
+        if(jobs[i].errorcode) errorcode = FAILURE;
+        LLVMDisposeTargetMachine(jobs[i].target_machine);
+    }
+
+    free(jobs);
+    free(plan.function_names);
+    free(plan.function_partitions);
+    LLVMDisposeMemoryBuffer(bitcode);
+    return errorcode;
+}
+
+static bool can_jit(compiler_t *compiler){
+    // Only executables for the host can be executed in-process
+    return compiler->traits & COMPILER_JIT
+        && compiler->cross_compile_for == CROSS_COMPILE_NONE
+        && !(compiler->traits & (COMPILER_EMIT_OBJECT | COMPILER_OUTPUT_DYNAMIC_LIBRARY | COMPILER_NO_REMOVE_OBJECT))
+        && compiler->windows_resources.length == 0;
+}
+
 errorcode_t ir_to_llvm(compiler_t *compiler, object_t *object){
     LLVMInitializeAllTargetInfos();
     LLVMInitializeAllTargets();
@@ -383,28 +879,35 @@ errorcode_t ir_to_llvm(compiler_t *compiler, object_t *object){
     ir_module_t *ir_module = &object->ir_module;
     weak_cstr_t module_name = filename_name_const(object->filename);
 
-    LLVMModuleRef llvm_module = LLVMModuleCreateWithName(module_name);
+    LLVMContextRef llvm_context = LLVMContextCreate();
+    LLVMModuleRef llvm_module = LLVMModuleCreateWithNameInContext(module_name, llvm_context);
     char *triple = get_triple(compiler);
 
     LLVMTargetRef target;
     if(get_target_from_triple(triple, &target)){
         LLVMDisposeMessage(triple);
+        LLVMDisposeModule(llvm_module);
+        LLVMContextDispose(llvm_context);
         return FAILURE;
     }
 
     LLVMSetTarget(llvm_module, triple);
 
-    weak_cstr_t cpu = "generic";
-    weak_cstr_t features = "";
+    char *cpu, *features;
+    get_cpu_and_features(compiler, &cpu, &features);
+
     LLVMCodeGenOptLevel level = ir_to_llvm_config_optlvl(compiler);
     LLVMRelocMode reloc = compiler->use_pic ? LLVMRelocPIC : LLVMRelocDefault;
     LLVMCodeModel code_model = LLVMCodeModelDefault;
     LLVMTargetMachineRef target_machine = LLVMCreateTargetMachine(target, triple, cpu, features, level, reloc, code_model);
+    LLVMDisposeMessage(cpu);
+    LLVMDisposeMessage(features);
 
     LLVMTargetDataRef data_layout = LLVMCreateTargetDataLayout(target_machine);
     LLVMSetModuleDataLayout(llvm_module, data_layout);
 
     llvm_context_t llvm = (llvm_context_t){
+        .context = llvm_context,
         .module = llvm_module,
         .builder = (void*) 0xD3ADB33F,
         .catalog = (void*) 0xD3ADB33F,
@@ -422,10 +925,13 @@ errorcode_t ir_to_llvm(compiler_t *compiler, object_t *object){
         .string_table = (llvm_string_table_t){0},
         .relocation_list = (llvm_phi2_relocation_list_t){0},
         .static_variable_info = (llvm_static_variable_info_t){0},
-        .i64_type = LLVMInt64Type(),
-        .f64_type = LLVMDoubleType(),
+        .type_cache = (llvm_type_cache_t){0},
+        .i64_type = LLVMInt64TypeInContext(llvm_context),
+        .f64_type = LLVMDoubleTypeInContext(llvm_context),
     };
 
+    llvm_type_cache_init(&llvm.type_cache, LLVMGetModuleContext(llvm.module));
+    name_composite_types(&llvm);
     create_static_variables(&llvm);
 
     if(ir_to_llvm_globals(&llvm, object)
@@ -440,14 +946,17 @@ errorcode_t ir_to_llvm(compiler_t *compiler, object_t *object){
         free(llvm.string_table.entries);
         free(llvm.static_variables.variables);
         free(llvm.relocation_list.unrelocated);
+        llvm_type_cache_free(&llvm.type_cache);
         LLVMDisposeTargetData(data_layout);
         LLVMDisposeTargetMachine(target_machine);
         LLVMDisposeModule(llvm.module);
+        LLVMContextDispose(llvm.context);
         return FAILURE;
     }
 
     free(llvm.string_table.entries);
     free(llvm.relocation_list.unrelocated);
+    llvm_type_cache_free(&llvm.type_cache);
 
     #ifdef ENABLE_DEBUG_FEATURES
     if(compiler->debug_traits & COMPILER_DEBUG_LLVMIR) LLVMDumpModule(llvm.module);
@@ -459,18 +968,23 @@ errorcode_t ir_to_llvm(compiler_t *compiler, object_t *object){
     free(llvm.anon_global_variables);
     free(llvm.static_variables.variables);
 
-    // Figure out object filename
-    autofill_output_filename(compiler, object);
+    // Figure out object filename(s)
+    compiler_autofill_output_filename(compiler, object);
     strong_cstr_t objfile_filename = get_objfile_filename(compiler);
 
-    strong_cstr_t link_command = create_link_command(&llvm, objfile_filename);
+    length_t partitions_length = get_partitions_length(compiler, llvm.module);
+    strong_cstr_list_t objfile_filenames = create_objfile_filenames(objfile_filename, partitions_length);
+    free(objfile_filename);
+
+    strong_cstr_t link_command = create_link_command(&llvm, &objfile_filenames);
 
     if(link_command == NULL){
         LLVMDisposeTargetData(data_layout);
         LLVMDisposeTargetMachine(target_machine);
         LLVMDisposeMessage(triple);
         LLVMDisposeModule(llvm.module);
-        free(objfile_filename);
+        LLVMContextDispose(llvm.context);
+        strong_cstr_list_free(&objfile_filenames);
         return FAILURE;
     }
 
@@ -481,7 +995,6 @@ errorcode_t ir_to_llvm(compiler_t *compiler, object_t *object){
     #endif
 
     debug_signal(compiler, DEBUG_SIGNAL_AT_OUT, NULL);
-    LLVMPassManagerRef pass_manager = LLVMCreatePassManager();
 
     #ifdef ENABLE_DEBUG_FEATURES
     bool no_result = compiler->debug_traits & COMPILER_DEBUG_NO_RESULT;
@@ -489,26 +1002,58 @@ errorcode_t ir_to_llvm(compiler_t *compiler, object_t *object){
     bool no_result = false;
     #endif
 
+    bool optimized = false;
+
+    if(!no_result && can_jit(compiler)){
+        errorcode_t errorcode = optimize_module(compiler, llvm.module, target_machine);
+        optimized = true;
+
+        if(errorcode == SUCCESS){
+            errorcode = llvm_jit_execute(compiler, object, llvm.module, create_similar_target_machine(compiler, target_machine));
+        }
+
+        // Otherwise, fall back to linking and executing normally
+        if(errorcode != ALT_FAILURE){
+            LLVMDisposeTargetData(data_layout);
+            LLVMDisposeTargetMachine(target_machine);
+            LLVMDisposeMessage(triple);
+            LLVMDisposeModule(llvm.module);
+            LLVMContextDispose(llvm.context);
+            strong_cstr_list_free(&objfile_filenames);
+            free(link_command);
+            return errorcode;
+        }
+    }
+
     if(!no_result){
-        if(emit_to_file(llvm.module, target_machine, pass_manager, objfile_filename)){
+        errorcode_t errorcode;
+
+        if(partitions_length > 1){
+            errorcode = emit_partitioned(compiler, llvm.module, target_machine, &objfile_filenames, !optimized);
+        } else {
+            errorcode = (!optimized && optimize_module(compiler, llvm.module, target_machine)) || emit_to_file(llvm.module, target_machine, objfile_filenames.items[0]);
+        }
+
+        if(errorcode){
             LLVMDisposeTargetData(data_layout);
             LLVMDisposeTargetMachine(target_machine);
-            LLVMDisposePassManager(pass_manager);
             LLVMDisposeMessage(triple);
             LLVMDisposeModule(llvm.module);
-            free(objfile_filename);
+            LLVMContextDispose(llvm.context);
+            strong_cstr_list_free(&objfile_filenames);
+            free(link_command);
             return FAILURE;
         }
     }
 
     LLVMDisposeTargetData(data_layout);
     LLVMDisposeTargetMachine(target_machine);
-    LLVMDisposePassManager(pass_manager);
     LLVMDisposeMessage(triple);
     LLVMDisposeModule(llvm.module);
+    LLVMContextDispose(llvm.context);
 
     if(compiler->traits & COMPILER_EMIT_OBJECT){
-        free(objfile_filename);
+        strong_cstr_list_free(&objfile_filenames);
         free(link_command);
         return SUCCESS;
     }
@@ -517,7 +1062,7 @@ errorcode_t ir_to_llvm(compiler_t *compiler, object_t *object){
         // Don't support linking output Mach-O object files
         printf("Mach-O Object File Generated (Requires Manual Linking)\n");
         printf("\nLink Command: '%s'\n", link_command);
-        free(objfile_filename);
+        strong_cstr_list_free(&objfile_filenames);
         free(link_command);
         return SUCCESS;
     }
@@ -526,7 +1071,7 @@ errorcode_t ir_to_llvm(compiler_t *compiler, object_t *object){
         // Linking linux object files may depend on target system, so require manual linking for now
         printf("GNU/Linux Object File Generated (Requires Manual Linking)\n");
         printf("\nLink Command: '%s'\n", link_command);
-        free(objfile_filename);
+        strong_cstr_list_free(&objfile_filenames);
         free(link_command);
         return SUCCESS;
     }
@@ -534,22 +1079,23 @@ errorcode_t ir_to_llvm(compiler_t *compiler, object_t *object){
     debug_signal(compiler, DEBUG_SIGNAL_AT_LINKING, NULL);
 
     if(!no_result){
-        // TODO: SECURITY: Stop using system(3) call to invoke linker
-        if(system(link_command) != 0){
+        if(link_result(&llvm, &objfile_filenames, link_command)){
             redprintf("external-error: ");
             printf("link command failed\n%s\n", link_command);
-            free(objfile_filename);
+            strong_cstr_list_free(&objfile_filenames);
             free(link_command);
             return FAILURE;
         }
     
         if(compiler->traits & COMPILER_EXECUTE_RESULT){
-            execute_result(compiler->output_filename);
+            compiler_execute_result(compiler);
         }
     }
 
     if(!(compiler->traits & COMPILER_NO_REMOVE_OBJECT)){
-        remove(objfile_filename);
+        for(length_t i = 0; i != objfile_filenames.length; i++){
+            remove(objfile_filenames.items[i]);
+        }
 
         for(size_t i = 0; i < compiler->windows_resources.length; i++){
             const char *resource_file = compiler->windows_resources.items[i];
@@ -565,7 +1111,7 @@ errorcode_t ir_to_llvm(compiler_t *compiler, object_t *object){
         }
     }
     
-    free(objfile_filename);
+    strong_cstr_list_free(&objfile_filenames);
     free(link_command);
     return SUCCESS;
 }
@@ -35,16 +35,16 @@
 static LLVMValueRef llvm_create_global_string(llvm_context_t *llvm, const char *content){
     length_t length = strlen(content) + 1;
 
-    LLVMTypeRef array_type = LLVMArrayType(LLVMInt8Type(), length);
+    LLVMTypeRef array_type = LLVMArrayType(LLVMInt8TypeInContext(llvm->context), length);
 
     LLVMValueRef global_data = LLVMAddGlobal(llvm->module, array_type, ".str");
     LLVMSetLinkage(global_data, LLVMInternalLinkage);
     LLVMSetGlobalConstant(global_data, true);
-    LLVMSetInitializer(global_data, LLVMConstString(content, length, true));
+    LLVMSetInitializer(global_data, LLVMConstStringInContext(llvm->context, content, length, true));
 
     LLVMValueRef gep_indices_zeros[] = {
-        LLVMConstInt(LLVMInt32Type(), 0, true),
-        LLVMConstInt(LLVMInt32Type(), 0, true),
+        LLVMConstInt(LLVMInt32TypeInContext(llvm->context), 0, true),
+        LLVMConstInt(LLVMInt32TypeInContext(llvm->context), 0, true),
     };
 
     return LLVMConstGEP2(array_type, global_data, gep_indices_zeros, NUM_ITEMS(gep_indices_zeros));
@@ -53,27 +53,27 @@ static LLVMValueRef llvm_create_global_string(llvm_context_t *llvm, const char *
 static LLVMValueRef llvm_get_zero_value(llvm_context_t *llvm, ir_type_t *type){
     switch(type->kind){
     case TYPE_KIND_S8:
-        return LLVMConstInt(LLVMInt8Type(), 0, true);
+        return LLVMConstInt(LLVMInt8TypeInContext(llvm->context), 0, true);
     case TYPE_KIND_U8:
-        return LLVMConstInt(LLVMInt8Type(), 0, false);
+        return LLVMConstInt(LLVMInt8TypeInContext(llvm->context), 0, false);
     case TYPE_KIND_S16:
-        return LLVMConstInt(LLVMInt16Type(), 0, true);
+        return LLVMConstInt(LLVMInt16TypeInContext(llvm->context), 0, true);
     case TYPE_KIND_U16:
-        return LLVMConstInt(LLVMInt16Type(), 0, false);
+        return LLVMConstInt(LLVMInt16TypeInContext(llvm->context), 0, false);
     case TYPE_KIND_S32:
-        return LLVMConstInt(LLVMInt32Type(), 0, true);
+        return LLVMConstInt(LLVMInt32TypeInContext(llvm->context), 0, true);
     case TYPE_KIND_U32:
-        return LLVMConstInt(LLVMInt32Type(), 0, false);
+        return LLVMConstInt(LLVMInt32TypeInContext(llvm->context), 0, false);
     case TYPE_KIND_S64:
         return LLVMConstInt(llvm->i64_type, 0, true);
     case TYPE_KIND_U64:
         return LLVMConstInt(llvm->i64_type, 0, false);
     case TYPE_KIND_FLOAT:
-        return LLVMConstReal(LLVMFloatType(), 0);
+        return LLVMConstReal(LLVMFloatTypeInContext(llvm->context), 0);
     case TYPE_KIND_DOUBLE:
         return LLVMConstReal(llvm->f64_type, 0);
     case TYPE_KIND_BOOLEAN:
-        return LLVMConstInt(LLVMInt1Type(), 0, false);
+        return LLVMConstInt(LLVMInt1TypeInContext(llvm->context), 0, false);
     case TYPE_KIND_FUNCPTR:
     case TYPE_KIND_POINTER:
         return LLVMConstNull(ir_to_llvm_type(llvm, type));
@@ -86,13 +86,13 @@ static void llvm_build_memset(llvm_context_t *llvm, LLVMValueRef args[4]){
         LLVMValueRef *memset_intrinsic = &llvm->intrinsics.memset;
 
         LLVMTypeRef arg_types[] = {
-        LLVMPointerType(LLVMInt8Type(), 0),
-        LLVMInt8Type(),
+        LLVMPointerType(LLVMInt8TypeInContext(llvm->context), 0),
+        LLVMInt8TypeInContext(llvm->context),
         llvm->i64_type,
-        LLVMInt1Type(),
+        LLVMInt1TypeInContext(llvm->context),
     };
 
-    LLVMTypeRef memset_intrinsic_type = LLVMFunctionType(LLVMVoidType(), arg_types, 4, 0);
+    LLVMTypeRef memset_intrinsic_type = LLVMFunctionType(LLVMVoidTypeInContext(llvm->context), arg_types, 4, 0);
 
     if(*memset_intrinsic == NULL){
         *memset_intrinsic = LLVMAddFunction(llvm->module, "llvm.memset.p0.i64", memset_intrinsic_type);
@@ -122,21 +122,24 @@ LLVMTypeRef ir_to_llvm_type(llvm_context_t *llvm, ir_type_t *ir_type){
         if(type_ref_tmp == NULL) return NULL;
         return LLVMPointerType(type_ref_tmp, 0);
     }
-    case TYPE_KIND_S8:      return LLVMInt8Type();
-    case TYPE_KIND_S16:     return LLVMInt16Type();
-    case TYPE_KIND_S32:     return LLVMInt32Type();
+    case TYPE_KIND_S8:      return LLVMInt8TypeInContext(llvm->context);
+    case TYPE_KIND_S16:     return LLVMInt16TypeInContext(llvm->context);
+    case TYPE_KIND_S32:     return LLVMInt32TypeInContext(llvm->context);
     case TYPE_KIND_S64:     return llvm->i64_type;
-    case TYPE_KIND_U8:      return LLVMInt8Type();
-    case TYPE_KIND_U16:     return LLVMInt16Type();
-    case TYPE_KIND_U32:     return LLVMInt32Type();
+    case TYPE_KIND_U8:      return LLVMInt8TypeInContext(llvm->context);
+    case TYPE_KIND_U16:     return LLVMInt16TypeInContext(llvm->context);
+    case TYPE_KIND_U32:     return LLVMInt32TypeInContext(llvm->context);
     case TYPE_KIND_U64:     return llvm->i64_type;
-    case TYPE_KIND_HALF:    return LLVMHalfType();
-    case TYPE_KIND_FLOAT:   return LLVMFloatType();
+    case TYPE_KIND_HALF:    return LLVMHalfTypeInContext(llvm->context);
+    case TYPE_KIND_FLOAT:   return LLVMFloatTypeInContext(llvm->context);
     case TYPE_KIND_DOUBLE:  return llvm->f64_type;
-    case TYPE_KIND_BOOLEAN: return LLVMInt1Type();
+    case TYPE_KIND_BOOLEAN: return LLVMInt1TypeInContext(llvm->context);
     case TYPE_KIND_STRUCTURE: {
-            // TODO: Should probably cache struct types so they don't have to be
-            //           remade into LLVM types every time we use them.
+            llvm_type_cache_entry_t *entry = llvm_type_cache_find(&llvm->type_cache, ir_type);
+            if(entry && entry->llvm_type) return entry->llvm_type;
+
+            // NOTE: The name is heap allocated, so it stays valid even if the entry moves
+            maybe_null_weak_cstr_t name = entry ? entry->name : NULL;
 
             ir_type_extra_composite_t *composite = (ir_type_extra_composite_t*) ir_type->extra;
             LLVMTypeRef fields[length_max(1, composite->subtypes_length)];
@@ -146,11 +149,14 @@ LLVMTypeRef ir_to_llvm_type(llvm_context_t *llvm, ir_type_t *ir_type){
                 if(fields[i] == NULL) return NULL;
             }
 
-            return LLVMStructType(fields, composite->subtypes_length, composite->traits & TYPE_KIND_COMPOSITE_PACKED);
+            bool is_packed = composite->traits & TYPE_KIND_COMPOSITE_PACKED;
+            type_ref_tmp = llvm_type_cache_struct(&llvm->type_cache, fields, composite->subtypes_length, is_packed, name);
+            llvm_type_cache_insert(&llvm->type_cache, ir_type, type_ref_tmp);
+            return type_ref_tmp;
         }
     case TYPE_KIND_UNION: {
-            // TODO: Should probably cache union types so they don't have to be
-            //           remade into LLVM types every time we use them.
+            llvm_type_cache_entry_t *entry = llvm_type_cache_find(&llvm->type_cache, ir_type);
+            if(entry && entry->llvm_type) return entry->llvm_type;
 
             ir_type_extra_composite_t *composite = (ir_type_extra_composite_t*) ir_type->extra;
             LLVMTypeRef fields[length_max(1, composite->subtypes_length)];
@@ -169,23 +175,26 @@ LLVMTypeRef ir_to_llvm_type(llvm_context_t *llvm, ir_type_t *ir_type){
 
             if(composite->traits & TYPE_KIND_COMPOSITE_PACKED){
                 // Packed Unions
-                return LLVMArrayType(LLVMInt8Type(), largest_size);
+                type_ref_tmp = LLVMArrayType(LLVMInt8TypeInContext(llvm->context), largest_size);
             } else {
                 // Unpacked Unions
 
                 // Do some black magic to get good alignment
                 length_t chosen_element_size = largest_size >= 8 ? 8 : largest_size;
-                LLVMTypeRef chosen_element_type = LLVMIntType(chosen_element_size * 8);
+                LLVMTypeRef chosen_element_type = LLVMIntTypeInContext(llvm->context, chosen_element_size * 8);
                 length_t extra_one = largest_size % chosen_element_size != 0 ? 1 : 0;
                 
-                return LLVMArrayType(chosen_element_type, largest_size / chosen_element_size + extra_one);
+                type_ref_tmp = LLVMArrayType(chosen_element_type, largest_size / chosen_element_size + extra_one);
             }
+
+            llvm_type_cache_insert(&llvm->type_cache, ir_type, type_ref_tmp);
+            return type_ref_tmp;
         }
         break;
     case TYPE_KIND_VOID:
-        return LLVMVoidType();
+        return LLVMVoidTypeInContext(llvm->context);
     case TYPE_KIND_FUNCPTR:
-            return LLVMPointerType(LLVMIntType(8), 0);
+            return LLVMPointerType(LLVMIntTypeInContext(llvm->context, 8), 0);
     case TYPE_KIND_FIXED_ARRAY: {
             ir_type_extra_fixed_array_t *fixed_array = (ir_type_extra_fixed_array_t*) ir_type->extra;
             type_ref_tmp = ir_to_llvm_type(llvm, fixed_array->subtype);
@@ -207,17 +216,17 @@ LLVMValueRef ir_to_llvm_value(llvm_context_t *llvm, ir_value_t *value){
     switch(value->value_type){
     case VALUE_TYPE_LITERAL: {
             switch(value->type->kind){
-            case TYPE_KIND_S8: return LLVMConstInt(LLVMInt8Type(), (unsigned long long) *((adept_byte*) value->extra), true);
-            case TYPE_KIND_U8: return LLVMConstInt(LLVMInt8Type(), (unsigned long long) *((adept_ubyte*) value->extra), false);
-            case TYPE_KIND_S16: return LLVMConstInt(LLVMInt16Type(), (unsigned long long) *((adept_short*) value->extra), true);
-            case TYPE_KIND_U16: return LLVMConstInt(LLVMInt16Type(), (unsigned long long) *((adept_ushort*) value->extra), false);
-            case TYPE_KIND_S32: return LLVMConstInt(LLVMInt32Type(), (unsigned long long) *((adept_int*) value->extra), true);
-            case TYPE_KIND_U32: return LLVMConstInt(LLVMInt32Type(), (unsigned long long) *((adept_uint*) value->extra), false);
+            case TYPE_KIND_S8: return LLVMConstInt(LLVMInt8TypeInContext(llvm->context), (unsigned long long) *((adept_byte*) value->extra), true);
+            case TYPE_KIND_U8: return LLVMConstInt(LLVMInt8TypeInContext(llvm->context), (unsigned long long) *((adept_ubyte*) value->extra), false);
+            case TYPE_KIND_S16: return LLVMConstInt(LLVMInt16TypeInContext(llvm->context), (unsigned long long) *((adept_short*) value->extra), true);
+            case TYPE_KIND_U16: return LLVMConstInt(LLVMInt16TypeInContext(llvm->context), (unsigned long long) *((adept_ushort*) value->extra), false);
+            case TYPE_KIND_S32: return LLVMConstInt(LLVMInt32TypeInContext(llvm->context), (unsigned long long) *((adept_int*) value->extra), true);
+            case TYPE_KIND_U32: return LLVMConstInt(LLVMInt32TypeInContext(llvm->context), (unsigned long long) *((adept_uint*) value->extra), false);
             case TYPE_KIND_S64: return LLVMConstInt(llvm->i64_type, (unsigned long long) *((adept_long *)value->extra), true);
             case TYPE_KIND_U64: return LLVMConstInt(llvm->i64_type, (unsigned long long) *((adept_ulong *)value->extra), false);
-            case TYPE_KIND_FLOAT: return LLVMConstReal(LLVMFloatType(), (double) *((adept_float*) value->extra));
+            case TYPE_KIND_FLOAT: return LLVMConstReal(LLVMFloatTypeInContext(llvm->context), (double) *((adept_float*) value->extra));
             case TYPE_KIND_DOUBLE: return LLVMConstReal(llvm->f64_type, (double) *((adept_double*) value->extra));
-            case TYPE_KIND_BOOLEAN: return LLVMConstInt(LLVMInt1Type(), (double) *((adept_bool*) value->extra), false);
+            case TYPE_KIND_BOOLEAN: return LLVMConstInt(LLVMInt1TypeInContext(llvm->context), (double) *((adept_bool*) value->extra), false);
             default:
                 die("ir_to_llvm_value() - Unrecognized type kind for literal in ir_to_llvm_value\n");
             }
@@ -227,7 +236,7 @@ LLVMValueRef ir_to_llvm_value(llvm_context_t *llvm, ir_value_t *value){
             return llvm->catalog->blocks[extra->block_id].value_references[extra->instruction_id];
         }
     case VALUE_TYPE_NULLPTR:
-        return LLVMConstNull(LLVMPointerType(LLVMInt8Type(), 0));
+        return LLVMConstNull(LLVMPointerType(LLVMInt8TypeInContext(llvm->context), 0));
     case VALUE_TYPE_NULLPTR_OF_TYPE:
         return LLVMConstNull(ir_to_llvm_type(llvm, value->type));
     case VALUE_TYPE_ARRAY_LITERAL: {
@@ -253,8 +262,8 @@ LLVMValueRef ir_to_llvm_value(llvm_context_t *llvm, ir_value_t *value){
             LLVMSetInitializer(global_data, static_array);
 
             LLVMValueRef indices[] = {
-                LLVMConstInt(LLVMInt32Type(), 0, true),
-                LLVMConstInt(LLVMInt32Type(), 0, true),
+                LLVMConstInt(LLVMInt32TypeInContext(llvm->context), 0, true),
+                LLVMConstInt(LLVMInt32TypeInContext(llvm->context), 0, true),
             };
 
             return LLVMConstGEP2(array_type, global_data, indices, NUM_ITEMS(indices));
@@ -288,16 +297,16 @@ LLVMValueRef ir_to_llvm_value(llvm_context_t *llvm, ir_value_t *value){
                 char name_buffer[256];
                 snprintf(name_buffer, sizeof name_buffer, "S%X", i++);
 
-                LLVMTypeRef raw_characters_type = LLVMArrayType(LLVMInt8Type(), cstr_of_len->size);
+                LLVMTypeRef raw_characters_type = LLVMArrayType(LLVMInt8TypeInContext(llvm->context), cstr_of_len->size);
 
                 LLVMValueRef global_data = LLVMAddGlobal(llvm->module, raw_characters_type, name_buffer);
                 LLVMSetLinkage(global_data, LLVMInternalLinkage);
                 LLVMSetGlobalConstant(global_data, true);
-                LLVMSetInitializer(global_data, LLVMConstString(cstr_of_len->array, cstr_of_len->size, true));
+                LLVMSetInitializer(global_data, LLVMConstStringInContext(llvm->context, cstr_of_len->array, cstr_of_len->size, true));
 
                 LLVMValueRef indices[] = {
-                    LLVMConstInt(LLVMInt32Type(), 0, true),
-                    LLVMConstInt(LLVMInt32Type(), 0, true),
+                    LLVMConstInt(LLVMInt32TypeInContext(llvm->context), 0, true),
+                    LLVMConstInt(LLVMInt32TypeInContext(llvm->context), 0, true),
                 };
 
                 value = LLVMConstGEP2(raw_characters_type, global_data, indices, NUM_ITEMS(indices));
@@ -398,10 +407,18 @@ errorcode_t ir_to_llvm_functions(llvm_context_t *llvm, object_t *object){
     LLVMValueRef *func_skeletons = llvm->func_skeletons;
     LLVMTypeRef *func_skeleton_types = llvm->func_skeleton_types;
 
-    LLVMAttributeRef nounwind = LLVMCreateEnumAttribute(LLVMGetGlobalContext(), LLVMGetEnumAttributeKindForName("nounwind", 8), 0);
+    LLVMAttributeRef nounwind = LLVMCreateEnumAttribute(llvm->context, LLVMGetEnumAttributeKindForName("nounwind", 8), 0);
 
     for(length_t ir_func_id = 0; ir_func_id != module_funcs_length; ir_func_id++){
         ir_func_t *ir_func = &module_funcs[ir_func_id];
+
+        // Functions that were never reached don't exist in the output
+        if(ir_func->traits & IR_FUNC_DEFERRED){
+            func_skeletons[ir_func_id] = NULL;
+            func_skeleton_types[ir_func_id] = NULL;
+            continue;
+        }
+
         LLVMTypeRef parameters[length_max(1, ir_func->arity)];
 
         for(length_t a = 0; a != ir_func->arity; a++){
@@ -479,7 +496,9 @@ errorcode_t ir_to_llvm_function_bodies(llvm_context_t *llvm, object_t *object){
     llvm->relocation_list = (llvm_phi2_relocation_list_t){0};
 
     for(length_t f = 0; f != module_funcs_length; f++){
-        LLVMBuilderRef builder = LLVMCreateBuilder();
+        if(module_funcs[f].traits & IR_FUNC_DEFERRED) continue;
+
+        LLVMBuilderRef builder = LLVMCreateBuilderInContext(llvm->context);
         ir_basicblocks_t basicblocks = module_funcs[f].basicblocks;
 
         value_catalog_t catalog;
@@ -511,12 +530,12 @@ errorcode_t ir_to_llvm_function_bodies(llvm_context_t *llvm, object_t *object){
 
         // Inject true entry before faux program entry
         if(is_entry_function){
-            llvm->static_variable_info.init_routine = LLVMAppendBasicBlock(func_skeletons[f], "");
+            llvm->static_variable_info.init_routine = LLVMAppendBasicBlockInContext(llvm->context, func_skeletons[f], "");
         }
 
         // Create basicblocks
         for(length_t i = 0; i != basicblocks.length; i++){
-            llvm_blocks[i] = LLVMAppendBasicBlock(func_skeletons[f], "");
+            llvm_blocks[i] = LLVMAppendBasicBlockInContext(llvm->context, func_skeletons[f], "");
             llvm_exit_blocks[i] = llvm_blocks[i];
         }
 
@@ -658,15 +677,15 @@ void build_llvm_check_on_failure_block(llvm_context_t *llvm, LLVMValueRef func_s
     // Line number and column number and created via a PHI node
     // when we call pseudo-function to handle null check failures
     // Create pseudo-function
-    check->on_fail_block = LLVMAppendBasicBlock(func_skeleton, "");
+    check->on_fail_block = LLVMAppendBasicBlockInContext(llvm->context, func_skeleton, "");
     LLVMPositionBuilderAtEnd(builder, check->on_fail_block);
 
     // Establish dependencies and define them if necessary
     LLVMValueRef printf_fn = LLVMGetNamedFunction(llvm->module, "printf");
     LLVMValueRef exit_fn = LLVMGetNamedFunction(llvm->module, "exit");
 
-    LLVMTypeRef int32 = LLVMInt32Type();
-    LLVMTypeRef charptr = LLVMPointerType(LLVMInt8Type(), 0);
+    LLVMTypeRef int32 = LLVMInt32TypeInContext(llvm->context);
+    LLVMTypeRef charptr = LLVMPointerType(LLVMInt8TypeInContext(llvm->context), 0);
     LLVMTypeRef printf_fn_type = LLVMFunctionType(int32, &charptr, 1, true);
     LLVMTypeRef exit_fn_type = LLVMFunctionType(int32, &int32, 1, false);
 
@@ -695,8 +714,8 @@ void build_llvm_check_on_failure_block(llvm_context_t *llvm, LLVMValueRef func_s
     // Define function definition string
     LLVMValueRef func_name_str = llvm_create_global_string(llvm, func_name);
 
-    check->line_phi = LLVMBuildPhi(llvm->builder, LLVMInt32Type(), "");
-    check->column_phi = LLVMBuildPhi(llvm->builder, LLVMInt32Type(), "");
+    check->line_phi = LLVMBuildPhi(llvm->builder, LLVMInt32TypeInContext(llvm->context), "");
+    check->column_phi = LLVMBuildPhi(llvm->builder, LLVMInt32TypeInContext(llvm->context), "");
 
     // Create argument list
     LLVMValueRef args[] = {check->failure_message_bytes, filename_str, func_name_str, check->line_phi, check->column_phi};
@@ -705,7 +724,7 @@ void build_llvm_check_on_failure_block(llvm_context_t *llvm, LLVMValueRef func_s
     LLVMBuildCall2(builder, printf_fn_type, printf_fn, args, NUM_ITEMS(args), "");
 
     // Exit the program
-    LLVMValueRef one = LLVMConstInt(LLVMInt32Type(), 1, true);
+    LLVMValueRef one = LLVMConstInt(LLVMInt32TypeInContext(llvm->context), 1, true);
     LLVMBuildCall2(builder, exit_fn_type, exit_fn, &one, 1, "");
     LLVMBuildUnreachable(builder);
 }
@@ -976,8 +995,8 @@ errorcode_t ir_to_llvm_instructions(llvm_context_t *llvm, ir_instrs_t instructio
                 llvm_create_optional_null_check(llvm, f, foundation, member_instr->maybe_line_number, member_instr->maybe_column_number, &llvm_exit_blocks[b]);
 
                 LLVMValueRef gep_indices[] = {
-                    LLVMConstInt(LLVMInt32Type(), 0, true),
-                    LLVMConstInt(LLVMInt32Type(), ((ir_instr_member_t*) instr)->member, true),
+                    LLVMConstInt(LLVMInt32TypeInContext(llvm->context), 0, true),
+                    LLVMConstInt(LLVMInt32TypeInContext(llvm->context), ((ir_instr_member_t*) instr)->member, true),
                 };
 
                 // For some reason, LLVM has problems with using a regular GEP for a constant value/indicies
@@ -1104,10 +1123,10 @@ errorcode_t ir_to_llvm_instructions(llvm_context_t *llvm, ir_instrs_t instructio
                 LLVMValueRef per_item_size = LLVMConstInt(llvm->i64_type, LLVMABISizeOfType(llvm->data_layout, destination_type), false);
 
                 LLVMValueRef args[] = {
-                    LLVMBuildBitCast(llvm->builder, destination, LLVMPointerType(LLVMInt8Type(), 0), ""),
-                    LLVMConstInt(LLVMInt8Type(), 0, false),
+                    LLVMBuildBitCast(llvm->builder, destination, LLVMPointerType(LLVMInt8TypeInContext(llvm->context), 0), ""),
+                    LLVMConstInt(LLVMInt8TypeInContext(llvm->context), 0, false),
                     per_item_size,
-                    LLVMConstInt(LLVMInt1Type(), 0, false),
+                    LLVMConstInt(LLVMInt1TypeInContext(llvm->context), 0, false),
                 };
 
                 llvm_build_memset(llvm, args);
@@ -1135,10 +1154,10 @@ errorcode_t ir_to_llvm_instructions(llvm_context_t *llvm, ir_instrs_t instructio
                         count = LLVMBuildZExt(llvm->builder, count, llvm->i64_type, "");
 
                         LLVMValueRef args[] = {
-                            LLVMBuildBitCast(llvm->builder, allocated, LLVMPointerType(LLVMInt8Type(), 0), ""),
-                            LLVMConstInt(LLVMInt8Type(), 0, false),
+                            LLVMBuildBitCast(llvm->builder, allocated, LLVMPointerType(LLVMInt8TypeInContext(llvm->context), 0), ""),
+                            LLVMConstInt(LLVMInt8TypeInContext(llvm->context), 0, false),
                             LLVMBuildMul(llvm->builder, per_item_size, count, ""),
-                            LLVMConstInt(LLVMInt1Type(), 0, false),
+                            LLVMConstInt(LLVMInt1TypeInContext(llvm->context), 0, false),
                         };
 
                         llvm_build_memset(llvm, args);
@@ -1156,12 +1175,12 @@ errorcode_t ir_to_llvm_instructions(llvm_context_t *llvm, ir_instrs_t instructio
                 LLVMValueRef *memcpy_intrinsic = &llvm->intrinsics.memcpy;
 
                 LLVMTypeRef arg_types[] = {
-                    LLVMPointerType(LLVMInt8Type(), 0),
-                    LLVMPointerType(LLVMInt8Type(), 0),
+                    LLVMPointerType(LLVMInt8TypeInContext(llvm->context), 0),
+                    LLVMPointerType(LLVMInt8TypeInContext(llvm->context), 0),
                     llvm->i64_type,
-                    LLVMInt1Type(),
+                    LLVMInt1TypeInContext(llvm->context),
                 };
-                LLVMTypeRef signature = LLVMFunctionType(LLVMVoidType(), arg_types, 4, 0);
+                LLVMTypeRef signature = LLVMFunctionType(LLVMVoidTypeInContext(llvm->context), arg_types, 4, 0);
 
                 if(*memcpy_intrinsic == NULL){
                     *memcpy_intrinsic = LLVMAddFunction(llvm->module, "llvm.memcpy.p0.p0.i64", signature);
@@ -1171,7 +1190,7 @@ errorcode_t ir_to_llvm_instructions(llvm_context_t *llvm, ir_instrs_t instructio
                     ir_to_llvm_value(llvm, memcpy_instr->destination),
                     ir_to_llvm_value(llvm, memcpy_instr->value),
                     ir_to_llvm_value(llvm, memcpy_instr->bytes),
-                    LLVMConstInt(LLVMInt1Type(), memcpy_instr->is_volatile, false),
+                    LLVMConstInt(LLVMInt1TypeInContext(llvm->context), memcpy_instr->is_volatile, false),
                 };
 
                 LLVMBuildCall2(builder, signature, *memcpy_intrinsic, args, 4, "");
@@ -1199,7 +1218,7 @@ errorcode_t ir_to_llvm_instructions(llvm_context_t *llvm, ir_instrs_t instructio
                 LLVMValueRef base = ir_to_llvm_value(llvm, ((ir_instr_unary_t*) instr)->value);
                 
                 unsigned int bits = global_type_kind_sizes_in_bits_64[type_kind];
-                LLVMValueRef transform = LLVMConstInt(LLVMIntType(bits), (unsigned long long) ~0, global_type_kind_signs[type_kind]);
+                LLVMValueRef transform = LLVMConstInt(LLVMIntTypeInContext(llvm->context, bits), (unsigned long long) ~0, global_type_kind_signs[type_kind]);
 
                 llvm_result = LLVMBuildXor(builder, base, transform, "");
                 catalog->blocks[b].value_references[i] = llvm_result;
@@ -1279,7 +1298,7 @@ errorcode_t ir_to_llvm_instructions(llvm_context_t *llvm, ir_instrs_t instructio
             break;
         case INSTRUCTION_STACK_SAVE: {
                 LLVMValueRef *stacksave_intrinsic = &llvm->intrinsics.stacksave;
-                LLVMTypeRef signature = LLVMFunctionType(LLVMPointerType(LLVMInt8Type(), 0), NULL, 0, false);
+                LLVMTypeRef signature = LLVMFunctionType(LLVMPointerType(LLVMInt8TypeInContext(llvm->context), 0), NULL, 0, false);
 
                 if(*stacksave_intrinsic == NULL){
                     #if LLVM_VERSION_MAJOR < 18
@@ -1296,10 +1315,10 @@ errorcode_t ir_to_llvm_instructions(llvm_context_t *llvm, ir_instrs_t instructio
                 LLVMValueRef *stackrestore_intrinsic = &llvm->intrinsics.stackrestore;
 
                 LLVMTypeRef arg_types[] = {
-                    LLVMPointerType(LLVMInt8Type(), 0),
+                    LLVMPointerType(LLVMInt8TypeInContext(llvm->context), 0),
                 };
 
-                LLVMTypeRef signature = LLVMFunctionType(LLVMVoidType(), arg_types, 1, false);
+                LLVMTypeRef signature = LLVMFunctionType(LLVMVoidTypeInContext(llvm->context), arg_types, 1, false);
 
                 if(*stackrestore_intrinsic == NULL){
                     #if LLVM_VERSION_MAJOR < 18
@@ -1322,10 +1341,10 @@ errorcode_t ir_to_llvm_instructions(llvm_context_t *llvm, ir_instrs_t instructio
                 LLVMValueRef *va_intrinsic = is_start ? &llvm->intrinsics.va_start : &llvm->intrinsics.va_end;
 
                 LLVMTypeRef arg_types[] = {
-                    LLVMPointerType(LLVMInt8Type(), 0),
+                    LLVMPointerType(LLVMInt8TypeInContext(llvm->context), 0),
                 };
 
-                LLVMTypeRef signature = LLVMFunctionType(LLVMVoidType(), arg_types, 1, false);
+                LLVMTypeRef signature = LLVMFunctionType(LLVMVoidTypeInContext(llvm->context), arg_types, 1, false);
 
                 if(*va_intrinsic == NULL){
                     *va_intrinsic = LLVMAddFunction(llvm->module, is_start ? "llvm.va_start.p0" : "llvm.va_end.p0", signature);
@@ -1350,12 +1369,12 @@ errorcode_t ir_to_llvm_instructions(llvm_context_t *llvm, ir_instrs_t instructio
                 ir_instr_va_copy_t *va_copy_instr = (ir_instr_va_copy_t*) instr;
 
                 LLVMValueRef *va_copy_intrinsic = &llvm->intrinsics.va_copy;
-                LLVMTypeRef ptr_type = LLVMPointerType(LLVMInt8Type(), 0);
+                LLVMTypeRef ptr_type = LLVMPointerType(LLVMInt8TypeInContext(llvm->context), 0);
                 LLVMTypeRef parameters[] = {
                     ptr_type,
                     ptr_type
                 };
-                LLVMTypeRef signature = LLVMFunctionType(LLVMVoidType(), parameters, NUM_ITEMS(parameters), false);
+                LLVMTypeRef signature = LLVMFunctionType(LLVMVoidTypeInContext(llvm->context), parameters, NUM_ITEMS(parameters), false);
 
                 if(*va_copy_intrinsic == NULL){
                     *va_copy_intrinsic = LLVMAddFunction(llvm->module, "llvm.va_copy", signature);
@@ -1382,7 +1401,7 @@ errorcode_t ir_to_llvm_instructions(llvm_context_t *llvm, ir_instrs_t instructio
                 }
 
                 LLVMInlineAsmDialect dialect = asm_instr->is_intel ? LLVMInlineAsmDialectIntel : LLVMInlineAsmDialectATT;
-                LLVMTypeRef signature = LLVMFunctionType(LLVMVoidType(), types, asm_instr->arity, false);
+                LLVMTypeRef signature = LLVMFunctionType(LLVMVoidTypeInContext(llvm->context), types, asm_instr->arity, false);
 
                 LLVMValueRef inline_asm = LLVMGetInlineAsm(
                     signature,
@@ -1407,7 +1426,7 @@ errorcode_t ir_to_llvm_instructions(llvm_context_t *llvm, ir_instrs_t instructio
                 die("ir_to_llvm_instructions() - INSTRUCTION_DEINIT_SVARS cannot operate since static_variables_deinitialization_function doesn't exist\n");
             }
 
-            LLVMTypeRef function_type = LLVMFunctionType(LLVMVoidType(), NULL, 0, false);
+            LLVMTypeRef function_type = LLVMFunctionType(LLVMVoidTypeInContext(llvm->context), NULL, 0, false);
 
             LLVMBuildCall2(builder, function_type, llvm->static_variable_info.deinit_function, NULL, 0, "");
             break;
@@ -1479,11 +1498,11 @@ void llvm_create_optional_null_check(llvm_context_t *llvm, length_t func_skeleto
     if(!(llvm->compiler->checks & COMPILER_NULL_CHECKS)) return;
 
     llvm_check_t *check = &llvm->null_check;
-    LLVMBasicBlockRef not_null_block = LLVMAppendBasicBlock(llvm->func_skeletons[func_skeleton_index], "");
+    LLVMBasicBlockRef not_null_block = LLVMAppendBasicBlockInContext(llvm->context, llvm->func_skeletons[func_skeleton_index], "");
 
     LLVMBasicBlockRef current_block = LLVMGetInsertBlock(llvm->builder);
-    LLVMValueRef line_value = LLVMConstInt(LLVMInt32Type(), line, true);
-    LLVMValueRef column_value = LLVMConstInt(LLVMInt32Type(), column, true);
+    LLVMValueRef line_value = LLVMConstInt(LLVMInt32TypeInContext(llvm->context), line, true);
+    LLVMValueRef column_value = LLVMConstInt(LLVMInt32TypeInContext(llvm->context), column, true);
 
     LLVMAddIncoming(check->line_phi, &line_value, &current_block, 1);
     LLVMAddIncoming(check->column_phi, &column_value, &current_block, 1);
@@ -1497,18 +1516,18 @@ void llvm_create_optional_null_check(llvm_context_t *llvm, length_t func_skeleto
 }
 
 void llvm_create_vtable_check(llvm_context_t *llvm, length_t func_skeleton_index, LLVMValueRef pointer, int line, int column, LLVMBasicBlockRef *out_landing_basicblock){
-    LLVMBasicBlockRef not_null_block = LLVMAppendBasicBlock(llvm->func_skeletons[func_skeleton_index], "");
+    LLVMBasicBlockRef not_null_block = LLVMAppendBasicBlockInContext(llvm->context, llvm->func_skeletons[func_skeleton_index], "");
 
     llvm_check_t *check = &llvm->vtable_check;
-    LLVMTypeRef llvm_ptr_ty = LLVMPointerType(LLVMInt8Type(), 0);
+    LLVMTypeRef llvm_ptr_ty = LLVMPointerType(LLVMInt8TypeInContext(llvm->context), 0);
     LLVMTypeRef llvm_ptr_ptr_ty = LLVMPointerType(llvm_ptr_ty, 0);
 
     LLVMValueRef field_ref = LLVMBuildBitCast(llvm->builder, pointer, llvm_ptr_ptr_ty, "");
     LLVMValueRef vtable = LLVMBuildLoad2(llvm->builder, llvm_ptr_ty, field_ref, "");
 
     LLVMBasicBlockRef current_block = LLVMGetInsertBlock(llvm->builder);
-    LLVMValueRef line_value = LLVMConstInt(LLVMInt32Type(), line, true);
-    LLVMValueRef column_value = LLVMConstInt(LLVMInt32Type(), column, true);
+    LLVMValueRef line_value = LLVMConstInt(LLVMInt32TypeInContext(llvm->context), line, true);
+    LLVMValueRef column_value = LLVMConstInt(LLVMInt32TypeInContext(llvm->context), column, true);
 
     LLVMAddIncoming(check->line_phi, &line_value, &current_block, 1);
     LLVMAddIncoming(check->column_phi, &column_value, &current_block, 1);
@@ -1532,10 +1551,25 @@ LLVMCodeGenOptLevel ir_to_llvm_config_optlvl(compiler_t *compiler){
     case OPTIMIZATION_LESS:       return LLVMCodeGenLevelLess;
     case OPTIMIZATION_DEFAULT:    return LLVMCodeGenLevelDefault;
     case OPTIMIZATION_AGGRESSIVE: return LLVMCodeGenLevelAggressive;
+    case OPTIMIZATION_SIZE:       return LLVMCodeGenLevelDefault;
+    case OPTIMIZATION_MIN_SIZE:   return LLVMCodeGenLevelDefault;
     default:                      return LLVMCodeGenLevelDefault;
     }
 }
 
+maybe_null_weak_cstr_t ir_to_llvm_config_passes(compiler_t *compiler){
+    switch(compiler->optimization){
+    case OPTIMIZATION_ABSOLUTELY_NOTHING: return NULL;
+    case OPTIMIZATION_NONE:       return "default<O0>";
+    case OPTIMIZATION_LESS:       return "default<O1>";
+    case OPTIMIZATION_DEFAULT:    return "default<O2>";
+    case OPTIMIZATION_AGGRESSIVE: return "default<O3>";
+    case OPTIMIZATION_SIZE:       return "default<Os>";
+    case OPTIMIZATION_MIN_SIZE:   return "default<Oz>";
+    default:                      return "default<O2>";
+    }
+}
+
 LLVMValueRef llvm_string_table_find(llvm_string_table_t *table, weak_cstr_t array, length_t length){
     // If not found returns NULL else returns global variable value
 
@@ -1615,7 +1649,7 @@ errorcode_t ir_to_llvm_inject_init_built(llvm_context_t *llvm){
     object_t *object = llvm->object;
     ir_builder_t *init_builder = object->ir_module.init_builder;
 
-    LLVMBuilderRef builder = LLVMCreateBuilder();
+    LLVMBuilderRef builder = LLVMCreateBuilderInContext(llvm->context);
     ir_basicblocks_t basicblocks = init_builder->basicblocks;
 
     if(!llvm->object->ir_module.common.has_init){
@@ -1649,7 +1683,7 @@ errorcode_t ir_to_llvm_inject_init_built(llvm_context_t *llvm){
 
     // Create basicblocks
     for(length_t b = 0; b != basicblocks.length; b++){
-        llvm_blocks[b] = LLVMAppendBasicBlock(func_skeleton, "");
+        llvm_blocks[b] = LLVMAppendBasicBlockInContext(llvm->context, func_skeleton, "");
         llvm_exit_blocks[b] = llvm_blocks[b];
     }
 
@@ -1689,7 +1723,7 @@ errorcode_t ir_to_llvm_inject_deinit_built(llvm_context_t *llvm){
     object_t *object = llvm->object;
     ir_builder_t *deinit_builder = object->ir_module.deinit_builder;
 
-    LLVMBuilderRef builder = LLVMCreateBuilder();
+    LLVMBuilderRef builder = LLVMCreateBuilderInContext(llvm->context);
     ir_basicblocks_t basicblocks = deinit_builder->basicblocks;
 
     if(llvm->static_variable_info.deinit_function == NULL){
@@ -1721,7 +1755,7 @@ errorcode_t ir_to_llvm_inject_deinit_built(llvm_context_t *llvm){
 
         // Create basicblocks
         for(length_t b = 0; b != basicblocks.length; b++){
-            llvm_blocks[b] = LLVMAppendBasicBlock(func_skeleton, "");
+            llvm_blocks[b] = LLVMAppendBasicBlockInContext(llvm->context, func_skeleton, "");
             llvm_exit_blocks[b] = llvm_blocks[b];
         }
 
@@ -1737,7 +1771,7 @@ errorcode_t ir_to_llvm_inject_deinit_built(llvm_context_t *llvm){
         warningprintf("No main or main-like function exists to perform global deinitialization in, skipping...\n");
 
         LLVMValueRef func_skeleton = llvm->static_variable_info.deinit_function;
-        LLVMBasicBlockRef block = LLVMAppendBasicBlock(func_skeleton, "");
+        LLVMBasicBlockRef block = LLVMAppendBasicBlockInContext(llvm->context, func_skeleton, "");
         LLVMPositionBuilderAtEnd(builder, block);
     }
 
@@ -1759,7 +1793,7 @@ errorcode_t ir_to_llvm_generate_deinit_svars_function_head(llvm_context_t *llvm)
         internalerrorprintf("ir_to_llvm_generate_deinit_svars_function_head() - Static variable deinitialization function already exists\n");
         return FAILURE;
     } else {
-        LLVMTypeRef signature = LLVMFunctionType(LLVMVoidType(), NULL, 0, false);
+        LLVMTypeRef signature = LLVMFunctionType(LLVMVoidTypeInContext(llvm->context), NULL, 0, false);
 
         // Create head of function that will deinitialize static variables
         *deinit_function = LLVMAddFunction(llvm->module, "____deinit_static", signature);
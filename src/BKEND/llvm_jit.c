@@ -0,0 +1,351 @@
+
+#include <llvm-c/Analysis.h>
+#include <llvm-c/BitReader.h>
+#include <llvm-c/BitWriter.h>
+#include <llvm-c/Core.h>
+#include <llvm-c/Error.h>
+#include <llvm-c/TargetMachine.h>
+#include <llvm/Config/llvm-config.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if LLVM_VERSION_MAJOR >= 14
+#include <llvm-c/LLJIT.h>
+#include <llvm-c/Orc.h>
+#endif
+
+#include "AST/ast.h"
+#include "BKEND/llvm_jit.h"
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "UTIL/color.h"
+#include "UTIL/ground.h"
+#include "UTIL/list.h"
+#include "UTIL/util.h"
+
+#if LLVM_VERSION_MAJOR >= 14
+
+static void print_llvm_error(const char *what, LLVMErrorRef error){
+    char *message = LLVMGetErrorMessage(error);
+    redprintf("error: ");
+    printf("%s: %s\n", what, message);
+    LLVMDisposeErrorMessage(message);
+}
+
+static bool has_extension(weak_cstr_t filename, weak_cstr_t extension){
+    length_t filename_length = strlen(filename);
+    length_t extension_length = strlen(extension);
+    return filename_length >= extension_length && streq(&filename[filename_length - extension_length], extension);
+}
+
+static LLVMErrorRef add_library_file(LLVMOrcLLJITRef jit, LLVMOrcJITDylibRef dylib, weak_cstr_t filename){
+    if(has_extension(filename, ".o") || has_extension(filename, ".obj")){
+        LLVMMemoryBufferRef buffer;
+        char *message;
+
+        if(LLVMCreateMemoryBufferWithContentsOfFile(filename, &buffer, &message)){
+            LLVMErrorRef error = LLVMCreateStringError(message);
+            LLVMDisposeMessage(message);
+            return error;
+        }
+
+        return LLVMOrcLLJITAddObjectFile(jit, dylib, buffer);
+    }
+
+    LLVMOrcDefinitionGeneratorRef generator;
+    LLVMErrorRef error;
+
+    if(has_extension(filename, ".a") || has_extension(filename, ".lib")){
+        error = LLVMOrcCreateStaticLibrarySearchGeneratorForPath(&generator, LLVMOrcLLJITGetObjLinkingLayer(jit), filename, LLVMOrcLLJITGetTripleString(jit));
+    } else {
+        error = LLVMOrcCreateDynamicLibrarySearchGeneratorForPath(&generator, filename, LLVMOrcLLJITGetGlobalPrefix(jit), NULL, NULL);
+    }
+
+    if(error) return error;
+
+    LLVMOrcJITDylibAddGenerator(dylib, generator);
+    return NULL;
+}
+
+static errorcode_t add_libraries(compiler_t *compiler, object_t *object, LLVMOrcLLJITRef jit, LLVMOrcJITDylibRef dylib){
+    // Returns ALT_FAILURE if a library can't be loaded in-process
+
+    ast_t *ast = &object->ast;
+
+    if(compiler->user_linker_options.length != 0){
+        warningprintf("Custom linker options are not supported by '--jit', linking normally instead\n");
+        return ALT_FAILURE;
+    }
+
+    for(length_t i = 0; i != ast->libraries_length; i++){
+        weak_cstr_t library = ast->libraries[i];
+        strong_cstr_t filename;
+
+        switch(ast->library_kinds[i]){
+        case LIBRARY_KIND_NONE:
+            filename = strclone(library);
+            break;
+        case LIBRARY_KIND_LIBRARY:
+            #if defined(_WIN32)
+            filename = mallocandsprintf("%s.dll", library);
+            #elif defined(__APPLE__)
+            filename = mallocandsprintf("lib%s.dylib", library);
+            #else
+            filename = mallocandsprintf("lib%s.so", library);
+            #endif
+            break;
+        default:
+            warningprintf("Library '%s' is not supported by '--jit', linking normally instead\n", library);
+            return ALT_FAILURE;
+        }
+
+        LLVMErrorRef error = add_library_file(jit, dylib, filename);
+
+        if(error){
+            char *message = LLVMGetErrorMessage(error);
+            warningprintf("Failed to load library '%s' for '--jit' (%s), linking normally instead\n", filename, message);
+            LLVMDisposeErrorMessage(message);
+            free(filename);
+            return ALT_FAILURE;
+        }
+
+        free(filename);
+    }
+
+    return SUCCESS;
+}
+
+static errorcode_t load_module(LLVMModuleRef module, LLVMOrcThreadSafeContextRef context, LLVMModuleRef *out_module){
+    // Copies a module into the context owned by the JIT, since
+    // the backend's context is disposed of together with its module
+
+    // Invalid modules can't reliably be round-tripped through bitcode
+    if(LLVMVerifyModule(module, LLVMReturnStatusAction, NULL)) return FAILURE;
+
+    LLVMMemoryBufferRef bitcode = LLVMWriteBitcodeToMemoryBuffer(module);
+    bool failed = LLVMParseBitcodeInContext2(LLVMOrcThreadSafeContextGetContext(context), bitcode, out_module);
+    LLVMDisposeMemoryBuffer(bitcode);
+
+    return failed ? FAILURE : SUCCESS;
+}
+
+typedef struct {
+    strong_cstr_t name;
+    unsigned long long priority;
+    length_t order;
+} jit_structor_t;
+
+typedef listof(jit_structor_t, structors) jit_structors_t;
+
+static int jit_structor_cmp(const void *va, const void *vb){
+    const jit_structor_t *a = va;
+    const jit_structor_t *b = vb;
+
+    if(a->priority != b->priority) return a->priority < b->priority ? -1 : 1;
+    return a->order < b->order ? -1 : (a->order > b->order ? 1 : 0);
+}
+
+static void jit_structors_free(jit_structors_t *structors){
+    for(length_t i = 0; i != structors->length; i++){
+        free(structors->structors[i].name);
+    }
+    free(structors->structors);
+}
+
+static void take_structors(LLVMModuleRef module, const char *list_name, jit_structors_t *out_structors){
+    // Removes 'llvm.global_ctors'/'llvm.global_dtors' from a module, since LLJIT
+    // doesn't run them without platform support, and makes each function it lists
+    // available to be looked up by name, ordered by priority
+
+    *out_structors = (jit_structors_t){0};
+
+    LLVMValueRef list = LLVMGetNamedGlobal(module, list_name);
+    if(list == NULL) return;
+
+    LLVMValueRef entries = LLVMGetInitializer(list);
+    length_t entries_length = entries && LLVMIsAConstantArray(entries) ? (length_t) LLVMGetNumOperands(entries) : 0;
+
+    for(length_t i = 0; i != entries_length; i++){
+        LLVMValueRef entry = LLVMGetOperand(entries, i);
+        LLVMValueRef function = LLVMGetOperand(entry, 1);
+
+        // Function may be behind a pointer cast
+        if(LLVMIsAConstantExpr(function)) function = LLVMGetOperand(function, 0);
+        if(!LLVMIsAFunction(function)) continue;
+
+        size_t name_length;
+        LLVMGetValueName2(function, &name_length);
+
+        LLVMLinkage linkage = LLVMGetLinkage(function);
+
+        if(name_length == 0 || linkage == LLVMPrivateLinkage || linkage == LLVMInternalLinkage){
+            strong_cstr_t new_name = mallocandsprintf("__adept_jit.%s.%d", list_name, (int) i);
+            LLVMSetValueName2(function, new_name, strlen(new_name));
+            free(new_name);
+
+            LLVMSetLinkage(function, LLVMExternalLinkage);
+            LLVMSetVisibility(function, LLVMHiddenVisibility);
+        }
+
+        jit_structor_t structor = (jit_structor_t){
+            .name = strclone(LLVMGetValueName2(function, &name_length)),
+            .priority = LLVMConstIntGetZExtValue(LLVMGetOperand(entry, 0)),
+            .order = i,
+        };
+
+        list_append(out_structors, structor, jit_structor_t);
+    }
+
+    LLVMDeleteGlobal(list);
+
+    if(out_structors->length > 1){
+        qsort(out_structors->structors, out_structors->length, sizeof(jit_structor_t), &jit_structor_cmp);
+    }
+}
+
+static errorcode_t run_structors(LLVMOrcLLJITRef jit, jit_structors_t *structors){
+    for(length_t i = 0; i != structors->length; i++){
+        LLVMOrcExecutorAddress address;
+        LLVMErrorRef error = LLVMOrcLLJITLookup(jit, &address, structors->structors[i].name);
+
+        if(error){
+            print_llvm_error("Failed to compile in JIT", error);
+            return FAILURE;
+        }
+
+        void (*structor)(void) = (void (*)(void)) (uintptr_t) address;
+        structor();
+    }
+
+    return SUCCESS;
+}
+
+errorcode_t llvm_jit_execute(compiler_t *compiler, object_t *object, LLVMModuleRef module, LLVMTargetMachineRef target_machine){
+    LLVMOrcThreadSafeContextRef context = LLVMOrcCreateNewThreadSafeContext();
+    LLVMModuleRef jit_module;
+
+    if(load_module(module, context, &jit_module)){
+        LLVMOrcDisposeThreadSafeContext(context);
+        LLVMDisposeTargetMachine(target_machine);
+        return ALT_FAILURE;
+    }
+
+    LLVMOrcLLJITBuilderRef builder = LLVMOrcCreateLLJITBuilder();
+    LLVMOrcLLJITBuilderSetJITTargetMachineBuilder(builder, LLVMOrcJITTargetMachineBuilderCreateFromTargetMachine(target_machine));
+
+    LLVMOrcLLJITRef jit;
+    LLVMErrorRef error = LLVMOrcCreateLLJIT(&jit, builder);
+
+    if(error){
+        print_llvm_error("Failed to create JIT", error);
+        LLVMDisposeModule(jit_module);
+        LLVMOrcDisposeThreadSafeContext(context);
+        return FAILURE;
+    }
+
+    LLVMOrcJITDylibRef dylib = LLVMOrcLLJITGetMainJITDylib(jit);
+
+    // Make symbols of this process (such as the C standard library) available
+    LLVMOrcDefinitionGeneratorRef process_generator;
+    error = LLVMOrcCreateDynamicLibrarySearchGeneratorForProcess(&process_generator, LLVMOrcLLJITGetGlobalPrefix(jit), NULL, NULL);
+
+    if(error){
+        print_llvm_error("Failed to expose process symbols to JIT", error);
+        LLVMDisposeModule(jit_module);
+        LLVMOrcDisposeThreadSafeContext(context);
+        LLVMOrcDisposeLLJIT(jit);
+        return FAILURE;
+    }
+
+    LLVMOrcJITDylibAddGenerator(dylib, process_generator);
+
+    errorcode_t errorcode = add_libraries(compiler, object, jit, dylib);
+
+    if(errorcode){
+        LLVMDisposeModule(jit_module);
+        LLVMOrcDisposeThreadSafeContext(context);
+        LLVMOrcDisposeLLJIT(jit);
+        return errorcode;
+    }
+
+    jit_structors_t ctors, dtors;
+    take_structors(jit_module, "llvm.global_ctors", &ctors);
+    take_structors(jit_module, "llvm.global_dtors", &dtors);
+
+    // Adept's 'main' returns an int, but a void 'main' can still come from elsewhere
+    LLVMValueRef main_skeleton = LLVMGetNamedFunction(jit_module, "main");
+    bool main_returns_int = main_skeleton && LLVMGetTypeKind(LLVMGetReturnType(LLVMGlobalGetValueType(main_skeleton))) == LLVMIntegerTypeKind;
+
+    // Ownership of the module is transferred to the JIT
+    LLVMOrcThreadSafeModuleRef thread_safe_module = LLVMOrcCreateNewThreadSafeModule(jit_module, context);
+    LLVMOrcDisposeThreadSafeContext(context);
+
+    error = LLVMOrcLLJITAddLLVMIRModule(jit, dylib, thread_safe_module);
+
+    if(error){
+        print_llvm_error("Failed to add module to JIT", error);
+        jit_structors_free(&ctors);
+        jit_structors_free(&dtors);
+        LLVMOrcDisposeLLJIT(jit);
+        return FAILURE;
+    }
+
+    LLVMOrcExecutorAddress main_address;
+    error = LLVMOrcLLJITLookup(jit, &main_address, "main");
+
+    if(error){
+        print_llvm_error("Failed to compile in JIT", error);
+        jit_structors_free(&ctors);
+        jit_structors_free(&dtors);
+        LLVMOrcDisposeLLJIT(jit);
+        return FAILURE;
+    }
+
+    char *argv[] = {compiler->output_filename, NULL};
+    int exitcode = 0;
+
+    fflush(stdout);
+
+    if(run_structors(jit, &ctors)){
+        jit_structors_free(&ctors);
+        jit_structors_free(&dtors);
+        LLVMOrcDisposeLLJIT(jit);
+        return FAILURE;
+    }
+
+    if(main_returns_int){
+        int (*main_function)(int, char**) = (int (*)(int, char**)) (uintptr_t) main_address;
+        exitcode = main_function(1, argv);
+    } else {
+        void (*main_function)(int, char**) = (void (*)(int, char**)) (uintptr_t) main_address;
+        main_function(1, argv);
+    }
+
+    errorcode = run_structors(jit, &dtors);
+    fflush(stdout);
+
+    // Same as the exit code of the executable when run normally
+    compiler->result_exitcode = exitcode & 0xFF;
+
+    jit_structors_free(&ctors);
+    jit_structors_free(&dtors);
+    LLVMOrcDisposeLLJIT(jit);
+    return errorcode;
+}
+
+#else
+
+errorcode_t llvm_jit_execute(compiler_t *compiler, object_t *object, LLVMModuleRef module, LLVMTargetMachineRef target_machine){
+    (void) compiler;
+    (void) object;
+    (void) module;
+
+    warningprintf("'--jit' requires LLVM 14 or newer, linking normally instead\n");
+    LLVMDisposeTargetMachine(target_machine);
+    return ALT_FAILURE;
+}
+
+#endif
@@ -0,0 +1,189 @@
+
+#include <llvm-c/Core.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "BKEND/llvm_type_cache.h"
+#include "IR/ir_type.h"
+#include "UTIL/ground.h"
+#include "UTIL/hash.h"
+#include "UTIL/util.h"
+
+#define LLVM_TYPE_CACHE_INITIAL_ENTRIES 256
+#define LLVM_TYPE_CACHE_INITIAL_STRUCT_SLOTS 256
+
+void llvm_type_cache_init(llvm_type_cache_t *cache, LLVMContextRef context){
+    *cache = (llvm_type_cache_t){
+        .context = context,
+        .entries = calloc(LLVM_TYPE_CACHE_INITIAL_ENTRIES, sizeof(llvm_type_cache_entry_t)),
+        .entries_length = 0,
+        .entries_capacity = LLVM_TYPE_CACHE_INITIAL_ENTRIES,
+        .structs = NULL,
+        .structs_length = 0,
+        .structs_capacity = 0,
+        .struct_slots = calloc(LLVM_TYPE_CACHE_INITIAL_STRUCT_SLOTS, sizeof(length_t)),
+        .struct_slots_capacity = LLVM_TYPE_CACHE_INITIAL_STRUCT_SLOTS,
+    };
+}
+
+void llvm_type_cache_free(llvm_type_cache_t *cache){
+    for(length_t i = 0; i != cache->entries_capacity; i++){
+        free(cache->entries[i].name);
+    }
+
+    for(length_t i = 0; i != cache->structs_length; i++){
+        free(cache->structs[i].fields);
+    }
+
+    free(cache->entries);
+    free(cache->structs);
+    free(cache->struct_slots);
+}
+
+static hash_t llvm_type_cache_hash_ir_type(ir_type_t *ir_type){
+    return hash_data(&ir_type, sizeof ir_type);
+}
+
+// Returns the entry that either is for the IR type, or is where it should be inserted
+static llvm_type_cache_entry_t *llvm_type_cache_probe(llvm_type_cache_t *cache, ir_type_t *ir_type){
+    length_t position = llvm_type_cache_hash_ir_type(ir_type) & (cache->entries_capacity - 1);
+
+    while(cache->entries[position].ir_type != NULL && cache->entries[position].ir_type != ir_type){
+        position = (position + 1) & (cache->entries_capacity - 1);
+    }
+
+    return &cache->entries[position];
+}
+
+static void llvm_type_cache_grow_entries(llvm_type_cache_t *cache){
+    llvm_type_cache_entry_t *old_entries = cache->entries;
+    length_t old_capacity = cache->entries_capacity;
+
+    cache->entries_capacity = old_capacity * 2;
+    cache->entries = calloc(cache->entries_capacity, sizeof(llvm_type_cache_entry_t));
+
+    for(length_t i = 0; i != old_capacity; i++){
+        if(old_entries[i].ir_type == NULL) continue;
+        *llvm_type_cache_probe(cache, old_entries[i].ir_type) = old_entries[i];
+    }
+
+    free(old_entries);
+}
+
+// Returns the entry for an IR type, creating an empty one if it doesn't exist
+static llvm_type_cache_entry_t *llvm_type_cache_locate_or_insert(llvm_type_cache_t *cache, ir_type_t *ir_type){
+    // Keep load factor at or below 1/2
+    if((cache->entries_length + 1) * 2 > cache->entries_capacity){
+        llvm_type_cache_grow_entries(cache);
+    }
+
+    llvm_type_cache_entry_t *entry = llvm_type_cache_probe(cache, ir_type);
+
+    if(entry->ir_type == NULL){
+        *entry = (llvm_type_cache_entry_t){
+            .ir_type = ir_type,
+            .llvm_type = NULL,
+            .name = NULL,
+        };
+        cache->entries_length++;
+    }
+
+    return entry;
+}
+
+llvm_type_cache_entry_t *llvm_type_cache_find(llvm_type_cache_t *cache, ir_type_t *ir_type){
+    llvm_type_cache_entry_t *entry = llvm_type_cache_probe(cache, ir_type);
+    return entry->ir_type ? entry : NULL;
+}
+
+void llvm_type_cache_insert(llvm_type_cache_t *cache, ir_type_t *ir_type, LLVMTypeRef llvm_type){
+    llvm_type_cache_locate_or_insert(cache, ir_type)->llvm_type = llvm_type;
+}
+
+void llvm_type_cache_name(llvm_type_cache_t *cache, ir_type_t *ir_type, strong_cstr_t name){
+    llvm_type_cache_entry_t *entry = llvm_type_cache_locate_or_insert(cache, ir_type);
+
+    if(entry->name){
+        free(name);
+        return;
+    }
+
+    entry->name = name;
+}
+
+static hash_t llvm_type_cache_hash_fields(LLVMTypeRef *fields, length_t fields_length, bool is_packed){
+    return hash_combine(hash_data(fields, sizeof(LLVMTypeRef) * fields_length), (hash_t) is_packed);
+}
+
+// Returns the slot that either contains the struct, or is where it should be inserted
+static length_t llvm_type_cache_probe_struct(llvm_type_cache_t *cache, LLVMTypeRef *fields, length_t fields_length, bool is_packed, hash_t hash){
+    length_t slot = hash & (cache->struct_slots_capacity - 1);
+
+    while(cache->struct_slots[slot] != 0){
+        llvm_type_cache_struct_t *existing = &cache->structs[cache->struct_slots[slot] - 1];
+
+        if(existing->hash == hash
+        && existing->fields_length == fields_length
+        && existing->is_packed == is_packed
+        && memcmp(existing->fields, fields, sizeof(LLVMTypeRef) * fields_length) == 0){
+            break;
+        }
+
+        slot = (slot + 1) & (cache->struct_slots_capacity - 1);
+    }
+
+    return slot;
+}
+
+static void llvm_type_cache_grow_struct_slots(llvm_type_cache_t *cache){
+    length_t new_capacity = cache->struct_slots_capacity * 2;
+    length_t *new_slots = calloc(new_capacity, sizeof(length_t));
+
+    for(length_t i = 0; i != cache->structs_length; i++){
+        length_t slot = cache->structs[i].hash & (new_capacity - 1);
+
+        while(new_slots[slot] != 0){
+            slot = (slot + 1) & (new_capacity - 1);
+        }
+
+        new_slots[slot] = i + 1;
+    }
+
+    free(cache->struct_slots);
+    cache->struct_slots = new_slots;
+    cache->struct_slots_capacity = new_capacity;
+}
+
+LLVMTypeRef llvm_type_cache_struct(llvm_type_cache_t *cache, LLVMTypeRef *fields, length_t fields_length, bool is_packed, maybe_null_weak_cstr_t name){
+    hash_t hash = llvm_type_cache_hash_fields(fields, fields_length, is_packed);
+    length_t slot = llvm_type_cache_probe_struct(cache, fields, fields_length, is_packed, hash);
+
+    if(cache->struct_slots[slot] != 0){
+        return cache->structs[cache->struct_slots[slot] - 1].llvm_type;
+    }
+
+    LLVMTypeRef llvm_type = LLVMStructCreateNamed(cache->context, name ? name : "");
+    LLVMStructSetBody(llvm_type, fields, fields_length, is_packed);
+
+    LLVMTypeRef *fields_copy = malloc(sizeof(LLVMTypeRef) * length_max(1, fields_length));
+    memcpy(fields_copy, fields, sizeof(LLVMTypeRef) * fields_length);
+
+    expand((void**) &cache->structs, sizeof(llvm_type_cache_struct_t), cache->structs_length, &cache->structs_capacity, 1, 64);
+    cache->structs[cache->structs_length++] = (llvm_type_cache_struct_t){
+        .fields = fields_copy,
+        .fields_length = fields_length,
+        .is_packed = is_packed,
+        .hash = hash,
+        .llvm_type = llvm_type,
+    };
+
+    cache->struct_slots[slot] = cache->structs_length;
+
+    // Keep load factor at or below 1/2
+    if(cache->structs_length * 2 > cache->struct_slots_capacity){
+        llvm_type_cache_grow_struct_slots(cache);
+    }
+
+    return llvm_type;
+}
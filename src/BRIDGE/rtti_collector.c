@@ -2,7 +2,7 @@
 #include "BRIDGE/rtti_collector.h"
 
 void rtti_collector_init(rtti_collector_t *collector){
-    ast_type_set_init(&collector->ast_types_used, 2048);
+    ast_type_set_init(&collector->ast_types_used, 64);
 }
 
 void rtti_collector_free(rtti_collector_t *collector){
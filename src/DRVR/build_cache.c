@@ -0,0 +1,414 @@
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#ifndef ADEPT_INSIGHT_BUILD
+#include <llvm-c/Core.h>
+#include <llvm-c/TargetMachine.h>
+#endif
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <direct.h>
+#include <process.h>
+#include <sys/utime.h>
+#define makedir(a) _mkdir(a)
+#define getpid() _getpid()
+#define utime(a, b) _utime(a, b)
+#else
+#include <dirent.h>
+#include <unistd.h>
+#include <utime.h>
+#define makedir(a) mkdir(a, 0777)
+#endif
+
+#include "DRVR/build_cache.h"
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "UTIL/filename.h"
+#include "UTIL/ground.h"
+#include "UTIL/list.h"
+#include "UTIL/sha256.h"
+#include "UTIL/string.h"
+#include "UTIL/util.h"
+
+// Changes whenever the layout of cache keys changes
+#define BUILD_CACHE_KEY_VERSION "adept-build-cache-2"
+
+// Traits that don't affect the output of a build
+#define BUILD_CACHE_IGNORED_TRAITS (COMPILER_EXECUTE_RESULT | COMPILER_CACHE | COMPILER_CACHE_VERBOSE)
+
+// Length of the hexadecimal key that names each cache entry
+#define BUILD_CACHE_KEY_LENGTH 32
+
+void build_cache_digest_init(build_cache_digest_t *digest){
+    sha256_init(&digest->sha256);
+}
+
+void build_cache_digest_bytes(build_cache_digest_t *digest, const void *data, length_t size){
+    sha256_update(&digest->sha256, data, size);
+}
+
+void build_cache_digest_u64(build_cache_digest_t *digest, uint64_t value){
+    uint8_t bytes[8];
+
+    // Always digest in little-endian order
+    for(int i = 0; i != 8; i++){
+        bytes[i] = (uint8_t) (value >> (i * 8));
+    }
+
+    build_cache_digest_bytes(digest, bytes, sizeof bytes);
+}
+
+void build_cache_digest_string(build_cache_digest_t *digest, maybe_null_weak_cstr_t string){
+    // Length-prefix strings so adjacent strings can't run together
+    if(string == NULL){
+        build_cache_digest_u64(digest, UINT64_MAX);
+        return;
+    }
+
+    length_t length = strlen(string);
+    build_cache_digest_u64(digest, length);
+    build_cache_digest_bytes(digest, string, length);
+}
+
+void build_cache_digest_finish(build_cache_digest_t *digest, build_cache_key_t *out_key){
+    uint8_t bytes[SHA256_DIGEST_SIZE];
+    sha256_finish(&digest->sha256, bytes);
+
+    uint64_t a = 0, b = 0;
+
+    for(int i = 0; i != 8; i++){
+        a = a << 8 | bytes[i];
+        b = b << 8 | bytes[8 + i];
+    }
+
+    *out_key = (build_cache_key_t){
+        .a = a,
+        .b = b,
+    };
+}
+
+static void build_cache_digest_file(build_cache_digest_t *digest, weak_cstr_t filename){
+    strong_cstr_t contents;
+    length_t length;
+
+    build_cache_digest_string(digest, filename);
+
+    if(file_binary_contents(filename, &contents, &length)){
+        build_cache_digest_u64(digest, length);
+        build_cache_digest_bytes(digest, contents, length);
+        free(contents);
+    } else {
+        build_cache_digest_u64(digest, UINT64_MAX);
+    }
+}
+
+static void build_cache_digest_compiler(build_cache_digest_t *digest, compiler_t *compiler){
+    build_cache_digest_string(digest, BUILD_CACHE_KEY_VERSION);
+    build_cache_digest_string(digest, ADEPT_VERSION_STRING);
+
+    // Identify the compiler executable itself, so that rebuilding the compiler invalidates the cache
+    struct stat info;
+
+    if(stat(compiler->location, &info) == 0){
+        build_cache_digest_u64(digest, (uint64_t) info.st_size);
+        build_cache_digest_u64(digest, (uint64_t) info.st_mtime);
+    }
+
+    build_cache_digest_u64(digest, compiler->traits & ~BUILD_CACHE_IGNORED_TRAITS);
+    build_cache_digest_u64(digest, compiler->optimization);
+    build_cache_digest_u64(digest, compiler->checks);
+    build_cache_digest_u64(digest, compiler->ignore);
+    build_cache_digest_u64(digest, compiler->debug_traits);
+    build_cache_digest_u64(digest, compiler->use_pic);
+    build_cache_digest_u64(digest, compiler->use_libm);
+    build_cache_digest_u64(digest, compiler->cross_compile_for);
+
+    // Partitioned ('-j') builds are deterministic, but their output depends on the number of partitions
+    build_cache_digest_u64(digest, compiler->jobs);
+    build_cache_digest_string(digest, compiler->output_filename);
+    build_cache_digest_string(digest, compiler->target_cpu);
+    build_cache_digest_string(digest, compiler->target_features);
+    build_cache_digest_string(digest, compiler->fuse_ld);
+    build_cache_digest_string(digest, compiler->entry_point);
+    build_cache_digest_string(digest, compiler->init_point);
+    build_cache_digest_string(digest, compiler->deinit_point);
+
+    #ifndef ADEPT_INSIGHT_BUILD
+    if(compiler->target_cpu && streq(compiler->target_cpu, "native")){
+        // Output depends on the machine we're running on
+        char *host_cpu = LLVMGetHostCPUName();
+        char *host_features = LLVMGetHostCPUFeatures();
+        build_cache_digest_string(digest, host_cpu);
+        build_cache_digest_string(digest, host_features);
+        LLVMDisposeMessage(host_cpu);
+        LLVMDisposeMessage(host_features);
+    }
+    #endif
+
+    build_cache_digest_u64(digest, compiler->user_linker_args.length);
+
+    for(length_t i = 0; i != compiler->user_linker_args.length; i++){
+        build_cache_digest_string(digest, compiler->user_linker_args.items[i]);
+    }
+}
+
+static void build_cache_digest_objects(build_cache_digest_t *digest, compiler_t *compiler){
+    build_cache_digest_u64(digest, compiler->objects_length);
+
+    for(length_t i = 0; i != compiler->objects_length; i++){
+        object_t *object = compiler->objects[i];
+
+        build_cache_digest_string(digest, object->full_filename);
+        build_cache_digest_u64(digest, object->buffer_length);
+        build_cache_digest_bytes(digest, object->buffer, object->buffer_length);
+
+        // Library files given by path are linked into the output
+        for(length_t j = 0; j != object->ast.libraries_length; j++){
+            build_cache_digest_string(digest, object->ast.libraries[j]);
+            build_cache_digest_u64(digest, object->ast.library_kinds[j]);
+
+            if(object->ast.library_kinds[j] == LIBRARY_KIND_NONE){
+                build_cache_digest_file(digest, object->ast.libraries[j]);
+            }
+        }
+    }
+
+    build_cache_digest_u64(digest, compiler->embedded_files.length);
+
+    for(length_t i = 0; i != compiler->embedded_files.length; i++){
+        build_cache_digest_file(digest, compiler->embedded_files.items[i]);
+    }
+}
+
+strong_cstr_t build_cache_directory(compiler_t *compiler){
+    maybe_null_weak_cstr_t xdg_cache_home = getenv("XDG_CACHE_HOME");
+
+    if(xdg_cache_home && xdg_cache_home[0] != '\0'){
+        // Make sure '$XDG_CACHE_HOME/' exists before creating 'adept/' inside it
+        makedir(xdg_cache_home);
+        return mallocandsprintf("%s/adept/", xdg_cache_home);
+    }
+
+    return mallocandsprintf("%scache/", compiler->root);
+}
+
+static bool build_cache_is_possible(compiler_t *compiler){
+    if(!(compiler->traits & COMPILER_CACHE)) return false;
+
+    // Builds that execute in-process or don't produce a single local output can't be cached
+    if(compiler->traits & COMPILER_JIT) return false;
+    if(compiler->cross_compile_for != CROSS_COMPILE_NONE) return false;
+    if(compiler->windows_resources.length != 0) return false;
+    if(compiler->traits & COMPILER_NO_REMOVE_OBJECT && !(compiler->traits & COMPILER_EMIT_OBJECT)) return false;
+
+    #ifdef ENABLE_DEBUG_FEATURES
+    if(compiler->debug_traits & COMPILER_DEBUG_NO_RESULT) return false;
+    #endif
+
+    return true;
+}
+
+errorcode_t build_cache_init(build_cache_t *cache, compiler_t *compiler, object_t *object){
+    if(!build_cache_is_possible(compiler)) return FAILURE;
+
+    compiler_autofill_output_filename(compiler, object);
+
+    build_cache_digest_t digest;
+    build_cache_digest_init(&digest);
+    build_cache_digest_compiler(&digest, compiler);
+    build_cache_digest_objects(&digest, compiler);
+
+    build_cache_key_t cache_key;
+    build_cache_digest_finish(&digest, &cache_key);
+
+    char key[BUILD_CACHE_KEY_LENGTH + 1];
+    snprintf(key, sizeof key, "%016llx%016llx", (unsigned long long) cache_key.a, (unsigned long long) cache_key.b);
+
+    strong_cstr_t directory = build_cache_directory(compiler);
+
+    *cache = (build_cache_t){
+        .directory = directory,
+        .entry_filename = mallocandsprintf("%s%s", directory, key),
+        .output_filename = compiler->traits & COMPILER_EMIT_OBJECT ? filename_ext(compiler->output_filename, "o") : strclone(compiler->output_filename),
+        .warnings_length = compiler->warnings_length,
+    };
+
+    return SUCCESS;
+}
+
+void build_cache_free(build_cache_t *cache){
+    free(cache->directory);
+    free(cache->entry_filename);
+    free(cache->output_filename);
+}
+
+static void build_cache_make_executable(compiler_t *compiler, weak_cstr_t filename){
+    #ifndef _WIN32
+    if(compiler->traits & COMPILER_EMIT_OBJECT) return;
+
+    // Same permissions the linker would've given it
+    mode_t mask = umask(0);
+    umask(mask);
+    chmod(filename, 0777 & ~mask);
+    #else
+    (void) compiler;
+    (void) filename;
+    #endif
+}
+
+bool build_cache_restore(build_cache_t *cache, compiler_t *compiler){
+    if(!file_exists(cache->entry_filename)) return false;
+
+    if(file_copy(cache->entry_filename, cache->output_filename)){
+        // Fall back to compiling normally
+        remove(cache->output_filename);
+        return false;
+    }
+
+    build_cache_make_executable(compiler, cache->output_filename);
+
+    // Mark as recently used, so it's among the last to be evicted
+    utime(cache->entry_filename, NULL);
+
+    if(compiler->traits & COMPILER_CACHE_VERBOSE){
+        printf("Reused cached output '%s'\n", cache->entry_filename);
+        fflush(stdout);
+    }
+
+    return true;
+}
+
+void build_cache_store(build_cache_t *cache, compiler_t *compiler){
+    if(compiler->warnings_length != cache->warnings_length) return;
+    if(!file_exists(cache->output_filename)) return;
+
+    if(makedir(cache->directory) != 0 && errno != EEXIST) return;
+
+    // Write to a temporary file first, so concurrent builds never see a partial entry
+    char suffix[32];
+    snprintf(suffix, sizeof suffix, ".%d.tmp", (int) getpid());
+
+    strong_cstr_t temporary_filename = mallocandsprintf("%s%s", cache->entry_filename, suffix);
+
+    if(file_copy(cache->output_filename, temporary_filename) || rename(temporary_filename, cache->entry_filename) != 0){
+        remove(temporary_filename);
+        free(temporary_filename);
+        return;
+    }
+
+    free(temporary_filename);
+
+    if(compiler->traits & COMPILER_CACHE_VERBOSE){
+        printf("Stored output in cache '%s'\n", cache->entry_filename);
+    }
+
+    build_cache_evict(cache->directory, BUILD_CACHE_MAX_ENTRIES, BUILD_CACHE_MAX_BYTES);
+}
+
+typedef struct {
+    strong_cstr_t filename;
+    time_t last_used;
+    uint64_t size;
+} build_cache_entry_info_t;
+
+typedef listof(build_cache_entry_info_t, entries) build_cache_entry_infos_t;
+
+static bool build_cache_is_entry_name(const char *name){
+    // Only entries are evicted, never temporary files or anything else
+    length_t length = strlen(name);
+    if(length != BUILD_CACHE_KEY_LENGTH) return false;
+
+    for(length_t i = 0; i != length; i++){
+        if(!((name[i] >= '0' && name[i] <= '9') || (name[i] >= 'a' && name[i] <= 'f'))) return false;
+    }
+
+    return true;
+}
+
+static void build_cache_add_entry_info(build_cache_entry_infos_t *infos, weak_cstr_t directory, const char *name){
+    if(!build_cache_is_entry_name(name)) return;
+
+    strong_cstr_t filename = mallocandsprintf("%s%s", directory, name);
+    struct stat info;
+
+    if(stat(filename, &info) != 0){
+        free(filename);
+        return;
+    }
+
+    build_cache_entry_info_t entry_info = (build_cache_entry_info_t){
+        .filename = filename,
+        .last_used = info.st_mtime,
+        .size = (uint64_t) info.st_size,
+    };
+
+    list_append(infos, entry_info, build_cache_entry_info_t);
+}
+
+static int build_cache_entry_info_cmp(const void *va, const void *vb){
+    // Most recently used first
+    const build_cache_entry_info_t *a = va;
+    const build_cache_entry_info_t *b = vb;
+    return a->last_used > b->last_used ? -1 : (a->last_used < b->last_used ? 1 : 0);
+}
+
+void build_cache_evict(weak_cstr_t directory, length_t max_entries, uint64_t max_bytes){
+    build_cache_entry_infos_t infos = {0};
+
+    #ifdef _WIN32
+    strong_cstr_t pattern = mallocandsprintf("%s*", directory);
+    WIN32_FIND_DATAA find_data;
+    HANDLE handle = FindFirstFileA(pattern, &find_data);
+    free(pattern);
+
+    if(handle == INVALID_HANDLE_VALUE) return;
+
+    do {
+        build_cache_add_entry_info(&infos, directory, find_data.cFileName);
+    } while(FindNextFileA(handle, &find_data));
+
+    FindClose(handle);
+    #else
+    DIR *dir = opendir(directory);
+    if(dir == NULL) return;
+
+    struct dirent *dirent;
+    while((dirent = readdir(dir))){
+        build_cache_add_entry_info(&infos, directory, dirent->d_name);
+    }
+
+    closedir(dir);
+    #endif
+
+    if(infos.length > 1){
+        qsort(infos.entries, infos.length, sizeof(build_cache_entry_info_t), &build_cache_entry_info_cmp);
+    }
+
+    length_t kept = 0;
+    uint64_t kept_bytes = 0;
+
+    for(length_t i = 0; i != infos.length; i++){
+        build_cache_entry_info_t *entry_info = &infos.entries[i];
+
+        // Always keep the most recently used entry
+        if(i == 0 || (kept < max_entries && kept_bytes + entry_info->size <= max_bytes)){
+            kept++;
+            kept_bytes += entry_info->size;
+        } else {
+            remove(entry_info->filename);
+        }
+
+        free(entry_info->filename);
+    }
+
+    free(infos.entries);
+}
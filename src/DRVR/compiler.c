@@ -12,6 +12,11 @@
 #include <linux/limits.h> // IWYU pragma: keep
 #endif
 
+#ifndef _WIN32
+#include <sys/wait.h>
+#endif
+
+#include <ctype.h>
 #include <stdarg.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -25,11 +30,14 @@
 #include "AST/ast_dump.h"
 #include "AST/ast_expr.h"
 #include "AST/ast_poly_catalog.h"
+#include "AST/ast_pool.h"
 #include "AST/ast_type.h"
 #include "DRVR/compiler.h"
 #include "DRVR/config.h"
 #include "DRVR/object.h"
+#include "DRVR/server.h"
 #include "LEX/lex.h"
+#include "LEX/lex_pool.h"
 #include "LEX/token.h"
 #include "PARSE/parse.h"
 #include "UTIL/color.h"
@@ -44,6 +52,7 @@
 #ifndef ADEPT_INSIGHT_BUILD
 #include "BKEND/backend.h"
 #include "DBG/debug.h"
+#include "DRVR/build_cache.h"
 #include "INFER/infer.h"
 #include "IR/ir_module.h"
 #include "IRGEN/ir_gen.h"
@@ -54,15 +63,42 @@
 #include "NET/stash.h"
 #endif
 
-errorcode_t compiler_run(compiler_t *compiler, int argc, char **argv){
+#ifndef ADEPT_INSIGHT_BUILD
+static errorcode_t compile_ast(compiler_t *compiler, object_t *object){
+    debug_signal(compiler, DEBUG_SIGNAL_AT_INFERENCE, NULL);
+
+    if(infer(compiler, object)) return FAILURE;
+
+    debug_signal(compiler, DEBUG_SIGNAL_AT_INFER_DUMP, &object->ast);
+    debug_signal(compiler, DEBUG_SIGNAL_AT_ASSEMBLY, NULL);
+
+    if(ir_gen(compiler, object)) return FAILURE;
+
+    debug_signal(compiler, DEBUG_SIGNAL_AT_IR_MODULE_DUMP, &object->ir_module);
+    debug_signal(compiler, DEBUG_SIGNAL_AT_EXPORT, NULL);
+    
+    return ir_export(compiler, object, BACKEND_LLVM);
+}
+
+static errorcode_t compile_parsed(compiler_t *compiler, object_t *object){
+    // Expressions and type elements made by later stages are allocated from the same AST
+    ast_pool_t *previous_pool = ast_pool_use(&object->ast.pool);
+    errorcode_t errorcode = compile_ast(compiler, object);
+    ast_pool_use(previous_pool);
+    return errorcode;
+}
+#endif
+
+int compiler_run(compiler_t *compiler, int argc, char **argv){
     // A wrapper function around 'compiler_invoke'
     compiler_invoke(compiler, argc, argv);
-    return compiler->result_flags & COMPILER_RESULT_SUCCESS ? SUCCESS : FAILURE;
+    return compiler->result_flags & COMPILER_RESULT_SUCCESS ? compiler->result_exitcode : FAILURE;
 }
 
 void compiler_invoke(compiler_t *compiler, int argc, char **argv){
     object_t *object = compiler_new_object(compiler);
     compiler->result_flags = TRAIT_NONE;
+    compiler->result_exitcode = 0;
 
     #ifdef _WIN32
 	char *module_location = malloc(1024);
@@ -119,7 +155,8 @@ void compiler_invoke(compiler_t *compiler, int argc, char **argv){
     #endif
 
     #ifdef ADEPT_ENABLE_PACKAGE_MANAGER
-    {
+    // Compilers created by a compile server already have the config
+    if(compiler->config_filename == NULL){
         // Pre-scan arguments
         bool no_update = false;
 
@@ -151,6 +188,7 @@ void compiler_invoke(compiler_t *compiler, int argc, char **argv){
     #endif
 
     if(handle_package_management(compiler, argc, argv)) return;
+    if(handle_server(compiler, argc, argv)) return;
     if(parse_arguments(compiler, object, argc, argv)) return;
 
     #ifndef ADEPT_INSIGHT_BUILD
@@ -182,19 +220,29 @@ void compiler_invoke(compiler_t *compiler, int argc, char **argv){
 
     #ifndef ADEPT_INSIGHT_BUILD
     debug_signal(compiler, DEBUG_SIGNAL_AT_AST_DUMP, &object->ast);
-    debug_signal(compiler, DEBUG_SIGNAL_AT_INFERENCE, NULL);
 
-    if(infer(compiler, object)) return;
+    build_cache_t cache;
+    bool use_cache = build_cache_init(&cache, compiler, object) == SUCCESS;
 
-    debug_signal(compiler, DEBUG_SIGNAL_AT_INFER_DUMP, &object->ast);
-    debug_signal(compiler, DEBUG_SIGNAL_AT_ASSEMBLY, NULL);
+    if(use_cache && build_cache_restore(&cache, compiler)){
+        // Output of an identical build was reused
+        if(compiler->traits & COMPILER_EXECUTE_RESULT && !(compiler->traits & COMPILER_EMIT_OBJECT)){
+            compiler_execute_result(compiler);
+        }
 
-    if(ir_gen(compiler, object)) return;
+        build_cache_free(&cache);
+        compiler->result_flags |= COMPILER_RESULT_SUCCESS;
+        return;
+    }
 
-    debug_signal(compiler, DEBUG_SIGNAL_AT_IR_MODULE_DUMP, &object->ir_module);
-    debug_signal(compiler, DEBUG_SIGNAL_AT_EXPORT, NULL);
-    
-    if(ir_export(compiler, object, BACKEND_LLVM)) return;
+    errorcode_t errorcode = compile_parsed(compiler, object);
+
+    if(use_cache){
+        if(errorcode == SUCCESS) build_cache_store(&cache, compiler);
+        build_cache_free(&cache);
+    }
+
+    if(errorcode) return;
     #endif
 
     compiler->result_flags |= COMPILER_RESULT_SUCCESS;
@@ -238,6 +286,7 @@ void compiler_init(compiler_t *compiler){
     compiler->ignore = TRAIT_NONE;
     compiler->output_filename = NULL;
     compiler->optimization = OPTIMIZATION_LESS;
+    compiler->result_exitcode = 0;
     compiler->checks = TRAIT_NONE;
 
     #if __linux__
@@ -260,31 +309,53 @@ void compiler_init(compiler_t *compiler){
     compiler->warnings_capacity = 0;
     compiler->show_unused_variables_how_to_disable = false;
     compiler->cross_compile_for = CROSS_COMPILE_NONE;
+    compiler->target_cpu = NULL;
+    compiler->target_features = NULL;
+    compiler->jobs = 1;
+    compiler->fuse_ld = NULL;
     compiler->entry_point = "main";
     string_builder_init(&compiler->user_linker_options);
+    compiler->user_linker_args = (strong_cstr_list_t){0};
     compiler->user_search_paths = (strong_cstr_list_t){0};
     compiler->windows_resources = (strong_cstr_list_t){0};
+    compiler->embedded_files = (strong_cstr_list_t){0};
 
     // Allow '::' and ': Type' by default
     compiler->traits |= COMPILER_COLON_COLON | COMPILER_TYPE_COLON;
 
     compiler->init_point = NULL;
     compiler->deinit_point = NULL;
+    intern_table_init(&compiler->symbols);
+    intern_table_init(&compiler->object_filenames);
+    compiler->object_filenames_length = 0;
+    filename_memo_init(&compiler->import_locations);
+    filename_memo_init(&compiler->import_absolutes);
+    compiler->server = NULL;
+    compiler->lex_pool = NULL;
 }
 
 void compiler_free(compiler_t *compiler){
     free(compiler->location);
     free(compiler->root);
     free(compiler->output_filename);
+    free(compiler->target_cpu);
+    free(compiler->target_features);
+    free(compiler->fuse_ld);
     string_builder_abandon(&compiler->user_linker_options);
+    strong_cstr_list_free(&compiler->user_linker_args);
     strong_cstr_list_free(&compiler->user_search_paths);
     strong_cstr_list_free(&compiler->windows_resources);
+    strong_cstr_list_free(&compiler->embedded_files);
 
     compiler_free_objects(compiler);
     compiler_free_error(compiler);
     compiler_free_warnings(compiler);
     config_free(&compiler->config);
     free(compiler->config_filename);
+    intern_table_free(&compiler->symbols);
+    intern_table_free(&compiler->object_filenames);
+    filename_memo_free(&compiler->import_locations);
+    filename_memo_free(&compiler->import_absolutes);
 }
 
 void compiler_free_objects(compiler_t *compiler){
@@ -302,7 +373,8 @@ void compiler_free_objects(compiler_t *compiler){
             free(object->current_namespace);
             // fallthrough
         case COMPILATION_STAGE_TOKENLIST:
-            free(object->buffer);
+            file_text_release(object->buffer, object->buffer_length, object->buffer_is_mapped);
+            free(object->line_offsets);
             tokenlist_free(&object->tokenlist);
             // fallthrough
         case COMPILATION_STAGE_FILENAME:
@@ -350,6 +422,8 @@ object_t *compiler_new_object(compiler_t *compiler){
     object_t *object = malloc_init(object_t, {
         .filename = NULL,
         .full_filename = NULL,
+        .line_offsets = NULL,
+        .line_offsets_length = 0,
         .compilation_stage = COMPILATION_STAGE_NONE,
         .index = next_object_index,
         .traits = OBJECT_NONE,
@@ -374,6 +448,17 @@ static errorcode_t read_dll_init_deinit(compiler_t *compiler, weak_cstr_t *argv,
     return SUCCESS;
 }
 
+static bool is_valid_linker_name(weak_cstr_t name){
+    // Linker names are passed to the compiler driver, so only allow simple names like "lld" or "mold"
+    if(name[0] == '\0') return false;
+
+    for(weak_cstr_t c = name; *c; c++){
+        if(!isalnum((unsigned char) *c) && *c != '.' && *c != '_' && *c != '-') return false;
+    }
+
+    return true;
+}
+
 errorcode_t parse_arguments(compiler_t *compiler, object_t *object, int argc, char **argv){
     int arg_index = 1;
 
@@ -422,6 +507,12 @@ errorcode_t parse_arguments(compiler_t *compiler, object_t *object, int argc, ch
                 compiler->traits |= COMPILER_DEBUG_SYMBOLS;
             } else if(streq(arg, "-e")){
                 compiler->traits |= COMPILER_EXECUTE_RESULT;
+            } else if(streq(arg, "--cache")){
+                compiler->traits |= COMPILER_CACHE;
+            } else if(streq(arg, "--cache-verbose")){
+                compiler->traits |= COMPILER_CACHE | COMPILER_CACHE_VERBOSE;
+            } else if(streq(arg, "--jit")){
+                compiler->traits |= COMPILER_EXECUTE_RESULT | COMPILER_JIT;
             } else if(streq(arg, "-w")){
                 compiler->traits |= COMPILER_NO_WARN;
             } else if(streq(arg, "-Werror")){
@@ -442,6 +533,10 @@ errorcode_t parse_arguments(compiler_t *compiler, object_t *object, int argc, ch
                 compiler->optimization = OPTIMIZATION_DEFAULT;
             } else if(streq(arg, "-O3")){
                 compiler->optimization = OPTIMIZATION_AGGRESSIVE;
+            } else if(streq(arg, "-Os")){
+                compiler->optimization = OPTIMIZATION_SIZE;
+            } else if(streq(arg, "-Oz")){
+                compiler->optimization = OPTIMIZATION_MIN_SIZE;
             } else if(streq(arg, "--fussy")){
                 compiler->traits |= COMPILER_FUSSY;
             } else if(streq(arg, "-v") || streq(arg, "--version")){
@@ -450,6 +545,8 @@ errorcode_t parse_arguments(compiler_t *compiler, object_t *object, int argc, ch
             } else if (streq(arg, "--root")){
                 show_root(compiler);
                 return FAILURE;
+            } else if(streq(arg, "--demand-ir")){
+                compiler->traits |= COMPILER_DEMAND_IR;
             } else if(streq(arg, "--no-undef")){
                 compiler->traits |= COMPILER_NO_UNDEF;
             } else if(streq(arg, "--no-type-info") || streq(arg, "--no-typeinfo")){
@@ -506,6 +603,34 @@ errorcode_t parse_arguments(compiler_t *compiler, object_t *object, int argc, ch
             } else if(strncmp(arg, "--std=", 6) == 0){
                 compiler->default_stdlib = &arg[6];
                 compiler->traits |= COMPILER_FORCE_STDLIB;
+            } else if(strncmp(arg, "--cpu=", 6) == 0){
+                compiler_set_target_cpu(compiler, &arg[6]);
+            } else if(strncmp(arg, "-mcpu=", 6) == 0){
+                compiler_set_target_cpu(compiler, &arg[6]);
+            } else if(strncmp(arg, "-march=", 7) == 0){
+                compiler_set_target_cpu(compiler, &arg[7]);
+            } else if(strncmp(arg, "--features=", 11) == 0){
+                compiler_set_target_features(compiler, &arg[11]);
+            } else if(strncmp(arg, "--jobs=", 7) == 0){
+                char *end;
+                unsigned long jobs = strtoul(&arg[7], &end, 10);
+
+                if(arg[7] == '\0' || *end != '\0' || jobs == 0 || jobs > 256){
+                    redprintf("Invalid number of jobs '%s', expected a number between 1 and 256\n", &arg[7]);
+                    return FAILURE;
+                }
+
+                compiler->jobs = (unsigned int) jobs;
+            } else if(strncmp(arg, "--fuse-ld=", 10) == 0 || strncmp(arg, "-fuse-ld=", 9) == 0){
+                weak_cstr_t name = strchr(arg, '=') + 1;
+
+                if(!is_valid_linker_name(name)){
+                    redprintf("Invalid linker name '%s'\n", name);
+                    return FAILURE;
+                }
+
+                free(compiler->fuse_ld);
+                compiler->fuse_ld = strclone(name);
             } else if(streq(arg, "--windowed") || streq(arg, "-mwindows")){
                 compiler->traits |= COMPILER_WINDOWED;
             } else if(streq(arg, "--entry")){
@@ -744,6 +869,13 @@ void show_help(bool show_advanced_options){
     }
     
     printf("    -O0,-O1,-O2,-O3   Set optimization level\n");
+
+    if(show_advanced_options)
+        printf("    -Os,-Oz           Optimize for size / minimum size\n");
+
+    if(show_advanced_options)
+        printf("    --demand-ir       Only generate functions reachable from the entry point\n");
+
     printf("    --windowed        Don't open console with executable (only applies to Windows)\n");
     printf("    -std=2.x          Set standard library version\n");
     
@@ -766,6 +898,15 @@ void show_help(bool show_advanced_options){
         printf("\nMachine Code Options:\n");
         printf("    --PIC             Forces PIC relocation model\n");
         printf("    --no-PIC          Forbids PIC relocation model\n");
+        printf("    --cpu=<CPU>       Generate code for CPU (e.g. 'x86-64-v3')\n");
+        printf("    --features=<LIST> Enable/disable target features (e.g. '+avx2,+fma')\n");
+        printf("    -march=native     Generate code for the host CPU and its features\n");
+        printf("    --jobs=<N>        Lex imports and generate machine code using N threads\n");
+        printf("                      (machine code is not split when using -O2, -O3, -Os or -Oz)\n");
+        printf("    --jit             Execute result in-process instead of linking (implies -e)\n");
+        printf("    --cache           Reuse the output of identical previous builds\n");
+        printf("    --cache-verbose   Same as --cache, but reports when the cache is used\n");
+        printf("    --server[=SOCKET] Run a compile server for 'adept-client' to use\n");
 
         printf("\nCross Compilation:\n");
         printf("    --windows         Output Windows Executable (Requires Extension)\n");
@@ -775,6 +916,7 @@ void show_help(bool show_advanced_options){
         printf("\nLinker Options:\n");
         printf("    --libm                            Forces linking against libc math library\n");
         printf("    --dylib <init fn> <deinit fn>     Creates dynamic library instead of executable with init/deinit points\n");
+        printf("    --fuse-ld=<NAME>                  Link using NAME (e.g. 'lld' or 'mold') instead of the default linker\n");
         
         printf("\nIgnore Options:\n");
         printf("    --ignore-all                      Enables all ignore options\n");
@@ -861,9 +1003,53 @@ strong_cstr_t compiler_get_string(void){
     return mallocandsprintf("Adept %s - Built %s %s", ADEPT_VERSION_STRING, __DATE__, __TIME__);
 }
 
+void compiler_autofill_output_filename(compiler_t *compiler, object_t *object){
+    // Auto specify output filename for compiler if one wasn't already given
+    if(compiler->output_filename == NULL){
+        compiler->output_filename = filename_without_ext(object->filename);
+    }
+    
+    filename_auto_ext(&compiler->output_filename, compiler->cross_compile_for, FILENAME_AUTO_EXECUTABLE, compiler->traits & COMPILER_OUTPUT_DYNAMIC_LIBRARY);
+}
+
+void compiler_execute_result(compiler_t *compiler){
+    strong_cstr_t executable = strclone(compiler->output_filename);
+
+    #ifdef _WIN32
+        // For windows, make sure we change all '/' to '\' before invoking
+        length_t executable_length = strlen(executable);
+    
+        for(length_t i = 0; i != executable_length; i++){
+            if(executable[i] == '/') executable[i] = '\\';
+        }
+    #else
+        filename_prepend_dotslash_if_needed(&executable);
+    #endif
+
+    int status = system(executable);
+    free(executable);
+
+    #ifdef _WIN32
+    compiler->result_exitcode = status;
+    #else
+    compiler->result_exitcode = status != -1 && WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+    #endif
+}
+
 void compiler_add_user_linker_option(compiler_t *compiler, weak_cstr_t option){
     string_builder_append_char(&compiler->user_linker_options, ' ');
     string_builder_append(&compiler->user_linker_options, option);
+    strong_cstr_list_append(&compiler->user_linker_args, strclone(option));
+}
+
+void compiler_set_target_cpu(compiler_t *compiler, weak_cstr_t cpu){
+    free(compiler->target_cpu);
+    compiler->target_cpu = strclone(cpu);
+}
+
+void compiler_set_target_features(compiler_t *compiler, weak_cstr_t features){
+    free(compiler->target_features);
+    compiler->target_features = strclone(features);
 }
 
 void compiler_add_user_search_path(compiler_t *compiler, weak_cstr_t search_path, maybe_null_weak_cstr_t current_file){
@@ -891,6 +1077,10 @@ errorcode_t compiler_read_file(compiler_t *compiler, object_t *object){
     if(filename_length >= 4 && streq(&object->filename[filename_length - 4], ".dep")){
         object_panic_plain(object, "Importing compressed package is no longer supported");
         return FAILURE;
+    } else if(compiler->server && server_take_warm_object(compiler->server, object)){
+        return SUCCESS;
+    } else if(compiler->lex_pool && lex_pool_take(compiler->lex_pool, compiler, object)){
+        return SUCCESS;
     } else {
         return lex(compiler, object);
     }
@@ -921,10 +1111,7 @@ void compiler_print_source(compiler_t *compiler, int line, source_t source){
         return;
     }
 
-    length_t line_index = 0;
-    for(int current_line = 1; current_line != line; line_index++){
-        if(relevant_object->buffer[line_index] == '\n') current_line++;
-    }
+    length_t line_index = lex_get_line_offset(relevant_object, line);
 
     char prefix[128];
     snprintf(prefix, sizeof prefix, "  %d| ", line);
@@ -950,7 +1137,9 @@ void compiler_print_source(compiler_t *compiler, int line, source_t source){
     for(length_t i = 0; i != prefix_length; i++) printf(" ");
     for(length_t i = line_index; i != source.index; i++) printf(relevant_object->buffer[i] != '\t' ? " " : "    ");
 
-    for(length_t i = 0; i != source.stride; i++)
+    length_t stride = tokenlist_source_stride(&relevant_object->tokenlist, source);
+
+    for(length_t i = 0; i != stride; i++)
         whiteprintf("^");
     printf("\n");
 }
@@ -965,7 +1154,7 @@ void compiler_panic(compiler_t *compiler, source_t source, const char *message){
             printf("%s:?:?:", filename_name_const(relevant_object->filename));
             redprintf(" error:\n");
         } else {
-            lex_get_location(relevant_object->buffer, source.index, &line, &column);
+            lex_get_object_location(relevant_object, source.index, &line, &column);
             printf("%s:%d:%d:", filename_name_const(relevant_object->filename), line, column);
             redprintf(" error:\n");
             compiler_print_source(compiler, line, source);
@@ -978,7 +1167,7 @@ void compiler_panic(compiler_t *compiler, source_t source, const char *message){
         redprintf("error: ");
         printf("%s\n", message);
     } else {
-        lex_get_location(relevant_object->buffer, source.index, &line, &column);
+        lex_get_object_location(relevant_object, source.index, &line, &column);
         printf("%s:%d:%d: ", filename_name_const(relevant_object->filename), line, column);
         redprintf("error: ");
         printf("%s\n", message);
@@ -1014,7 +1203,7 @@ void compiler_vpanicf(compiler_t *compiler, source_t source, const char *format,
             printf("%s:?:?: ", filename_name_const(relevant_object->filename));
             redprintf("error: \n");
         } else {
-            lex_get_location(relevant_object->buffer, source.index, &line, &column);
+            lex_get_object_location(relevant_object, source.index, &line, &column);
             printf("%s:%d:%d: ", filename_name_const(relevant_object->filename), line, column);
             redprintf("error: \n");
             compiler_print_source(compiler, line, source);
@@ -1027,7 +1216,7 @@ void compiler_vpanicf(compiler_t *compiler, source_t source, const char *format,
         column = 1;
         printf("%s:?:?: ", filename_name_const(relevant_object->filename));
     } else {
-        lex_get_location(relevant_object->buffer, source.index, &line, &column);
+        lex_get_object_location(relevant_object, source.index, &line, &column);
         printf("%s:%d:%d: ", filename_name_const(relevant_object->filename), line, column);
     }
 
@@ -1060,7 +1249,7 @@ bool compiler_warn(compiler_t *compiler, source_t source, const char *message){
     
     object_t *relevant_object = compiler->objects[source.object_index];
     int line, column;
-    lex_get_location(relevant_object->buffer, source.index, &line, &column);
+    lex_get_object_location(relevant_object, source.index, &line, &column);
     printf("%s:%d:%d: ", filename_name_const(relevant_object->filename), line, column);
     yellowprintf("warning: ");
     printf("%s\n", message);
@@ -1110,7 +1299,7 @@ void compiler_vwarnf(compiler_t *compiler, source_t source, const char *format,
         column = 1;
         printf("%s:?:?: ", filename_name_const(relevant_object->filename));
     } else {
-        lex_get_location(relevant_object->buffer, source.index, &line, &column);
+        lex_get_object_location(relevant_object, source.index, &line, &column);
         printf("%s:%d:%d: ", filename_name_const(relevant_object->filename), line, column);
     }
 
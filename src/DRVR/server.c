@@ -0,0 +1,550 @@
+
+#ifdef __linux__
+#define _GNU_SOURCE // For 'struct ucred'
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "DRVR/server.h"
+#include "DRVR/server_protocol.h"
+#include "LEX/lex.h"
+#include "LEX/token.h"
+#include "UTIL/color.h"
+#include "UTIL/ground.h"
+#include "UTIL/list.h"
+#include "UTIL/string.h"
+#include "UTIL/string_builder.h"
+#include "UTIL/util.h"
+
+#if !defined(_WIN32) && !defined(ADEPT_INSIGHT_BUILD)
+
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <llvm-c/Target.h>
+
+extern char **environ;
+
+// How long a client has to send its request after connecting
+#define SERVER_REQUEST_TIMEOUT_SECONDS 10
+
+static volatile sig_atomic_t server_stop_requested = 0;
+
+static void server_request_stop(int signal_number){
+    (void) signal_number;
+    server_stop_requested = 1;
+}
+
+static bool server_get_file_stamp(weak_cstr_t filename, server_file_stamp_t *out_stamp){
+    struct stat info;
+    if(stat(filename, &info) != 0) return false;
+
+    *out_stamp = (server_file_stamp_t){
+        .device = (uint64_t) info.st_dev,
+        .inode = (uint64_t) info.st_ino,
+        .size = (uint64_t) info.st_size,
+        #ifdef __APPLE__
+        .mtime_seconds = (int64_t) info.st_mtimespec.tv_sec,
+        .mtime_nanoseconds = (int64_t) info.st_mtimespec.tv_nsec,
+        #else
+        .mtime_seconds = (int64_t) info.st_mtim.tv_sec,
+        .mtime_nanoseconds = (int64_t) info.st_mtim.tv_nsec,
+        #endif
+    };
+    return true;
+}
+
+static bool server_file_stamps_equal(server_file_stamp_t *a, server_file_stamp_t *b){
+    return a->device == b->device
+        && a->inode == b->inode
+        && a->size == b->size
+        && a->mtime_seconds == b->mtime_seconds
+        && a->mtime_nanoseconds == b->mtime_nanoseconds;
+}
+
+static maybe_index_t server_find_warm_object(server_t *server, weak_cstr_t full_filename){
+    for(length_t i = 0; i != server->warm.objects_length; i++){
+        if(streq(server->warm.objects[i]->full_filename, full_filename)) return i;
+    }
+    return -1;
+}
+
+static void server_forget_tokens(object_t *object){
+    if(object->compilation_stage == COMPILATION_STAGE_TOKENLIST){
+        file_text_release(object->buffer, object->buffer_length, object->buffer_is_mapped);
+        free(object->line_offsets);
+        tokenlist_free(&object->tokenlist);
+    }
+
+    object->buffer = NULL;
+    object->buffer_length = 0;
+    object->buffer_is_mapped = false;
+    object->line_offsets = NULL;
+    object->line_offsets_length = 0;
+    object->compilation_stage = COMPILATION_STAGE_FILENAME;
+}
+
+bool server_take_warm_object(server_t *server, object_t *object){
+    if(object->full_filename == NULL) return false;
+
+    maybe_index_t index = server_find_warm_object(server, object->full_filename);
+    if(index < 0) return false;
+
+    object_t *warm = server->warm.objects[index];
+    server_file_stamp_t stamp;
+
+    if(warm->compilation_stage != COMPILATION_STAGE_TOKENLIST
+    || !server_get_file_stamp(object->full_filename, &stamp)
+    || !server_file_stamps_equal(&server->stamps[index], &stamp)){
+        return false;
+    }
+
+    object->buffer = warm->buffer;
+    object->buffer_length = warm->buffer_length;
+    object->buffer_is_mapped = warm->buffer_is_mapped;
+    object->line_offsets = warm->line_offsets;
+    object->line_offsets_length = warm->line_offsets_length;
+    object->tokenlist = warm->tokenlist;
+    object->compilation_stage = COMPILATION_STAGE_TOKENLIST;
+
+    // Sources still refer to the object that was lexed by the server
+    for(length_t i = 0; i != object->tokenlist.length; i++){
+        object->tokenlist.sources[i].object_index = object->index;
+    }
+
+    // Token list now belongs to the object, so it can't be given out again
+    warm->buffer = NULL;
+    warm->line_offsets = NULL;
+    warm->tokenlist = (tokenlist_t){0};
+    warm->compilation_stage = COMPILATION_STAGE_FILENAME;
+    return true;
+}
+
+static void server_warm_file(server_t *server, weak_cstr_t full_filename){
+    // NOTE: The stamp is taken before reading the file, so that changes
+    // made while the file is being read are always noticed later
+    server_file_stamp_t stamp;
+    if(!server_get_file_stamp(full_filename, &stamp)) return;
+
+    maybe_index_t index = server_find_warm_object(server, full_filename);
+    object_t *object;
+
+    if(index >= 0){
+        object = server->warm.objects[index];
+
+        // Already have an up-to-date token list
+        if(object->compilation_stage == COMPILATION_STAGE_TOKENLIST && server_file_stamps_equal(&server->stamps[index], &stamp)) return;
+
+        server_forget_tokens(object);
+    } else {
+        object = compiler_new_object(&server->warm);
+        object->filename = strclone(full_filename);
+        object->full_filename = strclone(full_filename);
+        object->compilation_stage = COMPILATION_STAGE_FILENAME;
+
+        expand((void**) &server->stamps, sizeof(server_file_stamp_t), object->index, &server->stamps_capacity, 1, 16);
+        index = object->index;
+    }
+
+    server->stamps[index] = stamp;
+
+    // Problems are left to be reported by the next compilation that needs the file,
+    // instead of being printed to the server's console
+    if(!file_text_map(full_filename, &object->buffer, &object->buffer_length, &object->buffer_is_mapped)){
+        server_forget_tokens(object);
+        return;
+    }
+
+    if(lex_buffer_quietly(&server->warm.symbols, object)){
+        file_text_release(object->buffer, object->buffer_length, object->buffer_is_mapped);
+        free(object->line_offsets);
+        server_forget_tokens(object);
+    }
+}
+
+static void server_report_files(compiler_t *compiler, int feedback){
+    // Tells the server which files were lexed, so it can have them ready next time
+    // Each filename is followed by a null-terminator
+    string_builder_t builder;
+    string_builder_init(&builder);
+
+    for(length_t i = 0; i != compiler->objects_length; i++){
+        object_t *object = compiler->objects[i];
+
+        if(object->full_filename && object->compilation_stage >= COMPILATION_STAGE_TOKENLIST){
+            string_builder_append_view(&builder, object->full_filename, strlen(object->full_filename) + 1);
+        }
+    }
+
+    const char *cursor = builder.buffer;
+    length_t remaining = builder.length;
+
+    while(remaining != 0){
+        ssize_t written = write(feedback, cursor, remaining);
+
+        if(written < 0){
+            if(errno == EINTR) continue;
+            break;
+        }
+
+        cursor += written;
+        remaining -= (length_t) written;
+    }
+
+    string_builder_abandon(&builder);
+}
+
+static int server_child(server_t *server, server_request_t *request, int feedback){
+    // Use the standard input, output, and error of the client
+    for(int i = 0; i != 3; i++){
+        dup2(request->fds[i], i);
+    }
+
+    signal(SIGINT, SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+    signal(SIGPIPE, SIG_DFL);
+
+    // Buffer output the same way a standalone compiler would
+    setvbuf(stdout, NULL, isatty(STDOUT_FILENO) ? _IOLBF : _IOFBF, BUFSIZ);
+
+    if(chdir(request->working_directory) != 0){
+        redprintf("Compile server failed to enter working directory '%s'\n", request->working_directory);
+        return FAILURE;
+    }
+
+    environ = request->envp;
+
+    compiler_t compiler;
+    compiler_init(&compiler);
+
+    // Reuse the config already read by the server
+    config_free(&compiler.config);
+    compiler.config = server->compiler->config;
+    compiler.config_filename = server->compiler->config_filename ? strclone(server->compiler->config_filename) : NULL;
+
+    // Pre-lexed token lists point into the identifiers interned by the server
+    intern_table_free(&compiler.symbols);
+    compiler.symbols = server->warm.symbols;
+    compiler.server = server;
+
+    int exitcode = compiler_run(&compiler, request->argc, request->argv);
+
+    fflush(stdout);
+    fflush(stderr);
+
+    server_report_files(&compiler, feedback);
+    return exitcode;
+}
+
+// ---------------- server_job_t ----------------
+// A request that is being compiled by a child process
+typedef struct {
+    pid_t pid;
+    int connection;              // -1 once the client went away
+    int feedback;                // -1 once the child finished reporting files
+    string_builder_t files;      // Files reported by the child so far
+} server_job_t;
+
+typedef listof(server_job_t, jobs) server_jobs_t;
+
+static bool server_is_same_user(int connection){
+    // Only serve the user who started the server
+    #ifdef __linux__
+    struct ucred credentials;
+    socklen_t credentials_size = sizeof credentials;
+
+    return getsockopt(connection, SOL_SOCKET, SO_PEERCRED, &credentials, &credentials_size) == 0
+        && credentials_size == sizeof credentials
+        && credentials.uid == getuid();
+    #else
+    uid_t uid;
+    gid_t gid;
+
+    return getpeereid(connection, &uid, &gid) == 0 && uid == getuid();
+    #endif
+}
+
+static void server_start_job(server_t *server, server_jobs_t *jobs, int connection){
+    // Don't let a client that never sends its request hold up the server
+    struct timeval timeout = {.tv_sec = SERVER_REQUEST_TIMEOUT_SECONDS, .tv_usec = 0};
+    setsockopt(connection, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof timeout);
+
+    server_request_t request;
+
+    if(server_receive_request(connection, &request)){
+        close(connection);
+        return;
+    }
+
+    int feedback[2];
+
+    if(pipe(feedback) != 0){
+        server_request_free(&request);
+        server_send_exit_code(connection, 1);
+        close(connection);
+        return;
+    }
+
+    // Don't let the child inherit any buffered output
+    fflush(stdout);
+    fflush(stderr);
+
+    pid_t pid = fork();
+
+    if(pid == 0){
+        close(server->listener);
+        close(connection);
+        close(feedback[0]);
+
+        // Other requests being compiled are none of this child's business
+        for(length_t i = 0; i != jobs->length; i++){
+            if(jobs->jobs[i].connection >= 0) close(jobs->jobs[i].connection);
+            if(jobs->jobs[i].feedback >= 0) close(jobs->jobs[i].feedback);
+        }
+
+        exit(server_child(server, &request, feedback[1]));
+    }
+
+    close(feedback[1]);
+    server_request_free(&request);
+
+    if(pid < 0){
+        redprintf("Compile server failed to create process for request\n");
+        close(feedback[0]);
+        server_send_exit_code(connection, 1);
+        close(connection);
+        return;
+    }
+
+    server_job_t *job = list_append_new(jobs, server_job_t);
+    job->pid = pid;
+    job->connection = connection;
+    job->feedback = feedback[0];
+    string_builder_init(&job->files);
+}
+
+static void server_read_feedback(server_job_t *job){
+    char buffer[4096];
+    ssize_t amount = read(job->feedback, buffer, sizeof buffer);
+
+    if(amount > 0){
+        string_builder_append_view(&job->files, buffer, (length_t) amount);
+    } else if(amount == 0 || errno != EINTR){
+        // Child is done
+        close(job->feedback);
+        job->feedback = -1;
+    }
+}
+
+static void server_finish_job(server_t *server, server_job_t *job){
+    int status;
+    int exit_code = 1;
+    pid_t waited;
+
+    do waited = waitpid(job->pid, &status, 0); while(waited < 0 && errno == EINTR);
+
+    if(waited == job->pid){
+        exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+    }
+
+    if(job->connection >= 0){
+        server_send_exit_code(job->connection, exit_code);
+        close(job->connection);
+    }
+
+    // Get files ready for next time, now that the client isn't waiting
+    for(length_t i = 0; i < job->files.length; i += strlen(&job->files.buffer[i]) + 1){
+        server_warm_file(server, &job->files.buffer[i]);
+    }
+
+    string_builder_abandon(&job->files);
+}
+
+static void server_accept(server_t *server, server_jobs_t *jobs){
+    int connection = accept(server->listener, NULL, NULL);
+
+    if(connection < 0){
+        if(errno != EINTR && errno != ECONNABORTED && errno != EAGAIN){
+            redprintf("Compile server failed to accept connection\n");
+        }
+        return;
+    }
+
+    if(!server_is_same_user(connection)){
+        close(connection);
+        return;
+    }
+
+    server_start_job(server, jobs, connection);
+}
+
+static errorcode_t server_run(compiler_t *compiler, strong_cstr_t socket_filename){
+    server_t server = (server_t){
+        .compiler = compiler,
+        .stamps = NULL,
+        .stamps_capacity = 0,
+        .socket_filename = socket_filename,
+        .listener = -1,
+    };
+
+    int existing = server_connect(socket_filename);
+
+    if(existing >= 0){
+        close(existing);
+        redprintf("A compile server is already listening on '%s'\n", socket_filename);
+        free(socket_filename);
+        return FAILURE;
+    }
+
+    server.listener = server_listen(socket_filename);
+
+    if(server.listener < 0){
+        redprintf("Failed to listen on '%s'\n", socket_filename);
+        free(socket_filename);
+        return FAILURE;
+    }
+
+    compiler_init(&server.warm);
+
+    // Do everything that every compilation would otherwise do by itself
+    LLVMInitializeAllTargetInfos();
+    LLVMInitializeAllTargets();
+    LLVMInitializeAllTargetMCs();
+    LLVMInitializeAllAsmParsers();
+    LLVMInitializeAllAsmPrinters();
+
+    struct sigaction stop_action = {0};
+    stop_action.sa_handler = server_request_stop;
+    sigemptyset(&stop_action.sa_mask);
+    sigaction(SIGINT, &stop_action, NULL);
+    sigaction(SIGTERM, &stop_action, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    printf("Compile server listening on '%s'\n", socket_filename);
+    fflush(stdout);
+
+    server_jobs_t jobs = {0};
+    struct pollfd *fds = NULL;
+    length_t fds_capacity = 0;
+
+    // Requests are compiled concurrently, each by its own child process
+    // When asked to stop, stop accepting new requests and let running ones finish
+    while(!server_stop_requested || jobs.length != 0){
+        length_t fds_length = 1 + 2 * jobs.length;
+        expand((void**) &fds, sizeof(struct pollfd), 0, &fds_capacity, fds_length, 16);
+
+        fds[0] = (struct pollfd){.fd = server_stop_requested ? -1 : server.listener, .events = POLLIN};
+
+        for(length_t i = 0; i != jobs.length; i++){
+            fds[1 + 2 * i] = (struct pollfd){.fd = jobs.jobs[i].feedback, .events = POLLIN};
+            fds[2 + 2 * i] = (struct pollfd){.fd = jobs.jobs[i].connection, .events = POLLIN};
+        }
+
+        if(poll(fds, fds_length, -1) < 0){
+            if(errno == EINTR) continue;
+            redprintf("Compile server failed to wait for connections\n");
+            break;
+        }
+
+        for(length_t i = jobs.length; i-- != 0;){
+            server_job_t *job = &jobs.jobs[i];
+
+            if(fds[1 + 2 * i].revents){
+                server_read_feedback(job);
+            }
+
+            // Clients never send anything after their request, so this means the client went away
+            if(fds[2 + 2 * i].revents && job->connection >= 0){
+                kill(job->pid, SIGTERM);
+                close(job->connection);
+                job->connection = -1;
+            }
+
+            if(job->feedback < 0){
+                server_finish_job(&server, job);
+                jobs.jobs[i] = jobs.jobs[--jobs.length];
+            }
+        }
+
+        if(fds[0].revents){
+            server_accept(&server, &jobs);
+        }
+    }
+
+    // Only left early if waiting failed
+    for(length_t i = 0; i != jobs.length; i++){
+        kill(jobs.jobs[i].pid, SIGTERM);
+        if(jobs.jobs[i].feedback >= 0) close(jobs.jobs[i].feedback);
+        server_finish_job(&server, &jobs.jobs[i]);
+    }
+
+    free(jobs.jobs);
+    free(fds);
+    close(server.listener);
+    unlink(socket_filename);
+    free(socket_filename);
+    free(server.stamps);
+    compiler_free(&server.warm);
+    return SUCCESS;
+}
+
+#else
+
+bool server_take_warm_object(server_t *server, object_t *object){
+    (void) server;
+    (void) object;
+    return false;
+}
+
+#endif
+
+bool handle_server(compiler_t *compiler, int argc, char **argv){
+    if(argc < 2) return false;
+
+    weak_cstr_t arg = argv[1];
+    maybe_null_weak_cstr_t requested_socket_filename;
+
+    if(streq(arg, "--server")){
+        requested_socket_filename = NULL;
+    } else if(string_starts_with(arg, "--server=")){
+        requested_socket_filename = &arg[9];
+    } else {
+        return false;
+    }
+
+    if(argc != 2){
+        redprintf("Unexpected arguments after '%s'\n", arg);
+        return true;
+    }
+
+    if(compiler->server){
+        redprintf("Can't start a compile server from within a compile server\n");
+        return true;
+    }
+
+    #if !defined(_WIN32) && !defined(ADEPT_INSIGHT_BUILD)
+    strong_cstr_t socket_filename = requested_socket_filename ? strclone(requested_socket_filename) : server_socket_filename();
+
+    if(server_run(compiler, socket_filename) == SUCCESS){
+        compiler->result_flags |= COMPILER_RESULT_SUCCESS;
+    }
+    #else
+    (void) requested_socket_filename;
+    redprintf("Compile servers aren't supported on this platform\n");
+    #endif
+
+    return true;
+}
@@ -0,0 +1,376 @@
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "DRVR/server_protocol.h"
+#include "UTIL/ground.h"
+
+#if !defined(_WIN32) && !defined(ADEPT_INSIGHT_BUILD)
+
+#include <errno.h>
+#include <limits.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#ifndef PATH_MAX
+#define PATH_MAX 4096
+#endif
+
+maybe_null_strong_cstr_t server_socket_filename(void){
+    maybe_null_weak_cstr_t override = getenv(SERVER_SOCKET_ENVIRONMENT_VARIABLE);
+    maybe_null_weak_cstr_t runtime_directory = getenv("XDG_RUNTIME_DIR");
+
+    char filename[PATH_MAX];
+
+    if(override && override[0] != '\0'){
+        snprintf(filename, sizeof filename, "%s", override);
+    } else if(runtime_directory && runtime_directory[0] != '\0'){
+        snprintf(filename, sizeof filename, "%s/adept-server.sock", runtime_directory);
+    } else {
+        snprintf(filename, sizeof filename, "/tmp/adept-server-%lu.sock", (unsigned long) getuid());
+    }
+
+    length_t length = strlen(filename);
+    return memcpy(malloc(length + 1), filename, length + 1);
+}
+
+static bool make_socket_address(weak_cstr_t socket_filename, struct sockaddr_un *out_address){
+    memset(out_address, 0, sizeof *out_address);
+    out_address->sun_family = AF_UNIX;
+
+    if(strlen(socket_filename) >= sizeof out_address->sun_path) return false;
+
+    strcpy(out_address->sun_path, socket_filename);
+    return true;
+}
+
+int server_connect(weak_cstr_t socket_filename){
+    struct sockaddr_un address;
+    struct stat info;
+
+    if(!make_socket_address(socket_filename, &address)) return -1;
+
+    // Only talk to servers started by the same user
+    if(lstat(socket_filename, &info) != 0 || !S_ISSOCK(info.st_mode) || info.st_uid != getuid()) return -1;
+
+    int connection = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(connection < 0) return -1;
+
+    if(connect(connection, (struct sockaddr*) &address, sizeof address) != 0){
+        close(connection);
+        return -1;
+    }
+
+    return connection;
+}
+
+int server_listen(weak_cstr_t socket_filename){
+    struct sockaddr_un address;
+    struct stat info;
+
+    if(!make_socket_address(socket_filename, &address)) return -1;
+
+    // Remove socket left behind by a server that no longer exists
+    if(lstat(socket_filename, &info) == 0 && S_ISSOCK(info.st_mode)){
+        unlink(socket_filename);
+    }
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(listener < 0) return -1;
+
+    // Create the socket as only accessible by us from the start
+    mode_t mask = umask(0077);
+    int bound = bind(listener, (struct sockaddr*) &address, sizeof address);
+    umask(mask);
+
+    if(bound != 0 || listen(listener, SOMAXCONN) != 0){
+        close(listener);
+        return -1;
+    }
+
+    return listener;
+}
+
+static errorcode_t write_all(int fd, const void *data, length_t size){
+    const char *cursor = data;
+
+    while(size != 0){
+        ssize_t written = write(fd, cursor, size);
+
+        if(written < 0){
+            if(errno == EINTR) continue;
+            return FAILURE;
+        }
+
+        cursor += written;
+        size -= (length_t) written;
+    }
+
+    return SUCCESS;
+}
+
+static errorcode_t read_all(int fd, void *data, length_t size){
+    char *cursor = data;
+
+    while(size != 0){
+        ssize_t amount = read(fd, cursor, size);
+
+        if(amount < 0){
+            if(errno == EINTR) continue;
+            return FAILURE;
+        }
+
+        if(amount == 0) return FAILURE;
+
+        cursor += amount;
+        size -= (length_t) amount;
+    }
+
+    return SUCCESS;
+}
+
+static char *append_string(char *destination, const char *string){
+    // Copies a string including its null-terminator, and returns where the next string goes
+    length_t size = strlen(string) + 1;
+    return (char*) memcpy(destination, string, size) + size;
+}
+
+errorcode_t server_send_request(int connection, int argc, char **argv, char **envp){
+    char working_directory[PATH_MAX];
+    if(getcwd(working_directory, sizeof working_directory) == NULL) return FAILURE;
+
+    uint32_t envc = 0;
+    while(envp && envp[envc]) envc++;
+
+    // Lay out all strings one after another
+    length_t body_size = strlen(working_directory) + 1;
+
+    for(int i = 0; i != argc; i++) body_size += strlen(argv[i]) + 1;
+    for(uint32_t i = 0; i != envc; i++) body_size += strlen(envp[i]) + 1;
+
+    if(body_size > SERVER_PROTOCOL_MAX_BODY_SIZE) return FAILURE;
+
+    char *body = malloc(body_size);
+    char *end = body;
+
+    end = append_string(end, working_directory);
+    for(int i = 0; i != argc; i++) end = append_string(end, argv[i]);
+    for(uint32_t i = 0; i != envc; i++) end = append_string(end, envp[i]);
+
+    server_request_header_t header = {
+        .magic = SERVER_PROTOCOL_MAGIC,
+        .version = SERVER_PROTOCOL_VERSION,
+        .argc = (uint32_t) argc,
+        .envc = envc,
+        .body_size = body_size,
+    };
+
+    // Send standard input, output, and error along with the header
+    int fds[3] = {STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO};
+
+    union {
+        char buffer[CMSG_SPACE(sizeof fds)];
+        struct cmsghdr align;
+    } control;
+
+    memset(&control, 0, sizeof control);
+
+    struct iovec iov = {
+        .iov_base = &header,
+        .iov_len = sizeof header,
+    };
+
+    struct msghdr message = {
+        .msg_iov = &iov,
+        .msg_iovlen = 1,
+        .msg_control = control.buffer,
+        .msg_controllen = sizeof control.buffer,
+    };
+
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&message);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof fds);
+    memcpy(CMSG_DATA(cmsg), fds, sizeof fds);
+
+    ssize_t sent;
+    do sent = sendmsg(connection, &message, 0); while(sent < 0 && errno == EINTR);
+
+    errorcode_t errorcode = sent == (ssize_t) sizeof header ? write_all(connection, body, body_size) : FAILURE;
+    free(body);
+    return errorcode;
+}
+
+static void close_fds(int *fds, length_t count){
+    for(length_t i = 0; i != count; i++){
+        if(fds[i] >= 0) close(fds[i]);
+    }
+}
+
+errorcode_t server_receive_request(int connection, server_request_t *out_request){
+    server_request_header_t header;
+    int fds[3] = {-1, -1, -1};
+
+    union {
+        char buffer[CMSG_SPACE(sizeof fds)];
+        struct cmsghdr align;
+    } control;
+
+    struct iovec iov = {
+        .iov_base = &header,
+        .iov_len = sizeof header,
+    };
+
+    struct msghdr message = {
+        .msg_iov = &iov,
+        .msg_iovlen = 1,
+        .msg_control = control.buffer,
+        .msg_controllen = sizeof control.buffer,
+    };
+
+    ssize_t received;
+    do received = recvmsg(connection, &message, 0); while(received < 0 && errno == EINTR);
+
+    for(struct cmsghdr *cmsg = CMSG_FIRSTHDR(&message); cmsg; cmsg = CMSG_NXTHDR(&message, cmsg)){
+        if(cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS && cmsg->cmsg_len == CMSG_LEN(sizeof fds)){
+            memcpy(fds, CMSG_DATA(cmsg), sizeof fds);
+        }
+    }
+
+    if(received != (ssize_t) sizeof header
+    || message.msg_flags & MSG_CTRUNC
+    || fds[0] < 0 || fds[1] < 0 || fds[2] < 0
+    || header.magic != SERVER_PROTOCOL_MAGIC
+    || header.version != SERVER_PROTOCOL_VERSION
+    || header.body_size == 0
+    || header.body_size > SERVER_PROTOCOL_MAX_BODY_SIZE
+    || header.argc == 0
+    || header.argc > header.body_size
+    || header.envc > header.body_size){
+        close_fds(fds, 3);
+        return FAILURE;
+    }
+
+    length_t body_size = header.body_size;
+    char *body = malloc(body_size);
+
+    if(read_all(connection, body, body_size) || body[body_size - 1] != '\0'){
+        free(body);
+        close_fds(fds, 3);
+        return FAILURE;
+    }
+
+    // Layout of 'strings' is: argv..., NULL, envp..., NULL
+    weak_cstr_t *strings = malloc(sizeof(weak_cstr_t) * (header.argc + header.envc + 2));
+    weak_cstr_t working_directory = NULL;
+
+    // Split body into strings
+    char *cursor = body;
+    char *end = body + body_size;
+
+    for(length_t i = 0; i != 1 + header.argc + header.envc; i++){
+        if(cursor == end){
+            free(strings);
+            free(body);
+            close_fds(fds, 3);
+            return FAILURE;
+        }
+
+        if(i == 0){
+            working_directory = cursor;
+        } else if(i <= header.argc){
+            strings[i - 1] = cursor;
+        } else {
+            strings[i] = cursor;
+        }
+
+        cursor += strlen(cursor) + 1;
+    }
+
+    strings[header.argc] = NULL;
+    strings[header.argc + header.envc + 1] = NULL;
+
+    *out_request = (server_request_t){
+        .body = body,
+        .working_directory = working_directory,
+        .argc = (int) header.argc,
+        .argv = strings,
+        .envp = &strings[header.argc + 1],
+        .fds = {fds[0], fds[1], fds[2]},
+    };
+
+    return SUCCESS;
+}
+
+void server_request_free(server_request_t *request){
+    close_fds(request->fds, 3);
+    free(request->argv);
+    free(request->body);
+}
+
+errorcode_t server_send_exit_code(int connection, int exit_code){
+    int32_t value = exit_code;
+    return write_all(connection, &value, sizeof value);
+}
+
+errorcode_t server_receive_exit_code(int connection, int *out_exit_code){
+    int32_t value;
+    if(read_all(connection, &value, sizeof value)) return FAILURE;
+
+    *out_exit_code = value;
+    return SUCCESS;
+}
+
+#else
+
+maybe_null_strong_cstr_t server_socket_filename(void){
+    return NULL;
+}
+
+int server_connect(weak_cstr_t socket_filename){
+    (void) socket_filename;
+    return -1;
+}
+
+int server_listen(weak_cstr_t socket_filename){
+    (void) socket_filename;
+    return -1;
+}
+
+errorcode_t server_send_request(int connection, int argc, char **argv, char **envp){
+    (void) connection;
+    (void) argc;
+    (void) argv;
+    (void) envp;
+    return FAILURE;
+}
+
+errorcode_t server_receive_request(int connection, server_request_t *out_request){
+    (void) connection;
+    (void) out_request;
+    return FAILURE;
+}
+
+void server_request_free(server_request_t *request){
+    free(request->argv);
+    free(request->body);
+}
+
+errorcode_t server_send_exit_code(int connection, int exit_code){
+    (void) connection;
+    (void) exit_code;
+    return FAILURE;
+}
+
+errorcode_t server_receive_exit_code(int connection, int *out_exit_code){
+    (void) connection;
+    (void) out_exit_code;
+    return FAILURE;
+}
+
+#endif
@@ -1,4 +1,5 @@
 
+#include "AST/ast_pool.h"
 #include "INFER/infer.h"
 
 #include <assert.h>
@@ -84,6 +85,9 @@ errorcode_t infer_in_composites(infer_ctx_t *ctx, ast_composite_t *composites, l
         if(infer_layout_skeleton(ctx, &composite->layout.skeleton)){
             return FAILURE;
         }
+
+        // Layout is final, so index large field maps for faster member lookups
+        ast_field_map_build_index(&composite->layout.field_map);
     }
 
     return SUCCESS;
@@ -96,6 +100,8 @@ errorcode_t infer_in_poly_composites(infer_ctx_t *ctx, ast_poly_composite_t *pol
         if(infer_layout_skeleton(ctx, &poly_composite->layout.skeleton)){
             return FAILURE;
         }
+
+        ast_field_map_build_index(&poly_composite->layout.field_map);
     }
 
     return SUCCESS;
@@ -166,13 +172,13 @@ errorcode_t infer_in_funcs(infer_ctx_t *ctx, ast_func_t *funcs, length_t funcs_l
                     || function->traits & (AST_FUNC_MAIN | AST_FUNC_DISALLOW | AST_FUNC_DISPATCHER)
                     || (a == 0 && streq(function->arg_names[a], "this"));
                 
-                infer_var_scope_ir_builder_add_variable(ctx->scope, function->arg_names[a], &function->arg_types[a], function->arg_sources[a], force_used, false);
+                infer_var_scope_ir_builder_add_variable(ctx->compiler, ctx->scope, function->arg_names[a], &function->arg_types[a], function->arg_sources[a], force_used, false);
             }
         }
 
         if(function->traits & AST_FUNC_VARIADIC){
             // Add variadic array variable
-            infer_var_scope_ir_builder_add_variable(ctx->scope, function->variadic_arg_name, ctx->ast->common.ast_variadic_array, function->variadic_source, false, false);
+            infer_var_scope_ir_builder_add_variable(ctx->compiler, ctx->scope, function->variadic_arg_name, ctx->ast->common.ast_variadic_array, function->variadic_source, false, false);
         }
         
         // Infer expressions in statements
@@ -219,7 +225,7 @@ errorcode_t infer_in_stmts(infer_ctx_t *ctx, ast_func_t *func, ast_expr_list_t *
                 // SPEED: PERFORMANCE: This is probably really slow to do
                 // TODO: Clean up and/or speed up this code
                 if(!(ctx->compiler->ignore & COMPILER_IGNORE_UNUSED || ctx->compiler->traits & COMPILER_NO_WARN) && ctx->scope != NULL){
-                    infer_var_t *func_variable = infer_var_scope_find(ctx->scope, call_stmt->name);
+                    infer_var_t *func_variable = infer_var_scope_find(ctx->compiler, ctx->scope, call_stmt->name);
                     if(func_variable) func_variable->used = true;
                 }
                 
@@ -250,7 +256,7 @@ errorcode_t infer_in_stmts(infer_ctx_t *ctx, ast_func_t *func, ast_expr_list_t *
                     }
                 }
 
-                infer_var_scope_ir_builder_add_variable(ctx->scope, declare_stmt->name, &declare_stmt->type, declare_stmt->source, false, declare_stmt->traits & AST_EXPR_DECLARATION_CONST);
+                infer_var_scope_ir_builder_add_variable(ctx->compiler, ctx->scope, declare_stmt->name, &declare_stmt->type, declare_stmt->source, false, declare_stmt->traits & AST_EXPR_DECLARATION_CONST);
             }
             break;
         case EXPR_ASSIGN:
@@ -367,8 +373,8 @@ errorcode_t infer_in_stmts(infer_ctx_t *ctx, ast_func_t *func, ast_expr_list_t *
                 if(loop->list      && infer_expr(ctx, func, &loop->list, EXPR_USIZE, true))     return FAILURE;
  
                 infer_var_scope_push(&ctx->scope);
-                infer_var_scope_ir_builder_add_variable(ctx->scope, "idx", &ctx->ast->common.ast_usize_type, loop->source, true, false);
-                infer_var_scope_ir_builder_add_variable(ctx->scope, loop->it_name ? loop->it_name : "it", loop->it_type, loop->source, true, false);
+                infer_var_scope_ir_builder_add_variable(ctx->compiler, ctx->scope, "idx", &ctx->ast->common.ast_usize_type, loop->source, true, false);
+                infer_var_scope_ir_builder_add_variable(ctx->compiler, ctx->scope, loop->it_name ? loop->it_name : "it", loop->it_type, loop->source, true, false);
 
                 if(infer_in_stmts(ctx, func, &loop->statements)){
                     infer_var_scope_pop(ctx->compiler, &ctx->scope);
@@ -384,7 +390,7 @@ errorcode_t infer_in_stmts(infer_ctx_t *ctx, ast_func_t *func, ast_expr_list_t *
                 if(infer_expr(ctx, func, &loop->limit, EXPR_USIZE, false)) return FAILURE;
  
                 infer_var_scope_push(&ctx->scope);
-                infer_var_scope_ir_builder_add_variable(ctx->scope, loop->idx_name ? loop->idx_name : "idx", &ctx->ast->common.ast_usize_type, loop->source, true, false);
+                infer_var_scope_ir_builder_add_variable(ctx->compiler, ctx->scope, loop->idx_name ? loop->idx_name : "idx", &ctx->ast->common.ast_usize_type, loop->source, true, false);
 
                 if(infer_in_stmts(ctx, func, &loop->statements)){
                     infer_var_scope_pop(ctx->compiler, &ctx->scope);
@@ -646,7 +652,7 @@ errorcode_t infer_expr_inner(infer_ctx_t *ctx, ast_func_t *ast_func, ast_expr_t
             // SPEED: PERFORMANCE: This is probably really slow to do
             // TODO: Clean up and/or speed up this code
             if(!(ctx->compiler->ignore & COMPILER_IGNORE_UNUSED || ctx->compiler->traits & COMPILER_NO_WARN) && ctx->scope != NULL){
-                infer_var_t *variable = infer_var_scope_find(ctx->scope, ((ast_expr_call_t*) *expr)->name);
+                infer_var_t *variable = infer_var_scope_find(ctx->compiler, ctx->scope, ((ast_expr_call_t*) *expr)->name);
 
                 if(variable){
                     variable->used = true;
@@ -843,7 +849,7 @@ errorcode_t infer_expr_inner(infer_ctx_t *ctx, ast_func_t *ast_func, ast_expr_t
                 return FAILURE;
             }
 
-            infer_var_scope_ir_builder_add_variable(ctx->scope, def->name, &def->type, def->source, true, false);
+            infer_var_scope_ir_builder_add_variable(ctx->compiler, ctx->scope, def->name, &def->type, def->source, true, false);
         }
         break;
     case EXPR_VA_ARG: {
@@ -889,7 +895,7 @@ errorcode_t infer_expr_inner_variable(infer_ctx_t *ctx, ast_func_t *ast_func, as
     unsigned int var_expr_primitive;
 
     // Search in local variables scope first
-    infer_var_t *local_variable = ctx->scope ? infer_var_scope_find(ctx->scope, variable_name) : NULL;
+    infer_var_t *local_variable = ctx->scope ? infer_var_scope_find(ctx->compiler, ctx->scope, variable_name) : NULL;
     
     if(local_variable != NULL){
         variable_type = local_variable->type;
@@ -939,7 +945,7 @@ found_named_expression:
     }
 
     // DANGEROUS: Manually freeing variable expression
-    free(*expr);
+    ast_release(*expr);
 
     // Clone expression of named expression
     *expr = ast_expr_clone(named_expression->expression);
@@ -1254,7 +1260,7 @@ errorcode_t infer_type_inner(infer_ctx_t *ctx, ast_type_t *type, source_t origin
                     }
 
                     // Create replacement element
-                    ast_elem_base_t *ptr_elem = malloc(sizeof(ast_elem_base_t));
+                    ast_elem_base_t *ptr_elem = ast_alloc(sizeof(ast_elem_base_t));
                     ptr_elem->id = AST_ELEM_BASE;
                     ptr_elem->source = type->elements[elem_i]->source;
                     ptr_elem->base = strclone("ptr");
@@ -1263,7 +1269,7 @@ errorcode_t infer_type_inner(infer_ctx_t *ctx, ast_type_t *type, source_t origin
                     ast_elem_free(elem);
 
                     // DANGEROUS: Manually freeing pointer ast_elem_pointer_t element
-                    free(new_elements[length - 1]);
+                    ast_release(new_elements[length - 1]);
 
                     // Replace previous '*' with 'ptr'
                     new_elements[length - 1] = (ast_elem_t*) ptr_elem;
@@ -1452,14 +1458,22 @@ void infer_var_scope_pop(compiler_t *compiler, infer_var_scope_t **scope){
     *scope = parent;
 }
 
-infer_var_t* infer_var_scope_find(infer_var_scope_t *scope, const char *name){
+static infer_var_t* infer_var_scope_find_symbol(infer_var_scope_t *scope, weak_cstr_t symbol){
+    // Variable names are interned, so they can be compared by pointer
+
     for(length_t i = 0; i != scope->list.length; i++){
-        if(streq(scope->list.variables[i].name, name)){
+        if(scope->list.variables[i].name == symbol){
             return &scope->list.variables[i];
         }
     }
 
-    return scope->parent ? infer_var_scope_find(scope->parent, name) : NULL;
+    return scope->parent ? infer_var_scope_find_symbol(scope->parent, symbol) : NULL;
+}
+
+infer_var_t* infer_var_scope_find(compiler_t *compiler, infer_var_scope_t *scope, const char *name){
+    // Names that were never interned can't belong to any variable
+    maybe_null_weak_cstr_t symbol = intern_table_find_cstr(&compiler->symbols, name);
+    return symbol ? infer_var_scope_find_symbol(scope, symbol) : NULL;
 }
 
 ast_named_expression_t* infer_var_scope_find_named_expression(infer_var_scope_t *scope, const char *name){
@@ -1471,11 +1485,11 @@ ast_named_expression_t* infer_var_scope_find_named_expression(infer_var_scope_t
     return scope->parent ? infer_var_scope_find_named_expression(scope->parent, name) : NULL;
 }
 
-void infer_var_scope_ir_builder_add_variable(infer_var_scope_t *scope, weak_cstr_t name, ast_type_t *type, source_t source, bool force_used, bool is_const){
+void infer_var_scope_ir_builder_add_variable(compiler_t *compiler, infer_var_scope_t *scope, weak_cstr_t name, ast_type_t *type, source_t source, bool force_used, bool is_const){
     // NOTE: Assumes name is a valid C-String
 
     infer_var_list_append(&scope->list, ((infer_var_t){
-        .name = name,
+        .name = intern_table_insert_cstr(&compiler->symbols, name),
         .type = type,
         .source = source,
         .used = force_used || name[0] == '_',
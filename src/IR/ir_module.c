@@ -23,6 +23,7 @@ static rtti_collector_t *create_rtti_collector(ir_pool_t *pool){
 void ir_module_init(ir_module_t *ir_module, length_t funcs_capacity, length_t globals_length, length_t number_of_function_names_guess){
     ir_pool_t *pool = &ir_module->pool;
     ir_pool_init(pool);
+    ir_pool_init(&ir_module->type_pool);
 
     ir_module->funcs = (ir_funcs_t){
         .funcs = malloc(sizeof(ir_func_t) * funcs_capacity),
@@ -30,15 +31,17 @@ void ir_module_init(ir_module_t *ir_module, length_t funcs_capacity, length_t gl
         .capacity = funcs_capacity,
     };
 
-    ir_proc_map_init(&ir_module->func_map, sizeof(ir_func_key_t), number_of_function_names_guess);
-    ir_proc_map_init(&ir_module->method_map, sizeof(ir_method_key_t), 0);
+    ir_proc_map_init(&ir_module->func_map, sizeof(ir_func_key_t), number_of_function_names_guess, &hash_ir_func_key, &equals_ir_func_key);
+    ir_proc_map_init(&ir_module->method_map, sizeof(ir_method_key_t), 0, &hash_ir_method_key, &equals_ir_method_key);
 
     ir_module->type_map.mappings = NULL;
     ir_module->globals = malloc(sizeof(ir_global_t) * globals_length);
     ir_module->globals_length = 0;
     ir_module->anon_globals = (ir_anon_globals_t){0};
 
-    ir_gen_sf_cache_init(&ir_module->sf_cache, IR_GEN_SF_CACHE_SUGGESTED_NUM_BUCKETS);
+    ast_type_intern_table_init(&ir_module->canonical_types);
+    ir_gen_sf_cache_init(&ir_module->sf_cache, &ir_module->canonical_types);
+    ir_gen_poly_cache_init(&ir_module->poly_cache);
 
     ir_module->rtti_collector = create_rtti_collector(pool);
     ir_module->rtti_table = NULL;
@@ -73,6 +76,8 @@ void ir_module_free(ir_module_t *ir_module){
     free(ir_module->globals);
     free(ir_module->anon_globals.globals);
     ir_gen_sf_cache_free(&ir_module->sf_cache);
+    ir_gen_poly_cache_free(&ir_module->poly_cache);
+    ast_type_intern_table_free(&ir_module->canonical_types);
 
     // Free init_builder
     if(ir_module->init_builder){
@@ -103,6 +108,7 @@ void ir_module_free(ir_module_t *ir_module){
     ir_vtable_dispatch_list_free(&ir_module->vtable_dispatch_list);
 
     ir_pool_free(&ir_module->pool);
+    ir_pool_free(&ir_module->type_pool);
 }
 
 void ir_module_create_func_mapping(ir_module_t *module, weak_cstr_t function_name, ir_func_endpoint_t endpoint, bool add_to_job_list){
@@ -110,20 +116,33 @@ void ir_module_create_func_mapping(ir_module_t *module, weak_cstr_t function_nam
         .name = function_name,
     };
 
-    ir_proc_map_insert(&module->func_map, &key, sizeof key, endpoint, &compare_ir_func_key);
+    ir_proc_map_insert(&module->func_map, &key, endpoint);
 
     if(add_to_job_list){
         ir_job_list_append(&module->job_list, endpoint);
     }
 }
 
+void ir_module_request_func(ir_module_t *module, func_id_t ir_func_id){
+    ir_func_t *func = &module->funcs.funcs[ir_func_id];
+
+    if(func->traits & IR_FUNC_DEFERRED){
+        func->traits &= ~IR_FUNC_DEFERRED;
+
+        ir_job_list_append(&module->job_list, ((ir_func_endpoint_t){
+            .ast_func_id = func->deferred_ast_func_id,
+            .ir_func_id = ir_func_id,
+        }));
+    }
+}
+
 void ir_module_create_method_mapping(ir_module_t *module, weak_cstr_t struct_name, weak_cstr_t method_name, ir_func_endpoint_t endpoint){
     ir_method_key_t key = (ir_method_key_t){
         .method_name = method_name,
         .struct_name = struct_name,
     };
 
-    ir_proc_map_insert(&module->method_map, &key, sizeof key, endpoint, &compare_ir_method_key);
+    ir_proc_map_insert(&module->method_map, &key, endpoint);
 }
 
 ir_value_t *ir_module_create_anon_global(ir_module_t *module, ir_type_t *type, bool is_constant, ir_value_t *initializer_or_null){
@@ -5,23 +5,82 @@
 #include <string.h>
 
 #include "UTIL/ground.h"
+#include "UTIL/hash.h"
 #include "UTIL/util.h"
 
-static void ir_proc_map_expand(ir_proc_map_t *map, length_t sizeof_key){
+static length_t ir_proc_map_slots_capacity_for(length_t keys){
+    // Keep load factor at or below 1/2
+    length_t slots_capacity = 16;
+
+    while(slots_capacity < keys * 2){
+        slots_capacity *= 2;
+    }
+
+    return slots_capacity;
+}
+
+static void ir_proc_map_expand(ir_proc_map_t *map){
     coexpand(
-        (void**) &map->keys, sizeof_key,
+        (void**) &map->keys, map->sizeof_key,
         (void**) &map->endpoint_lists, sizeof *map->endpoint_lists,
         map->length, &map->capacity,
         1, 4
     );
 }
 
-void ir_proc_map_init(ir_proc_map_t *map, length_t sizeof_key, length_t estimated_keys){
+static void ir_proc_map_grow_slots(ir_proc_map_t *map){
+    length_t new_capacity = map->slots_capacity * 2;
+    ir_proc_map_slot_t *new_slots = calloc(new_capacity, sizeof(ir_proc_map_slot_t));
+
+    for(length_t i = 0; i != map->slots_capacity; i++){
+        ir_proc_map_slot_t slot = map->slots[i];
+        if(slot.index_plus_one == 0) continue;
+
+        length_t position = slot.hash & (new_capacity - 1);
+
+        while(new_slots[position].index_plus_one != 0){
+            position = (position + 1) & (new_capacity - 1);
+        }
+
+        new_slots[position] = slot;
+    }
+
+    free(map->slots);
+    map->slots = new_slots;
+    map->slots_capacity = new_capacity;
+}
+
+// Returns the slot that either contains the key, or is where it should be inserted
+static ir_proc_map_slot_t *ir_proc_map_probe(ir_proc_map_t *map, const void *key, hash_t hash){
+    length_t position = hash & (map->slots_capacity - 1);
+
+    while(map->slots[position].index_plus_one != 0){
+        ir_proc_map_slot_t *slot = &map->slots[position];
+        const void *existing_key = (char*) map->keys + map->sizeof_key * (slot->index_plus_one - 1);
+
+        if(slot->hash == hash && (*map->equals_func)(key, existing_key)){
+            return slot;
+        }
+
+        position = (position + 1) & (map->slots_capacity - 1);
+    }
+
+    return &map->slots[position];
+}
+
+void ir_proc_map_init(ir_proc_map_t *map, length_t sizeof_key, length_t estimated_keys, ir_proc_map_hash_func_t hash_func, ir_proc_map_equals_func_t equals_func){
+    length_t slots_capacity = ir_proc_map_slots_capacity_for(estimated_keys);
+
     *map = (ir_proc_map_t){
         .keys = malloc(sizeof_key * estimated_keys),
-        .endpoint_lists = malloc(sizeof(ir_func_endpoint_t) * estimated_keys),
+        .endpoint_lists = malloc(sizeof(ir_func_endpoint_list_t*) * estimated_keys),
         .length = 0,
         .capacity = estimated_keys,
+        .slots = calloc(slots_capacity, sizeof(ir_proc_map_slot_t)),
+        .slots_capacity = slots_capacity,
+        .sizeof_key = sizeof_key,
+        .hash_func = hash_func,
+        .equals_func = equals_func,
         .endpoint_pool = {0},
     };
 
@@ -36,57 +95,68 @@ void ir_proc_map_free(ir_proc_map_t *map){
     }
 
     free(map->endpoint_lists);
+    free(map->slots);
 
     ir_pool_free(&map->endpoint_pool);
 }
 
-void ir_proc_map_insert(ir_proc_map_t *map, const void *key, length_t sizeof_key, ir_func_endpoint_t endpoint, int (*key_compare)(const void*, const void*)){
-    length_t position = find_insert_position(map->keys, map->length, key_compare, key, sizeof_key);
+void ir_proc_map_insert(ir_proc_map_t *map, const void *key, ir_func_endpoint_t endpoint){
+    hash_t hash = (*map->hash_func)(key);
+    ir_proc_map_slot_t *slot = ir_proc_map_probe(map, key, hash);
 
-    if(position < map->length && (*key_compare)(key, (char*) map->keys + sizeof_key * (position)) == 0){
-        // Key already exists in map
-    } else {
+    if(slot->index_plus_one == 0){
         // Key doesn't already exist in map
+        length_t position = map->length;
 
-        ir_proc_map_expand(map, sizeof_key);
-
-        memmove((char*) map->keys + sizeof_key * (position + 1), (char*) map->keys + sizeof_key * (position), sizeof_key * (map->length - position));
-        memmove(&map->endpoint_lists[position + 1], &map->endpoint_lists[position], sizeof(*map->endpoint_lists) * (map->length - position));
+        ir_proc_map_expand(map);
 
-        memcpy((char*) map->keys + sizeof_key * position, key, sizeof_key);
+        memcpy((char*) map->keys + map->sizeof_key * position, key, map->sizeof_key);
         map->endpoint_lists[position] = (ir_func_endpoint_list_t*) ir_pool_alloc(&map->endpoint_pool, sizeof(ir_func_endpoint_list_t));
         map->length += 1;
 
         memset(map->endpoint_lists[position], 0, sizeof(ir_func_endpoint_list_t));
+
+        *slot = (ir_proc_map_slot_t){
+            .index_plus_one = position + 1,
+            .hash = hash,
+        };
+
+        ir_func_endpoint_list_insert(map->endpoint_lists[position], endpoint);
+
+        if(map->length * 2 > map->slots_capacity){
+            ir_proc_map_grow_slots(map);
+        }
+        return;
     }
 
-    ir_func_endpoint_list_insert(map->endpoint_lists[position], endpoint);
+    ir_func_endpoint_list_insert(map->endpoint_lists[slot->index_plus_one - 1], endpoint);
 }
 
-ir_func_endpoint_list_t *ir_proc_map_find(ir_proc_map_t *map, const void *key, length_t sizeof_key, int (*key_compare)(const void*, const void*)){
-    void **found_key = bsearch(key, map->keys, map->length, sizeof_key, key_compare);
+ir_func_endpoint_list_t *ir_proc_map_find(ir_proc_map_t *map, const void *key){
+    ir_proc_map_slot_t *slot = ir_proc_map_probe(map, key, (*map->hash_func)(key));
 
-    if(found_key != NULL){
-        // Use index of found key to access corresponding endpoint list
-        length_t co_index = (length_t)((char*) found_key - (char*) map->keys) / sizeof_key;
-        return map->endpoint_lists[co_index];
-    } else {
-        return NULL;
-    }
+    // Use index of found key to access corresponding endpoint list
+    return slot->index_plus_one != 0 ? map->endpoint_lists[slot->index_plus_one - 1] : NULL;
+}
+
+hash_t hash_ir_func_key(const void *raw_key){
+    const ir_func_key_t *key = raw_key;
+    return hash_string(key->name);
 }
 
-int compare_ir_func_key(const void *raw_a, const void *raw_b){
+hash_t hash_ir_method_key(const void *raw_key){
+    const ir_method_key_t *key = raw_key;
+    return hash_combine(hash_string(key->struct_name), hash_string(key->method_name));
+}
+
+bool equals_ir_func_key(const void *raw_a, const void *raw_b){
     const ir_func_key_t *a = raw_a;
     const ir_func_key_t *b = raw_b;
-    return strcmp(a->name, b->name);
+    return streq(a->name, b->name);
 }
 
-int compare_ir_method_key(const void *raw_a, const void *raw_b){
+bool equals_ir_method_key(const void *raw_a, const void *raw_b){
     const ir_method_key_t *a = raw_a;
     const ir_method_key_t *b = raw_b;
-
-    int compare = strcmp(a->struct_name, b->struct_name);
-    if(compare != 0) return compare;
-
-    return strcmp(a->method_name, b->method_name);
+    return streq(a->struct_name, b->struct_name) && streq(a->method_name, b->method_name);
 }
@@ -288,7 +288,7 @@ bridge_var_t *ir_builder_add_variable(ir_builder_t *builder, weak_cstr_t name, a
     }
 
     bridge_var_list_append(list, ((bridge_var_t){
-        .name = name,
+        .name = intern_table_insert_cstr(&builder->compiler->symbols, name),
         .ast_type = ast_type,
         .traits = traits,
         .ir_type = ir_type,
@@ -299,6 +299,17 @@ bridge_var_t *ir_builder_add_variable(ir_builder_t *builder, weak_cstr_t name, a
     return &list->variables[list->length - 1];
 }
 
+bridge_var_t *ir_builder_find_variable(ir_builder_t *builder, const char *name){
+    // Names that were never interned can't belong to any variable
+    maybe_null_weak_cstr_t symbol = intern_table_find_cstr(&builder->compiler->symbols, name);
+    return symbol ? bridge_scope_find_var(builder->scope, symbol) : NULL;
+}
+
+bool ir_builder_variable_already_declared(ir_builder_t *builder, const char *name){
+    maybe_null_weak_cstr_t symbol = intern_table_find_cstr(&builder->compiler->symbols, name);
+    return symbol && bridge_scope_var_already_in_list(builder->scope, symbol);
+}
+
 errorcode_t handle_deference_for_variables(ir_builder_t *builder, bridge_var_list_t *list){
     for(length_t i = 0; i != list->length; i++){
         bridge_var_t *variable = &list->variables[i];
@@ -1536,13 +1547,13 @@ errorcode_t attempt_autogen___assign__(compiler_t *compiler, object_t *object, a
 
     // Generate assignment statements
     for(length_t i = 0; i != field_map.arrows_length; i++){
-        weak_cstr_t member = field_map.arrows[i].name;
+        weak_cstr_t member = intern_table_insert_cstr(&compiler->symbols, field_map.arrows[i].name);
 
         ast_expr_t *this_value = ast_expr_create_variable("this", NULL_SOURCE);
         ast_expr_t *other_value = ast_expr_create_variable("$", NULL_SOURCE);
 
-        ast_expr_t *this_member = ast_expr_create_member(this_value, strclone(member), NULL_SOURCE);
-        ast_expr_t *other_member = ast_expr_create_member(other_value, strclone(member), NULL_SOURCE);
+        ast_expr_t *this_member = ast_expr_create_member(this_value, member, NULL_SOURCE);
+        ast_expr_t *other_member = ast_expr_create_member(other_value, member, NULL_SOURCE);
 
         ast_expr_list_append(&func->statements, ast_expr_create_assignment(EXPR_ASSIGN, NULL_SOURCE, this_member, other_member, false));
     }
@@ -1755,5 +1766,17 @@ void ir_instrs_snapshot_restore(ir_builder_t *builder, ir_instrs_snapshot_t *sna
     builder->current_block->instructions.length = snapshot->current_basicblock_instructions_length;
     builder->basicblocks.length = snapshot->basicblocks_length;
     builder->object->ir_module.funcs.length = snapshot->funcs_length;
+
+    // Functions that were only requested by the abandoned instructions go back to being deferred
+    for(length_t i = snapshot->job_list_length; i < builder->job_list->length; i++){
+        ir_func_endpoint_t job = builder->job_list->jobs[i];
+
+        if(job.ir_func_id < snapshot->funcs_length){
+            ir_func_t *func = &builder->object->ir_module.funcs.funcs[job.ir_func_id];
+            func->traits |= IR_FUNC_DEFERRED;
+            func->deferred_ast_func_id = job.ast_func_id;
+        }
+    }
+
     builder->job_list->length = snapshot->job_list_length;
 }
@@ -10,32 +10,20 @@
 #include "IRGEN/ir_cache.h"
 #include "UTIL/ground.h"
 #include "UTIL/hash.h"
+#include "UTIL/string.h"
+#include "UTIL/util.h"
 
-void ir_gen_sf_cache_init(ir_gen_sf_cache_t *cache, length_t num_buckets){
-    cache->capacity = num_buckets;
-    cache->storage = malloc(sizeof(ir_gen_sf_cache_entry_t) * cache->capacity);
-    memset(cache->storage, 0, sizeof(ir_gen_sf_cache_entry_t) * cache->capacity);
+void ir_gen_sf_cache_init(ir_gen_sf_cache_t *cache, ast_type_intern_table_t *canonical_types){
+    cache->entries = NULL;
+    cache->entries_capacity = 0;
+    cache->canonical_types = canonical_types;
 }
 
 void ir_gen_sf_cache_free(ir_gen_sf_cache_t *cache){
-    for(length_t i = 0; i != cache->capacity; i++){
-        if(!ir_gen_sf_cache_entry_is_occupied(&cache->storage[i])) continue;
-
-        bool is_first = true;
-        ir_gen_sf_cache_entry_t *head = &cache->storage[i];
-
-        while(head){
-            ir_gen_sf_cache_entry_t *previous = head;
-            head = head->next;
-
-            // Assume occupied since first is occupied and rest were allocated
-            ast_type_free(&previous->ast_type);
-            if(!is_first) free(previous);
-            
-            is_first = false;
-        }
+    for(length_t i = 0; i != cache->entries_capacity; i++){
+        free(cache->entries[i]);
     }
-    free(cache->storage);
+    free(cache->entries);
 }
 
 
@@ -53,50 +41,140 @@ errorcode_t ir_gen_sf_cache_read(troolean has, func_pair_t maybe_pair, optional_
 }
 
 ir_gen_sf_cache_entry_t *ir_gen_sf_cache_locate_or_insert(ir_gen_sf_cache_t *cache, ast_type_t *type){
-    hash_t hash = ast_type_hash(type);
-    ir_gen_sf_cache_entry_t *entry = &cache->storage[hash % cache->capacity];
-
-    if(ir_gen_sf_cache_entry_is_occupied(entry)){
-        // Space already occupied, so put it in the linked list
-        // for that space
-
-        while(true){
-            if(ast_types_identical(type, &entry->ast_type)) return entry;
-
-            if(entry->next == NULL){
-                // New entry here
-                entry->next = malloc(sizeof(ir_gen_sf_cache_entry_t));
-                entry = entry->next;
-
-                memset(entry, 0, sizeof(ir_gen_sf_cache_entry_t));
-                entry->ast_type = ast_type_clone(type);
-                entry->has_pass = TROOLEAN_UNKNOWN;
-                entry->has_defer = TROOLEAN_UNKNOWN;
-                entry->has_assign = TROOLEAN_UNKNOWN;
-                return entry;
-            }
-            entry = entry->next;
-        }
+    const ast_canonical_type_t *canonical = ast_type_intern(cache->canonical_types, type);
+
+    if(canonical->id >= cache->entries_capacity){
+        // Canonical ids are dense, so grow to cover every id handed out so far
+        length_t new_capacity = cache->entries_capacity ? cache->entries_capacity : 256;
+        while(new_capacity <= canonical->id) new_capacity *= 2;
+
+        cache->entries = realloc(cache->entries, sizeof(ir_gen_sf_cache_entry_t*) * new_capacity);
+        memset(&cache->entries[cache->entries_capacity], 0, sizeof(ir_gen_sf_cache_entry_t*) * (new_capacity - cache->entries_capacity));
+        cache->entries_capacity = new_capacity;
+    }
+
+    ir_gen_sf_cache_entry_t **entry = &cache->entries[canonical->id];
+
+    if(*entry == NULL){
+        *entry = malloc_init(ir_gen_sf_cache_entry_t, {
+            .canonical = canonical,
+            .has_pass = TROOLEAN_UNKNOWN,
+            .has_defer = TROOLEAN_UNKNOWN,
+            .has_assign = TROOLEAN_UNKNOWN,
+        });
     }
 
-    // New entry here
-    entry->ast_type = ast_type_clone(type);
-    entry->has_pass = TROOLEAN_UNKNOWN;
-    entry->has_defer = TROOLEAN_UNKNOWN;
-    entry->has_assign = TROOLEAN_UNKNOWN;
-    return entry;
+    return *entry;
 }
 
 void ir_gen_sf_cache_dump(FILE *file, ir_gen_sf_cache_t *sf_cache){
-    for(length_t i = 0; i < sf_cache->capacity; i++){
-        ir_gen_sf_cache_entry_t *entry = &sf_cache->storage[i];
-        if(ir_gen_sf_cache_entry_is_occupied(entry)) fprintf(file, "+");
+    for(length_t i = 0; i < sf_cache->entries_capacity; i++){
+        ir_gen_sf_cache_entry_t *entry = sf_cache->entries[i];
+        if(entry == NULL) continue;
+
+        strong_cstr_t typename = ast_type_str(&entry->canonical->type);
+        fprintf(file, "%s\n", typename);
+        free(typename);
+    }
+}
+
+#define IR_GEN_POLY_CACHE_INITIAL_SLOTS 64
+
+void ir_gen_poly_cache_init(ir_gen_poly_cache_t *cache){
+    *cache = (ir_gen_poly_cache_t){
+        .entries = NULL,
+        .length = 0,
+        .capacity = 0,
+        .slots = calloc(IR_GEN_POLY_CACHE_INITIAL_SLOTS, sizeof(length_t)),
+        .slots_capacity = IR_GEN_POLY_CACHE_INITIAL_SLOTS,
+    };
+}
+
+void ir_gen_poly_cache_free(ir_gen_poly_cache_t *cache){
+    for(length_t i = 0; i != cache->length; i++){
+        ir_gen_poly_cache_entry_t *entry = &cache->entries[i];
+        free(entry->name);
+        ast_types_free_fully(entry->generics, entry->generics_length);
+    }
+
+    free(cache->entries);
+    free(cache->slots);
+}
+
+static hash_t ir_gen_poly_cache_hash(weak_cstr_t name, ast_type_t *generics, length_t generics_length){
+    return hash_combine(hash_string(name), ast_types_hash(generics, generics_length));
+}
+
+static bool ir_gen_poly_cache_entry_matches(ir_gen_poly_cache_entry_t *entry, weak_cstr_t name, ast_type_t *generics, length_t generics_length, hash_t hash){
+    if(entry->hash != hash || entry->generics_length != generics_length || !streq(entry->name, name)) return false;
 
-        while(entry->next){
-            fprintf(file, "+");
-            entry = entry->next;
+    for(length_t i = 0; i != generics_length; i++){
+        if(!ast_types_identical(&entry->generics[i], &generics[i])) return false;
+    }
+
+    return true;
+}
+
+// Returns the slot that either contains the instance, or is where it should be inserted
+static length_t ir_gen_poly_cache_probe(ir_gen_poly_cache_t *cache, weak_cstr_t name, ast_type_t *generics, length_t generics_length, hash_t hash){
+    length_t slot = hash & (cache->slots_capacity - 1);
+
+    while(cache->slots[slot] != 0){
+        if(ir_gen_poly_cache_entry_matches(&cache->entries[cache->slots[slot] - 1], name, generics, generics_length, hash)) break;
+        slot = (slot + 1) & (cache->slots_capacity - 1);
+    }
+
+    return slot;
+}
+
+static void ir_gen_poly_cache_grow_slots(ir_gen_poly_cache_t *cache){
+    length_t new_capacity = cache->slots_capacity * 2;
+    length_t *new_slots = calloc(new_capacity, sizeof(length_t));
+
+    for(length_t i = 0; i != cache->length; i++){
+        length_t slot = cache->entries[i].hash & (new_capacity - 1);
+
+        while(new_slots[slot] != 0){
+            slot = (slot + 1) & (new_capacity - 1);
         }
 
-        fprintf(file, "\n");
+        new_slots[slot] = i + 1;
+    }
+
+    free(cache->slots);
+    cache->slots = new_slots;
+    cache->slots_capacity = new_capacity;
+}
+
+ir_type_t *ir_gen_poly_cache_find(ir_gen_poly_cache_t *cache, weak_cstr_t name, ast_type_t *generics, length_t generics_length){
+    hash_t hash = ir_gen_poly_cache_hash(name, generics, generics_length);
+    length_t slot = ir_gen_poly_cache_probe(cache, name, generics, generics_length, hash);
+    return cache->slots[slot] != 0 ? cache->entries[cache->slots[slot] - 1].ir_type : NULL;
+}
+
+void ir_gen_poly_cache_insert(ir_gen_poly_cache_t *cache, weak_cstr_t name, ast_type_t *generics, length_t generics_length, ir_type_t *ir_type){
+    hash_t hash = ir_gen_poly_cache_hash(name, generics, generics_length);
+    length_t slot = ir_gen_poly_cache_probe(cache, name, generics, generics_length, hash);
+
+    if(cache->slots[slot] != 0){
+        // Instance was already cached (possibly by a nested resolution)
+        cache->entries[cache->slots[slot] - 1].ir_type = ir_type;
+        return;
+    }
+
+    expand((void**) &cache->entries, sizeof(ir_gen_poly_cache_entry_t), cache->length, &cache->capacity, 1, 16);
+    cache->entries[cache->length++] = (ir_gen_poly_cache_entry_t){
+        .name = strclone(name),
+        .generics = ast_types_clone(generics, generics_length),
+        .generics_length = generics_length,
+        .hash = hash,
+        .ir_type = ir_type,
+    };
+
+    cache->slots[slot] = cache->length;
+
+    // Keep load factor at or below 1/2
+    if(cache->length * 2 > cache->slots_capacity){
+        ir_gen_poly_cache_grow_slots(cache);
     }
 }
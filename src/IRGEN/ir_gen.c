@@ -84,7 +84,7 @@ errorcode_t ir_gen_vtables(compiler_t *compiler, object_t *object){
 
             if(func->traits & AST_FUNC_VIRTUAL && endpoint.ir_func_id != INVALID_FUNC_ID){
                 ast_type_t subject_type = ast_type_unwrapped_view(&func->arg_types[0]);
-                vtree_t *vtree = vtree_list_find_or_append(&vtree_list, &subject_type, 0);
+                vtree_t *vtree = vtree_list_find_or_append(&vtree_list, &module->canonical_types, &subject_type, 0);
                 vtree_append_virtual(vtree, endpoint);
             }
         }
@@ -96,12 +96,12 @@ errorcode_t ir_gen_vtables(compiler_t *compiler, object_t *object){
 
         if(func->traits & AST_FUNC_CLASS_CONSTRUCTOR && !(func->traits & AST_FUNC_POLYMORPHIC)){
             ast_type_t subject_type = ast_type_unwrapped_view(&func->arg_types[0]);
-            vtree_list_find_or_append(&vtree_list, &subject_type, 0);
+            vtree_list_find_or_append(&vtree_list, &module->canonical_types, &subject_type, 0);
         }
     }
 
     // Link up parents and children
-    if(ir_gen_vtree_link_up_nodes(compiler, ast, &vtree_list, 0)) goto failure;
+    if(ir_gen_vtree_link_up_nodes(compiler, ast, &module->canonical_types, &vtree_list, 0)) goto failure;
 
     // Search for overrides for descendent classes
     for(length_t i = 0; i != vtree_list.length; i++){
@@ -144,7 +144,7 @@ errorcode_t ir_gen_vtables(compiler_t *compiler, object_t *object){
                 ast_type_t subject_type = ast_type_unwrapped_view(&func->arg_types[0]);
 
                 virtual_addition_t addition = (virtual_addition_t){
-                    .vtree = vtree_list_find_or_append(&vtree_list, &subject_type, func->instantiation_depth),
+                    .vtree = vtree_list_find_or_append(&vtree_list, &module->canonical_types, &subject_type, func->instantiation_depth),
                     .endpoint = endpoint,
                 };
 
@@ -158,12 +158,12 @@ errorcode_t ir_gen_vtables(compiler_t *compiler, object_t *object){
 
             if(func->traits & AST_FUNC_CLASS_CONSTRUCTOR && !(func->traits & AST_FUNC_POLYMORPHIC)){
                 ast_type_t subject_type = ast_type_unwrapped_view(&func->arg_types[0]);
-                vtree_list_find_or_append(&vtree_list, &subject_type, func->instantiation_depth);
+                vtree_list_find_or_append(&vtree_list, &module->canonical_types, &subject_type, func->instantiation_depth);
             }
         }
 
         // Link up any newly created vtrees
-        if(ir_gen_vtree_link_up_nodes(compiler, ast, &vtree_list, start_vtree_i)) goto failure;
+        if(ir_gen_vtree_link_up_nodes(compiler, ast, &module->canonical_types, &vtree_list, start_vtree_i)) goto failure;
 
         // Waterfall new virtuals and search for their overrides
         for(length_t i = 0; i < additions.length; i++){
@@ -209,7 +209,7 @@ errorcode_t ir_gen_vtables(compiler_t *compiler, object_t *object){
     for(length_t i = 0; i < module->vtable_init_list.length; i++){
         ir_vtable_init_t *vtable_init = &module->vtable_init_list.initializations[i];
 
-        vtree_t *vtree = vtree_list_find(&vtree_list, &vtable_init->subject_type);
+        vtree_t *vtree = vtree_list_find(&vtree_list, &module->canonical_types, &vtable_init->subject_type);
 
         if(vtree == NULL){
             strong_cstr_t typename = ast_type_str(&vtable_init->subject_type);
@@ -408,7 +408,7 @@ errorcode_t ir_gen_func_head(compiler_t *compiler, object_t *object, ast_func_t
 
     if(compiler->checks & COMPILER_NULL_CHECKS){
         int line, column;
-        lex_get_location(compiler->objects[ast_func->source.object_index]->buffer, ast_func->source.index, &line, &column);
+        lex_get_object_location(compiler->objects[ast_func->source.object_index], ast_func->source.index, &line, &column);
         module_func->maybe_line_number = line;
         module_func->maybe_column_number = column;
     }
@@ -439,7 +439,19 @@ errorcode_t ir_gen_func_head(compiler_t *compiler, object_t *object, ast_func_t
         .ir_func_id = ir_func_id,
     };
     
-    ir_module_create_func_mapping(module, ast_func->name, new_endpoint, true);
+    // When only generating reachable functions, immediately queue the bodies of functions
+    // which can be reached without a visible call (entry points, exports, and vtable entries),
+    // and defer the rest until a call or function address requests them
+    bool defer_body = compiler->traits & COMPILER_DEMAND_IR
+        && !(ast_func->traits & (AST_FUNC_FOREIGN | AST_FUNC_MAIN | AST_FUNC_INIT | AST_FUNC_DEINIT | AST_FUNC_VIRTUAL | AST_FUNC_OVERRIDE))
+        && ast_func->export_as == NULL;
+
+    if(defer_body){
+        module_func->traits |= IR_FUNC_DEFERRED;
+        module_func->deferred_ast_func_id = ast_func_id;
+    }
+
+    ir_module_create_func_mapping(module, ast_func->name, new_endpoint, !defer_body);
 
     if(optional_out_new_endpoint){
         *optional_out_new_endpoint = new_endpoint;
@@ -656,7 +668,7 @@ errorcode_t ir_gen_functions_body_statements(compiler_t *compiler, object_t *obj
         ast_type_t subject_type = ast_type_dereferenced_view(&ast_func.arg_types[0]);
         
         // Find 'this' argument
-        bridge_var_t *bridge_var = bridge_scope_find_var(builder.scope, "this");
+        bridge_var_t *bridge_var = ir_builder_find_variable(&builder, "this");
         assert(bridge_var);
 
         // Get value of 'this'
@@ -687,7 +699,7 @@ errorcode_t ir_gen_functions_body_statements(compiler_t *compiler, object_t *obj
 
     if(ast_func.traits & AST_FUNC_DISPATCHER){
         // Find 'this' argument
-        bridge_var_t *bridge_var = bridge_scope_find_var(builder.scope, "this");
+        bridge_var_t *bridge_var = ir_builder_find_variable(&builder, "this");
         assert(bridge_var);
 
         // Get value of 'this'
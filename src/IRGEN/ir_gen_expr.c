@@ -399,7 +399,7 @@ errorcode_t ir_gen_expr_cstr(ir_builder_t *builder, ast_expr_cstr_t *expr, ir_va
 
 errorcode_t ir_gen_expr_variable(ir_builder_t *builder, ast_expr_variable_t *expr, ir_value_t **ir_value, bool leave_mutable, ast_type_t *out_expr_type){
     char *variable_name = expr->name;
-    bridge_var_t *variable = bridge_scope_find_var(builder->scope, variable_name);
+    bridge_var_t *variable = ir_builder_find_variable(builder, variable_name);
 
     // Found variable in nearby scope
     if(variable){
@@ -472,7 +472,7 @@ errorcode_t ir_gen_expr_call(ir_builder_t *builder, ast_expr_call_t *expr, ir_va
     ir_type_t *tmp_ir_variable_type;
 
     // Check for variable of name in nearby scope
-    bridge_var_t *var = bridge_scope_find_var(builder->scope, expr->name);
+    bridge_var_t *var = ir_builder_find_variable(builder, expr->name);
     bool is_var_function_like = var && ast_type_is_func(var->ast_type);
 
     // Found variable of name in nearby scope
@@ -717,7 +717,7 @@ errorcode_t ir_gen_expr_super(ir_builder_t *builder, ast_expr_super_t *expr, ir_
     // super(a, b, c, d)  ->  (this as Super).__constructor__(a, b, c); this.__vtable__ = <__vtable__>
 
     // Find 'this' argument
-    bridge_var_t *bridge_var = bridge_scope_find_var(builder->scope, "this");
+    bridge_var_t *bridge_var = ir_builder_find_variable(builder, "this");
     assert(bridge_var);
 
     ast_type_t subject_type = ast_type_dereferenced_view(bridge_var->ast_type);
@@ -1429,6 +1429,7 @@ errorcode_t ir_gen_expr_func_addr(ir_builder_t *builder, ast_expr_func_addr_t *e
         *ir_value = build_func_addr_by_name(builder->pool, ir_funcptr_type, expr->name);
     } else {
         *ir_value = build_func_addr(builder->pool, ir_funcptr_type, pair.ir_func_id);
+        ir_module_request_func(&builder->object->ir_module, pair.ir_func_id);
     }
 
     // Write resulting type if requested
@@ -2540,7 +2541,7 @@ errorcode_t ir_gen_expr_inline_declare(ir_builder_t *builder, ast_expr_inline_de
     bool is_assign_pod = def->traits & AST_EXPR_DECLARATION_ASSIGN_POD;
 
     // Ensure no variable with the same name already exists in this scope
-    if(bridge_scope_var_already_in_list(builder->scope, def->name)){
+    if(ir_builder_variable_already_declared(builder, def->name)){
         compiler_panicf(builder->compiler, def->source, "Variable '%s' already declared", def->name);
         return FAILURE;
     }
@@ -313,11 +313,9 @@ static errorcode_t ir_gen_find_proc_sweep_proc_map(
     optional_func_pair_t *result,
     unsigned int conform_mode_if_applicable,
     ir_proc_map_t *proc_map,
-    void *key,
-    length_t sizeof_key,
-    int (*compare)(const void*, const void*)
+    void *key
 ){
-    ir_func_endpoint_list_t *endpoint_list = ir_proc_map_find(proc_map, key, sizeof_key, compare);
+    ir_func_endpoint_list_t *endpoint_list = ir_proc_map_find(proc_map, key);
     
     return ir_gen_find_proc_sweep_endpoint_list(query, result, conform_mode_if_applicable, endpoint_list);
 }
@@ -338,9 +336,7 @@ static errorcode_t ir_gen_find_proc_sweep(ir_proc_query_t *query, optional_func_
             &(ir_method_key_t){
                 .method_name = query->proc_name,
                 .struct_name = query->struct_name,
-            },
-            sizeof(ir_method_key_t),
-            &compare_ir_method_key
+            }
         );
 
         if(res != FAILURE) return res;
@@ -361,9 +357,7 @@ static errorcode_t ir_gen_find_proc_sweep(ir_proc_query_t *query, optional_func_
         &ir_module->func_map,
         &(ir_func_key_t){
             .name = query->proc_name
-        },
-        sizeof(ir_func_key_t),
-        &compare_ir_func_key
+        }
     );
 
     if(res != FAILURE) return res;
@@ -400,9 +394,7 @@ errorcode_t ir_gen_find_func_named(object_t *object, weak_cstr_t name, bool *out
     // Find list of function endpoints for the given name
     ir_func_endpoint_list_t *endpoint_list = ir_proc_map_find(
         &object->ir_module.func_map,
-        &(ir_func_key_t){ .name = name },
-        sizeof(ir_func_key_t),
-        &compare_ir_func_key
+        &(ir_func_key_t){ .name = name }
     );
 
     if(endpoint_list == NULL) return FAILURE;
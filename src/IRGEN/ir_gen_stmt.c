@@ -8,6 +8,7 @@
 #include "AST/TYPE/ast_type_make.h"
 #include "AST/ast.h"
 #include "AST/ast_expr.h"
+#include "AST/ast_pool.h"
 #include "AST/ast_type.h"
 #include "BRIDGE/bridge.h"
 #include "DRVR/compiler.h"
@@ -707,7 +708,7 @@ errorcode_t ir_gen_stmt_call_like(ir_builder_t *builder, ast_expr_t *call_like_s
 
 errorcode_t ir_gen_stmt_declare(ir_builder_t *builder, ast_expr_declare_t *stmt){
     // Don't allow multiple variables with the same name in the same scope
-    if(bridge_scope_var_already_in_list(builder->scope, stmt->name)){
+    if(ir_builder_variable_already_declared(builder, stmt->name)){
         compiler_panicf(builder->compiler, stmt->source, "Variable '%s' already declared", stmt->name);
         return FAILURE;
     }
@@ -1576,7 +1577,7 @@ errorcode_t ir_gen_stmt_each(ir_builder_t *builder, ast_expr_each_in_t *stmt){
 
     if(single_expr){
         ast_type_free(&single_expr->type);
-        free(single_expr);
+        ast_release(single_expr);
     }
 
     if(stmt->label != NULL) ir_builder_pop_loop_label(builder);
@@ -1589,7 +1590,7 @@ errorcode_t ir_gen_stmt_each(ir_builder_t *builder, ast_expr_each_in_t *stmt){
 failure:
     if(single_expr){
         ast_type_free(&single_expr->type);
-        free(single_expr);
+        ast_release(single_expr);
     }
 
     return FAILURE;
@@ -1720,7 +1721,7 @@ errorcode_t ir_gen_stmt_assert(ir_builder_t *builder, ast_expr_assert_t *stmt){
     }
     
     int line, column;
-    lex_get_location(src_object->buffer, stmt->source.index, &line, &column);
+    lex_get_object_location(src_object, stmt->source.index, &line, &column);
 
     length_t num_args = 6;
     ast_expr_t **args = malloc(sizeof *args * num_args);
@@ -23,6 +23,7 @@
 #include "IRGEN/ir_build_instr.h"
 #include "IRGEN/ir_build_literal.h"
 #include "IRGEN/ir_builder.h"
+#include "IRGEN/ir_cache.h"
 #include "IRGEN/ir_gen_expr.h"
 #include "IRGEN/ir_gen_polymorphable.h"
 #include "IRGEN/ir_gen_type.h"
@@ -31,6 +32,10 @@
 #include "UTIL/ground.h"
 #include "UTIL/trait.h"
 
+// Variants that allocate from a specific pool instead of 'object->ir_module.pool'
+static errorcode_t ir_gen_resolve_type_in_pool(compiler_t *compiler, object_t *object, ir_pool_t *pool, const ast_type_t *unresolved_type, ir_type_t **resolved_type);
+static ir_type_t *ast_layout_bone_to_ir_type_in_pool(compiler_t *compiler, object_t *object, ir_pool_t *pool, ast_layout_bone_t *bone, ast_poly_catalog_t *optional_catalog);
+
 ir_type_map_t ir_type_map_create(ast_t *ast, ir_module_t *module){
     ir_pool_t *pool = &module->pool;
 
@@ -158,10 +163,14 @@ errorcode_t ir_gen_type_mappings(compiler_t *compiler, object_t *object){
 }
 
 errorcode_t ir_gen_resolve_type(compiler_t *compiler, object_t *object, const ast_type_t *unresolved_type, ir_type_t **resolved_type){
+    return ir_gen_resolve_type_in_pool(compiler, object, &object->ir_module.pool, unresolved_type, resolved_type);
+}
+
+static errorcode_t ir_gen_resolve_type_in_pool(compiler_t *compiler, object_t *object, ir_pool_t *pool, const ast_type_t *unresolved_type, ir_type_t **resolved_type){
     // NOTE: Stores resolved type into 'resolved_type'
     // NOTE: If this function fails, 'resolved_type' is not guaranteed to be the same.
     //       However, no memory will have to be manually freed after this call since
-    //       everything that is allocated is allocated inside the memory pool 'object->ir_module->pool'
+    //       everything that is allocated is allocated inside the memory pool 'pool'
     // NOTE: Therefore, don't call this function if you expect it to fail, because it will pollute the pool
     //       will inactive and unused memory.
     // TODO: Add ability to handle cases with dynamic arrays etc.
@@ -203,11 +212,19 @@ errorcode_t ir_gen_resolve_type(compiler_t *compiler, object_t *object, const as
         }
         break;
     case AST_ELEM_FUNC:
-        *resolved_type = ir_type_make_pointer_to(&ir_module->pool, ir_module->common.ir_ubyte, false);
+        *resolved_type = ir_type_make_pointer_to(pool, ir_module->common.ir_ubyte, false);
         break;
     case AST_ELEM_GENERIC_BASE: {
             ast_elem_generic_base_t *generic_base = (ast_elem_generic_base_t*) unresolved_type->elements[non_concrete_layers];
 
+            // Reuse the IR type if this instance has already been built
+            ir_type_t *cached_type = ir_gen_poly_cache_find(&ir_module->poly_cache, generic_base->name, generic_base->generics, generic_base->generics_length);
+
+            if(cached_type){
+                *resolved_type = cached_type;
+                break;
+            }
+
             // Find polymorphic structure
             ast_poly_composite_t *template = ast_poly_composite_find_exact_from_elem(&object->ast, generic_base);
 
@@ -229,13 +246,16 @@ errorcode_t ir_gen_resolve_type(compiler_t *compiler, object_t *object, const as
             ast_poly_catalog_init(&catalog);
             ast_poly_catalog_add_types(&catalog, template->generics, generic_base->generics, template->generics_length);
 
+            // Build the instance in memory that outlives any pool snapshots,
+            // since it will be remembered by the cache
             ast_layout_bone_t layout_as_bone = ast_layout_as_bone(&template->layout);
-            ir_type_t *created_type = ast_layout_bone_to_ir_type(compiler, object, &layout_as_bone, &catalog);
+            ir_type_t *created_type = ast_layout_bone_to_ir_type_in_pool(compiler, object, &ir_module->type_pool, &layout_as_bone, &catalog);
             if(created_type == NULL){
                 ast_poly_catalog_free(&catalog);
                 return FAILURE;
             }
 
+            ir_gen_poly_cache_insert(&ir_module->poly_cache, generic_base->name, generic_base->generics, generic_base->generics_length, created_type);
             *resolved_type = created_type;
             ast_poly_catalog_free(&catalog);
         }
@@ -250,7 +270,7 @@ errorcode_t ir_gen_resolve_type(compiler_t *compiler, object_t *object, const as
             ast_elem_layout_t *layout_elem = (ast_elem_layout_t*) unresolved_type->elements[non_concrete_layers];
             ast_layout_bone_t as_bone = ast_layout_as_bone(&layout_elem->layout);
             
-            *resolved_type = ast_layout_bone_to_ir_type(compiler, object, &as_bone, NULL);
+            *resolved_type = ast_layout_bone_to_ir_type_in_pool(compiler, object, pool, &as_bone, NULL);
             if(*resolved_type == NULL) return FAILURE;
         }
         break;
@@ -290,17 +310,17 @@ errorcode_t ir_gen_resolve_type(compiler_t *compiler, object_t *object, const as
     }
 
     for(length_t i = non_concrete_layers; i != 0; i--){
-        ir_type_t *wrapped_type = ir_pool_alloc(&ir_module->pool, sizeof(ir_type_t));
+        ir_type_t *wrapped_type = ir_pool_alloc(pool, sizeof(ir_type_t));
         unsigned int non_concrete_element_id = unresolved_type->elements[i - 1]->id;
 
         if(non_concrete_element_id == AST_ELEM_POINTER){
-            ir_type_extra_pointer_t *pointer = ir_pool_alloc(&ir_module->pool, sizeof(ir_type_extra_pointer_t));
+            ir_type_extra_pointer_t *pointer = ir_pool_alloc(pool, sizeof(ir_type_extra_pointer_t));
             wrapped_type->kind = TYPE_KIND_POINTER;
             wrapped_type->extra = pointer;
             pointer->inner = *resolved_type;
             pointer->is_volatile = ((ast_elem_pointer_t*) unresolved_type->elements[i - 1])->is_volatile;
         } else if(non_concrete_element_id == AST_ELEM_FIXED_ARRAY){
-            ir_type_extra_fixed_array_t *fixed_array = ir_pool_alloc(&ir_module->pool, sizeof(ir_type_extra_fixed_array_t));
+            ir_type_extra_fixed_array_t *fixed_array = ir_pool_alloc(pool, sizeof(ir_type_extra_fixed_array_t));
             fixed_array->subtype = *resolved_type;
             fixed_array->length = ((ast_elem_fixed_array_t*) unresolved_type->elements[i - 1])->length;
             wrapped_type->kind = TYPE_KIND_FIXED_ARRAY;
@@ -802,6 +822,10 @@ successful_t ast_types_merge(ir_builder_t *builder, ir_value_t **ir_value_a, ir_
 }
 
 ir_type_t *ast_layout_bone_to_ir_type(compiler_t *compiler, object_t *object, ast_layout_bone_t *bone, ast_poly_catalog_t *optional_catalog){
+    return ast_layout_bone_to_ir_type_in_pool(compiler, object, &object->ir_module.pool, bone, optional_catalog);
+}
+
+static ir_type_t *ast_layout_bone_to_ir_type_in_pool(compiler_t *compiler, object_t *object, ir_pool_t *pool, ast_layout_bone_t *bone, ast_poly_catalog_t *optional_catalog){
     // Returns NULL when something goes wrong
 
     // Handle AST Type bones
@@ -823,13 +847,13 @@ ir_type_t *ast_layout_bone_to_ir_type(compiler_t *compiler, object_t *object, as
                 return NULL;
             }
 
-            if(ir_gen_resolve_type(compiler, object, &resolved_ast_type, &result)){
+            if(ir_gen_resolve_type_in_pool(compiler, object, pool, &resolved_ast_type, &result)){
                 ast_type_free(&resolved_ast_type);
                 return NULL;
             }
 
             ast_type_free(&resolved_ast_type);
-        } else if(ir_gen_resolve_type(compiler, object, &bone->type, &result)){
+        } else if(ir_gen_resolve_type_in_pool(compiler, object, pool, &bone->type, &result)){
             return NULL;
         }
 
@@ -837,7 +861,6 @@ ir_type_t *ast_layout_bone_to_ir_type(compiler_t *compiler, object_t *object, as
     }
 
     // Handle bones that have children
-    ir_pool_t *pool = &object->ir_module.pool;
     ir_type_t *result = ir_pool_alloc(pool, sizeof(ir_type_t));
     ir_type_extra_composite_t *extra = ir_pool_alloc(pool, sizeof(ir_type_extra_composite_t));
     extra->subtypes = ir_pool_alloc(pool, sizeof(ir_type_t*) * bone->children.bones_length);
@@ -845,7 +868,7 @@ ir_type_t *ast_layout_bone_to_ir_type(compiler_t *compiler, object_t *object, as
     extra->traits = bone->traits & AST_LAYOUT_BONE_PACKED;
 
     for(length_t i = 0; i != bone->children.bones_length; i++){
-        ir_type_t *subtype = ast_layout_bone_to_ir_type(compiler, object, &bone->children.bones[i], optional_catalog);
+        ir_type_t *subtype = ast_layout_bone_to_ir_type_in_pool(compiler, object, pool, &bone->children.bones[i], optional_catalog);
         if(subtype == NULL) return NULL;
         extra->subtypes[i] = subtype;
     }
@@ -197,6 +197,7 @@ failure:
 errorcode_t ir_gen_vtree_link_up_nodes(
     compiler_t *compiler,
     ast_t *ast,
+    ast_type_intern_table_t *canonical_types,
     vtree_list_t *vtree_list,
     length_t start_i
 ){
@@ -228,7 +229,7 @@ errorcode_t ir_gen_vtree_link_up_nodes(
             return FAILURE;
         }
 
-        vtree_t *parent_vtree = vtree_list_find_or_append(vtree_list, &parent, vtree->instantiation_depth);
+        vtree_t *parent_vtree = vtree_list_find_or_append(vtree_list, canonical_types, &parent, vtree->instantiation_depth);
 
         if(parent_vtree == NULL){
             strong_cstr_t typename = ast_type_str(&vtree->signature);
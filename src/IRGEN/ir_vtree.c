@@ -2,7 +2,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-#include "AST/TYPE/ast_type_identical.h"
+#include "AST/TYPE/ast_type_intern.h"
 #include "AST/ast_type.h"
 #include "IR/ir_func_endpoint.h"
 #include "IRGEN/ir_vtree.h"
@@ -15,17 +15,23 @@ void vtree_list_free(vtree_list_t *vtree_list){
     free(vtree_list->vtrees);
 }
 
-vtree_t *vtree_list_find_or_append(vtree_list_t *vtree_list, const ast_type_t *signature, length_t instantiation_depth){
+vtree_t *vtree_list_find_or_append(vtree_list_t *vtree_list, ast_type_intern_table_t *canonical_types, const ast_type_t *signature, length_t instantiation_depth){
+    const ast_canonical_type_t *canonical = ast_type_intern(canonical_types, signature);
+
     for(length_t i = 0; i != vtree_list->length; i++){
-        if(ast_types_identical(&vtree_list->vtrees[i]->signature, signature)){
+        if(vtree_list->vtrees[i]->canonical == canonical){
             return vtree_list->vtrees[i];
         }
     }
 
     vtree_t *new_vtree = malloc(sizeof(vtree_t));
+
+    ast_type_t signature_view = canonical->type;
+    signature_view.source = signature->source;
     
     *new_vtree = (vtree_t){
-        .signature = ast_type_clone(signature),
+        .canonical = canonical,
+        .signature = signature_view,
         .parent = NULL,
         .virtuals = (ir_func_endpoint_list_t){0},
         .table = (ir_func_endpoint_list_t){0},
@@ -38,9 +44,12 @@ vtree_t *vtree_list_find_or_append(vtree_list_t *vtree_list, const ast_type_t *s
     return new_vtree;
 }
 
-vtree_t *vtree_list_find(vtree_list_t *vtree_list, const ast_type_t *signature){
+vtree_t *vtree_list_find(vtree_list_t *vtree_list, ast_type_intern_table_t *canonical_types, const ast_type_t *signature){
+    const ast_canonical_type_t *canonical = ast_type_intern_find(canonical_types, signature);
+    if(canonical == NULL) return NULL;
+
     for(length_t i = 0; i != vtree_list->length; i++){
-        if(ast_types_identical(&vtree_list->vtrees[i]->signature, signature)){
+        if(vtree_list->vtrees[i]->canonical == canonical){
             return vtree_list->vtrees[i];
         }
     }
@@ -51,7 +60,6 @@ void vtree_free_fully(vtree_t *vtree){
     // Free array of children
     free(vtree->children.vtrees);
 
-    ast_type_free(&vtree->signature);
     ir_func_endpoint_list_free(&vtree->virtuals);
     ir_func_endpoint_list_free(&vtree->table);
     free(vtree);
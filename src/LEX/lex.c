@@ -1,19 +1,22 @@
 
 #include <ctype.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "DRVR/compiler.h"
 #include "DRVR/object.h"
 #include "LEX/lex.h"
+#include "LEX/lex_scan.h"
 #include "LEX/token.h"
+#include "LEX/token_cache.h"
 #include "TOKEN/token_data.h"
 #include "UTIL/color.h"
 #include "UTIL/datatypes.h"
 #include "UTIL/filename.h"
 #include "UTIL/ground.h"
-#include "UTIL/search.h"
+#include "UTIL/intern.h"
 #include "UTIL/string.h"
 #include "UTIL/util.h"
 
@@ -27,6 +30,9 @@
     - Ability to read two characters ahead w/o checking buffer size - e.g. memcmp(ctx->buffer[ctx->i + 1], "ab", 2) assuming ctx->i is valid and non-newline
     - Ability to skip until a newline w/o checking buffer size - e.g. while(ctx->buffer[ctx->i] != '\n') ctx->i++; assuming ctx->i is valid and non-newline
     - Automatic TOKEN_NEWLINE as last token
+
+    Runs of whitespace, comments, string bodies, and identifiers are skipped
+    over using the vectorized scanning functions from 'LEX/lex_scan.h'
 */
 
 typedef struct {
@@ -49,6 +55,10 @@ static inline void add_token(tokenlist_t *tokenlist, token_t token, source_t sou
     tokenlist->sources[tokenlist->length++] = source;
 }
 
+static inline source_t lex_source(lex_ctx_t *ctx, length_t index, length_t stride){
+    return tokenlist_source(&ctx->tokenlist, index, stride, ctx->object_index);
+}
+
 static inline token_t character_to_token(char c){
     tokenid_t id;
 
@@ -70,20 +80,20 @@ static inline token_t character_to_token(char c){
 }
 
 static inline void add_simple_token(lex_ctx_t *ctx){
-    add_token(&ctx->tokenlist, character_to_token(ctx->buffer[ctx->i]), (source_t){ctx->i, 1, ctx->object_index});
+    add_token(&ctx->tokenlist, character_to_token(ctx->buffer[ctx->i]), lex_source(ctx, ctx->i, 1));
     ctx->i += 1;
 }
 
 static inline void cases(lex_ctx_t *ctx, char cases[], tokenid_t tokenids[], length_t count, tokenid_t tokenid_default){
     for(length_t i = 0; i != count; i++){
         if(ctx->buffer[ctx->i + 1] == cases[i]){
-            add_token(&ctx->tokenlist, (token_t){tokenids[i], NULL}, (source_t){ctx->i, 2, ctx->object_index});
+            add_token(&ctx->tokenlist, (token_t){tokenids[i], NULL}, lex_source(ctx, ctx->i, 2));
             ctx->i += 2;
             return;
         }
     }
 
-    add_token(&ctx->tokenlist, (token_t){tokenid_default, NULL}, (source_t){ctx->i, 1, ctx->object_index});
+    add_token(&ctx->tokenlist, (token_t){tokenid_default, NULL}, lex_source(ctx, ctx->i, 1));
     ctx->i += 1;
 }
 
@@ -94,7 +104,7 @@ static inline void options(lex_ctx_t *ctx, char **options, tokenid_t *cases, len
         length_t len = strlen(options[i]);
 
         if(memcmp(&ctx->buffer[ctx->i], options[i], len) == 0){
-            add_token(&ctx->tokenlist, (token_t){cases[i], NULL}, (source_t){ctx->i, len, ctx->object_index});
+            add_token(&ctx->tokenlist, (token_t){cases[i], NULL}, lex_source(ctx, ctx->i, len));
             ctx->i += len;
             return;
         }
@@ -108,7 +118,7 @@ static inline void stacking(lex_ctx_t *ctx, char character, tokenid_t *cases, le
         stride += 1;
     }
 
-    add_token(&ctx->tokenlist, (token_t){cases[stride - 1], NULL}, (source_t){ctx->i, stride, ctx->object_index});
+    add_token(&ctx->tokenlist, (token_t){cases[stride - 1], NULL}, lex_source(ctx, ctx->i, stride));
     ctx->i += stride;
 }
 
@@ -116,66 +126,64 @@ static inline const char *escapable_until_or_null(const char *beginning, const c
     const char *end = beginning;
 
     while(end < eof){
-        if(*end == terminator){
+        end = lex_scan_either(end, eof, terminator, escape_prefix);
+
+        if(end == eof){
+            return NULL;
+        } else if(*end == terminator){
             return end;
-        } else if(*end == escape_prefix){
-            end += 2;
         } else {
-            end += 1;
+            end += 2;
         }
     }
 
     return NULL;
 }
 
-static inline void error_unterminated_string(lex_ctx_t *ctx, compiler_t *compiler){
-    source_t source = {
-        .index = ctx->i,
-        .stride = 1,
-        .object_index = ctx->object_index,
-    };
+static inline void error_unterminated_string(lex_ctx_t *ctx, compiler_t *optional_error_compiler){
+    if(optional_error_compiler == NULL) return;
 
-    compiler_panicf(compiler, source, "Unterminated string literal");
+    source_t source = lex_source(ctx, ctx->i, 1);
+
+    compiler_panicf(optional_error_compiler, source, "Unterminated string literal");
 }
 
-static inline void error_unknown_escape_sequence(lex_ctx_t *ctx, compiler_t *compiler, string_unescape_error_t *error){
+static inline void error_unknown_escape_sequence(lex_ctx_t *ctx, compiler_t *optional_error_compiler, string_unescape_error_t *error){
+    if(optional_error_compiler == NULL) return;
+
     length_t position = ctx->i + 1 + error->relative_position;
     const char invalid_escape_char = ctx->buffer[position + 1];
 
-    source_t source = {
-        .index = position,
-        .stride = 2,
-        .object_index = ctx->object_index,
-    };
+    source_t source = lex_source(ctx, position, 2);
 
-    compiler_panicf(compiler, source, "Unknown escape sequence '\\%c\'", invalid_escape_char);
+    compiler_panicf(optional_error_compiler, source, "Unknown escape sequence '\\%c\'", invalid_escape_char);
 }
 
-static inline maybe_null_strong_cstr_t string_unescape_or_fail(lex_ctx_t *ctx, compiler_t *compiler, const char *beginning, length_t size, length_t *out_length){
+static inline maybe_null_strong_cstr_t string_unescape_or_fail(lex_ctx_t *ctx, compiler_t *optional_error_compiler, const char *beginning, length_t size, length_t *out_length){
     string_unescape_error_t error_cause;
     maybe_null_strong_cstr_t string = string_to_unescaped_string(beginning, size, out_length, &error_cause);
 
     if(string == NULL){
-        error_unknown_escape_sequence(ctx, compiler, &error_cause);
+        error_unknown_escape_sequence(ctx, optional_error_compiler, &error_cause);
     }
 
     return string;
 }
 
-static inline errorcode_t string(lex_ctx_t *ctx, compiler_t *compiler){
+static inline errorcode_t string(lex_ctx_t *ctx, compiler_t *optional_error_compiler){
     const char *beginning = &ctx->buffer[ctx->i + 1];
     const char *eof = &ctx->buffer[ctx->buffer_length];
     const char *end = escapable_until_or_null(beginning, eof, '"', '\\');
 
     if(end == NULL){
-        error_unterminated_string(ctx, compiler);
+        error_unterminated_string(ctx, optional_error_compiler);
         return FAILURE;
     }
 
     length_t size = end - beginning;
     length_t length;
 
-    maybe_null_strong_cstr_t string = string_unescape_or_fail(ctx, compiler, beginning, size, &length);
+    maybe_null_strong_cstr_t string = string_unescape_or_fail(ctx, optional_error_compiler, beginning, size, &length);
     if(string == NULL) return FAILURE;
 
     add_token(
@@ -187,31 +195,27 @@ static inline errorcode_t string(lex_ctx_t *ctx, compiler_t *compiler){
                 .length = length,
             })
         },
-        (source_t){
-            .index = ctx->i,
-            .stride = size + 2,
-            .object_index = ctx->object_index
-        }
+        lex_source(ctx, ctx->i, size + 2)
     );
 
     ctx->i += size + 2;
     return SUCCESS;
 }
 
-static inline errorcode_t cstring(lex_ctx_t *ctx, compiler_t *compiler){
+static inline errorcode_t cstring(lex_ctx_t *ctx, compiler_t *optional_error_compiler){
     const char *beginning = &ctx->buffer[ctx->i + 1];
     const char *eof = ctx->buffer + ctx->buffer_length;
     const char *end = escapable_until_or_null(beginning, eof, '\'', '\\');
 
     if(end == NULL){
-        error_unterminated_string(ctx, compiler);
+        error_unterminated_string(ctx, optional_error_compiler);
         return FAILURE;
     }
 
     length_t size = end - beginning;
     length_t length;
     
-    maybe_null_strong_cstr_t string = string_unescape_or_fail(ctx, compiler, beginning, size, &length);
+    maybe_null_strong_cstr_t string = string_unescape_or_fail(ctx, optional_error_compiler, beginning, size, &length);
     if(string == NULL) return FAILURE;
 
     // Handle special case of character literals differently
@@ -221,14 +225,14 @@ static inline errorcode_t cstring(lex_ctx_t *ctx, compiler_t *compiler){
         if(suffix_start + 2 <= eof){
             if(memcmp(suffix_start, "ub", 2) == 0){
                 // Actually a 'ubyte' character literal
-                add_token(&ctx->tokenlist, (token_t){TOKEN_UBYTE, (adept_ubyte*) string}, (source_t){ctx->i, size + 4, ctx->object_index});
+                add_token(&ctx->tokenlist, (token_t){TOKEN_UBYTE, (adept_ubyte*) string}, lex_source(ctx, ctx->i, size + 4));
                 ctx->i += size + 4;
                 return SUCCESS;
             }
 
             if(memcmp(suffix_start, "sb", 2) == 0){
                 // Actually a 'byte' character literal
-                add_token(&ctx->tokenlist, (token_t){TOKEN_BYTE, (adept_byte*) string}, (source_t){ctx->i, size + 4, ctx->object_index});
+                add_token(&ctx->tokenlist, (token_t){TOKEN_BYTE, (adept_byte*) string}, lex_source(ctx, ctx->i, size + 4));
                 ctx->i += size + 4;
                 return SUCCESS;
             }
@@ -245,11 +249,7 @@ static inline errorcode_t cstring(lex_ctx_t *ctx, compiler_t *compiler){
                 .length = length,
             })
         },
-        (source_t){
-            .index = ctx->i,
-            .stride = size + 2,
-            .object_index = ctx->object_index
-        }
+        lex_source(ctx, ctx->i, size + 2)
     );
 
     ctx->i += size + 2;
@@ -303,9 +303,9 @@ static inline errorcode_t number(lex_ctx_t *ctx, compiler_t *optional_error_comp
     if(put >= buf_size){
         if(optional_error_compiler && optional_error_object){
             int line, column;
-            lex_get_location(ctx->buffer, ctx->i, &line, &column);
+            lex_get_object_location(optional_error_object, ctx->i, &line, &column);
             redprintf("%s:%d:%d: Number is too long (%d characters max)\n", filename_name_const(optional_error_object->filename), line, column, buf_size - 1);
-            compiler_print_source(optional_error_compiler, line, (source_t){ctx->i, buf_size - 1, ctx->object_index});
+            compiler_print_source(optional_error_compiler, line, lex_source(ctx, ctx->i, buf_size - 1));
         }
         return FAILURE;
     }
@@ -346,12 +346,13 @@ static inline errorcode_t number(lex_ctx_t *ctx, compiler_t *optional_error_comp
             data = malloc_init(adept_usize, string_to_uint64(buf, base));
             stride += 2;
             break;
-        default: {
+        default:
+            if(optional_error_compiler && optional_error_object){
                 int line, column;
-                lex_get_location(ctx->buffer, ctx->i + (end - beginning + 1), &line, &column);
+                lex_get_object_location(optional_error_object, ctx->i + (end - beginning + 1), &line, &column);
                 redprintf("%s:%d:%d: Expected valid number suffix after 'u' base suffix\n", filename_name_const(optional_error_object->filename), line, column);
-                return FAILURE;
             }
+            return FAILURE;
         }
         break;
     case 's':
@@ -424,12 +425,27 @@ static inline errorcode_t number(lex_ctx_t *ctx, compiler_t *optional_error_comp
     }
     
     // Add number token
-    add_token(&ctx->tokenlist, (token_t){token_id, data}, (source_t){ctx->i, stride, ctx->object_index});
+    add_token(&ctx->tokenlist, (token_t){token_id, data}, lex_source(ctx, ctx->i, stride));
     ctx->i += stride;
     return SUCCESS;
 }
 
-static inline void running(lex_ctx_t *ctx, tokenid_t intent){
+static inline maybe_index_t keyword_lookup(const char *word, length_t size){
+    // Perfect hash of keywords generated by 'include/GENERATE/generate_c.py'
+    uint32_t hash = TOKEN_KEYWORDS_HASH_SEED;
+
+    for(length_t i = 0; i != size; i++){
+        hash = (hash ^ (unsigned char) word[i]) * 0x01000193;
+    }
+
+    unsigned char entry = global_token_keywords_hash_table[hash >> (32 - TOKEN_KEYWORDS_HASH_BITS)];
+    if(entry == 0) return -1;
+
+    const char *keyword = global_token_keywords_list[entry - 1];
+    return strncmp(keyword, word, size) == 0 && keyword[size] == '\0' ? (maybe_index_t) entry - 1 : -1;
+}
+
+static inline void running(lex_ctx_t *ctx, intern_table_t *symbols, tokenid_t intent){
     // Contains additional logic for intents:
     // - TOKEN_WORD
     // - TOKEN_POLYMORPH
@@ -439,13 +455,11 @@ static inline void running(lex_ctx_t *ctx, tokenid_t intent){
     const char *end = beginning;
     const char *eof = ctx->buffer + ctx->buffer_length;
 
-    while(end < eof){
-        char c = *end;
+    while(true){
+        end = lex_scan_identifier(end, eof);
+        if(end == eof) break;
 
-        if(c == '_' || isalnum(c)){
-            end++;
-            continue;
-        }
+        char c = *end;
 
         if(intent == TOKEN_WORD){
             if(c == '\\' || (c == ':' && (isalnum(end[1]) || c == '_'))){
@@ -474,26 +488,21 @@ static inline void running(lex_ctx_t *ctx, tokenid_t intent){
 
     // Calculate size
     length_t size = end - beginning;
-
-    // Create heap-allocated string to hold identifier
-    char *identifier = memcpy(malloc(size + 1), beginning, size);
-    identifier[size] = '\0';
+    char *replaced = NULL;
 
     if(intent == TOKEN_WORD){
-        maybe_index_t keyword_index = binary_string_search_const(global_token_keywords_list, global_token_keywords_list_length, identifier);
+        maybe_index_t keyword_index = keyword_lookup(beginning, size);
         
         // Handle word tokens that should be keywords
         if(keyword_index != -1){
-            add_token(&ctx->tokenlist, (token_t){BEGINNING_OF_KEYWORD_TOKENS + (unsigned int) keyword_index, NULL}, (source_t){ctx->i, size, ctx->object_index});
+            add_token(&ctx->tokenlist, (token_t){BEGINNING_OF_KEYWORD_TOKENS + (unsigned int) keyword_index, NULL}, lex_source(ctx, ctx->i, size));
             ctx->i += size;
-            free(identifier);
             return;
         } else if(size == 4 && memcmp(beginning, "elif", 4) == 0){
             // Legacy alternative syntax 'elif'
-            add_token(&ctx->tokenlist, (token_t){TOKEN_ELSE, NULL}, (source_t){ctx->i, 2, ctx->object_index});
-            add_token(&ctx->tokenlist, (token_t){TOKEN_IF, NULL}, (source_t){ctx->i + 2, 2, ctx->object_index});
+            add_token(&ctx->tokenlist, (token_t){TOKEN_ELSE, NULL}, lex_source(ctx, ctx->i, 2));
+            add_token(&ctx->tokenlist, (token_t){TOKEN_IF, NULL}, lex_source(ctx, ctx->i + 2, 2));
             ctx->i += 4;
-            free(identifier);
             return;
         }
 
@@ -501,33 +510,63 @@ static inline void running(lex_ctx_t *ctx, tokenid_t intent){
 
         // Legacy alternative syntax ':' instead of '\\' as a namespace character
         // This will be removed in the future
-        for(char *s = identifier; *s; s++){
-            if(*s == ':') *s = '\\';
+        if(memchr(beginning, ':', size)){
+            replaced = memcpy(malloc(size), beginning, size);
+
+            for(length_t i = 0; i != size; i++){
+                if(replaced[i] == ':') replaced[i] = '\\';
+            }
         }
     }
 
-    // Create token
-    add_token(&ctx->tokenlist, (token_t){intent, identifier}, (source_t){ctx->i, size + flag_length, ctx->object_index});
+    // Create token, whose data is the interned identifier (not owned by the token)
+    weak_cstr_t identifier = intern_table_insert(symbols, replaced ? replaced : beginning, size, NULL);
+    free(replaced);
+
+    add_token(&ctx->tokenlist, (token_t){intent, (void*) identifier}, lex_source(ctx, ctx->i, size + flag_length));
     ctx->i += size + flag_length;
 }
 
+static errorcode_t lex_buffer_into(compiler_t *optional_error_compiler, intern_table_t *symbols, object_t *object);
+
 errorcode_t lex(compiler_t *compiler, object_t *object){
-    if(!file_text_contents(object->filename, &object->buffer, &object->buffer_length, true)){
+    if(!file_text_map(object->filename, &object->buffer, &object->buffer_length, &object->buffer_is_mapped)){
         redprintf("The file '%s' doesn't exist or can't be accessed\n", object->filename);
         return FAILURE;
     }
 
+    if(compiler->traits & COMPILER_CACHE){
+        return token_cache_lex(compiler, object);
+    }
+
     return lex_buffer(compiler, object);
 }
 
 errorcode_t lex_buffer(compiler_t *compiler, object_t *object){
+    return lex_buffer_into(compiler, &compiler->symbols, object);
+}
+
+errorcode_t lex_buffer_quietly(intern_table_t *symbols, object_t *object){
+    return lex_buffer_into(NULL, symbols, object);
+}
+
+static errorcode_t lex_buffer_into(compiler_t *optional_error_compiler, intern_table_t *symbols, object_t *object){
     // REQUIREMENT: The attached buffer 'object->buffer' must be terminated with '\n\0'
     //     (where \0 is not included in the 'object->buffer_size')
+    // NOTE: Errors are only reported if 'optional_error_compiler' isn't NULL
 
     const char *buffer = object->buffer;
     length_t buffer_length = object->buffer_length;
     length_t estimate = buffer_length / 3;
 
+    // Sources can only refer to the first 4 GiB of a file
+    if(buffer_length > SOURCE_MAX_INDEX){
+        if(optional_error_compiler) redprintf("The file '%s' is too large to compile\n", object->filename);
+        return FAILURE;
+    }
+
+    lex_build_line_offsets(object);
+
     lex_ctx_t ctx = (lex_ctx_t){
         .buffer = buffer,
         .buffer_length = buffer_length,
@@ -545,7 +584,7 @@ errorcode_t lex_buffer(compiler_t *compiler, object_t *object){
         switch(buffer[ctx.i]){
         case ' ':
         case '\t':
-            ctx.i += 1;
+            ctx.i = lex_scan_blanks(&buffer[ctx.i + 1], &buffer[buffer_length]) - buffer;
             break;
         case '(': case ')':
         case '{': case '}':
@@ -558,7 +597,7 @@ errorcode_t lex_buffer(compiler_t *compiler, object_t *object){
             break;
         case '-':
             if(isdigit(buffer[ctx.i + 1])){
-                if(number(&ctx, compiler, object)) goto failure;
+                if(number(&ctx, optional_error_compiler, object)) goto failure;
             } else {
                 cases(&ctx, (char[]){'=', '-'}, (tokenid_t[]){TOKEN_SUBTRACT_ASSIGN, TOKEN_DECREMENT}, 2, TOKEN_SUBTRACT);
             }
@@ -566,24 +605,21 @@ errorcode_t lex_buffer(compiler_t *compiler, object_t *object){
         case '/':
             switch(buffer[ctx.i + 1]){
             case '/':
-                do ctx.i += 1; while(buffer[ctx.i] != '\n');
+                // Buffer always ends with a newline
+                ctx.i = (const char*) memchr(&buffer[ctx.i], '\n', buffer_length - ctx.i) - buffer;
                 break;
             case '*': {
                     const char *end = &buffer[ctx.i];
                     const char *eof = &buffer[buffer_length];
 
-                    while(end < eof && memcmp(end, "*/", 2) != 0){
+                    while((end = memchr(end, '*', eof - end)) && end[1] != '/'){
                         end++;
                     }
 
-                    if(end >= eof){
-                        source_t source = (source_t){
-                            .index = ctx.i,
-                            .stride = 2,
-                            .object_index = ctx.object_index,
-                        };
+                    if(end == NULL){
+                        source_t source = lex_source(&ctx, ctx.i, 2);
 
-                        compiler_panic(compiler, source, "Unterminated multi-line comment");
+                        if(optional_error_compiler) compiler_panic(optional_error_compiler, source, "Unterminated multi-line comment");
                         goto failure;
                     } else {
                         ctx.i += end - &buffer[ctx.i] + 2;
@@ -642,34 +678,36 @@ errorcode_t lex_buffer(compiler_t *compiler, object_t *object){
             stacking(&ctx, '.', (tokenid_t[]){TOKEN_MEMBER, TOKEN_RANGE, TOKEN_ELLIPSIS}, 3);
             break;
         case '"':
-            if(string(&ctx, compiler)) goto failure;
+            if(string(&ctx, optional_error_compiler)) goto failure;
             break;
         case '\'':
-            if(cstring(&ctx, compiler)) goto failure;
+            if(cstring(&ctx, optional_error_compiler)) goto failure;
             break;
         case '#':
-            running(&ctx, TOKEN_META);
+            running(&ctx, symbols, TOKEN_META);
             break;
         case '$':
-            running(&ctx, TOKEN_POLYMORPH);
+            running(&ctx, symbols, TOKEN_POLYMORPH);
             break;
         default: {
                 char c = buffer[ctx.i];
 
                 if(isalpha(c) || c == '_' || c == '\\'){
-                    running(&ctx, TOKEN_WORD);
+                    running(&ctx, symbols, TOKEN_WORD);
                     break;
                 }
 
                 if(isdigit(c)){
-                    if(number(&ctx, compiler, object)) goto failure;
+                    if(number(&ctx, optional_error_compiler, object)) goto failure;
                     break;
                 }
 
-                int line, column;
-                lex_get_location(buffer, ctx.i, &line, &column);
-                redprintf("%s:%d:%d: Unrecognized symbol '%c' (0x%02X)\n", filename_name_const(object->filename), line, column, buffer[ctx.i], (int) buffer[ctx.i]);
-                compiler_print_source(compiler, line, (source_t){ctx.i, 0, ctx.object_index});
+                if(optional_error_compiler){
+                    int line, column;
+                    lex_get_object_location(object, ctx.i, &line, &column);
+                    redprintf("%s:%d:%d: Unrecognized symbol '%c' (0x%02X)\n", filename_name_const(object->filename), line, column, buffer[ctx.i], (int) buffer[ctx.i]);
+                    compiler_print_source(optional_error_compiler, line, lex_source(&ctx, ctx.i, 0));
+                }
                 goto failure;
             }
         }
@@ -700,3 +738,68 @@ void lex_get_location(const char *buffer, length_t index, int *line, int *column
     *line = 1 + newlines;
     *column = last_newline ? (int)(&buffer[index] - last_newline) : (int) index + 1;
 }
+
+void lex_build_line_offsets(object_t *object){
+    const char *buffer = object->buffer;
+    const char *end = &buffer[object->buffer_length];
+
+    length_t capacity = object->buffer_length / 32 + 1;
+    length_t length = 0;
+    length_t *offsets = malloc(sizeof(length_t) * capacity);
+
+    // First line always starts at the beginning of the buffer
+    offsets[length++] = 0;
+
+    for(const char *newline = memchr(buffer, '\n', end - buffer); newline; newline = memchr(newline + 1, '\n', end - (newline + 1))){
+        expand((void**) &offsets, sizeof(length_t), length, &capacity, 1, 64);
+        offsets[length++] = (newline + 1) - buffer;
+    }
+
+    free(object->line_offsets);
+    object->line_offsets = offsets;
+    object->line_offsets_length = length;
+}
+
+static length_t lex_find_line_offset_index(object_t *object, length_t index){
+    // Finds the last line that starts at or before 'index'
+    length_t first = 0;
+    length_t last = object->line_offsets_length;
+
+    while(last - first > 1){
+        length_t middle = first + (last - first) / 2;
+
+        if(object->line_offsets[middle] <= index){
+            first = middle;
+        } else {
+            last = middle;
+        }
+    }
+
+    return first;
+}
+
+void lex_get_object_location(object_t *object, length_t index, int *line, int *column){
+    // NOTE: Expects index to be pointed at the character that caused the error or is the area of interest
+
+    if(object->line_offsets == NULL){
+        lex_get_location(object->buffer, index, line, column);
+        return;
+    }
+
+    length_t line_index = lex_find_line_offset_index(object, index);
+
+    *line = 1 + (int) line_index;
+    *column = 1 + (int)(index - object->line_offsets[line_index]);
+}
+
+length_t lex_get_line_offset(object_t *object, int line){
+    if(object->line_offsets != NULL){
+        return line >= 1 && (length_t) line <= object->line_offsets_length ? object->line_offsets[line - 1] : 0;
+    }
+
+    length_t line_index = 0;
+    for(int current_line = 1; current_line < line; line_index++){
+        if(object->buffer[line_index] == '\n') current_line++;
+    }
+    return line_index;
+}
@@ -0,0 +1,300 @@
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "LEX/lex.h"
+#include "LEX/lex_pool.h"
+#include "LEX/token.h"
+#include "UTIL/ground.h"
+#include "UTIL/intern.h"
+#include "UTIL/util.h"
+
+#if !defined(_WIN32) && !defined(ADEPT_INSIGHT_BUILD)
+
+#include <pthread.h>
+
+// Possible states of a lex pool job
+#define LEX_POOL_JOB_QUEUED  0x00
+#define LEX_POOL_JOB_RUNNING 0x01
+#define LEX_POOL_JOB_DONE    0x02
+#define LEX_POOL_JOB_FAILED  0x03
+#define LEX_POOL_JOB_TAKEN   0x04
+
+typedef struct {
+    strong_cstr_t full_filename;
+    int state;
+
+    // Only valid once LEX_POOL_JOB_DONE
+    strong_cstr_t buffer;
+    length_t buffer_length;
+    bool buffer_is_mapped;
+    length_t *line_offsets;
+    length_t line_offsets_length;
+    tokenlist_t tokenlist;
+} lex_pool_job_t;
+
+typedef struct {
+    lex_pool_t *pool;
+    pthread_t thread;
+
+    // Identifiers lexed by this worker, which are re-interned by the main thread
+    // NOTE: Strings in an intern table never move, so they can be read while the worker adds more
+    intern_table_t symbols;
+} lex_pool_worker_t;
+
+struct lex_pool {
+    pthread_mutex_t lock;
+    pthread_cond_t job_available;
+    pthread_cond_t job_finished;
+    bool stopping;
+
+    // Jobs are never moved, so workers can use them without holding the lock
+    lex_pool_job_t **jobs;
+    length_t jobs_length;
+    length_t jobs_capacity;
+    length_t next_job;
+
+    lex_pool_worker_t *workers;
+    length_t workers_length;
+};
+
+static errorcode_t lex_pool_lex(lex_pool_job_t *job, intern_table_t *symbols){
+    object_t object = (object_t){
+        .filename = job->full_filename,
+        .full_filename = job->full_filename,
+        .compilation_stage = COMPILATION_STAGE_FILENAME,
+        .index = 0,
+    };
+
+    if(!file_text_map(job->full_filename, &object.buffer, &object.buffer_length, &object.buffer_is_mapped)){
+        return FAILURE;
+    }
+
+    if(lex_buffer_quietly(symbols, &object)){
+        file_text_release(object.buffer, object.buffer_length, object.buffer_is_mapped);
+        free(object.line_offsets);
+        return FAILURE;
+    }
+
+    job->buffer = object.buffer;
+    job->buffer_length = object.buffer_length;
+    job->buffer_is_mapped = object.buffer_is_mapped;
+    job->line_offsets = object.line_offsets;
+    job->line_offsets_length = object.line_offsets_length;
+    job->tokenlist = object.tokenlist;
+    return SUCCESS;
+}
+
+static void *lex_pool_worker(void *data){
+    lex_pool_worker_t *worker = data;
+    lex_pool_t *pool = worker->pool;
+
+    pthread_mutex_lock(&pool->lock);
+
+    while(true){
+        while(pool->next_job == pool->jobs_length && !pool->stopping){
+            pthread_cond_wait(&pool->job_available, &pool->lock);
+        }
+
+        if(pool->stopping) break;
+
+        lex_pool_job_t *job = pool->jobs[pool->next_job++];
+
+        // Main thread might've decided to lex it by itself
+        if(job->state != LEX_POOL_JOB_QUEUED) continue;
+
+        job->state = LEX_POOL_JOB_RUNNING;
+        pthread_mutex_unlock(&pool->lock);
+
+        errorcode_t errorcode = lex_pool_lex(job, &worker->symbols);
+
+        pthread_mutex_lock(&pool->lock);
+        job->state = errorcode ? LEX_POOL_JOB_FAILED : LEX_POOL_JOB_DONE;
+        pthread_cond_broadcast(&pool->job_finished);
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+lex_pool_t *lex_pool_create(length_t threads_length){
+    if(threads_length == 0) return NULL;
+
+    lex_pool_t *pool = malloc(sizeof(lex_pool_t));
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->job_available, NULL);
+    pthread_cond_init(&pool->job_finished, NULL);
+    pool->stopping = false;
+    pool->jobs = NULL;
+    pool->jobs_length = 0;
+    pool->jobs_capacity = 0;
+    pool->next_job = 0;
+    pool->workers = malloc(sizeof(lex_pool_worker_t) * threads_length);
+    pool->workers_length = 0;
+
+    for(length_t i = 0; i != threads_length; i++){
+        lex_pool_worker_t *worker = &pool->workers[pool->workers_length];
+        worker->pool = pool;
+        intern_table_init(&worker->symbols);
+
+        if(pthread_create(&worker->thread, NULL, &lex_pool_worker, worker) != 0){
+            intern_table_free(&worker->symbols);
+            break;
+        }
+
+        pool->workers_length++;
+    }
+
+    if(pool->workers_length == 0){
+        lex_pool_free(pool);
+        return NULL;
+    }
+
+    return pool;
+}
+
+void lex_pool_free(lex_pool_t *pool){
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = true;
+    pthread_cond_broadcast(&pool->job_available);
+    pthread_mutex_unlock(&pool->lock);
+
+    for(length_t i = 0; i != pool->workers_length; i++){
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+
+    for(length_t i = 0; i != pool->jobs_length; i++){
+        lex_pool_job_t *job = pool->jobs[i];
+
+        if(job->state == LEX_POOL_JOB_DONE){
+            file_text_release(job->buffer, job->buffer_length, job->buffer_is_mapped);
+            free(job->line_offsets);
+            tokenlist_free(&job->tokenlist);
+        }
+
+        free(job->full_filename);
+        free(job);
+    }
+
+    // Token lists that point into these have either been taken (and re-interned) or freed
+    for(length_t i = 0; i != pool->workers_length; i++){
+        intern_table_free(&pool->workers[i].symbols);
+    }
+
+    free(pool->jobs);
+    free(pool->workers);
+    pthread_cond_destroy(&pool->job_finished);
+    pthread_cond_destroy(&pool->job_available);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool);
+}
+
+static lex_pool_job_t *lex_pool_find(lex_pool_t *pool, weak_cstr_t full_filename){
+    // NOTE: Must be called while holding the lock
+    for(length_t i = 0; i != pool->jobs_length; i++){
+        if(streq(pool->jobs[i]->full_filename, full_filename)) return pool->jobs[i];
+    }
+    return NULL;
+}
+
+void lex_pool_submit(lex_pool_t *pool, strong_cstr_t full_filename){
+    pthread_mutex_lock(&pool->lock);
+
+    if(lex_pool_find(pool, full_filename)){
+        pthread_mutex_unlock(&pool->lock);
+        free(full_filename);
+        return;
+    }
+
+    expand((void**) &pool->jobs, sizeof(lex_pool_job_t*), pool->jobs_length, &pool->jobs_capacity, 1, 16);
+
+    pool->jobs[pool->jobs_length++] = malloc_init(lex_pool_job_t, {
+        .full_filename = full_filename,
+        .state = LEX_POOL_JOB_QUEUED,
+    });
+
+    pthread_cond_signal(&pool->job_available);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+bool lex_pool_take(lex_pool_t *pool, compiler_t *compiler, object_t *object){
+    if(object->full_filename == NULL) return false;
+
+    pthread_mutex_lock(&pool->lock);
+
+    lex_pool_job_t *job = lex_pool_find(pool, object->full_filename);
+
+    if(job == NULL || job->state == LEX_POOL_JOB_TAKEN){
+        pthread_mutex_unlock(&pool->lock);
+        return false;
+    }
+
+    // Lexing it ourselves is faster than waiting for it to be started
+    if(job->state == LEX_POOL_JOB_QUEUED){
+        job->state = LEX_POOL_JOB_TAKEN;
+        pthread_mutex_unlock(&pool->lock);
+        return false;
+    }
+
+    while(job->state == LEX_POOL_JOB_RUNNING){
+        pthread_cond_wait(&pool->job_finished, &pool->lock);
+    }
+
+    bool is_done = job->state == LEX_POOL_JOB_DONE;
+    job->state = LEX_POOL_JOB_TAKEN;
+    pthread_mutex_unlock(&pool->lock);
+
+    // Failed files are lexed again normally, so that errors are reported
+    if(!is_done) return false;
+
+    object->buffer = job->buffer;
+    object->buffer_length = job->buffer_length;
+    object->buffer_is_mapped = job->buffer_is_mapped;
+    object->line_offsets = job->line_offsets;
+    object->line_offsets_length = job->line_offsets_length;
+    object->tokenlist = job->tokenlist;
+    object->compilation_stage = COMPILATION_STAGE_TOKENLIST;
+
+    token_t *tokens = object->tokenlist.tokens;
+    source_t *sources = object->tokenlist.sources;
+
+    for(length_t i = 0; i != object->tokenlist.length; i++){
+        sources[i].object_index = object->index;
+
+        // Move identifiers from the table of the worker into the table of the compiler
+        if(token_has_interned_data(tokens[i].id)){
+            weak_cstr_t name = tokens[i].data;
+            tokens[i].data = (void*) intern_table_insert(&compiler->symbols, name, strlen(name), NULL);
+        }
+    }
+
+    return true;
+}
+
+#else
+
+lex_pool_t *lex_pool_create(length_t threads_length){
+    (void) threads_length;
+    return NULL;
+}
+
+void lex_pool_free(lex_pool_t *pool){
+    (void) pool;
+}
+
+void lex_pool_submit(lex_pool_t *pool, strong_cstr_t full_filename){
+    (void) pool;
+    free(full_filename);
+}
+
+bool lex_pool_take(lex_pool_t *pool, compiler_t *compiler, object_t *object){
+    (void) pool;
+    (void) compiler;
+    (void) object;
+    return false;
+}
+
+#endif
@@ -0,0 +1,51 @@
+
+#include <stdint.h>
+
+#include "LEX/lex_scan.h"
+
+#ifdef LEX_SCAN_AVX2
+
+#include <immintrin.h>
+
+// Compiled for AVX2 regardless of the target, and only called when
+// the processor supports it (see 'lex_scan_has_avx2')
+#define LEX_SCAN_AVX2_FUNCTION __attribute__((target("avx2")))
+
+LEX_SCAN_AVX2_FUNCTION const char *lex_scan_blanks_avx2(const char *p, const char *end){
+    while(end - p >= 32){
+        __m256i chunk = _mm256_loadu_si256((const __m256i*) p);
+        __m256i blank = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\t')));
+        uint32_t other = ~(uint32_t) _mm256_movemask_epi8(blank);
+        if(other) return p + __builtin_ctz(other);
+        p += 32;
+    }
+    return p;
+}
+
+LEX_SCAN_AVX2_FUNCTION const char *lex_scan_identifier_avx2(const char *p, const char *end){
+    while(end - p >= 32){
+        __m256i chunk = _mm256_loadu_si256((const __m256i*) p);
+        __m256i lower = _mm256_or_si256(chunk, _mm256_set1_epi8(0x20));
+        __m256i is_letter = _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), lower));
+        __m256i is_digit = _mm256_and_si256(_mm256_cmpgt_epi8(chunk, _mm256_set1_epi8('0' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), chunk));
+        __m256i is_underscore = _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('_'));
+        __m256i is_identifier = _mm256_or_si256(_mm256_or_si256(is_letter, is_digit), is_underscore);
+        uint32_t other = ~(uint32_t) _mm256_movemask_epi8(is_identifier);
+        if(other) return p + __builtin_ctz(other);
+        p += 32;
+    }
+    return p;
+}
+
+LEX_SCAN_AVX2_FUNCTION const char *lex_scan_either_avx2(const char *p, const char *end, char a, char b){
+    while(end - p >= 32){
+        __m256i chunk = _mm256_loadu_si256((const __m256i*) p);
+        __m256i found = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(a)), _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(b)));
+        uint32_t mask = (uint32_t) _mm256_movemask_epi8(found);
+        if(mask) return p + __builtin_ctz(mask);
+        p += 32;
+    }
+    return p;
+}
+
+#endif // LEX_SCAN_AVX2
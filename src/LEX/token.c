@@ -5,10 +5,12 @@
 
 #include "LEX/lex.h"
 #include "LEX/token.h"
+#include "LEX/token_cache.h"
 #include "TOKEN/token_data.h"
 #include "UTIL/color.h"
 #include "UTIL/datatypes.h"
 #include "UTIL/ground.h"
+#include "UTIL/util.h"
 
 void tokenlist_print(tokenlist_t *tokenlist, const char *buffer){
     // Prints detailed information contained in tokenlist
@@ -21,7 +23,7 @@ void tokenlist_print(tokenlist_t *tokenlist, const char *buffer){
         if(buffer != NULL){
             int line, column;
             lex_get_location(buffer, tokenlist->sources[i].index, &line, &column);
-            printf("%d:%d~%d ", line, column, (int) tokenlist->sources[i].stride);
+            printf("%d:%d~%d ", line, column, (int) tokenlist_source_stride(tokenlist, tokenlist->sources[i]));
         }
 
         token_t *token = &tokenlist->tokens[i];
@@ -114,13 +116,53 @@ void token_print_literal_value(token_t *token){
     }
 }
 
+void tokenlist_add_wide_stride(tokenlist_t *tokenlist, length_t index, length_t stride){
+    expand((void**) &tokenlist->wide_strides, sizeof(wide_stride_t), tokenlist->wide_strides_length, &tokenlist->wide_strides_capacity, 1, 4);
+
+    tokenlist->wide_strides[tokenlist->wide_strides_length++] = (wide_stride_t){
+        .index = index,
+        .stride = stride,
+    };
+}
+
+length_t tokenlist_source_stride(tokenlist_t *tokenlist, source_t source){
+    if(source.stride != SOURCE_WIDE_STRIDE) return source.stride;
+
+    length_t first = 0;
+    length_t last = tokenlist->wide_strides_length;
+
+    while(first != last){
+        length_t middle = first + (last - first) / 2;
+        length_t index = tokenlist->wide_strides[middle].index;
+
+        if(index == source.index) return tokenlist->wide_strides[middle].stride;
+
+        if(index < source.index){
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+
+    return source.stride;
+}
+
 void tokenlist_free(tokenlist_t *tokenlist){
-    for(length_t i = 0; i != tokenlist->length; i++){
-        if(tokenlist->tokens[i].id == TOKEN_STRING){
-            free(((token_string_data_t*) tokenlist->tokens[i].data)->array);
+    if(tokenlist->image == NULL){
+        for(length_t i = 0; i != tokenlist->length; i++){
+            if(token_has_interned_data(tokenlist->tokens[i].id)) continue;
+
+            if(tokenlist->tokens[i].id == TOKEN_STRING){
+                free(((token_string_data_t*) tokenlist->tokens[i].data)->array);
+            }
+            free(tokenlist->tokens[i].data);
         }
-        free(tokenlist->tokens[i].data);
+    } else {
+        // Token data of cached token lists lives in their image
+        token_cache_release_image(tokenlist->image, tokenlist->image_size, tokenlist->image_is_mapped);
     }
+
     free(tokenlist->tokens);
     free(tokenlist->sources);
+    free(tokenlist->wide_strides);
 }
@@ -0,0 +1,490 @@
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#if defined(_WIN32)
+#include <direct.h>
+#include <process.h>
+#define makedir(a) _mkdir(a)
+#define getpid() _getpid()
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define makedir(a) mkdir(a, 0777)
+#endif
+
+#include "DRVR/build_cache.h"
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "LEX/lex.h"
+#include "LEX/token.h"
+#include "LEX/token_cache.h"
+#include "TOKEN/token_data.h"
+#include "UTIL/datatypes.h"
+#include "UTIL/filename.h"
+#include "UTIL/ground.h"
+#include "UTIL/intern.h"
+#include "UTIL/util.h"
+
+static bool token_cache_open_image(weak_cstr_t filename, tokenlist_t *tokenlist){
+    #ifndef _WIN32
+    int fd = open(filename, O_RDONLY);
+    if(fd < 0) return false;
+
+    struct stat info;
+
+    if(fstat(fd, &info) != 0 || info.st_size == 0){
+        close(fd);
+        return false;
+    }
+
+    // Mapped as private and writable, so that the pointers of string tokens can be
+    // filled in, only the pages that are written to get copied
+    void *image = mmap(NULL, (size_t) info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if(image == MAP_FAILED) return false;
+
+    tokenlist->image = image;
+    tokenlist->image_size = (length_t) info.st_size;
+    tokenlist->image_is_mapped = true;
+    return true;
+    #else
+    char *image;
+    length_t size;
+
+    if(!file_binary_contents(filename, &image, &size)) return false;
+
+    tokenlist->image = image;
+    tokenlist->image_size = size;
+    tokenlist->image_is_mapped = false;
+    return true;
+    #endif
+}
+
+void token_cache_release_image(void *image, length_t size, bool is_mapped){
+    #ifndef _WIN32
+    if(is_mapped){
+        munmap(image, size);
+        return;
+    }
+    #else
+    (void) size;
+    (void) is_mapped;
+    #endif
+
+    free(image);
+}
+
+static length_t token_cache_literal_size(tokenid_t id){
+    // Returns the size of the value carried by literal tokens, or zero for other tokens
+    switch(id){
+    case TOKEN_BYTE:          return sizeof(adept_byte);
+    case TOKEN_UBYTE:         return sizeof(adept_ubyte);
+    case TOKEN_SHORT:         return sizeof(adept_short);
+    case TOKEN_USHORT:        return sizeof(adept_ushort);
+    case TOKEN_INT:           return sizeof(adept_int);
+    case TOKEN_UINT:          return sizeof(adept_uint);
+    case TOKEN_LONG:          return sizeof(adept_long);
+    case TOKEN_ULONG:         return sizeof(adept_ulong);
+    case TOKEN_USIZE:         return sizeof(adept_usize);
+    case TOKEN_FLOAT:         return sizeof(adept_float);
+    case TOKEN_DOUBLE:        return sizeof(adept_double);
+    case TOKEN_GENERIC_INT:   return sizeof(adept_generic_int);
+    case TOKEN_GENERIC_FLOAT: return sizeof(adept_generic_float);
+    default:                  return 0;
+    }
+}
+
+static bool token_cache_has_string_data(tokenid_t id){
+    return id == TOKEN_STRING || id == TOKEN_CSTRING;
+}
+
+static uint64_t token_cache_align(uint64_t size){
+    // Token data is kept 8-byte aligned within images
+    return (size + 7) & ~(uint64_t) 7;
+}
+
+static uint64_t token_cache_mtime_nanoseconds(struct stat *info){
+    #if defined(__APPLE__)
+    return (uint64_t) info->st_mtimespec.tv_nsec;
+    #elif defined(__linux__)
+    return (uint64_t) info->st_mtim.tv_nsec;
+    #else
+    (void) info;
+    return 0;
+    #endif
+}
+
+static void token_cache_source_key(object_t *object, build_cache_key_t *out_source_key){
+    build_cache_digest_t digest;
+    build_cache_digest_init(&digest);
+
+    struct stat info;
+
+    if(object->full_filename && stat(object->full_filename, &info) == 0){
+        // Identify the file by its metadata, so that its contents never have to be hashed
+        // NOTE: The length of the file is still checked against the image when loading
+        build_cache_digest_u64(&digest, 1);
+        build_cache_digest_u64(&digest, (uint64_t) info.st_size);
+        build_cache_digest_u64(&digest, (uint64_t) info.st_dev);
+        build_cache_digest_u64(&digest, (uint64_t) info.st_ino);
+        build_cache_digest_u64(&digest, (uint64_t) info.st_mtime);
+        build_cache_digest_u64(&digest, token_cache_mtime_nanoseconds(&info));
+        build_cache_digest_u64(&digest, (uint64_t) info.st_ctime);
+    } else {
+        build_cache_digest_u64(&digest, 0);
+        build_cache_digest_bytes(&digest, object->buffer, object->buffer_length);
+    }
+
+    build_cache_digest_finish(&digest, out_source_key);
+}
+
+static strong_cstr_t token_cache_filename(compiler_t *compiler, object_t *object, const build_cache_key_t *source_key){
+    build_cache_digest_t digest;
+    build_cache_digest_init(&digest);
+    build_cache_digest_u64(&digest, TOKEN_CACHE_FORMAT_VERSION);
+    build_cache_digest_u64(&digest, TOKEN_ITERATION_VERSION);
+
+    if(object->full_filename){
+        // Each file only ever has one image, which is overwritten once the file changes
+        build_cache_digest_u64(&digest, 1);
+        build_cache_digest_string(&digest, object->full_filename);
+    } else {
+        build_cache_digest_u64(&digest, 0);
+        build_cache_digest_u64(&digest, source_key->a);
+        build_cache_digest_u64(&digest, source_key->b);
+    }
+
+    build_cache_key_t cache_key;
+    build_cache_digest_finish(&digest, &cache_key);
+
+    char key[48];
+    snprintf(key, sizeof key, "%016llx%016llx.tokens", (unsigned long long) cache_key.a, (unsigned long long) cache_key.b);
+
+    strong_cstr_t directory = build_cache_directory(compiler);
+    strong_cstr_t filename = mallocandsprintf("%s%s", directory, key);
+    free(directory);
+    return filename;
+}
+
+errorcode_t token_cache_lex(compiler_t *compiler, object_t *object){
+    build_cache_key_t source_key;
+    token_cache_source_key(object, &source_key);
+
+    strong_cstr_t cache_filename = token_cache_filename(compiler, object, &source_key);
+
+    if(token_cache_load(compiler, object, cache_filename, &source_key) == SUCCESS){
+        free(cache_filename);
+        return SUCCESS;
+    }
+
+    if(lex_buffer(compiler, object)){
+        free(cache_filename);
+        return FAILURE;
+    }
+
+    token_cache_store(compiler, object, cache_filename, &source_key);
+    free(cache_filename);
+    return SUCCESS;
+}
+
+static bool token_cache_read_u32(const uint8_t **cursor, const uint8_t *end, uint32_t *out_value){
+    if(end - *cursor < (ptrdiff_t) sizeof(uint32_t)) return false;
+
+    memcpy(out_value, *cursor, sizeof(uint32_t));
+    *cursor += sizeof(uint32_t);
+    return true;
+}
+
+static errorcode_t token_cache_decode(compiler_t *compiler, object_t *object, tokenlist_t *tokenlist, const build_cache_key_t *source_key){
+    uint8_t *image = tokenlist->image;
+    length_t image_size = tokenlist->image_size;
+    token_cache_header_t header;
+
+    if(image_size < sizeof header) return FAILURE;
+    memcpy(&header, image, sizeof header);
+
+    if(header.magic != TOKEN_CACHE_MAGIC
+    || header.format_version != TOKEN_CACHE_FORMAT_VERSION
+    || header.token_iteration_version != TOKEN_ITERATION_VERSION
+    || header.string_data_size != sizeof(token_string_data_t)
+    || header.source_key_a != source_key->a
+    || header.source_key_b != source_key->b
+    || header.buffer_length != object->buffer_length
+    || header.tokens_length > (image_size - sizeof header) / sizeof(token_cache_record_t)){
+        return FAILURE;
+    }
+
+    length_t symbols_offset = sizeof header + header.tokens_length * sizeof(token_cache_record_t);
+
+    if(header.symbols_size > image_size - symbols_offset
+    || header.symbols_size % 8 != 0
+    || header.symbols_length > header.symbols_size / sizeof(uint32_t)
+    || header.data_size != image_size - symbols_offset - header.symbols_size){
+        return FAILURE;
+    }
+
+    const token_cache_record_t *records = (const token_cache_record_t*) &image[sizeof header];
+    uint8_t *data = &image[symbols_offset + header.symbols_size];
+    length_t data_size = header.data_size;
+    length_t tokens_length = header.tokens_length;
+
+    // Each distinct identifier is only interned once, instead of once per token
+    weak_cstr_t *symbols = malloc(sizeof(weak_cstr_t) * (header.symbols_length ? header.symbols_length : 1));
+    const uint8_t *cursor = &image[symbols_offset];
+    const uint8_t *symbols_end = cursor + header.symbols_size;
+
+    for(length_t i = 0; i != header.symbols_length; i++){
+        uint32_t length;
+        if(!token_cache_read_u32(&cursor, symbols_end, &length) || symbols_end - cursor < (ptrdiff_t) length) goto failure;
+
+        symbols[i] = intern_table_insert(&compiler->symbols, (const char*) cursor, length, NULL);
+        cursor += length;
+    }
+
+    // Only padding is allowed after the identifiers
+    if(symbols_end - cursor >= 8) goto failure;
+
+    tokenlist->tokens = malloc(sizeof(token_t) * (tokens_length ? tokens_length : 1));
+    tokenlist->capacity = tokens_length ? tokens_length : 1;
+    tokenlist->sources = malloc(sizeof(source_t) * (tokens_length ? tokens_length : 1));
+
+    for(length_t i = 0; i != tokens_length; i++){
+        const token_cache_record_t *record = &records[i];
+        length_t payload = record->payload;
+
+        if(record->id >= MAX_LEX_TOKEN || (length_t) record->index + record->stride > object->buffer_length){
+            goto failure;
+        }
+
+        tokenid_t id = record->id;
+        void *token_data = NULL;
+        length_t literal_size = token_cache_literal_size(id);
+
+        if(token_has_interned_data(id)){
+            if(payload >= header.symbols_length) goto failure;
+
+            token_data = (void*) symbols[payload];
+        } else if(token_cache_has_string_data(id)){
+            if(payload % 8 != 0 || payload > data_size || data_size - payload <= sizeof(token_string_data_t)) goto failure;
+
+            // String contents follow their 'token_string_data_t', and are null-terminated
+            token_string_data_t *string_data = (token_string_data_t*) &data[payload];
+            char *array = (char*) (string_data + 1);
+
+            if(string_data->length >= data_size - payload - sizeof(token_string_data_t) || array[string_data->length] != '\0'){
+                goto failure;
+            }
+
+            string_data->array = array;
+            token_data = string_data;
+        } else if(literal_size != 0){
+            if(payload % 8 != 0 || payload > data_size || data_size - payload < literal_size) goto failure;
+
+            token_data = &data[payload];
+        } else if(payload != 0){
+            goto failure;
+        }
+
+        tokenlist->tokens[i] = (token_t){
+            .id = id,
+            .data = token_data,
+        };
+
+        tokenlist->sources[i] = tokenlist_source(tokenlist, record->index, record->stride, object->index);
+
+        tokenlist->length = i + 1;
+    }
+
+    free(symbols);
+    return SUCCESS;
+
+failure:
+    free(symbols);
+    return FAILURE;
+}
+
+errorcode_t token_cache_load(compiler_t *compiler, object_t *object, weak_cstr_t cache_filename, const build_cache_key_t *source_key){
+    tokenlist_t tokenlist = {0};
+    if(!token_cache_open_image(cache_filename, &tokenlist)) return FAILURE;
+
+    if(token_cache_decode(compiler, object, &tokenlist, source_key)){
+        // Fall back to lexing normally (the stale image is replaced afterwards)
+        // NOTE: Already interned identifiers are harmless to keep
+        tokenlist_free(&tokenlist);
+        return FAILURE;
+    }
+
+    lex_build_line_offsets(object);
+    object->compilation_stage = COMPILATION_STAGE_TOKENLIST;
+    object->tokenlist = tokenlist;
+    return SUCCESS;
+}
+
+static bool token_cache_write_padding(FILE *file, length_t size){
+    static const uint8_t zeros[8] = {0};
+    return fwrite(zeros, 1, size, file) == size;
+}
+
+static bool token_cache_write(FILE *file, compiler_t *compiler, object_t *object, const build_cache_key_t *source_key){
+    tokenlist_t *tokenlist = &object->tokenlist;
+    intern_table_t *table = &compiler->symbols;
+    length_t tokens_length = tokenlist->length;
+
+    token_cache_record_t *records = malloc(sizeof(token_cache_record_t) * (tokens_length ? tokens_length : 1));
+
+    // Distinct identifiers in order of first use, and their index within the image
+    // plus one (or zero if not used yet) by symbol id
+    symbol_id_t *symbols = malloc(sizeof(symbol_id_t) * (tokens_length ? tokens_length : 1));
+    uint32_t *symbol_indices = calloc(table->length ? table->length : 1, sizeof(uint32_t));
+    length_t symbols_length = 0;
+    uint64_t symbols_size = 0;
+    uint64_t data_size = 0;
+    bool written = false;
+
+    // Lay out the image first, so that the header can be written up front
+    for(length_t i = 0; i != tokens_length; i++){
+        token_t *token = &tokenlist->tokens[i];
+        source_t source = tokenlist->sources[i];
+        length_t literal_size = token_cache_literal_size(token->id);
+        uint64_t payload = 0;
+
+        if(token_has_interned_data(token->id)){
+            symbol_id_t symbol;
+            if(!intern_table_find(table, token->data, strlen(token->data), &symbol)) goto cleanup;
+
+            if(symbol_indices[symbol] == 0){
+                symbols[symbols_length++] = symbol;
+                symbol_indices[symbol] = (uint32_t) symbols_length;
+                symbols_size += sizeof(uint32_t) + table->entries[symbol].length;
+            }
+
+            payload = symbol_indices[symbol] - 1;
+        } else if(token_cache_has_string_data(token->id)){
+            payload = data_size;
+            data_size += token_cache_align(sizeof(token_string_data_t) + ((token_string_data_t*) token->data)->length + 1);
+        } else if(literal_size != 0){
+            payload = data_size;
+            data_size += token_cache_align(literal_size);
+        } else if(token->data != NULL){
+            // Unknown kind of token data, can't be cached
+            goto cleanup;
+        }
+
+        if(payload > UINT32_MAX) goto cleanup;
+
+        records[i] = (token_cache_record_t){
+            .id = token->id,
+            .reserved = 0,
+            .index = (uint32_t) source.index,
+            .stride = (uint32_t) tokenlist_source_stride(tokenlist, source),
+            .payload = (uint32_t) payload,
+        };
+    }
+
+    token_cache_header_t header = {
+        .magic = TOKEN_CACHE_MAGIC,
+        .format_version = TOKEN_CACHE_FORMAT_VERSION,
+        .token_iteration_version = TOKEN_ITERATION_VERSION,
+        .string_data_size = sizeof(token_string_data_t),
+        .source_key_a = source_key->a,
+        .source_key_b = source_key->b,
+        .buffer_length = object->buffer_length,
+        .tokens_length = tokens_length,
+        .symbols_length = symbols_length,
+        .symbols_size = token_cache_align(symbols_size),
+        .data_size = data_size,
+    };
+
+    if(fwrite(&header, sizeof header, 1, file) != 1
+    || fwrite(records, sizeof(token_cache_record_t), tokens_length, file) != tokens_length){
+        goto cleanup;
+    }
+
+    for(length_t i = 0; i != symbols_length; i++){
+        intern_entry_t *entry = &table->entries[symbols[i]];
+        uint32_t length = (uint32_t) entry->length;
+
+        if(length != entry->length
+        || fwrite(&length, sizeof length, 1, file) != 1
+        || fwrite(entry->name, 1, length, file) != length){
+            goto cleanup;
+        }
+    }
+
+    if(!token_cache_write_padding(file, header.symbols_size - symbols_size)) goto cleanup;
+
+    for(length_t i = 0; i != tokens_length; i++){
+        token_t *token = &tokenlist->tokens[i];
+        length_t literal_size = token_cache_literal_size(token->id);
+
+        if(token_has_interned_data(token->id)) continue;
+
+        if(token_cache_has_string_data(token->id)){
+            // The pointer to the contents is filled in when loading
+            token_string_data_t *string_data = token->data;
+            token_string_data_t slot = {
+                .array = NULL,
+                .length = string_data->length,
+            };
+
+            length_t size = sizeof slot + string_data->length;
+
+            // Padding includes the null-terminator
+            if(fwrite(&slot, sizeof slot, 1, file) != 1
+            || fwrite(string_data->array, 1, string_data->length, file) != string_data->length
+            || !token_cache_write_padding(file, token_cache_align(size + 1) - size)){
+                goto cleanup;
+            }
+        } else if(literal_size != 0){
+            if(fwrite(token->data, literal_size, 1, file) != 1
+            || !token_cache_write_padding(file, token_cache_align(literal_size) - literal_size)){
+                goto cleanup;
+            }
+        }
+    }
+
+    written = true;
+
+cleanup:
+    free(records);
+    free(symbols);
+    free(symbol_indices);
+    return written;
+}
+
+void token_cache_store(compiler_t *compiler, object_t *object, weak_cstr_t cache_filename, const build_cache_key_t *source_key){
+    strong_cstr_t directory = filename_path(cache_filename);
+    bool has_directory = makedir(directory) == 0 || errno == EEXIST;
+    free(directory);
+
+    if(!has_directory) return;
+
+    // Write to a temporary file first, so concurrent builds never see a partial token list
+    char suffix[32];
+    snprintf(suffix, sizeof suffix, ".%d.tmp", (int) getpid());
+
+    strong_cstr_t temporary_filename = mallocandsprintf("%s%s", cache_filename, suffix);
+    FILE *file = fopen(temporary_filename, "wb");
+
+    if(file == NULL){
+        free(temporary_filename);
+        return;
+    }
+
+    bool written = token_cache_write(file, compiler, object, source_key);
+
+    if(fclose(file) != 0 || !written || rename(temporary_filename, cache_filename) != 0){
+        remove(temporary_filename);
+    }
+
+    free(temporary_filename);
+}
@@ -0,0 +1,55 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "DRVR/server_protocol.h"
+
+extern char **environ;
+
+/*
+    Thin client for compile servers (see 'adept --server')
+
+    Takes the same arguments as 'adept'. When no compile server is running,
+    the regular compiler next to this executable is used instead.
+*/
+
+static int run_compiler_directly(char **argv){
+    const char *separator = strrchr(argv[0], '/');
+
+    if(separator == NULL){
+        execvp("adept", argv);
+    } else {
+        size_t directory_length = (size_t) (separator - argv[0]) + 1;
+        char *compiler_filename = malloc(directory_length + sizeof "adept");
+
+        memcpy(compiler_filename, argv[0], directory_length);
+        memcpy(&compiler_filename[directory_length], "adept", sizeof "adept");
+        execv(compiler_filename, argv);
+        free(compiler_filename);
+    }
+
+    fprintf(stderr, "No compile server is running, and failed to run 'adept' instead\n");
+    return 1;
+}
+
+int main(int argc, char **argv){
+    if(argc == 0) return 1;
+
+    char *socket_filename = server_socket_filename();
+    int connection = socket_filename ? server_connect(socket_filename) : -1;
+    free(socket_filename);
+
+    if(connection < 0) return run_compiler_directly(argv);
+
+    int exit_code;
+
+    if(server_send_request(connection, argc, argv, environ) || server_receive_exit_code(connection, &exit_code)){
+        fprintf(stderr, "Lost connection to compile server\n");
+        exit_code = 1;
+    }
+
+    close(connection);
+    return exit_code;
+}
@@ -6,6 +6,7 @@
 #include "BRIDGE/any.h"
 #include "DRVR/compiler.h"
 #include "DRVR/object.h"
+#include "LEX/lex_pool.h"
 #include "LEX/token.h"
 #include "PARSE/parse.h"
 #include "PARSE/parse_alias.h"
@@ -27,18 +28,33 @@ errorcode_t parse(compiler_t *compiler, object_t *object){
 
     object_init_ast(object, compiler->cross_compile_for);
     parse_ctx_init(&ctx, compiler, object);
+
+    // Expressions and type elements made while parsing are allocated from this AST
+    ast_pool_t *previous_pool = ast_pool_use(&object->ast.pool);
     
     if(!(compiler->traits & COMPILER_INFLATE_PACKAGE)){
         any_inject_ast(ctx.ast);
         va_args_inject_ast(compiler, ctx.ast);
     }
     
-    if(parse_tokens(&ctx)){
-        if(ctx.prename) free(ctx.prename);
-        return FAILURE;
+    // Lex imported files on other threads while parsing
+    // NOTE: Not used with '--cache', since files lexed by the pool don't go through the token cache
+    if(compiler->jobs > 1 && !(compiler->traits & COMPILER_CACHE)){
+        compiler->lex_pool = lex_pool_create(compiler->jobs - 1);
+    }
+
+    errorcode_t errorcode = parse_tokens(&ctx);
+
+    if(compiler->lex_pool){
+        lex_pool_free(compiler->lex_pool);
+        compiler->lex_pool = NULL;
     }
 
     if(ctx.prename) free(ctx.prename);
+    ast_pool_use(previous_pool);
+
+    if(errorcode) return FAILURE;
+
     qsort(object->ast.poly_funcs, object->ast.poly_funcs_length, sizeof(ast_poly_func_t), &ast_poly_funcs_cmp);
     qsort(object->ast.polymorphic_methods, object->ast.polymorphic_methods_length, sizeof(ast_poly_func_t), &ast_poly_funcs_cmp);
     return SUCCESS;
@@ -51,6 +67,8 @@ errorcode_t parse_tokens(parse_ctx_t *ctx){
     token_t *tokens = ctx->tokenlist->tokens;
     length_t tokens_length = ctx->tokenlist->length;
 
+    parse_prefetch_imports(ctx);
+
     for(ctx->i = &i; i != tokens_length; i++){
         switch(tokens[i].id){
         case TOKEN_NEWLINE:
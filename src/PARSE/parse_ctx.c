@@ -9,6 +9,7 @@
 #include "PARSE/parse_ctx.h"
 #include "TOKEN/token_data.h"
 #include "UTIL/ground.h"
+#include "UTIL/string.h"
 #include "UTIL/trait.h"
 #include "UTIL/util.h"
 
@@ -221,6 +222,12 @@ void *parse_ctx_peek_data(parse_ctx_t *ctx){
 
 void *parse_ctx_peek_data_take(parse_ctx_t *ctx){
     token_t *token = &ctx->tokenlist->tokens[*ctx->i];
+
+    // Interned identifiers are shared, so hand out an owned copy instead
+    if(token_has_interned_data(token->id)){
+        return strclone(token->data);
+    }
+
     void *tmp = token->data;
     token->data = NULL;
     return tmp;
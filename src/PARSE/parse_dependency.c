@@ -7,17 +7,22 @@
 #include "AST/ast.h"
 #include "DRVR/compiler.h"
 #include "DRVR/object.h"
+#include "LEX/lex_pool.h"
 #include "LEX/token.h"
 #include "PARSE/parse.h"
 #include "PARSE/parse_ctx.h"
 #include "PARSE/parse_dependency.h"
 #include "TOKEN/token_data.h"
+#include "UTIL/color.h"
 #include "UTIL/filename.h"
 #include "UTIL/ground.h"
 #include "UTIL/string.h"
 #include "UTIL/string_list.h"
 #include "UTIL/util.h"
 
+static maybe_null_strong_cstr_t parse_search_for_import(compiler_t *compiler, weak_cstr_t local, weak_cstr_t filename);
+static maybe_null_strong_cstr_t parse_resolve_import_quietly(compiler_t *compiler, weak_cstr_t filename);
+
 errorcode_t parse_import(parse_ctx_t *ctx){
     // import 'some_file.adept'
     //   ^
@@ -139,6 +144,14 @@ errorcode_t parse_foreign_library(parse_ctx_t *ctx){
 }
 
 errorcode_t parse_import_object(parse_ctx_t *ctx, strong_cstr_t relative_filename, strong_cstr_t absolute_filename) {
+    // Sources can only refer to a limited number of files
+    if(ctx->compiler->objects_length > SOURCE_MAX_OBJECT_INDEX){
+        redprintf("Cannot import '%s', too many files have been imported\n", relative_filename);
+        free(relative_filename);
+        free(absolute_filename);
+        return FAILURE;
+    }
+
     object_t *new_object = compiler_new_object(ctx->compiler);
     new_object->filename = relative_filename;
     new_object->full_filename = absolute_filename;
@@ -195,26 +208,63 @@ maybe_null_strong_cstr_t parse_standard_library_component(parse_ctx_t *ctx, sour
     
     // Update source stride if using 'thing1/...'
     // HACK: For 'import thing1/thing2/thing3', assume that there are no spaces in between the slashes
-    if(full_component) out_source->stride = full_component_length;
+    if(full_component) out_source->stride = full_component_length < SOURCE_WIDE_STRIDE ? full_component_length : SOURCE_WIDE_STRIDE;
 
     return full_component ? full_component : strclone(first_part_of_component);
 }
 
 maybe_null_strong_cstr_t parse_find_import(parse_ctx_t *ctx, weak_cstr_t filename, source_t source, bool allow_local_import){
+    maybe_null_strong_cstr_t found = parse_find_import_quietly(ctx->compiler, ctx->object, filename, allow_local_import);
+    if(found) return found;
+
+    compiler_panicf(ctx->compiler, source, "The file '%s' doesn't exist", filename);
+    return NULL;
+}
+
+maybe_null_strong_cstr_t parse_find_import_quietly(compiler_t *compiler, object_t *object, weak_cstr_t filename, bool allow_local_import){
+    // Where a file is found only depends on the local candidate and the filename,
+    // since search paths are only ever appended to
+    strong_cstr_t local = allow_local_import ? filename_local(object->filename, filename) : strclone("");
+    length_t local_length = strlen(local);
+    length_t filename_length = strlen(filename);
+
+    // Key is "<local candidate>\0<filename>"
+    length_t key_length = local_length + 1 + filename_length;
+    char *key = malloc(key_length);
+    memcpy(key, local, local_length + 1);
+    memcpy(&key[local_length + 1], filename, filename_length);
+
+    maybe_null_weak_cstr_t remembered = filename_memo_get(&compiler->import_locations, key, key_length);
+
+    if(remembered){
+        free(key);
+        free(local);
+        return strclone(remembered);
+    }
+
+    maybe_null_strong_cstr_t found = parse_search_for_import(compiler, local, filename);
+
+    // NOTE: Only files that were found are remembered
+    if(found) filename_memo_set(&compiler->import_locations, key, key_length, strclone(found));
+
+    free(key);
+    free(local);
+    return found;
+}
+
+static maybe_null_strong_cstr_t parse_search_for_import(compiler_t *compiler, weak_cstr_t local, weak_cstr_t filename){
     strong_cstr_t test;
 
-    if(allow_local_import){
-        test = filename_local(ctx->object->filename, filename);
-        if(file_exists(test)) return test;
-        free(test);
+    if(local[0] != '\0' && file_exists(local)){
+        return strclone(local);
     }
 
-    test = filename_adept_import(ctx->compiler->root, filename);
+    test = filename_adept_import(compiler->root, filename);
     if(file_exists(test)) return test;
     free(test);
 
-    for(length_t i = 0; i != ctx->compiler->user_search_paths.length; i++){
-        weak_cstr_t path = ctx->compiler->user_search_paths.items[i];
+    for(length_t i = 0; i != compiler->user_search_paths.length; i++){
+        weak_cstr_t path = compiler->user_search_paths.items[i];
         length_t path_length = strlen(path);
         
         bool append_slash = path_length && path[path_length - 1] != '/' && path[path_length - 1] != '\\';
@@ -224,25 +274,92 @@ maybe_null_strong_cstr_t parse_find_import(parse_ctx_t *ctx, weak_cstr_t filenam
         free(test);
     }
     
-    compiler_panicf(ctx->compiler, source, "The file '%s' doesn't exist", filename);
     return NULL;
 }
 
 maybe_null_strong_cstr_t parse_resolve_import(parse_ctx_t *ctx, weak_cstr_t filename){
-    char *absolute = filename_absolute(filename);
+    char *absolute = parse_resolve_import_quietly(ctx->compiler, filename);
     if(absolute) return absolute;
 
     compiler_panicf(ctx->compiler, parse_ctx_peek_source(ctx), "INTERNAL ERROR: Failed to get absolute path of filename '%s'", filename);
     return NULL;
 }
 
+static maybe_null_strong_cstr_t parse_resolve_import_quietly(compiler_t *compiler, weak_cstr_t filename){
+    length_t filename_length = strlen(filename);
+    maybe_null_weak_cstr_t remembered = filename_memo_get(&compiler->import_absolutes, filename, filename_length);
+    if(remembered) return strclone(remembered);
+
+    maybe_null_strong_cstr_t absolute = filename_absolute(filename);
+    if(absolute) filename_memo_set(&compiler->import_absolutes, filename, filename_length, strclone(absolute));
+    return absolute;
+}
+
 bool already_imported(parse_ctx_t *ctx, weak_cstr_t filename){
-    object_t **objects = ctx->compiler->objects;
-    length_t objects_length = ctx->compiler->objects_length;
+    compiler_t *compiler = ctx->compiler;
+    object_t **objects = compiler->objects;
 
-    for(length_t i = 0; i != objects_length; i++){
-        if(streq(objects[i]->full_filename, filename)) return true;
+    // Catch up on objects created since the last time
+    for(; compiler->object_filenames_length != compiler->objects_length; compiler->object_filenames_length++){
+        weak_cstr_t full_filename = objects[compiler->object_filenames_length]->full_filename;
+        if(full_filename) intern_table_insert(&compiler->object_filenames, full_filename, strlen(full_filename), NULL);
     }
 
-    return false;
+    return intern_table_find(&compiler->object_filenames, filename, strlen(filename), NULL);
+}
+
+void parse_prefetch_imports(parse_ctx_t *ctx){
+    // NOTE: Imports are only guessed here, 'parse_import' still decides
+    // which files get imported, and unused guesses are discarded
+
+    lex_pool_t *pool = ctx->compiler->lex_pool;
+    if(pool == NULL) return;
+
+    token_t *tokens = ctx->tokenlist->tokens;
+    length_t tokens_length = ctx->tokenlist->length;
+
+    for(length_t i = 0; i + 1 < tokens_length; i++){
+        if(tokens[i].id != TOKEN_IMPORT) continue;
+
+        maybe_null_strong_cstr_t target;
+        tokenid_t next = tokens[i + 1].id;
+
+        if(next == TOKEN_STRING || next == TOKEN_CSTRING){
+            // import 'some_file.adept'
+            target = parse_find_import_quietly(ctx->compiler, ctx->object, ((token_string_data_t*) tokens[i + 1].data)->array, true);
+        } else if(next == TOKEN_WORD){
+            // import standard_library/component
+            strong_cstr_t standard_library_folder = compiler_get_stdlib(ctx->compiler, ctx->object);
+            strong_cstr_t file = mallocandsprintf("%s%s", standard_library_folder, tokens[++i].data);
+            free(standard_library_folder);
+
+            while(i + 2 < tokens_length && tokens[i + 1].id == TOKEN_DIVIDE && tokens[i + 2].id == TOKEN_WORD){
+                strong_cstr_t longer = mallocandsprintf("%s/%s", file, tokens[i + 2].data);
+                free(file);
+                file = longer;
+                i += 2;
+            }
+
+            strong_cstr_t component_file = mallocandsprintf("%s.adept", file);
+            free(file);
+
+            target = parse_find_import_quietly(ctx->compiler, ctx->object, component_file, false);
+            free(component_file);
+        } else {
+            continue;
+        }
+
+        if(target == NULL) continue;
+
+        maybe_null_strong_cstr_t absolute = parse_resolve_import_quietly(ctx->compiler, target);
+        free(target);
+
+        if(absolute == NULL) continue;
+
+        if(already_imported(ctx, absolute)){
+            free(absolute);
+        } else {
+            lex_pool_submit(pool, absolute);
+        }
+    }
 }
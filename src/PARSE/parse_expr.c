@@ -6,6 +6,7 @@
 
 #include "AST/ast.h"
 #include "AST/ast_expr.h"
+#include "AST/ast_pool.h"
 #include "AST/ast_type.h"
 #include "AST/meta_directives.h"
 #include "DRVR/compiler.h"
@@ -19,6 +20,7 @@
 #include "UTIL/datatypes.h"
 #include "UTIL/filename.h"
 #include "UTIL/ground.h"
+#include "UTIL/string_list.h"
 #include "UTIL/trait.h"
 #include "UTIL/util.h"
 
@@ -38,7 +40,7 @@ errorcode_t parse_primary_expr(parse_ctx_t *ctx, ast_expr_t **out_expr){
     source_t *sources = ctx->tokenlist->sources;
 
     #define LITERAL_TO_EXPR(expr_type, expr_id, storage_type){                \
-        *out_expr = (ast_expr_t*) malloc(sizeof(expr_type));                  \
+        *out_expr = (ast_expr_t*) ast_alloc(sizeof(expr_type));               \
         ((expr_type *)*out_expr)->id = expr_id;                               \
         ((expr_type *)*out_expr)->value = *((storage_type *)tokens[*i].data); \
         ((expr_type *)*out_expr)->source = sources[(*i)++];                   \
@@ -289,7 +291,9 @@ errorcode_t parse_primary_expr(parse_ctx_t *ctx, ast_expr_t **out_expr){
             maybe_null_weak_cstr_t filename = parse_eat_string(ctx, "Expected filename after 'embed' keyword");
             if(filename == NULL) return FAILURE;
 
-            *out_expr = ast_expr_create_embed(filename_local(ctx->object->filename, filename), source);
+            strong_cstr_t embedded_filename = filename_local(ctx->object->filename, filename);
+            strong_cstr_list_append(&ctx->compiler->embedded_files, strclone(embedded_filename));
+            *out_expr = ast_expr_create_embed(embedded_filename, source);
         }
         break;
     case TOKEN_ASSOCIATE: {
@@ -351,11 +355,12 @@ errorcode_t parse_expr_post(parse_ctx_t *ctx, ast_expr_t **inout_expr){
 
                 source_t source = parse_ctx_peek_source(ctx);
 
-                strong_cstr_t name = parse_take_word(ctx, "Expected identifier after '.' operator");
+                // NOTE: Interned, so only copied when ownership is required
+                weak_cstr_t name = parse_eat_word(ctx, "Expected identifier after '.' operator");
                 if(name == NULL) return FAILURE;
 
                 if(parse_eat(ctx, TOKEN_OPEN, NULL) == SUCCESS){
-                    ast_expr_call_method_t *call_expr = (ast_expr_call_method_t*) ast_expr_create_call_method(name, *inout_expr, 0, NULL, is_tentative, false, NULL, source);
+                    ast_expr_call_method_t *call_expr = (ast_expr_call_method_t*) ast_expr_create_call_method(strclone(name), *inout_expr, 0, NULL, is_tentative, false, NULL, source);
 
                     // value.method(arg1, arg2, ...)
                     //              ^
@@ -366,7 +371,7 @@ errorcode_t parse_expr_post(parse_ctx_t *ctx, ast_expr_t **inout_expr){
                     if(parse_expr_arguments(ctx, &call_expr->args, &call_expr->arity, NULL)){
                         ctx->ignore_newlines_in_expr_depth--;
                         free(call_expr->name);
-                        free(call_expr);
+                        ast_release(call_expr);
                         return FAILURE;
                     }
 
@@ -377,7 +382,7 @@ errorcode_t parse_expr_post(parse_ctx_t *ctx, ast_expr_t **inout_expr){
                         if(parse_type(ctx, &call_expr->gives)){
                             ast_exprs_free_fully(call_expr->args, call_expr->arity);
                             free(call_expr->name);
-                            free(call_expr);
+                            ast_release(call_expr);
                             return FAILURE;
                         }
                     } else {
@@ -844,7 +849,7 @@ errorcode_t parse_expr_enum_value(parse_ctx_t *ctx, ast_expr_t **out_expr){
 }
 
 errorcode_t parse_expr_address(parse_ctx_t *ctx, ast_expr_t **out_expr){
-    ast_expr_unary_t *addr_expr = malloc(sizeof(ast_expr_unary_t));
+    ast_expr_unary_t *addr_expr = ast_alloc(sizeof(ast_expr_unary_t));
     addr_expr->id = EXPR_ADDRESS;
     addr_expr->source = ctx->tokenlist->sources[(*ctx->i)++];
 
@@ -864,7 +869,7 @@ errorcode_t parse_expr_address(parse_ctx_t *ctx, ast_expr_t **out_expr){
 }
 
 int parse_expr_func_address(parse_ctx_t *ctx, ast_expr_t **out_expr){
-    ast_expr_func_addr_t *func_addr_expr = malloc(sizeof(ast_expr_func_addr_t));
+    ast_expr_func_addr_t *func_addr_expr = ast_alloc(sizeof(ast_expr_func_addr_t));
 
     length_t *i = ctx->i;
     token_t *tokens = ctx->tokenlist->tokens;
@@ -884,14 +889,14 @@ int parse_expr_func_address(parse_ctx_t *ctx, ast_expr_t **out_expr){
     }
 
     if(parse_eat(ctx, TOKEN_ADDRESS, "Expected '&' after 'func' keyword in expression")){
-        free(func_addr_expr);
+        ast_release(func_addr_expr);
         return FAILURE;
     }
 
     func_addr_expr->name = parse_eat_word(ctx, "Expected function name after 'func &' operator");
 
     if(func_addr_expr->name == NULL){
-        free(func_addr_expr);
+        ast_release(func_addr_expr);
         return FAILURE;
     }
 
@@ -910,7 +915,7 @@ int parse_expr_func_address(parse_ctx_t *ctx, ast_expr_t **out_expr){
 
             if(parse_ignore_newlines(ctx, "Expected function argument") || parse_type(ctx, &arg_type)){
                 ast_types_free_fully(args, arity);
-                free(func_addr_expr);
+                ast_release(func_addr_expr);
                 return FAILURE;
             }
 
@@ -920,13 +925,13 @@ int parse_expr_func_address(parse_ctx_t *ctx, ast_expr_t **out_expr){
                 if(tokens[++(*i)].id == TOKEN_CLOSE){
                     compiler_panic(ctx->compiler, ctx->tokenlist->sources[*i], "Expected type after ',' in argument list");
                     ast_types_free_fully(args, arity);
-                    free(func_addr_expr);
+                    ast_release(func_addr_expr);
                     return FAILURE;
                 }
             } else if(tokens[*i].id != TOKEN_CLOSE){
                 compiler_panic(ctx->compiler, ctx->tokenlist->sources[*i], "Expected ',' after argument type");
                 ast_types_free_fully(args, arity);
-                free(func_addr_expr);
+                ast_release(func_addr_expr);
                 return FAILURE;
             }
         }
@@ -941,7 +946,7 @@ int parse_expr_func_address(parse_ctx_t *ctx, ast_expr_t **out_expr){
 }
 
 errorcode_t parse_expr_dereference(parse_ctx_t *ctx, ast_expr_t **out_expr){
-    ast_expr_unary_t *deref_expr = malloc(sizeof(ast_expr_unary_t));
+    ast_expr_unary_t *deref_expr = ast_alloc(sizeof(ast_expr_unary_t));
     deref_expr->id = EXPR_DEREFERENCE;
     deref_expr->source = ctx->tokenlist->sources[(*ctx->i)++];
     
@@ -990,7 +995,7 @@ errorcode_t parse_expr_cast(parse_ctx_t *ctx, ast_expr_t **out_expr){
         return FAILURE;
     }
 
-    ast_expr_cast_t *cast_expr = malloc(sizeof(ast_expr_cast_t));
+    ast_expr_cast_t *cast_expr = ast_alloc(sizeof(ast_expr_cast_t));
     cast_expr->id = EXPR_CAST;
     cast_expr->source = source;
     cast_expr->to = to;
@@ -1023,7 +1028,7 @@ errorcode_t parse_expr_at(parse_ctx_t *ctx, ast_expr_t **inout_expr){
     ast_expr_t *index_expr;
     if(parse_primary_expr(ctx, &index_expr)) return FAILURE;
 
-    ast_expr_array_access_t *at_expr = malloc(sizeof(ast_expr_array_access_t));
+    ast_expr_array_access_t *at_expr = ast_alloc(sizeof(ast_expr_array_access_t));
     at_expr->id = EXPR_AT;
     at_expr->source = source;
     at_expr->value = *inout_expr;
@@ -1042,7 +1047,7 @@ errorcode_t parse_expr_sizeof(parse_ctx_t *ctx, ast_expr_t **out_expr){
         ast_expr_t *value;
         if(parse_primary_expr(ctx, &value)) return FAILURE;
 
-        ast_expr_sizeof_value_t *sizeof_value_expr = malloc(sizeof(ast_expr_sizeof_value_t));
+        ast_expr_sizeof_value_t *sizeof_value_expr = ast_alloc(sizeof(ast_expr_sizeof_value_t));
         sizeof_value_expr->id = EXPR_SIZEOF_VALUE;
         sizeof_value_expr->source = source;
         sizeof_value_expr->value = value;
@@ -1053,7 +1058,7 @@ errorcode_t parse_expr_sizeof(parse_ctx_t *ctx, ast_expr_t **out_expr){
         ast_type_t type;
         if(parse_type(ctx, &type)) return FAILURE;
 
-        ast_expr_sizeof_t *sizeof_expr = malloc(sizeof(ast_expr_sizeof_t));
+        ast_expr_sizeof_t *sizeof_expr = ast_alloc(sizeof(ast_expr_sizeof_t));
         sizeof_expr->id = EXPR_SIZEOF;
         sizeof_expr->source = source;
         sizeof_expr->type = type;
@@ -1072,7 +1077,7 @@ errorcode_t parse_expr_alignof(parse_ctx_t *ctx, ast_expr_t **out_expr){
     ast_type_t type;
     if(parse_type(ctx, &type)) return FAILURE;
 
-    ast_expr_alignof_t *alignof_expr = malloc(sizeof(ast_expr_alignof_t));
+    ast_expr_alignof_t *alignof_expr = ast_alloc(sizeof(ast_expr_alignof_t));
     alignof_expr->id = EXPR_ALIGNOF;
     alignof_expr->source = source;
     alignof_expr->type = type;
@@ -1087,7 +1092,7 @@ errorcode_t parse_expr_unary(parse_ctx_t *ctx, unsigned int expr_id, ast_expr_t
     ast_expr_t *value;
     if(parse_primary_expr(ctx, &value)) return FAILURE;
 
-    ast_expr_unary_t *unary_expr = malloc(sizeof(ast_expr_unary_t));
+    ast_expr_unary_t *unary_expr = ast_alloc(sizeof(ast_expr_unary_t));
     unary_expr->id = expr_id;
     unary_expr->source = source;
     unary_expr->value = value;
@@ -1110,7 +1115,7 @@ errorcode_t parse_expr_new(parse_ctx_t *ctx, ast_expr_t **out_expr){
 
         token_string_data_t *string_data = (token_string_data_t*) parse_ctx_peek_data(ctx);
 
-        *out_expr = (ast_expr_t*) malloc_init(ast_expr_new_cstring_t, {
+        *out_expr = (ast_expr_t*) ast_alloc_init(ast_expr_new_cstring_t, {
             .id = EXPR_NEW_CSTRING,
             .source = source,
             .array = string_data->array,
@@ -1121,7 +1126,7 @@ errorcode_t parse_expr_new(parse_ctx_t *ctx, ast_expr_t **out_expr){
         return SUCCESS;
     }
 
-    ast_expr_new_t *new_expr = malloc(sizeof(ast_expr_new_t));
+    ast_expr_new_t *new_expr = ast_alloc(sizeof(ast_expr_new_t));
 
     *new_expr = (ast_expr_new_t){
         .id = EXPR_NEW,
@@ -1171,11 +1176,11 @@ errorcode_t parse_expr_static(parse_ctx_t *ctx, ast_expr_t **out_expr){
     token_t *tokens = ctx->tokenlist->tokens;
     source_t *sources = ctx->tokenlist->sources;
 
-    ast_expr_static_data_t *static_array = malloc(sizeof(ast_expr_static_data_t));
+    ast_expr_static_data_t *static_array = ast_alloc(sizeof(ast_expr_static_data_t));
     static_array->source = sources[(*i)++];
 
     if(parse_type(ctx, &static_array->type)){
-        free(static_array);
+        ast_release(static_array);
         return FAILURE;
     }
 
@@ -1285,12 +1290,12 @@ errorcode_t parse_expr_def(parse_ctx_t *ctx, ast_expr_t **out_expr){
 }
 
 errorcode_t parse_expr_typeinfo(parse_ctx_t *ctx, ast_expr_t **out_expr){
-    ast_expr_typeinfo_t *typeinfo = malloc(sizeof(ast_expr_typeinfo_t));
+    ast_expr_typeinfo_t *typeinfo = ast_alloc(sizeof(ast_expr_typeinfo_t));
     typeinfo->id = EXPR_TYPEINFO;
     typeinfo->source = ctx->tokenlist->sources[(*ctx->i)++];
 
     if(parse_type(ctx, &typeinfo->type)){
-        free(typeinfo);
+        ast_release(typeinfo);
         return FAILURE;
     }
 
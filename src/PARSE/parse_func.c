@@ -7,6 +7,7 @@
 #include "AST/TYPE/ast_type_make.h"
 #include "AST/ast.h"
 #include "AST/ast_expr.h"
+#include "AST/ast_pool.h"
 #include "AST/ast_type.h"
 #include "DRVR/compiler.h"
 #include "LEX/token.h"
@@ -976,7 +977,7 @@ void parse_collapse_polycount_var_fixed_arrays_for_type(ast_type_t *type){
                 ast_elem_free(type->elements[i]);
 
                 // Replace with unwrapped version
-                ast_elem_polycount_t *new_elem = (ast_elem_polycount_t*) malloc(sizeof(ast_elem_polycount_t));
+                ast_elem_polycount_t *new_elem = (ast_elem_polycount_t*) ast_alloc(sizeof(ast_elem_polycount_t));
 
                 *new_elem = (ast_elem_polycount_t){
                     .id =  AST_ELEM_POLYCOUNT,
@@ -38,7 +38,8 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
         "enable_warnings", "entry_point", "help", "ignore_all", "ignore_deprecation", "ignore_early_return", "ignore_obsolete",
         "ignore_partial_support", "ignore_unrecognized_directives", "ignore_unused", "libm", "linux_only", "mac_only", "mwindows",
         "no_type_info", "no_typeinfo", "no_undef", "null_checks", "optimization", "options", "package", "project_name", "search_path",
-        "short_warnings", "unsafe_meta", "unsafe_new", "unsupported", "warn_as_error", "warn_short", "windowed", "windows_only", "windres"
+        "short_warnings", "target_cpu", "target_features", "unsafe_meta", "unsafe_new", "unsupported", "warn_as_error", "warn_short",
+        "windowed", "windows_only", "windres"
     };
 
     const length_t directives_length = sizeof(directives) / sizeof(const char * const);
@@ -77,14 +78,16 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
     #define PRAGMA_PROJECT_NAME                     0x0000001C
     #define PRAGMA_SEARCH_PATH                      0x0000001D
     #define PRAGMA_SHORT_WARNINGS                   0x0000001E
-    #define PRAGMA_UNSAFE_META                      0x0000001F
-    #define PRAGMA_UNSAFE_NEW                       0x00000020
-    #define PRAGMA_UNSUPPORTED                      0x00000021
-    #define PRAGMA_WARN_AS_ERROR                    0x00000022
-    #define PRAGMA_WARN_SHORT                       0x00000023
-    #define PRAGMA_WINDOWED                         0x00000024
-    #define PRAGMA_WINDOWS_ONLY                     0x00000025
-    #define PRAGMA_WINDRES                          0x00000026
+    #define PRAGMA_TARGET_CPU                       0x0000001F
+    #define PRAGMA_TARGET_FEATURES                  0x00000020
+    #define PRAGMA_UNSAFE_META                      0x00000021
+    #define PRAGMA_UNSAFE_NEW                       0x00000022
+    #define PRAGMA_UNSUPPORTED                      0x00000023
+    #define PRAGMA_WARN_AS_ERROR                    0x00000024
+    #define PRAGMA_WARN_SHORT                       0x00000025
+    #define PRAGMA_WINDOWED                         0x00000026
+    #define PRAGMA_WINDOWS_ONLY                     0x00000027
+    #define PRAGMA_WINDRES                          0x00000028
 
     maybe_index_t directive = binary_string_search_const(directives, directives_length, directive_string);
 
@@ -301,7 +304,7 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
         read = parse_grab_word(ctx, "Expected optimization level after 'pragma optimization'");
 
         if(read == NULL){
-            printf("Possible levels are: none, less, normal or aggressive\n");
+            printf("Possible levels are: none, less, normal, aggressive, size or min_size\n");
             return FAILURE;
         }
 
@@ -311,10 +314,12 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
         else if(streq(read, "normal"))     ctx->compiler->optimization = OPTIMIZATION_DEFAULT;
         else if(streq(read, "aggressive")) ctx->compiler->optimization = OPTIMIZATION_AGGRESSIVE;
         else if(streq(read, "nothing"))    ctx->compiler->optimization = OPTIMIZATION_ABSOLUTELY_NOTHING;
+        else if(streq(read, "size"))       ctx->compiler->optimization = OPTIMIZATION_SIZE;
+        else if(streq(read, "min_size"))   ctx->compiler->optimization = OPTIMIZATION_MIN_SIZE;
         else {
             // Invalid optimization level
             compiler_panic(ctx->compiler, ctx->tokenlist->sources[*i], "Invalid optimization level after 'pragma optimization'");
-            printf("Possible levels are: none, less, normal or aggressive\n");
+            printf("Possible levels are: none, less, normal, aggressive, size or min_size\n");
             return FAILURE;
         }
         return SUCCESS;
@@ -339,6 +344,18 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
 
         compiler_add_user_search_path(ctx->compiler, read, ctx->object->full_filename);
         return SUCCESS;
+    case PRAGMA_TARGET_CPU: // 'target_cpu' directive
+        read = parse_grab_string(ctx, "Expected CPU name after 'pragma target_cpu', such as 'native' or 'x86-64-v3'");
+        if(read == NULL) return FAILURE;
+
+        compiler_set_target_cpu(ctx->compiler, read);
+        return SUCCESS;
+    case PRAGMA_TARGET_FEATURES: // 'target_features' directive
+        read = parse_grab_string(ctx, "Expected feature list after 'pragma target_features', such as '+avx2,+fma'");
+        if(read == NULL) return FAILURE;
+
+        compiler_set_target_features(ctx->compiler, read);
+        return SUCCESS;
     case PRAGMA_UNSAFE_META: // 'unsafe_meta' directive
         ctx->compiler->traits |= COMPILER_UNSAFE_META;
         return SUCCESS;
@@ -5,6 +5,7 @@
 
 #include "AST/ast_expr.h"
 #include "AST/ast_named_expression.h"
+#include "AST/ast_pool.h"
 #include "AST/ast_type.h"
 #include "DRVR/compiler.h"
 #include "DRVR/object.h"
@@ -255,7 +256,7 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
 
                 if(conditional == NULL){
                     // 'while continue' or 'until break' loop
-                    ast_expr_whilecontinue_t *stmt = malloc(sizeof(ast_expr_whilecontinue_t));
+                    ast_expr_whilecontinue_t *stmt = ast_alloc(sizeof(ast_expr_whilecontinue_t));
                     stmt->id = (conditional_type == TOKEN_UNTIL) ? EXPR_UNTILBREAK : EXPR_WHILECONTINUE;
                     stmt->source = source;
                     stmt->label = label;
@@ -264,7 +265,7 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
                     ast_expr_list_append_unchecked(stmt_list, (ast_expr_t*) stmt);
                 } else {
                     // 'while <expr>' or 'until <expr>' loop
-                    ast_expr_while_t *stmt = malloc(sizeof(ast_expr_while_t));
+                    ast_expr_while_t *stmt = ast_alloc(sizeof(ast_expr_while_t));
                     stmt->id = (conditional_type == TOKEN_UNTIL) ? EXPR_UNTIL : EXPR_WHILE;
                     stmt->source = source;
                     stmt->label = label;
@@ -394,7 +395,7 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
                 }
 
                 // 'each in list' or 'each in [array, length]
-                ast_expr_each_in_t *stmt = malloc(sizeof(ast_expr_each_in_t));
+                ast_expr_each_in_t *stmt = ast_alloc(sizeof(ast_expr_each_in_t));
                 stmt->id = EXPR_EACH_IN;
                 stmt->source = source;
                 stmt->label = label;
@@ -469,7 +470,7 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
                     *i += 1;
                 }
 
-                ast_expr_repeat_t *stmt = malloc(sizeof(ast_expr_repeat_t));
+                ast_expr_repeat_t *stmt = ast_alloc(sizeof(ast_expr_repeat_t));
                 stmt->id = EXPR_REPEAT;
                 stmt->source = source;
                 stmt->label = label;
@@ -504,7 +505,7 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
             break;
         case TOKEN_BREAK: {
                 if(tokens[++(*i)].id == TOKEN_WORD){
-                    ast_expr_break_to_t *stmt = malloc(sizeof(ast_expr_break_to_t));
+                    ast_expr_break_to_t *stmt = ast_alloc(sizeof(ast_expr_break_to_t));
                     stmt->id = EXPR_BREAK_TO;
                     stmt->source = sources[*i - 1];
                     stmt->label_source = sources[*i];
@@ -513,7 +514,7 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
                     defer_scope_rewind(defer_scope, stmt_list, BREAKABLE, stmt->label);
                     ast_expr_list_append_unchecked(stmt_list, (ast_expr_t*) stmt);
                 } else {
-                    ast_expr_break_t *stmt = malloc(sizeof(ast_expr_break_t));
+                    ast_expr_break_t *stmt = ast_alloc(sizeof(ast_expr_break_t));
                     stmt->id = EXPR_BREAK;
                     stmt->source = sources[*i - 1];
 
@@ -524,7 +525,7 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
             break;
         case TOKEN_CONTINUE: {
                 if(tokens[++(*i)].id == TOKEN_WORD){
-                    ast_expr_continue_to_t *stmt = malloc(sizeof(ast_expr_continue_to_t));
+                    ast_expr_continue_to_t *stmt = ast_alloc(sizeof(ast_expr_continue_to_t));
                     stmt->id = EXPR_CONTINUE_TO;
                     stmt->source = sources[*i - 1];
                     stmt->label_source = sources[*i];
@@ -533,7 +534,7 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
                     defer_scope_rewind(defer_scope, stmt_list, CONTINUABLE, stmt->label);
                     ast_expr_list_append_unchecked(stmt_list, (ast_expr_t*) stmt);
                 } else {
-                    ast_expr_continue_t *stmt = malloc(sizeof(ast_expr_continue_t));
+                    ast_expr_continue_t *stmt = ast_alloc(sizeof(ast_expr_continue_t));
                     stmt->id = EXPR_CONTINUE;
                     stmt->source = sources[*i - 1];
 
@@ -543,7 +544,7 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
             }
             break;
         case TOKEN_FALLTHROUGH: {
-                ast_expr_fallthrough_t *stmt = malloc(sizeof(ast_expr_fallthrough_t));
+                ast_expr_fallthrough_t *stmt = ast_alloc(sizeof(ast_expr_fallthrough_t));
 
                 *stmt = (ast_expr_fallthrough_t){
                     .id = EXPR_FALLTHROUGH,
@@ -1014,7 +1015,7 @@ errorcode_t parse_conditionless_block(parse_ctx_t *ctx, ast_expr_list_t *stmt_li
 
     defer_scope_free(&block_defer_scope);
 
-    ast_expr_list_append_unchecked(stmt_list, (ast_expr_t*) malloc_init(ast_expr_conditionless_block_t, {
+    ast_expr_list_append_unchecked(stmt_list, (ast_expr_t*) ast_alloc_init(ast_expr_conditionless_block_t, {
         .id = EXPR_CONDITIONLESS_BLOCK,
         .source = source,
         .statements = block_stmt_list,
@@ -1036,7 +1037,7 @@ errorcode_t parse_assert(parse_ctx_t *ctx, ast_expr_list_t *stmt_list){
         goto failure;
     }
 
-    ast_expr_list_append_unchecked(stmt_list, (ast_expr_t*) malloc_init(ast_expr_assert_t, {
+    ast_expr_list_append_unchecked(stmt_list, (ast_expr_t*) ast_alloc_init(ast_expr_assert_t, {
         .id = EXPR_ASSERT,
         .source = source,
         .assertion = assertion,
@@ -1129,7 +1130,7 @@ errorcode_t parse_onetime_conditional(parse_ctx_t *ctx, ast_expr_list_t *stmt_li
             *i += 1;
         }
 
-        ast_expr_ifelse_t *stmt = malloc(sizeof(ast_expr_ifelse_t));
+        ast_expr_ifelse_t *stmt = ast_alloc(sizeof(ast_expr_ifelse_t));
         stmt->id = (conditional_type == TOKEN_UNLESS) ? EXPR_UNLESSELSE : EXPR_IFELSE;
         stmt->source = source;
         stmt->label = NULL;
@@ -1232,7 +1233,7 @@ errorcode_t parse_ambiguous_open_bracket(parse_ctx_t *ctx, ast_expr_list_t *stmt
 
         for(length_t i = 0; i != expr_list.length; i++){
             ast_elem_var_fixed_array_t **element = (ast_elem_var_fixed_array_t**) &new_elements[i];
-            *element = malloc(sizeof(ast_elem_var_fixed_array_t));
+            *element = ast_alloc(sizeof(ast_elem_var_fixed_array_t));
             (*element)->id = AST_ELEM_VAR_FIXED_ARRAY;
             (*element)->source = expr_source_list[i];
             (*element)->length = expr_list.statements[i];
@@ -1524,7 +1525,7 @@ errorcode_t parse_llvm_asm(parse_ctx_t *ctx, ast_expr_list_t *stmt_list){
     // Move past closing ')'
     *i += 1;
 
-    ast_expr_llvm_asm_t *stmt = malloc(sizeof(ast_expr_llvm_asm_t));
+    ast_expr_llvm_asm_t *stmt = ast_alloc(sizeof(ast_expr_llvm_asm_t));
     stmt->id = EXPR_LLVM_ASM;
     stmt->source = source;
     stmt->assembly = strong_cstr_empty_if_null(assembly);
@@ -723,7 +723,7 @@ errorcode_t parse_create_record_constructor(parse_ctx_t *ctx, weak_cstr_t name,
         ast_expr_t *master = ast_expr_create_variable(master_variable_name, source);
 
         // Member value
-        ast_expr_t *mutable_expression = ast_expr_create_member(master, strclone(field_name), source);
+        ast_expr_t *mutable_expression = ast_expr_create_member(master, intern_table_insert_cstr(&ctx->compiler->symbols, field_name), source);
 
         // Argument variable
         ast_expr_t *variable = ast_expr_create_variable(field_name, source);
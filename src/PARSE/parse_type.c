@@ -7,6 +7,7 @@
 #include "AST/ast.h"
 #include "AST/ast_expr.h"
 #include "AST/ast_layout.h"
+#include "AST/ast_pool.h"
 #include "AST/ast_type.h"
 #include "DRVR/compiler.h"
 #include "LEX/token.h"
@@ -60,7 +61,7 @@ errorcode_t parse_type(parse_ctx_t *ctx, ast_type_t *out_type){
                     is_volatile = true;
                 }
 
-                out_type->elements[out_type->elements_length++] = (ast_elem_t*) malloc_init(ast_elem_pointer_t, {
+                out_type->elements[out_type->elements_length++] = (ast_elem_t*) ast_alloc_init(ast_elem_pointer_t, {
                     .id = AST_ELEM_POINTER,
                     .source = sources[*i],
                     .is_volatile = is_volatile,
@@ -79,7 +80,7 @@ errorcode_t parse_type(parse_ctx_t *ctx, ast_type_t *out_type){
                 ast_expr_t *length;
                 if(parse_expr(ctx, &length)) goto failure;
 
-                out_type->elements[out_type->elements_length++] = (ast_elem_t*) malloc_init(ast_elem_var_fixed_array_t, {
+                out_type->elements[out_type->elements_length++] = (ast_elem_t*) ast_alloc_init(ast_elem_var_fixed_array_t, {
                     .id = AST_ELEM_VAR_FIXED_ARRAY,
                     .source = sources[*i],
                     .length = length,
@@ -90,7 +91,7 @@ errorcode_t parse_type(parse_ctx_t *ctx, ast_type_t *out_type){
             }
             break;
         case TOKEN_POLYCOUNT: {
-                out_type->elements[out_type->elements_length++] = (ast_elem_t*) malloc_init(ast_elem_polycount_t, {
+                out_type->elements[out_type->elements_length++] = (ast_elem_t*) ast_alloc_init(ast_elem_polycount_t, {
                     .id = AST_ELEM_POLYCOUNT,
                     .name = parse_ctx_peek_data_take(ctx),
                     .source = sources[*i],
@@ -111,10 +112,10 @@ errorcode_t parse_type(parse_ctx_t *ctx, ast_type_t *out_type){
         }
         break;
     case TOKEN_FUNC: case TOKEN_STDCALL: {
-            ast_elem_func_t *func_elem = malloc(sizeof(ast_elem_func_t));
+            ast_elem_func_t *func_elem = ast_alloc(sizeof(ast_elem_func_t));
 
             if(parse_type_func(ctx, func_elem)){
-                free(func_elem);
+                ast_release(func_elem);
                 goto failure;
             }
 
@@ -140,7 +141,7 @@ errorcode_t parse_type(parse_ctx_t *ctx, ast_type_t *out_type){
             // Pass over closing ')'
             (*i)++;
             
-            ast_elem_layout_t *layout_elem = malloc(sizeof(ast_elem_layout_t));
+            ast_elem_layout_t *layout_elem = ast_alloc(sizeof(ast_elem_layout_t));
             layout_elem->id = AST_ELEM_LAYOUT;
             layout_elem->source = sources[*i];
             ast_layout_init(&layout_elem->layout, layout_kind, field_map, skeleton, traits);
@@ -280,7 +281,7 @@ errorcode_t parse_type(parse_ctx_t *ctx, ast_type_t *out_type){
                 return FAILURE;
             }
 
-            out_type->elements[out_type->elements_length] = (ast_elem_t*) malloc_init(ast_elem_anonymous_enum_t, {
+            out_type->elements[out_type->elements_length] = (ast_elem_t*) ast_alloc_init(ast_elem_anonymous_enum_t, {
                 .id = AST_ELEM_ANONYMOUS_ENUM,
                 .source = source,
                 .kinds = kinds,
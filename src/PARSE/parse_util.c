@@ -35,7 +35,7 @@ void parse_panic_token(parse_ctx_t *ctx, source_t source, unsigned int token_id,
     if(ctx->object->traits & OBJECT_PACKAGE){
         printf("%s: ", filename_name_const(ctx->object->filename));
     } else {
-        lex_get_location(ctx->object->buffer, source.index, &line, &column);
+        lex_get_object_location(ctx->object, source.index, &line, &column);
         printf("%s:%d:%d: ", filename_name_const(ctx->object->filename), line, column);
     }
 
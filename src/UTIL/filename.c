@@ -24,6 +24,7 @@
 #include "UTIL/filename.h"
 #include "UTIL/ground.h"
 #include "UTIL/string.h"
+#include "UTIL/util.h"
 
 strong_cstr_t filename_name(const char *filename){
     length_t i;
@@ -308,3 +309,39 @@ void filename_prepend_dotslash_if_needed(strong_cstr_t *filename){
 	}
 }
 
+void filename_memo_init(filename_memo_t *memo){
+    intern_table_init(&memo->keys);
+    memo->values = NULL;
+    memo->values_capacity = 0;
+}
+
+void filename_memo_free(filename_memo_t *memo){
+    for(length_t i = 0; i != memo->keys.length; i++){
+        free(memo->values[i]);
+    }
+
+    free(memo->values);
+    intern_table_free(&memo->keys);
+}
+
+maybe_null_weak_cstr_t filename_memo_get(filename_memo_t *memo, const char *key, length_t key_length){
+    symbol_id_t id;
+    return intern_table_find(&memo->keys, key, key_length, &id) ? memo->values[id] : NULL;
+}
+
+void filename_memo_set(filename_memo_t *memo, const char *key, length_t key_length, strong_cstr_t filename){
+    length_t old_length = memo->keys.length;
+
+    symbol_id_t id;
+    intern_table_insert(&memo->keys, key, key_length, &id);
+
+    if(id != old_length){
+        // Already remembered, replace it
+        free(memo->values[id]);
+        memo->values[id] = filename;
+        return;
+    }
+
+    expand((void**) &memo->values, sizeof(strong_cstr_t), old_length, &memo->values_capacity, 1, 16);
+    memo->values[id] = filename;
+}
@@ -1,13 +1,108 @@
 
+#include <stdint.h>
+#include <string.h>
+
 #include "UTIL/ground.h"
 #include "UTIL/hash.h"
 
+// Hashing is based on wyhash (public domain), which reads 8 or 16 bytes
+// at a time and mixes them using full 64x64 -> 128-bit multiplications
+
+static const uint64_t hash_secret[4] = {
+    0x2d358dccaa6c78a5ull,
+    0x8bb84b93962eacc9ull,
+    0x4b33a62ed433d4a3ull,
+    0x4d5a2da51de1aa47ull,
+};
+
+// Starting seed, equal to 'hash_mix(hash_secret[0], hash_secret[1])'
+#define HASH_SEED 0xca813bf4c7abf0a9ull
+
+static inline void hash_multiply(uint64_t *a, uint64_t *b){
+    // Replaces 'a' and 'b' with the low and high halves of their 128-bit product
+    #if defined(__SIZEOF_INT128__)
+    __uint128_t product = (__uint128_t) *a * *b;
+    *a = (uint64_t) product;
+    *b = (uint64_t) (product >> 64);
+    #else
+    uint64_t a_high = *a >> 32, a_low = (uint32_t) *a;
+    uint64_t b_high = *b >> 32, b_low = (uint32_t) *b;
+    uint64_t high_high = a_high * b_high, high_low = a_high * b_low;
+    uint64_t low_high = a_low * b_high, low_low = a_low * b_low;
+    uint64_t middle = high_low + (low_low >> 32) + (uint32_t) low_high;
+    *a = (middle << 32) | (uint32_t) low_low;
+    *b = high_high + (middle >> 32) + (low_high >> 32);
+    #endif
+}
+
+static inline uint64_t hash_mix(uint64_t a, uint64_t b){
+    hash_multiply(&a, &b);
+    return a ^ b;
+}
+
+static inline uint64_t hash_read64(const uint8_t *p){
+    uint64_t value;
+    memcpy(&value, p, sizeof value);
+    return value;
+}
+
+static inline uint64_t hash_read32(const uint8_t *p){
+    uint32_t value;
+    memcpy(&value, p, sizeof value);
+    return value;
+}
+
 hash_t hash_data(const void *data, length_t size){
-    hash_t hash = 0;
-    for(length_t i = 0; i != size; i++){
-        hash = (hash * 31) + (hash_t)((char*) data)[i];
+    const uint8_t *p = (const uint8_t*) data;
+    uint64_t a, b;
+
+    if(size <= 16){
+        // Short keys (such as most identifiers) only need a single mix
+        if(size >= 4){
+            // Two (possibly overlapping) pairs of 32-bit reads cover the whole input
+            length_t offset = (size >> 3) << 2;
+            a = (hash_read32(p) << 32) | hash_read32(p + offset);
+            b = (hash_read32(p + size - 4) << 32) | hash_read32(p + size - 4 - offset);
+        } else if(size > 0){
+            a = ((uint64_t) p[0] << 16) | ((uint64_t) p[size >> 1] << 8) | p[size - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+
+        // The length goes in the top byte, which keys shorter than 4 bytes never use
+        return (hash_t) hash_mix(a ^ hash_secret[1] ^ ((uint64_t) size << 56), b ^ HASH_SEED);
     }
-    return hash;
+
+    uint64_t seed = HASH_SEED;
+    length_t remaining = size;
+
+    if(remaining > 48){
+        uint64_t seed1 = seed, seed2 = seed;
+
+        // Three independent lanes so that the multiplications can overlap
+        do {
+            seed  = hash_mix(hash_read64(p)      ^ hash_secret[1], hash_read64(p + 8)  ^ seed);
+            seed1 = hash_mix(hash_read64(p + 16) ^ hash_secret[2], hash_read64(p + 24) ^ seed1);
+            seed2 = hash_mix(hash_read64(p + 32) ^ hash_secret[3], hash_read64(p + 40) ^ seed2);
+            p += 48;
+            remaining -= 48;
+        } while(remaining > 48);
+
+        seed ^= seed1 ^ seed2;
+    }
+
+    while(remaining > 16){
+        seed = hash_mix(hash_read64(p) ^ hash_secret[1], hash_read64(p + 8) ^ seed);
+        p += 16;
+        remaining -= 16;
+    }
+
+    // Last 16 bytes (which may overlap with bytes already mixed in)
+    a = hash_read64(p + remaining - 16) ^ hash_secret[1];
+    b = hash_read64(p + remaining - 8) ^ seed;
+    hash_multiply(&a, &b);
+    return (hash_t) hash_mix(a ^ hash_secret[0] ^ (uint64_t) size, b ^ hash_secret[1]);
 }
 
 hash_t hash_string(const char *s){
@@ -27,9 +122,6 @@ hash_t hash_strings(char *strings[], length_t num_strings){
 }
 
 hash_t hash_combine(hash_t h1, hash_t h2){
-    hash_t hash = h1;
-    for(length_t i = 0; i != sizeof(h2); i++){
-        hash = (hash * 31) + (hash_t)((char*) &h2)[i];
-    }
-    return hash;
+    // Different secrets for each side, so that the order of 'h1' and 'h2' matters
+    return (hash_t) hash_mix((uint64_t) h1 ^ hash_secret[0], (uint64_t) h2 ^ hash_secret[2]);
 }
@@ -0,0 +1,142 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "UTIL/ground.h"
+#include "UTIL/hash.h"
+#include "UTIL/intern.h"
+#include "UTIL/util.h"
+
+#define INTERN_TABLE_INITIAL_SLOTS 1024
+#define INTERN_TABLE_CHUNK_SIZE 8192
+
+void intern_table_init(intern_table_t *table){
+    *table = (intern_table_t){
+        .entries = NULL,
+        .length = 0,
+        .capacity = 0,
+        .slots = calloc(INTERN_TABLE_INITIAL_SLOTS, sizeof(symbol_id_t)),
+        .slots_capacity = INTERN_TABLE_INITIAL_SLOTS,
+        .chunks = NULL,
+        .chunks_length = 0,
+        .chunks_capacity = 0,
+        .chunk_used = 0,
+        .chunk_capacity = 0,
+    };
+}
+
+void intern_table_free(intern_table_t *table){
+    for(length_t i = 0; i != table->chunks_length; i++){
+        free(table->chunks[i]);
+    }
+
+    free(table->chunks);
+    free(table->entries);
+    free(table->slots);
+}
+
+static char *intern_table_store(intern_table_t *table, const char *string, length_t length){
+    length_t size = length + 1;
+
+    if(table->chunk_used + size > table->chunk_capacity){
+        // Strings larger than a chunk get a dedicated chunk
+        length_t new_chunk_size = size > INTERN_TABLE_CHUNK_SIZE ? size : INTERN_TABLE_CHUNK_SIZE;
+
+        expand((void**) &table->chunks, sizeof(char*), table->chunks_length, &table->chunks_capacity, 1, 4);
+        table->chunks[table->chunks_length++] = malloc(new_chunk_size);
+        table->chunk_used = 0;
+        table->chunk_capacity = new_chunk_size;
+    }
+
+    char *storage = &table->chunks[table->chunks_length - 1][table->chunk_used];
+    memcpy(storage, string, length);
+    storage[length] = '\0';
+    table->chunk_used += size;
+    return storage;
+}
+
+static void intern_table_grow_slots(intern_table_t *table){
+    length_t new_capacity = table->slots_capacity * 2;
+    symbol_id_t *new_slots = calloc(new_capacity, sizeof(symbol_id_t));
+
+    for(length_t id = 0; id != table->length; id++){
+        length_t slot = table->entries[id].hash & (new_capacity - 1);
+
+        while(new_slots[slot] != 0){
+            slot = (slot + 1) & (new_capacity - 1);
+        }
+
+        new_slots[slot] = (symbol_id_t) id + 1;
+    }
+
+    free(table->slots);
+    table->slots = new_slots;
+    table->slots_capacity = new_capacity;
+}
+
+// Returns the slot that either contains the string, or is where it should be inserted
+static length_t intern_table_probe(intern_table_t *table, const char *string, length_t length, hash_t hash){
+    length_t slot = hash & (table->slots_capacity - 1);
+
+    while(table->slots[slot] != 0){
+        intern_entry_t *entry = &table->entries[table->slots[slot] - 1];
+
+        if(entry->hash == hash && entry->length == length && memcmp(entry->name, string, length) == 0){
+            break;
+        }
+
+        slot = (slot + 1) & (table->slots_capacity - 1);
+    }
+
+    return slot;
+}
+
+weak_cstr_t intern_table_insert(intern_table_t *table, const char *string, length_t length, symbol_id_t *out_id){
+    hash_t hash = hash_data(string, length);
+    length_t slot = intern_table_probe(table, string, length, hash);
+
+    if(table->slots[slot] != 0){
+        symbol_id_t existing = table->slots[slot] - 1;
+        if(out_id) *out_id = existing;
+        return table->entries[existing].name;
+    }
+
+    symbol_id_t id = (symbol_id_t) table->length;
+
+    expand((void**) &table->entries, sizeof(intern_entry_t), table->length, &table->capacity, 1, 256);
+    table->entries[table->length++] = (intern_entry_t){
+        .name = intern_table_store(table, string, length),
+        .length = length,
+        .hash = hash,
+    };
+
+    table->slots[slot] = id + 1;
+
+    // Keep load factor at or below 1/2
+    if(table->length * 2 > table->slots_capacity){
+        intern_table_grow_slots(table);
+    }
+
+    if(out_id) *out_id = id;
+    return table->entries[id].name;
+}
+
+bool intern_table_find(intern_table_t *table, const char *string, length_t length, symbol_id_t *out_id){
+    length_t slot = intern_table_probe(table, string, length, hash_data(string, length));
+    if(table->slots[slot] == 0) return false;
+
+    if(out_id) *out_id = table->slots[slot] - 1;
+    return true;
+}
+
+weak_cstr_t intern_table_insert_cstr(intern_table_t *table, const char *string){
+    return intern_table_insert(table, string, strlen(string), NULL);
+}
+
+maybe_null_weak_cstr_t intern_table_find_cstr(intern_table_t *table, const char *string){
+    symbol_id_t id;
+    return intern_table_find(table, string, strlen(string), &id) ? table->entries[id].name : NULL;
+}
+
+weak_cstr_t intern_table_name(intern_table_t *table, symbol_id_t id){
+    return id < table->length ? table->entries[id].name : NULL;
+}
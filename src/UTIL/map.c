@@ -0,0 +1,145 @@
+
+#include <stdlib.h>
+
+#include "UTIL/map.h"
+
+#define MAP_MINIMUM_CAPACITY 8
+
+static length_t map_capacity_for(length_t count){
+    // Smallest power of two that keeps the load factor at or below 1/2
+    length_t capacity = MAP_MINIMUM_CAPACITY;
+
+    while(capacity < count * 2){
+        capacity *= 2;
+    }
+
+    return capacity;
+}
+
+void map_init(map_t *map, length_t starting_capacity, map_hash_func_t hash_func, map_equals_func_t equals_func){
+    length_t capacity = starting_capacity ? map_capacity_for(starting_capacity) : 0;
+
+    *map = (map_t){
+        .entries = capacity ? calloc(capacity, sizeof(map_entry_t)) : NULL,
+        .capacity = capacity,
+        .count = 0,
+        .hash_func = hash_func,
+        .equals_func = equals_func,
+    };
+}
+
+void map_free(map_t *map, map_free_entry_func_t optional_free_func){
+    if(optional_free_func != NULL){
+        for(length_t i = 0; i != map->capacity; i++){
+            map_entry_t *entry = &map->entries[i];
+            if(entry->key) (*optional_free_func)(entry->key, entry->value);
+        }
+    }
+
+    free(map->entries);
+}
+
+static void map_grow(map_t *map){
+    length_t new_capacity = map->capacity ? map->capacity * 2 : MAP_MINIMUM_CAPACITY;
+    map_entry_t *new_entries = calloc(new_capacity, sizeof(map_entry_t));
+
+    // Hashes are stored, so keys never have to be hashed again
+    for(length_t i = 0; i != map->capacity; i++){
+        map_entry_t *entry = &map->entries[i];
+        if(entry->key == NULL) continue;
+
+        length_t slot = entry->hash & (new_capacity - 1);
+
+        while(new_entries[slot].key != NULL){
+            slot = (slot + 1) & (new_capacity - 1);
+        }
+
+        new_entries[slot] = *entry;
+    }
+
+    free(map->entries);
+    map->entries = new_entries;
+    map->capacity = new_capacity;
+}
+
+// Returns the entry that either has the key, or is where it should be inserted
+// NOTE: Map must have a non-zero capacity
+static map_entry_t *map_probe(map_t *map, const void *key, hash_t hash){
+    length_t slot = hash & (map->capacity - 1);
+
+    while(map->entries[slot].key != NULL){
+        map_entry_t *entry = &map->entries[slot];
+
+        if(entry->hash == hash && (*map->equals_func)(entry->key, key)){
+            break;
+        }
+
+        slot = (slot + 1) & (map->capacity - 1);
+    }
+
+    return &map->entries[slot];
+}
+
+bool map_insert(map_t *map, void *key, void *value){
+    if((map->count + 1) * 2 > map->capacity){
+        map_grow(map);
+    }
+
+    hash_t hash = (*map->hash_func)((const void*) key);
+    map_entry_t *entry = map_probe(map, key, hash);
+
+    if(entry->key != NULL) return false;
+
+    *entry = (map_entry_t){
+        .key = key,
+        .value = value,
+        .hash = hash,
+    };
+
+    map->count++;
+    return true;
+}
+
+void *map_set(map_t *map, void *key, void *value){
+    if((map->count + 1) * 2 > map->capacity){
+        map_grow(map);
+    }
+
+    hash_t hash = (*map->hash_func)((const void*) key);
+    map_entry_t *entry = map_probe(map, key, hash);
+
+    if(entry->key != NULL){
+        void *previous = entry->value;
+        entry->value = value;
+        return previous;
+    }
+
+    *entry = (map_entry_t){
+        .key = key,
+        .value = value,
+        .hash = hash,
+    };
+
+    map->count++;
+    return NULL;
+}
+
+void *map_find(map_t *map, const void *key){
+    if(map->count == 0) return NULL;
+
+    map_entry_t *entry = map_probe(map, key, (*map->hash_func)(key));
+    return entry->key ? entry->value : NULL;
+}
+
+bool map_has(map_t *map, const void *key){
+    if(map->count == 0) return false;
+
+    return map_probe(map, key, (*map->hash_func)(key))->key != NULL;
+}
+
+void map_collect(map_t *map, map_collect_func_t collect_func, void *user_pointer){
+    for(length_t i = 0; i != map->capacity; i++){
+        map_entry_t *entry = &map->entries[i];
+        if(entry->key) (*collect_func)(entry->key, entry->value, user_pointer);
+    }
+}
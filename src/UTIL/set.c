@@ -1,6 +1,22 @@
 
+#include <stdio.h>
+#include <stdlib.h>
+
 #include "UTIL/set.h"
 
+#define SET_MINIMUM_CAPACITY 8
+
+static length_t set_capacity_for(length_t count){
+    // Smallest power of two that keeps the load factor at or below 1/2
+    length_t capacity = SET_MINIMUM_CAPACITY;
+
+    while(capacity < count * 2){
+        capacity *= 2;
+    }
+
+    return capacity;
+}
+
 void set_init(
     set_t *set,
     length_t starting_capacity,
@@ -8,9 +24,11 @@ void set_init(
     set_equals_func_t equals_func,
     set_preinsert_clone_func_t optional_preinsert_clone_func
 ){
+    length_t capacity = starting_capacity ? set_capacity_for(starting_capacity) : 0;
+
     *set = (set_t){
-        .entries = calloc(starting_capacity, sizeof(set_entry_t)),
-        .capacity = starting_capacity,
+        .entries = capacity ? calloc(capacity, sizeof(set_entry_t)) : NULL,
+        .capacity = capacity,
         .count = 0,
         .hash_func = hash_func,
         .equals_func = equals_func,
@@ -23,80 +41,91 @@ void set_free(set_t *set, set_free_item_func_t optional_free_func){
         set_traverse(set, optional_free_func);
     }
 
+    free(set->entries);
+}
+
+static void set_grow(set_t *set){
+    length_t new_capacity = set->capacity ? set->capacity * 2 : SET_MINIMUM_CAPACITY;
+    set_entry_t *new_entries = calloc(new_capacity, sizeof(set_entry_t));
+
+    // Hashes are stored, so items never have to be hashed again
     for(length_t i = 0; i != set->capacity; i++){
-        set_entry_t *entry = set->entries[i];
+        set_entry_t *entry = &set->entries[i];
+        if(entry->data == NULL) continue;
+
+        length_t slot = entry->hash & (new_capacity - 1);
 
-        while(entry){
-            set_entry_t *next = entry->next;
-            free(entry);
-            entry = next;
+        while(new_entries[slot].data != NULL){
+            slot = (slot + 1) & (new_capacity - 1);
         }
+
+        new_entries[slot] = *entry;
     }
+
+    free(set->entries);
+    set->entries = new_entries;
+    set->capacity = new_capacity;
 }
 
 bool set_insert(set_t *set, void *item){
+    if((set->count + 1) * 2 > set->capacity){
+        set_grow(set);
+    }
+
     hash_t hash = (*set->hash_func)((const void*) item);
-    set_entry_t **slot = &set->entries[hash % set->capacity];
-
-    if(*slot == NULL){
-        *slot = malloc_init(set_entry_t, {
-            .data = set->optional_preinsert_clone_func ? (*set->optional_preinsert_clone_func)((const void*) item) : item,
-            .next = NULL,
-        });
-    } else {
-        set_entry_t *entry = *slot, *prev;
-
-        while(entry){
-            if((*set->equals_func)(entry->data, item)){
-                return false;
-            }
-
-            prev = entry;
-            entry = entry->next;
+    length_t slot = hash & (set->capacity - 1);
+
+    while(set->entries[slot].data != NULL){
+        set_entry_t *entry = &set->entries[slot];
+
+        if(entry->hash == hash && (*set->equals_func)(entry->data, item)){
+            return false;
         }
 
-        prev->next = malloc_init(set_entry_t, {
-            .data = set->optional_preinsert_clone_func ? (*set->optional_preinsert_clone_func)((const void*) item) : item,
-            .next = NULL,
-        });
+        slot = (slot + 1) & (set->capacity - 1);
     }
 
+    set->entries[slot] = (set_entry_t){
+        .data = set->optional_preinsert_clone_func ? (*set->optional_preinsert_clone_func)((const void*) item) : item,
+        .hash = hash,
+    };
+
     set->count++;
     return true;
 }
 
 void set_traverse(set_t *set, set_traverse_func_t run_func){
     for(length_t i = 0; i != set->capacity; i++){
-        set_entry_t *entry = set->entries[i];
-
-        while(entry){
-            (*run_func)(entry->data);
-            entry = entry->next;
+        if(set->entries[i].data != NULL){
+            (*run_func)(set->entries[i].data);
         }
     }
 }
 
 void set_collect(set_t *set, set_collect_func_t collect_func, void *user_pointer){
     for(length_t i = 0; i != set->capacity; i++){
-        set_entry_t *entry = set->entries[i];
-
-        while(entry){
-            (*collect_func)(entry->data, user_pointer);
-            entry = entry->next;
+        if(set->entries[i].data != NULL){
+            (*collect_func)(set->entries[i].data, user_pointer);
         }
     }
 }
 
 void set_print_statistics(set_t *set){
-    length_t buckets_used = 0;
+    length_t total_probes = 0;
 
+    // Count how many slots have to be checked to find each item
     for(length_t i = 0; i != set->capacity; i++){
-        set_entry_t *entry = set->entries[i];
+        set_entry_t *entry = &set->entries[i];
+        if(entry->data == NULL) continue;
 
-        if(entry){
-            buckets_used++;
-        }
+        length_t home = entry->hash & (set->capacity - 1);
+        total_probes += ((i - home) & (set->capacity - 1)) + 1;
     }
 
-    printf("[set statistics : %d items, %d / %d buckets, alpha=%f]\n", (int) set->count, (int) buckets_used, (int) set->capacity, (double) set->count / (double) set->capacity);
+    printf("[set statistics : %d items, %d slots, alpha=%f, average probes=%f]\n",
+        (int) set->count,
+        (int) set->capacity,
+        set->capacity ? (double) set->count / (double) set->capacity : 0.0,
+        set->count ? (double) total_probes / (double) set->count : 0.0
+    );
 }
@@ -9,6 +9,13 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if !defined(_WIN32) && !__EMSCRIPTEN__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include "UTIL/color.h"
 #include "UTIL/ground.h"
 #include "UTIL/util.h"
@@ -185,6 +192,74 @@ bool file_text_contents(weak_cstr_t filename, strong_cstr_t *out_contents, lengt
     return true;
 }
 
+// Files smaller than this are cheaper to read than to map into memory
+#define FILE_TEXT_MAP_THRESHOLD (64 * 1024)
+
+bool file_text_map(weak_cstr_t filename, strong_cstr_t *out_contents, length_t *out_length, bool *out_is_mapped){
+    *out_is_mapped = false;
+
+    #if !defined(_WIN32) && !__EMSCRIPTEN__
+    int fd = open(filename, O_RDONLY);
+    if(fd < 0) return false;
+
+    struct stat info;
+
+    if(fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size < FILE_TEXT_MAP_THRESHOLD){
+        close(fd);
+        return file_text_contents(filename, out_contents, out_length, true);
+    }
+
+    size_t size = (size_t) info.st_size;
+    size_t page_size = (size_t) sysconf(_SC_PAGESIZE);
+    size_t reserved_size = (size + 2 + page_size - 1) / page_size * page_size;
+
+    // Reserve enough room for the contents and the '\n\0' terminator,
+    // and then map the file over the beginning of it
+    char *contents = mmap(NULL, reserved_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if(contents == MAP_FAILED){
+        close(fd);
+        return file_text_contents(filename, out_contents, out_length, true);
+    }
+
+    if(mmap(contents, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED){
+        munmap(contents, reserved_size);
+        close(fd);
+        return file_text_contents(filename, out_contents, out_length, true);
+    }
+
+    close(fd);
+
+    // Since the mapping is private, only the page that the terminator
+    // is written to gets copied, the rest stays shared with the file
+    contents[size] = '\n';
+    contents[size + 1] = '\0';
+    mprotect(contents, reserved_size, PROT_READ);
+
+    *out_contents = contents;
+    *out_length = size + 1;
+    *out_is_mapped = true;
+    return true;
+    #else
+    return file_text_contents(filename, out_contents, out_length, true);
+    #endif
+}
+
+void file_text_release(strong_cstr_t contents, length_t length, bool is_mapped){
+    #if !defined(_WIN32) && !__EMSCRIPTEN__
+    if(is_mapped){
+        // Includes the '\0' after the appended newline
+        munmap(contents, length + 1);
+        return;
+    }
+    #else
+    (void) length;
+    (void) is_mapped;
+    #endif
+
+    free(contents);
+}
+
 bool file_binary_contents(weak_cstr_t filename, strong_cstr_t *out_contents, length_t *out_length){
     char *buffer;
     length_t buffer_size;
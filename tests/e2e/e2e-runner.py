@@ -17,6 +17,10 @@ def run_all_tests():
         lambda output: b"     /\xe2\xe2\\\n    /    \\    \n   /      \\    \n  /   /\\   \\        The Adept Compiler v2.8 - (c) 2016-2024 Isaac Shelton\n /   /\\__   \\\n/___/    \\___\\\n\nUsage: adept [options] [filename]\n\nOptions:\n    -h, --help        Display this message\n    -e                Execute resulting executable\n    -w                Disable compiler warnings\n    -o FILENAME       Output to FILENAME (relative to working directory)\n    -n FILENAME       Output to FILENAME (relative to file)\n    -c                Emit object file\n    -O0,-O1,-O2,-O3   Set optimization level\n    --windowed        Don't open console with executable (only applies to Windows)\n    -std=2.x          Set standard library version\n    --version         Display compiler version\n    --root            Display root folder\n    --help-advanced   Show lesser used compiler flags\n" in output
     )
     test("hello_world", [executable, join(src_dir, "hello_world/main.adept"), "-e"], lambda output: b"Hello World!" in output)
+    test("hello_world --cache", [executable, join(src_dir, "hello_world/main.adept"), "--cache", "-e"], lambda output: b"Hello World!" in output)
+    test("hello_world --cache (reused)",
+        [executable, join(src_dir, "hello_world/main.adept"), "--cache-verbose", "-e"],
+        lambda output: b"Reused cached output" in output and b"Hello World!" in output)
     test("address", [executable, join(src_dir, "address/main.adept")], compiles)
     test("aliases", [executable, join(src_dir, "aliases/main.adept")], compiles)
     test("aliases_polymorphic", [executable, join(src_dir, "aliases_polymorphic/main.adept")], compiles)
@@ -98,6 +102,14 @@ def run_all_tests():
     test("defer", [executable, join(src_dir, "defer/main.adept")], compiles)
     test("defer_auto_noop", [executable, join(src_dir, "defer_auto_noop/main.adept")], compiles)
     test("defer_global", [executable, join(src_dir, "defer_global/main.adept")], compiles)
+    test("demand_ir",
+        [executable, join(src_dir, "demand_ir/main.adept")],
+        lambda output: b"main.adept:21:5: error: Undeclared function 'thisFunctionDoesNotExist'" in output,
+        expected_exitcode=1
+    )
+    test("demand_ir --demand-ir",
+        [executable, join(src_dir, "demand_ir/main.adept"), "--demand-ir", "-e"],
+        lambda output: b"square 42 42\n" in output)
     test("deprecated", [executable, join(src_dir, "deprecated/main.adept")], compiles)
     test("disallow",
         [executable, join(src_dir, "disallow/main.adept")],
@@ -139,6 +151,14 @@ def run_all_tests():
     test("enums_foreign", [executable, join(src_dir, "enums_foreign/main.adept")], compiles)
     test("enums_relaxed_syntax", [executable, join(src_dir, "enums_relaxed_syntax/main.adept")], compiles)
     test("equals_func", [executable, join(src_dir, "equals_func/main.adept")], compiles)
+    test("exit_code -e",
+        [executable, join(src_dir, "exit_code/main.adept"), "-e"],
+        lambda output: b"exiting with 7\n" in output,
+        expected_exitcode=7)
+    test("exit_code --jit",
+        [executable, join(src_dir, "exit_code/main.adept"), "--jit"],
+        lambda output: b"exiting with 7\n" in output,
+        expected_exitcode=7)
     test("external", [executable, join(src_dir, "external/main.adept")], compiles)
     test("fallthrough", [executable, join(src_dir, "fallthrough/main.adept")], compiles)
     test("fixed_array", [executable, join(src_dir, "fixed_array/main.adept")], compiles)
@@ -180,6 +200,15 @@ def run_all_tests():
     test("int_to_float_promotion_in_math", [executable, join(src_dir, "int_to_float_promotion_in_math/main.adept")], compiles)
     test("internal_deference", [executable, join(src_dir, "internal_deference/main.adept")], compiles)
     test("internal_deference_generic", [executable, join(src_dir, "internal_deference_generic/main.adept")], compiles)
+    test("jit --jit",
+        [executable, join(src_dir, "jit/main.adept"), "--jit"],
+        lambda output: b"counter = 10, argc = 1\n" in output)
+    test("jobs --jobs=4",
+        [executable, join(src_dir, "jobs/main.adept"), "--jobs=4", "-e"],
+        lambda output: b"15 odd 7 even\n" in output)
+    test("jobs --jobs=4 -O3",
+        [executable, join(src_dir, "jobs/main.adept"), "--jobs=4", "-O3", "-e"],
+        lambda output: b"15 odd 7 even\n" in output)
     test("list_map", [executable, join(src_dir, "list_map/main.adept")], compiles)
     test("llvm_asm", [executable, join(src_dir, "llvm_asm/main.adept")], compiles)
     test("loose_struct_syntax", [executable, join(src_dir, "loose_struct_syntax/main.adept")], compiles)
@@ -229,6 +258,13 @@ def run_all_tests():
         join(src_dir, "numeric_separators/main.adept"), "-e"],
         lambda output: b"123456789\n" in output
     )
+    test("optimization_levels", [executable, join(src_dir, "optimization_levels/main.adept")], compiles)
+    test("optimization_levels -O3",
+        [executable, join(src_dir, "optimization_levels/flags.adept"), "-O3", "-e"],
+        lambda output: b"1499998500000\n" in output)
+    test("optimization_levels -Oz",
+        [executable, join(src_dir, "optimization_levels/flags.adept"), "-Oz", "-e"],
+        lambda output: b"1499998500000\n" in output)
     test("order", [executable, join(src_dir, "order/main.adept")], compiles)
     test("pass_func", [executable, join(src_dir, "pass_func/main.adept")], compiles)
     test("permissive_blocks", [executable, join(src_dir, "permissive_blocks/main.adept")], compiles)
@@ -298,6 +334,8 @@ def run_all_tests():
     test("switch", [executable, join(src_dir, "switch/main.adept")], compiles)
     test("switch_exhaustive", [executable, join(src_dir, "switch_exhaustive/main.adept")], compiles)
     test("switch_more", [executable, join(src_dir, "switch_more/main.adept")], compiles)
+    test("target_cpu", [executable, join(src_dir, "target_cpu/main.adept")], compiles)
+    test("target_cpu -march=native", [executable, join(src_dir, "target_cpu/main.adept"), "-march=native"], compiles)
     test("temporary_mutable", [executable, join(src_dir, "temporary_mutable/main.adept")], compiles)
     test("tentative_function_calls", [executable, join(src_dir, "tentative_function_calls/main.adept")], compiles)
     test("tentative_method_calls", [executable, join(src_dir, "tentative_method_calls/main.adept")], compiles)
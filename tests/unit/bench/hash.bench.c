@@ -0,0 +1,247 @@
+
+/*
+    Microbenchmark for UTIL/hash.c
+
+    Compares the hash functions against the original byte-at-a-time versions,
+    both in speed and in how evenly they spread realistic AST types into buckets,
+    and times the intern table on identifier-sized keys
+
+    Usage: HashBenchmark [iterations]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "AST/TYPE/ast_type_hash.h"
+#include "AST/ast_type.h"
+#include "TypeCorpus.h"
+#include "UTIL/ground.h"
+#include "UTIL/hash.h"
+#include "UTIL/intern.h"
+
+// Original versions of 'hash_data' and 'hash_combine'
+
+__attribute__((noinline)) static hash_t legacy_hash_data(const void *data, length_t size){
+    hash_t hash = 0;
+    for(length_t i = 0; i != size; i++){
+        hash = (hash * 31) + (hash_t)((char*) data)[i];
+    }
+    return hash;
+}
+
+__attribute__((noinline)) static hash_t legacy_hash_combine(hash_t h1, hash_t h2){
+    hash_t hash = h1;
+    for(length_t i = 0; i != sizeof(h2); i++){
+        hash = (hash * 31) + (hash_t)((char*) &h2)[i];
+    }
+    return hash;
+}
+
+static hash_t legacy_ast_type_hash(const ast_type_t *type);
+
+static hash_t legacy_ast_elem_hash(const ast_elem_t *elem){
+    // Same structure as 'ast_elem_hash' for the elements in the corpus
+    hash_t hash = legacy_hash_data(&elem->id, sizeof elem->id);
+
+    switch(elem->id){
+    case AST_ELEM_BASE: {
+            const char *base = ((const ast_elem_base_t*) elem)->base;
+            return legacy_hash_combine(hash, legacy_hash_data(base, strlen(base)));
+        }
+    case AST_ELEM_FIXED_ARRAY: {
+            length_t length = ((const ast_elem_fixed_array_t*) elem)->length;
+            return legacy_hash_combine(hash, legacy_hash_data(&length, sizeof length));
+        }
+    case AST_ELEM_GENERIC_BASE: {
+            const ast_elem_generic_base_t *generic_base = (const ast_elem_generic_base_t*) elem;
+            hash = legacy_hash_combine(hash, legacy_hash_data(&generic_base->name_is_polymorphic, sizeof generic_base->name_is_polymorphic));
+            hash = legacy_hash_combine(hash, legacy_hash_data(generic_base->name, strlen(generic_base->name)));
+
+            hash_t generics_hash = 0;
+            for(length_t i = 0; i != generic_base->generics_length; i++){
+                generics_hash = legacy_hash_combine(generics_hash, legacy_ast_type_hash(&generic_base->generics[i]));
+            }
+            return legacy_hash_combine(hash, generics_hash);
+        }
+    }
+
+    return hash;
+}
+
+static hash_t legacy_ast_type_hash(const ast_type_t *type){
+    hash_t hash = 0;
+    for(length_t i = 0; i != type->elements_length; i++){
+        hash = legacy_hash_combine(hash, legacy_ast_elem_hash(type->elements[i]));
+    }
+    return hash;
+}
+
+static double seconds_now(void){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// Prevents hashes from being optimized away
+static volatile hash_t sink;
+
+static void bench_data(const char *label, hash_t (*hash_func)(const void*, length_t), length_t size, length_t iterations){
+    // Keys are prepared ahead of time, since writing a key right before hashing it
+    // stalls hashes that read whole words instead of single bytes. Each key is
+    // chosen by the previous hash, so this measures latency like a table lookup would
+    length_t num_keys = 256;
+    char *keys = malloc(size * num_keys);
+
+    for(length_t key = 0; key != num_keys; key++){
+        for(length_t i = 0; i != size; i++){
+            keys[key * size + i] = 'A' + (i + key) % 26;
+        }
+        keys[key * size] = (char) key;
+    }
+
+    double start = seconds_now();
+    hash_t accumulator = 0;
+
+    for(length_t i = 0; i != iterations; i++){
+        accumulator = hash_func(&keys[(accumulator % num_keys) * size], size);
+    }
+
+    double elapsed = seconds_now() - start;
+    sink = accumulator;
+
+    printf("  %-8s %5d bytes: %8.2f ns/hash  %6.2f GB/s\n", label, (int) size, elapsed * 1e9 / iterations, (double) size * iterations / elapsed / 1e9);
+    free(keys);
+}
+
+static void bench_types(const char *label, hash_t (*type_hash_func)(const ast_type_t*), ast_type_t *types, length_t length, length_t iterations){
+    double start = seconds_now();
+    hash_t accumulator = 0;
+
+    for(length_t i = 0; i != iterations; i++){
+        for(length_t j = 0; j != length; j++){
+            accumulator ^= type_hash_func(&types[j]);
+        }
+    }
+
+    double elapsed = seconds_now() - start;
+    sink = accumulator;
+
+    printf("  %-8s %8.2f ns/type\n", label, elapsed * 1e9 / (iterations * length));
+}
+
+static void bench_intern(length_t iterations){
+    // Identifiers like the ones the lexer interns, mostly between 1 and 16 bytes
+    static const char *words[] = {
+        "i", "x", "it", "len", "self", "value", "length", "count", "printf", "String",
+        "capacity", "elements", "ast_expr_t", "compiler", "initialize", "parseFunction",
+    };
+
+    length_t num_names = 4096;
+    char (*names)[32] = malloc(sizeof(*names) * num_names);
+    length_t *lengths = malloc(sizeof(length_t) * num_names);
+
+    for(length_t i = 0; i != num_names; i++){
+        const char *word = words[i % NUM_ITEMS(words)];
+        lengths[i] = i < NUM_ITEMS(words) ? (length_t) snprintf(names[i], sizeof names[i], "%s", word)
+                                          : (length_t) snprintf(names[i], sizeof names[i], "%s%d", word, (int) (i / NUM_ITEMS(words)));
+    }
+
+    length_t rounds = iterations / num_names + 1;
+    double insert_time = 0, find_time = 0;
+    length_t found = 0;
+
+    for(length_t round = 0; round != rounds; round++){
+        intern_table_t table;
+        intern_table_init(&table);
+
+        double start = seconds_now();
+        for(length_t i = 0; i != num_names; i++){
+            intern_table_insert(&table, names[i], lengths[i], NULL);
+        }
+
+        double middle = seconds_now();
+        for(length_t i = 0; i != num_names; i++){
+            found += intern_table_find(&table, names[i], lengths[i], NULL);
+        }
+
+        find_time += seconds_now() - middle;
+        insert_time += middle - start;
+        intern_table_free(&table);
+    }
+
+    sink = found;
+
+    printf("  insert   %8.2f ns/name\n", insert_time * 1e9 / (rounds * num_names));
+    printf("  find     %8.2f ns/name\n", find_time * 1e9 / (rounds * num_names));
+
+    free(lengths);
+    free(names);
+}
+
+static void report_distribution(const char *label, hash_t (*type_hash_func)(const ast_type_t*), ast_type_t *types, length_t length, length_t num_buckets){
+    length_t *buckets = calloc(num_buckets, sizeof(length_t));
+    hash_t *hashes = malloc(sizeof(hash_t) * length);
+    length_t full_collisions = 0;
+
+    for(length_t i = 0; i != length; i++){
+        hashes[i] = type_hash_func(&types[i]);
+        buckets[hashes[i] % num_buckets]++;
+
+        for(length_t j = 0; j != i; j++){
+            if(hashes[i] == hashes[j]) full_collisions++;
+        }
+    }
+
+    length_t longest = 0, used = 0;
+    double probes = 0;
+
+    for(length_t i = 0; i != num_buckets; i++){
+        if(buckets[i] > longest) longest = buckets[i];
+        if(buckets[i] != 0) used++;
+
+        // Average number of comparisons to find each entry in a chain
+        probes += buckets[i] * (buckets[i] + 1) / 2.0;
+    }
+
+    printf("  %-8s %4d/%d buckets used, longest chain %3d, %.2f compares/lookup, %d full collisions\n",
+        label, (int) used, (int) num_buckets, (int) longest, probes / length, (int) full_collisions);
+
+    free(hashes);
+    free(buckets);
+}
+
+int main(int argc, char **argv){
+    length_t iterations = argc > 1 ? (length_t) atol(argv[1]) : 2000000;
+
+    length_t length;
+    ast_type_t *types = type_corpus_create(&length);
+
+    printf("hash_data:\n");
+    length_t sizes[] = {4, 8, 16, 32, 64, 256, 4096};
+
+    for(length_t i = 0; i != NUM_ITEMS(sizes); i++){
+        length_t size_iterations = iterations * 16 / (sizes[i] + 16);
+        bench_data("legacy", legacy_hash_data, sizes[i], size_iterations);
+        bench_data("current", hash_data, sizes[i], size_iterations);
+    }
+
+    printf("intern_table (4096 identifiers):\n");
+    bench_intern(iterations);
+
+    printf("ast_type_hash (%d types):\n", (int) length);
+    bench_types("legacy", legacy_ast_type_hash, types, length, iterations / length + 1);
+    bench_types("current", ast_type_hash, types, length, iterations / length + 1);
+
+    printf("distribution (%d types):\n", (int) length);
+    length_t bucket_counts[] = {256, 1024, 4096};
+
+    for(length_t i = 0; i != NUM_ITEMS(bucket_counts); i++){
+        report_distribution("legacy", legacy_ast_type_hash, types, length, bucket_counts[i]);
+        report_distribution("current", ast_type_hash, types, length, bucket_counts[i]);
+    }
+
+    type_corpus_free(types, length);
+    return 0;
+}
@@ -0,0 +1,217 @@
+
+/*
+    Microbenchmark for LEX/lex.c and LEX/lex_scan.h
+
+    Measures the throughput of 'lex_buffer' on generated source files, and
+    of the scanning helpers against scanning one character at a time,
+    for runs of different lengths
+
+    Usage: LexBenchmark [megabytes]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "LEX/lex.h"
+#include "LEX/lex_scan.h"
+#include "UTIL/ground.h"
+#include "UTIL/string.h"
+#include "UTIL/string_builder.h"
+
+#define LEX_BENCH_REPEAT 5
+
+static double seconds_now(void){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+static strong_cstr_t generate_code(length_t megabytes, length_t *out_length){
+    // Token-dense code, mostly short identifiers, operators, and numbers
+    string_builder_t builder;
+    string_builder_init(&builder);
+
+    for(length_t i = 0; builder.length < megabytes * 1024 * 1024; i++){
+        char chunk[512];
+        snprintf(chunk, sizeof chunk,
+            "struct Point%d (x, y float, name *ubyte)\n"
+            "\n"
+            "func distance%d(a, b *Point%d) float {\n"
+            "    dx float = b.x - a.x\n"
+            "    dy float = b.y - a.y\n"
+            "    printf('point %%s at %%f, %%f\\n', a.name, a.x, a.y)\n"
+            "    return sqrtf(dx * dx + dy * dy) + %d.5f * 0x%xul\n"
+            "}\n\n",
+            (int) i, (int) i, (int) i, (int) (i % 1000), (int) i);
+        string_builder_append(&builder, chunk);
+    }
+
+    *out_length = builder.length;
+    return string_builder_finalize(&builder);
+}
+
+static strong_cstr_t generate_prose(length_t megabytes, length_t *out_length){
+    // Code dominated by comments, long strings, and indentation
+    string_builder_t builder;
+    string_builder_init(&builder);
+
+    for(length_t i = 0; builder.length < megabytes * 1024 * 1024; i++){
+        char chunk[1024];
+        snprintf(chunk, sizeof chunk,
+            "// ---------------- documented_function_number_%d ----------------\n"
+            "// Explains at great length what this function does, why it does it,\n"
+            "// and all of the things that callers should keep in mind when using it\n"
+            "/* Block comments are also common, especially for licenses and\n"
+            "   larger explanations that span multiple lines of the file */\n"
+            "func documented_function_number_%d(message *ubyte) void {\n"
+            "                printf('The quick brown fox jumps over the lazy dog %%d times\\n', %d)\n"
+            "                log(\"A somewhat longer string literal that is used for logging purposes\")\n"
+            "}\n\n",
+            (int) i, (int) i, (int) i);
+        string_builder_append(&builder, chunk);
+    }
+
+    *out_length = builder.length;
+    return string_builder_finalize(&builder);
+}
+
+static void bench_lex(weak_cstr_t label, strong_cstr_t source, length_t length){
+    double best = 0;
+    length_t tokens_length = 0;
+
+    for(int run = 0; run != LEX_BENCH_REPEAT; run++){
+        compiler_t compiler;
+        compiler_init(&compiler);
+
+        object_t *object = compiler_new_object(&compiler);
+        object->filename = strclone("bench.adept");
+        object->full_filename = strclone("bench.adept");
+        object->buffer = strclone(source);
+        object->buffer_length = length;
+
+        double start = seconds_now();
+        errorcode_t errorcode = lex_buffer(&compiler, object);
+        double elapsed = seconds_now() - start;
+
+        if(errorcode){
+            printf("  %-8s failed to lex\n", label);
+            compiler_free(&compiler);
+            return;
+        }
+
+        if(run == 0 || elapsed < best) best = elapsed;
+        tokens_length = object->tokenlist.length;
+        compiler_free(&compiler);
+    }
+
+    printf("  %-8s %8.2f ms  %7.1f MB/s  %6.1f Mtokens/s\n", label, best * 1e3, length / best / 1e6, tokens_length / best / 1e6);
+}
+
+// Scanning one character at a time, for comparison
+
+__attribute__((noinline)) static const char *scalar_blanks(const char *p, const char *end){
+    while(p < end && LEX_SCAN_IS_BLANK(*p)) p++;
+    return p;
+}
+
+__attribute__((noinline)) static const char *scalar_identifier(const char *p, const char *end){
+    while(p < end && LEX_SCAN_IS_IDENTIFIER(*p)) p++;
+    return p;
+}
+
+__attribute__((noinline)) static const char *scalar_either(const char *p, const char *end){
+    while(p < end && !LEX_SCAN_IS_EITHER(*p, '"', '\\')) p++;
+    return p;
+}
+
+__attribute__((noinline)) static const char *vector_blanks(const char *p, const char *end){
+    return lex_scan_blanks(p, end);
+}
+
+__attribute__((noinline)) static const char *vector_identifier(const char *p, const char *end){
+    return lex_scan_identifier(p, end);
+}
+
+__attribute__((noinline)) static const char *vector_either(const char *p, const char *end){
+    return lex_scan_either(p, end, '"', '\\');
+}
+
+typedef const char *(*scan_func_t)(const char *, const char *);
+
+static double time_scan(scan_func_t scan, const char *buffer, length_t buffer_length){
+    // Scans every run in a buffer made of runs separated by a single stopping character
+    const char *end = buffer + buffer_length;
+    double best = 0;
+
+    for(int repeat = 0; repeat != LEX_BENCH_REPEAT; repeat++){
+        double start = seconds_now();
+
+        for(const char *p = buffer; p < end; p++){
+            p = scan(p, end);
+        }
+
+        double elapsed = seconds_now() - start;
+        if(repeat == 0 || elapsed < best) best = elapsed;
+    }
+
+    return best;
+}
+
+static void bench_scan(weak_cstr_t label, scan_func_t scalar, scan_func_t vector, char inside, char stop){
+    length_t buffer_length = 16 * 1024 * 1024;
+    char *buffer = malloc(buffer_length);
+    length_t runs[] = {4, 12, 24, 64, 256, 4096};
+
+    for(length_t r = 0; r != NUM_ITEMS(runs); r++){
+        length_t run = runs[r];
+
+        for(length_t i = 0; i != buffer_length; i++){
+            buffer[i] = (i % (run + 1) == run) ? stop : inside;
+        }
+
+        double scalar_time = time_scan(scalar, buffer, buffer_length);
+        double vector_time = time_scan(vector, buffer, buffer_length);
+
+        printf("  %-10s run %4d  scalar %7.1f MB/s  lex_scan %7.1f MB/s  (%.2fx)\n",
+            label, (int) run, buffer_length / scalar_time / 1e6, buffer_length / vector_time / 1e6, scalar_time / vector_time);
+    }
+
+    free(buffer);
+}
+
+int main(int argc, char **argv){
+    length_t megabytes = argc > 1 ? (length_t) atoi(argv[1]) : 8;
+
+    #if defined(LEX_SCAN_AVX2)
+    printf("AVX2: %s (detected at runtime)\n", lex_scan_has_avx2() ? "used for long runs" : "not supported by this processor");
+    #else
+    printf("AVX2: not available for this target\n");
+    #endif
+
+    #if defined(LEX_SCAN_SSE2)
+    printf("SSE2: used\n");
+    #else
+    printf("SSE2: not available for this target\n");
+    #endif
+
+    length_t code_length, prose_length;
+    strong_cstr_t code = generate_code(megabytes, &code_length);
+    strong_cstr_t prose = generate_prose(megabytes, &prose_length);
+
+    printf("\nlex_buffer (%.1f MB each, best of %d):\n", code_length / 1e6, LEX_BENCH_REPEAT);
+    bench_lex("code", code, code_length);
+    bench_lex("comments", prose, prose_length);
+
+    printf("\nScanning helpers (16 MB of runs, best of %d):\n", LEX_BENCH_REPEAT);
+    bench_scan("blanks", scalar_blanks, vector_blanks, ' ', 'x');
+    bench_scan("identifier", scalar_identifier, vector_identifier, 'a', '.');
+    bench_scan("either", scalar_either, vector_either, 'x', '"');
+
+    free(code);
+    free(prose);
+    return 0;
+}
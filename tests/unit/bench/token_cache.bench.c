@@ -0,0 +1,117 @@
+
+/*
+    Microbenchmark for LEX/token_cache.c
+
+    Compares lexing a large generated source file against loading its
+    token list from the token cache (cold and warm), the same way
+    'adept --cache' does for each file
+
+    Usage: TokenCacheBenchmark [megabytes]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "LEX/lex.h"
+#include "LEX/token_cache.h"
+#include "UTIL/ground.h"
+#include "UTIL/string.h"
+#include "UTIL/util.h"
+
+static double seconds_now(void){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+static strong_cstr_t generate_source(length_t megabytes, length_t *out_length){
+    // Realistic mix of identifiers, keywords, literals and strings
+    string_builder_t builder;
+    string_builder_init(&builder);
+
+    for(length_t i = 0; builder.length < megabytes * 1024 * 1024; i++){
+        char chunk[512];
+        snprintf(chunk, sizeof chunk,
+            "struct Point%d (x, y float, name *ubyte)\n"
+            "\n"
+            "func distance%d(a, b *Point%d) float {\n"
+            "    dx float = b.x - a.x\n"
+            "    dy float = b.y - a.y\n"
+            "    printf('point %%s at %%f, %%f\\n', a.name, a.x, a.y)\n"
+            "    message String = \"distance number %d\"\n"
+            "    return sqrtf(dx * dx + dy * dy) + %d.5f * 0x%xul\n"
+            "}\n\n",
+            (int) i, (int) i, (int) i, (int) i, (int) (i % 1000), (int) i);
+        string_builder_append(&builder, chunk);
+    }
+
+    *out_length = builder.length;
+    return string_builder_finalize(&builder);
+}
+
+static object_t *create_object(compiler_t *compiler, weak_cstr_t filename, strong_cstr_t source, length_t length){
+    object_t *object = compiler_new_object(compiler);
+    object->filename = strclone(filename);
+    object->full_filename = strclone(filename);
+    object->buffer = source;
+    object->buffer_length = length;
+    return object;
+}
+
+static double time_lex(weak_cstr_t label, weak_cstr_t filename, strong_cstr_t source, length_t length, bool use_cache){
+    compiler_t compiler;
+    compiler_init(&compiler);
+
+    object_t *object = create_object(&compiler, filename, strclone(source), length);
+
+    double start = seconds_now();
+    errorcode_t errorcode = use_cache ? token_cache_lex(&compiler, object) : lex_buffer(&compiler, object);
+    double elapsed = seconds_now() - start;
+
+    if(errorcode){
+        printf("  %-22s failed\n", label);
+    } else {
+        printf("  %-22s %8.2f ms  %7.1f MB/s  (%d tokens)\n", label, elapsed * 1e3, length / elapsed / 1e6, (int) object->tokenlist.length);
+    }
+
+    compiler_free(&compiler);
+    return elapsed;
+}
+
+int main(int argc, char **argv){
+    length_t megabytes = argc > 1 ? (length_t) atoi(argv[1]) : 8;
+
+    // Keep the benchmark's cache entries away from the real cache
+    char cache_directory[] = "/tmp/adept-token-cache-bench-XXXXXX";
+    if(mkdtemp(cache_directory) == NULL) return 1;
+    setenv("XDG_CACHE_HOME", cache_directory, 1);
+
+    char filename[256];
+    snprintf(filename, sizeof filename, "%s/main.adept", cache_directory);
+
+    length_t length;
+    strong_cstr_t source = generate_source(megabytes, &length);
+
+    // The file must exist for its metadata to be used as a key
+    FILE *file = fopen(filename, "wb");
+    fwrite(source, 1, length, file);
+    fclose(file);
+
+    printf("Token cache benchmark (%.1f MB source):\n", length / 1e6);
+
+    double lexed = time_lex("lex", filename, source, length, false);
+    time_lex("cache miss (lex+store)", filename, source, length, true);
+    double warm = time_lex("cache hit", filename, source, length, true);
+
+    printf("  speedup of cache hit over lexing: %.2fx\n", lexed / warm);
+
+    free(source);
+
+    char command[512];
+    snprintf(command, sizeof command, "rm -rf '%s'", cache_directory);
+    return system(command) == 0 ? 0 : 1;
+}
@@ -0,0 +1,18 @@
+
+#ifndef _ISAAC_TYPE_CORPUS_H_INCLUDED
+#define _ISAAC_TYPE_CORPUS_H_INCLUDED
+
+#include "AST/ast_type_lean.h"
+#include "UTIL/ground.h"
+
+// ---------------- type_corpus_create ----------------
+// Creates a collection of distinct AST types that resemble the ones found in
+// real programs, using the names of primitives and types from the standard library
+// e.g. 'String', '*AnyCompositeType', '16 ubyte', '<String> List', '*<int> Optional'
+ast_type_t *type_corpus_create(length_t *out_length);
+
+// ---------------- type_corpus_free ----------------
+// Frees a collection of AST types created by 'type_corpus_create'
+void type_corpus_free(ast_type_t *types, length_t length);
+
+#endif // _ISAAC_TYPE_CORPUS_H_INCLUDED
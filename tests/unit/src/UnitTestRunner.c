@@ -3,8 +3,17 @@
 
 #include "CuTest.h"
 
+CuSuite *CuSuite_for_ast(void);
 CuSuite *CuSuite_for_ast_expr(void);
+CuSuite *CuSuite_for_ast_layout(void);
+CuSuite *CuSuite_for_ast_type(void);
+CuSuite *CuSuite_for_build_cache(void);
+CuSuite *CuSuite_for_hash(void);
+CuSuite *CuSuite_for_ir_gen_type(void);
 CuSuite *CuSuite_for_lex(void);
+CuSuite *CuSuite_for_set(void);
+CuSuite *CuSuite_for_sha256(void);
+CuSuite *CuSuite_for_token_cache(void);
 
 int RunAllTests(void){
     printf("Running all unit tests:\n");
@@ -12,8 +21,17 @@ int RunAllTests(void){
     CuString *output = CuStringNew();
     CuSuite* suite = CuSuiteNew();
 
+    CuSuiteAddSuite(suite, CuSuite_for_ast());
     CuSuiteAddSuite(suite, CuSuite_for_ast_expr());
+    CuSuiteAddSuite(suite, CuSuite_for_ast_layout());
+    CuSuiteAddSuite(suite, CuSuite_for_ast_type());
+    CuSuiteAddSuite(suite, CuSuite_for_build_cache());
+    CuSuiteAddSuite(suite, CuSuite_for_hash());
+    CuSuiteAddSuite(suite, CuSuite_for_ir_gen_type());
     CuSuiteAddSuite(suite, CuSuite_for_lex());
+    CuSuiteAddSuite(suite, CuSuite_for_set());
+    CuSuiteAddSuite(suite, CuSuite_for_sha256());
+    CuSuiteAddSuite(suite, CuSuite_for_token_cache());
 
     CuSuiteRun(suite);
     CuSuiteSummary(suite, output);
@@ -0,0 +1,119 @@
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "AST/TYPE/ast_type_make.h"
+#include "AST/ast.h"
+#include "AST/ast_layout.h"
+#include "AST/ast_type.h"
+#include "CuTest.h"
+#include "DRVR/compiler.h"
+#include "UTIL/ground.h"
+#include "UTIL/string.h"
+#include "UTIL/util.h"
+
+static ast_composite_t *add_composite(ast_t *ast, strong_cstr_t name, bool is_class){
+    ast_layout_t layout;
+    ast_layout_init_with_struct_fields(&layout, NULL, NULL, 0);
+    return ast_add_composite(ast, name, layout, NULL_SOURCE, AST_TYPE_NONE, is_class);
+}
+
+static ast_poly_composite_t *add_poly_composite(ast_t *ast, strong_cstr_t name, length_t generics_length, bool is_class){
+    strong_cstr_t *generics = malloc(sizeof(strong_cstr_t) * generics_length);
+
+    for(length_t i = 0; i != generics_length; i++){
+        generics[i] = mallocandsprintf("T%d", (int) i);
+    }
+
+    ast_layout_t layout;
+    ast_layout_init_with_struct_fields(&layout, NULL, NULL, 0);
+    return ast_add_poly_composite(ast, name, layout, NULL_SOURCE, AST_TYPE_NONE, is_class, generics, generics_length);
+}
+
+static void TEST_ast_composite_find_after_growth(CuTest *test){
+    ast_t ast;
+    ast_init(&ast, CROSS_COMPILE_NONE);
+
+    // Add enough composites for both arrays to be reallocated many times
+    length_t count = 1000;
+
+    for(length_t i = 0; i != count; i++){
+        add_composite(&ast, mallocandsprintf("Struct%d", (int) i), false);
+        add_poly_composite(&ast, mallocandsprintf("PolyStruct%d", (int) i), 1, false);
+    }
+
+    // Validate that lookups point into the current arrays
+    for(length_t i = 0; i != count; i++){
+        strong_cstr_t name = mallocandsprintf("Struct%d", (int) i);
+        CuAssertPtrEquals(test, &ast.composites[i], ast_composite_find_exact(&ast, name));
+        free(name);
+
+        strong_cstr_t poly_name = mallocandsprintf("PolyStruct%d", (int) i);
+        CuAssertPtrEquals(test, &ast.poly_composites[i], ast_poly_composite_find_exact(&ast, poly_name, 1));
+        free(poly_name);
+    }
+
+    ast_type_t type = ast_type_make_base(strclone("Struct500"));
+    CuAssertPtrEquals(test, &ast.composites[500], ast_find_composite(&ast, &type));
+    ast_type_free(&type);
+
+    CuAssertPtrEquals(test, NULL, ast_composite_find_exact(&ast, "Missing"));
+    CuAssertPtrEquals(test, NULL, ast_poly_composite_find_exact(&ast, "Missing", 1));
+
+    // Cleanup
+    ast_free(&ast);
+}
+
+static void TEST_ast_composite_find_duplicate(CuTest *test){
+    ast_t ast;
+    ast_init(&ast, CROSS_COMPILE_NONE);
+
+    add_composite(&ast, strclone("Thing"), false);
+    add_composite(&ast, strclone("Thing"), true);
+    add_poly_composite(&ast, strclone("Box"), 1, false);
+    add_poly_composite(&ast, strclone("Box"), 1, true);
+
+    // Validate that the earliest definition takes precedence
+    ast_composite_t *composite = ast_composite_find_exact(&ast, "Thing");
+    CuAssertPtrEquals(test, &ast.composites[0], composite);
+    CuAssertTrue(test, !composite->is_class);
+
+    ast_poly_composite_t *poly_composite = ast_poly_composite_find_exact(&ast, "Box", 1);
+    CuAssertPtrEquals(test, &ast.poly_composites[0], poly_composite);
+    CuAssertTrue(test, !poly_composite->is_class);
+
+    // Cleanup
+    ast_free(&ast);
+}
+
+static void TEST_ast_poly_composite_find_generics_count(CuTest *test){
+    ast_t ast;
+    ast_init(&ast, CROSS_COMPILE_NONE);
+
+    add_poly_composite(&ast, strclone("Pair"), 2, false);
+    add_poly_composite(&ast, strclone("Pair"), 1, false);
+
+    // Validate that the number of generics is part of the key
+    CuAssertPtrEquals(test, &ast.poly_composites[0], ast_poly_composite_find_exact(&ast, "Pair", 2));
+    CuAssertPtrEquals(test, &ast.poly_composites[1], ast_poly_composite_find_exact(&ast, "Pair", 1));
+    CuAssertPtrEquals(test, NULL, ast_poly_composite_find_exact(&ast, "Pair", 3));
+
+    weak_cstr_t generics[] = {"A"};
+    ast_type_t type = ast_type_make_base_with_polymorphs(strclone("Pair"), generics, NUM_ITEMS(generics));
+    CuAssertPtrEquals(test, &ast.poly_composites[1], ast_find_composite(&ast, &type));
+    ast_type_free(&type);
+
+    // Validate that polymorphic composites aren't found as regular composites
+    CuAssertPtrEquals(test, NULL, ast_composite_find_exact(&ast, "Pair"));
+
+    // Cleanup
+    ast_free(&ast);
+}
+
+CuSuite *CuSuite_for_ast(void){
+    CuSuite *suite = CuSuiteNew();
+    SUITE_ADD_TEST(suite, TEST_ast_composite_find_after_growth);
+    SUITE_ADD_TEST(suite, TEST_ast_composite_find_duplicate);
+    SUITE_ADD_TEST(suite, TEST_ast_poly_composite_find_generics_count);
+    return suite;
+}
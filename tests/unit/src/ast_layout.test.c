@@ -0,0 +1,84 @@
+
+#include <stdlib.h>
+
+#include "AST/ast_layout.h"
+#include "CuTest.h"
+#include "UTIL/ground.h"
+#include "UTIL/string.h"
+#include "UTIL/util.h"
+
+static ast_layout_endpoint_t make_endpoint(length_t index){
+    ast_layout_endpoint_t endpoint;
+    ast_layout_endpoint_init(&endpoint);
+    ast_layout_endpoint_add_index(&endpoint, (uint16_t) index);
+    return endpoint;
+}
+
+static void add_fields(ast_field_map_t *field_map, length_t start, length_t end){
+    for(length_t i = start; i != end; i++){
+        ast_field_map_add(field_map, mallocandsprintf("field%d", (int) i), make_endpoint(i));
+    }
+}
+
+static void assert_finds_fields(CuTest *test, ast_field_map_t *field_map, length_t count){
+    ast_layout_endpoint_t endpoint;
+
+    for(length_t i = 0; i != count; i++){
+        strong_cstr_t name = mallocandsprintf("field%d", (int) i);
+        CuAssertTrue(test, ast_field_map_find(field_map, name, &endpoint));
+        CuAssertIntEquals(test, i, endpoint.indices[0]);
+        free(name);
+    }
+
+    CuAssertTrue(test, !ast_field_map_find(field_map, "missing", &endpoint));
+}
+
+static void TEST_ast_field_map_index_small(CuTest *test){
+    ast_field_map_t field_map;
+    ast_field_map_init(&field_map);
+    add_fields(&field_map, 0, AST_FIELD_MAP_INDEX_THRESHOLD - 1);
+
+    // Validate that small field maps keep using a linear search
+    ast_field_map_build_index(&field_map);
+    CuAssertPtrEquals(test, NULL, field_map.slots);
+    assert_finds_fields(test, &field_map, AST_FIELD_MAP_INDEX_THRESHOLD - 1);
+
+    // Cleanup
+    ast_field_map_free(&field_map);
+}
+
+static void TEST_ast_field_map_index_large(CuTest *test){
+    ast_field_map_t field_map;
+    ast_field_map_init(&field_map);
+    add_fields(&field_map, 0, 100);
+
+    ast_field_map_build_index(&field_map);
+    CuAssertTrue(test, field_map.slots != NULL);
+    assert_finds_fields(test, &field_map, 100);
+
+    // Validate that fields added afterwards are still found, even once the index grows
+    add_fields(&field_map, 100, 500);
+    assert_finds_fields(test, &field_map, 500);
+
+    // Validate that the first of two fields with the same name wins, like the linear search
+    ast_layout_endpoint_t endpoint;
+    ast_field_map_add(&field_map, strclone("field7"), make_endpoint(1000));
+    CuAssertTrue(test, ast_field_map_find(&field_map, "field7", &endpoint));
+    CuAssertIntEquals(test, 7, endpoint.indices[0]);
+
+    // Validate that clones get their own index
+    ast_field_map_t clone = ast_field_map_clone(&field_map);
+    ast_field_map_free(&field_map);
+    CuAssertTrue(test, clone.slots != NULL);
+    assert_finds_fields(test, &clone, 500);
+
+    // Cleanup
+    ast_field_map_free(&clone);
+}
+
+CuSuite *CuSuite_for_ast_layout(void){
+    CuSuite *suite = CuSuiteNew();
+    SUITE_ADD_TEST(suite, TEST_ast_field_map_index_small);
+    SUITE_ADD_TEST(suite, TEST_ast_field_map_index_large);
+    return suite;
+}
@@ -0,0 +1,115 @@
+
+#include <stdlib.h>
+
+#include "AST/TYPE/ast_type_intern.h"
+#include "AST/TYPE/ast_type_make.h"
+#include "AST/ast_type.h"
+#include "CuTest.h"
+#include "IRGEN/ir_cache.h"
+#include "UTIL/ground.h"
+#include "UTIL/string.h"
+#include "UTIL/util.h"
+
+static void TEST_ast_type_intern_identical(CuTest *test){
+    ast_type_intern_table_t table;
+    ast_type_intern_table_init(&table);
+
+    // Create two separate but identical types
+    ast_type_t a = ast_type_make_base_ptr(strclone("Person"));
+    ast_type_t b = ast_type_make_base_ptr(strclone("Person"));
+
+    const ast_canonical_type_t *canonical_a = ast_type_intern(&table, &a);
+    const ast_canonical_type_t *canonical_b = ast_type_intern(&table, &b);
+
+    // Validate that they share a canonical copy which doesn't depend on either
+    CuAssertPtrEquals(test, (void*) canonical_a, (void*) canonical_b);
+    CuAssertIntEquals(test, 0, canonical_a->id);
+    CuAssertTrue(test, canonical_a->type.elements != a.elements);
+
+    ast_type_free(&a);
+    ast_type_free(&b);
+
+    strong_cstr_t actual = ast_type_str(&canonical_a->type);
+    CuAssertStrEquals(test, "*Person", actual);
+
+    // Cleanup
+    free(actual);
+    ast_type_intern_table_free(&table);
+}
+
+static void TEST_ast_type_intern_distinct(CuTest *test){
+    ast_type_intern_table_t table;
+    ast_type_intern_table_init(&table);
+
+    // Intern enough distinct types to require the table to grow
+    length_t count = 1000;
+    ast_type_t *types = malloc(sizeof(ast_type_t) * count);
+    const ast_canonical_type_t **canonicals = malloc(sizeof(ast_canonical_type_t*) * count);
+
+    for(length_t i = 0; i != count; i++){
+        types[i] = ast_type_make_base(mallocandsprintf("T%d", (int) i));
+        canonicals[i] = ast_type_intern(&table, &types[i]);
+    }
+
+    // Validate that each type got its own canonical copy, with ids in order
+    for(length_t i = 0; i != count; i++){
+        CuAssertIntEquals(test, i, canonicals[i]->id);
+        CuAssertPtrEquals(test, (void*) canonicals[i], (void*) ast_type_intern_find(&table, &types[i]));
+    }
+
+    ast_type_t missing = ast_type_make_base(strclone("Missing"));
+    CuAssertPtrEquals(test, NULL, (void*) ast_type_intern_find(&table, &missing));
+
+    // Cleanup
+    ast_type_free(&missing);
+    ast_types_free(types, count);
+    free(types);
+    free(canonicals);
+    ast_type_intern_table_free(&table);
+}
+
+static void TEST_ast_type_intern_sf_cache(CuTest *test){
+    ast_type_intern_table_t table;
+    ast_type_intern_table_init(&table);
+
+    ir_gen_sf_cache_t cache;
+    ir_gen_sf_cache_init(&cache, &table);
+
+    // Insert enough types for the entries array to grow
+    length_t count = 1000;
+    ast_type_t *types = malloc(sizeof(ast_type_t) * count);
+    ir_gen_sf_cache_entry_t **entries = malloc(sizeof(ir_gen_sf_cache_entry_t*) * count);
+
+    for(length_t i = 0; i != count; i++){
+        types[i] = ast_type_make_base(mallocandsprintf("T%d", (int) i));
+        entries[i] = ir_gen_sf_cache_locate_or_insert(&cache, &types[i]);
+        entries[i]->has_pass = TROOLEAN_FALSE;
+    }
+
+    // Validate that entries are keyed by canonical id and never move
+    for(length_t i = 0; i != count; i++){
+        ast_type_t same = ast_type_make_base(mallocandsprintf("T%d", (int) i));
+        ir_gen_sf_cache_entry_t *entry = ir_gen_sf_cache_locate_or_insert(&cache, &same);
+
+        CuAssertPtrEquals(test, entries[i], entry);
+        CuAssertIntEquals(test, i, entry->canonical->id);
+        CuAssertIntEquals(test, TROOLEAN_FALSE, entry->has_pass);
+        CuAssertIntEquals(test, TROOLEAN_UNKNOWN, entry->has_defer);
+        ast_type_free(&same);
+    }
+
+    // Cleanup
+    ast_types_free(types, count);
+    free(types);
+    free(entries);
+    ir_gen_sf_cache_free(&cache);
+    ast_type_intern_table_free(&table);
+}
+
+CuSuite *CuSuite_for_ast_type(void){
+    CuSuite *suite = CuSuiteNew();
+    SUITE_ADD_TEST(suite, TEST_ast_type_intern_identical);
+    SUITE_ADD_TEST(suite, TEST_ast_type_intern_distinct);
+    SUITE_ADD_TEST(suite, TEST_ast_type_intern_sf_cache);
+    return suite;
+}
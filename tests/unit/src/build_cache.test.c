@@ -0,0 +1,101 @@
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <utime.h>
+#endif
+
+#include "CuTest.h"
+#include "DRVR/build_cache.h"
+#include "UTIL/ground.h"
+#include "UTIL/util.h"
+
+#ifndef _WIN32
+
+static const char *entry_names[] = {
+    "00000000000000000000000000000000",
+    "11111111111111111111111111111111",
+    "22222222222222222222222222222222",
+    "33333333333333333333333333333333",
+    "44444444444444444444444444444444",
+};
+
+static strong_cstr_t create_file(const char *directory, const char *name, time_t last_used){
+    strong_cstr_t filename = mallocandsprintf("%s%s", directory, name);
+
+    FILE *file = fopen(filename, "wb");
+    fwrite("0123456789", 1, 10, file);
+    fclose(file);
+
+    struct utimbuf times = {.actime = last_used, .modtime = last_used};
+    utime(filename, &times);
+    return filename;
+}
+
+static void TEST_build_cache_evict(CuTest *test){
+    char directory_template[] = "/tmp/adept-build-cache-test-XXXXXX";
+    CuAssertPtrNotNull(test, mkdtemp(directory_template));
+
+    strong_cstr_t directory = mallocandsprintf("%s/", directory_template);
+    strong_cstr_t entries[NUM_ITEMS(entry_names)];
+
+    // Oldest entries first
+    for(length_t i = 0; i != NUM_ITEMS(entry_names); i++){
+        entries[i] = create_file(directory, entry_names[i], 1000 + i);
+    }
+
+    // Files that aren't cache entries are never evicted
+    strong_cstr_t tokens = create_file(directory, "f93707666644a90221cbb7f97676a24d.tokens", 1);
+    strong_cstr_t temporary = create_file(directory, "00000000000000000000000000000000.123.tmp", 1);
+
+    // Bounded by number of entries
+    build_cache_evict(directory, 3, UINT64_MAX);
+
+    CuAssertTrue(test, !file_exists(entries[0]));
+    CuAssertTrue(test, !file_exists(entries[1]));
+    CuAssertTrue(test, file_exists(entries[2]));
+    CuAssertTrue(test, file_exists(entries[3]));
+    CuAssertTrue(test, file_exists(entries[4]));
+    CuAssertTrue(test, file_exists(tokens));
+    CuAssertTrue(test, file_exists(temporary));
+
+    // Bounded by size, where only one 10 byte entry fits
+    build_cache_evict(directory, 64, 15);
+
+    CuAssertTrue(test, !file_exists(entries[2]));
+    CuAssertTrue(test, !file_exists(entries[3]));
+    CuAssertTrue(test, file_exists(entries[4]));
+
+    // The most recently used entry is kept even if it's too big
+    build_cache_evict(directory, 0, 0);
+    CuAssertTrue(test, file_exists(entries[4]));
+
+    for(length_t i = 0; i != NUM_ITEMS(entry_names); i++){
+        remove(entries[i]);
+        free(entries[i]);
+    }
+
+    remove(tokens);
+    remove(temporary);
+    rmdir(directory_template);
+
+    free(tokens);
+    free(temporary);
+    free(directory);
+}
+
+#endif // _WIN32
+
+CuSuite *CuSuite_for_build_cache(void){
+    CuSuite *suite = CuSuiteNew();
+
+    #ifndef _WIN32
+    SUITE_ADD_TEST(suite, TEST_build_cache_evict);
+    #endif
+
+    return suite;
+}
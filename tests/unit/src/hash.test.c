@@ -0,0 +1,97 @@
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "AST/TYPE/ast_type_hash.h"
+#include "CuTest.h"
+#include "TypeCorpus.h"
+#include "UTIL/ground.h"
+#include "UTIL/hash.h"
+
+static void TEST_hash_data_lengths(CuTest *test){
+    char buffer[200];
+
+    for(length_t i = 0; i != sizeof buffer; i++){
+        buffer[i] = 'a' + i % 26;
+    }
+
+    // Every length takes a different path through the hash, so check that each prefix is distinct
+    hash_t hashes[sizeof buffer + 1];
+
+    for(length_t length = 0; length <= sizeof buffer; length++){
+        hashes[length] = hash_data(buffer, length);
+
+        for(length_t i = 0; i != length; i++){
+            CuAssertTrue(test, hashes[i] != hashes[length]);
+        }
+    }
+
+    // Every byte should affect the hash
+    hash_t original = hash_data(buffer, sizeof buffer);
+
+    for(length_t i = 0; i != sizeof buffer; i++){
+        buffer[i] ^= 0x01;
+        CuAssertTrue(test, hash_data(buffer, sizeof buffer) != original);
+        buffer[i] ^= 0x01;
+    }
+}
+
+static void TEST_hash_combine_order(CuTest *test){
+    hash_t a = hash_string("List");
+    hash_t b = hash_string("String");
+
+    CuAssertTrue(test, hash_combine(a, b) != hash_combine(b, a));
+    CuAssertTrue(test, hash_combine(0, a) != hash_combine(0, b));
+    CuAssertTrue(test, hash_combine(a, 0) != hash_combine(b, 0));
+}
+
+static void TEST_hash_type_distribution(CuTest *test){
+    length_t length;
+    ast_type_t *types = type_corpus_create(&length);
+    hash_t *hashes = malloc(sizeof(hash_t) * length);
+
+    for(length_t i = 0; i != length; i++){
+        hashes[i] = ast_type_hash(&types[i]);
+    }
+
+    // No two distinct types should have the same full hash
+    for(length_t i = 0; i != length; i++){
+        for(length_t j = i + 1; j != length; j++){
+            CuAssertTrue(test, hashes[i] != hashes[j]);
+        }
+    }
+
+    // Tables pick buckets using the low bits of hashes, so those
+    // should spread out about as evenly as a random function would
+    length_t num_buckets = 1024;
+    length_t *buckets = calloc(num_buckets, sizeof(length_t));
+
+    for(length_t i = 0; i != length; i++){
+        buckets[hashes[i] % num_buckets]++;
+    }
+
+    length_t longest = 0, used = 0;
+
+    for(length_t i = 0; i != num_buckets; i++){
+        if(buckets[i] > longest) longest = buckets[i];
+        if(buckets[i] != 0) used++;
+    }
+
+    // For ~1300 random hashes into 1024 buckets, about 730 buckets are used
+    // and the longest chain is almost never over 8
+    CuAssertTrue(test, longest <= 8);
+    CuAssertTrue(test, used >= 650);
+
+    free(buckets);
+    free(hashes);
+    type_corpus_free(types, length);
+}
+
+CuSuite *CuSuite_for_hash(void){
+    CuSuite *suite = CuSuiteNew();
+    SUITE_ADD_TEST(suite, TEST_hash_data_lengths);
+    SUITE_ADD_TEST(suite, TEST_hash_combine_order);
+    SUITE_ADD_TEST(suite, TEST_hash_type_distribution);
+    return suite;
+}
@@ -0,0 +1,72 @@
+
+#include <string.h>
+
+#include "AST/ast.h"
+#include "CuTest.h"
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "IR/ir_pool.h"
+#include "IR/ir_type.h"
+#include "IRGEN/ir_gen_type.h"
+#include "LEX/lex.h"
+#include "PARSE/parse.h"
+#include "UTIL/ground.h"
+#include "UTIL/string.h"
+
+static void TEST_ir_gen_poly_instance_survives_rollback(CuTest *test){
+    compiler_t compiler;
+    compiler_init(&compiler);
+
+    object_t *object = compiler_new_object(&compiler);
+    object->filename = strclone("fake_filename.adept");
+    object->full_filename = strclone("fake_filename.adept");
+    object->buffer = strclone("struct <$T> Box (value $T, pair 2 $T)\nbox <int> Box\n");
+    object->buffer_length = strlen(object->buffer);
+
+    CuAssert(test, "Failed to lex", lex_buffer(&compiler, object) == SUCCESS);
+    CuAssert(test, "Failed to parse", parse(&compiler, object) == SUCCESS);
+
+    object_create_module(object);
+    CuAssert(test, "Failed to generate type mappings", ir_gen_type_mappings(&compiler, object) == SUCCESS);
+
+    ir_pool_t *pool = &object->ir_module.pool;
+    ast_type_t *box_type = NULL;
+
+    for(length_t i = 0; i != object->ast.globals_length; i++){
+        if(streq(object->ast.globals[i].name, "box")) box_type = &object->ast.globals[i].type;
+    }
+
+    CuAssertTrue(test, box_type != NULL);
+
+    // Resolve the instance for the first time inside of a region that gets rolled back
+    ir_pool_snapshot_t snapshot = ir_pool_snapshot_capture(pool);
+
+    ir_type_t *first;
+    CuAssert(test, "Failed to resolve type", ir_gen_resolve_type(&compiler, object, box_type, &first) == SUCCESS);
+
+    ir_pool_snapshot_restore(pool, &snapshot);
+
+    // Reuse the memory that was rolled back, by filling the rest of the current fragment
+    ir_pool_fragment_t *fragment = &pool->fragments[pool->length - 1];
+    length_t remaining = fragment->capacity - fragment->used - POOL_ALLOCATION_ALIGNMENT;
+    memset(ir_pool_alloc(pool, remaining), 0xFF, remaining);
+
+    // Validate that the cached instance is still intact
+    ir_type_t *second;
+    CuAssert(test, "Failed to resolve type", ir_gen_resolve_type(&compiler, object, box_type, &second) == SUCCESS);
+    CuAssertPtrEquals(test, first, second);
+    CuAssertIntEquals(test, TYPE_KIND_STRUCTURE, second->kind);
+
+    ir_type_extra_composite_t *composite = second->extra;
+    CuAssertIntEquals(test, 2, composite->subtypes_length);
+    CuAssertIntEquals(test, TYPE_KIND_S32, composite->subtypes[0]->kind);
+    CuAssertIntEquals(test, TYPE_KIND_FIXED_ARRAY, composite->subtypes[1]->kind);
+
+    compiler_free(&compiler);
+}
+
+CuSuite *CuSuite_for_ir_gen_type(void){
+    CuSuite *suite = CuSuiteNew();
+    SUITE_ADD_TEST(suite, TEST_ir_gen_poly_instance_survives_rollback);
+    return suite;
+}
@@ -6,9 +6,12 @@
 #include "DRVR/compiler.h"
 #include "DRVR/object.h"
 #include "LEX/lex.h"
+#include "LEX/lex_scan.h"
 #include "LEX/token.h"
 #include "TOKEN/token_data.h"
 #include "UTIL/ground.h"
+#include "UTIL/intern.h"
+#include "UTIL/string_builder.h"
 #include "UTIL/string.h"
 
 static void TEST_lex_1(CuTest *test){
@@ -104,9 +107,231 @@ static void TEST_lex_2(CuTest *test){
     compiler_free(&compiler);
 }
 
+static void TEST_lex_line_offsets(CuTest *test){
+    compiler_t compiler;
+    compiler_init(&compiler);
+
+    object_t *object = compiler_new_object(&compiler);
+    object->filename = strclone("fake_filename.adept");
+    object->full_filename = strclone("fake_filename.adept");
+    object->buffer = strclone("func main() {\n\n    x int = 10\n\tprint(\"Hello World\")\n}\n");
+    object->buffer_length = strlen(object->buffer);
+
+    CuAssert(test, "Failed to lex", lex_buffer(&compiler, object) == SUCCESS);
+    CuAssertIntEquals(test, 6, object->line_offsets_length);
+
+    // Every index should map to the same location as a full rescan of the buffer would give
+    for(length_t i = 0; i <= object->buffer_length; i++){
+        int expected_line, expected_column, actual_line, actual_column;
+        lex_get_location(object->buffer, i, &expected_line, &expected_column);
+        lex_get_object_location(object, i, &actual_line, &actual_column);
+
+        CuAssertIntEquals_Msgf(test, "incorrect line for index %d", expected_line, actual_line, (int) i);
+        CuAssertIntEquals_Msgf(test, "incorrect column for index %d", expected_column, actual_column, (int) i);
+    }
+
+    CuAssertIntEquals(test, 0, lex_get_line_offset(object, 1));
+    CuAssertIntEquals(test, 14, lex_get_line_offset(object, 2));
+    CuAssertIntEquals(test, 15, lex_get_line_offset(object, 3));
+
+    compiler_free(&compiler);
+}
+
+static void TEST_lex_interned_words(CuTest *test){
+    compiler_t compiler;
+    compiler_init(&compiler);
+
+    object_t *object = compiler_new_object(&compiler);
+    object->filename = strclone("fake_filename.adept");
+    object->full_filename = strclone("fake_filename.adept");
+    object->buffer = strclone("x = x + y\nfunc if_x elif a:b a\\b $T $T\n");
+    object->buffer_length = strlen(object->buffer);
+
+    CuAssert(test, "Failed to lex", lex_buffer(&compiler, object) == SUCCESS);
+
+    tokenid_t expected_token_ids[] = {
+        TOKEN_WORD, TOKEN_ASSIGN, TOKEN_WORD, TOKEN_ADD, TOKEN_WORD, TOKEN_NEWLINE,
+        TOKEN_FUNC, TOKEN_WORD, TOKEN_ELSE, TOKEN_IF, TOKEN_WORD, TOKEN_WORD, TOKEN_POLYMORPH, TOKEN_POLYMORPH, TOKEN_NEWLINE
+    };
+
+    CuAssertIntEquals(test, sizeof(expected_token_ids) / sizeof(tokenid_t), object->tokenlist.length);
+
+    for(length_t i = 0; i < object->tokenlist.length; i++){
+        CuAssertIntEquals_Msgf(test, "incorrect tokens[%d].id", expected_token_ids[i], object->tokenlist.tokens[i].id, (int) i);
+    }
+
+    token_t *tokens = object->tokenlist.tokens;
+
+    // Equal identifiers should share the same interned string
+    CuAssertStrEquals(test, "x", tokens[0].data);
+    CuAssertPtrEquals(test, tokens[0].data, tokens[2].data);
+    CuAssertTrue(test, tokens[0].data != tokens[4].data);
+    CuAssertStrEquals(test, "if_x", tokens[7].data);
+    CuAssertStrEquals(test, "a\\b", tokens[10].data);
+    CuAssertPtrEquals(test, tokens[10].data, tokens[11].data);
+    CuAssertPtrEquals(test, tokens[12].data, tokens[13].data);
+
+    symbol_id_t id;
+    CuAssertTrue(test, intern_table_find(&compiler.symbols, "y", 1, &id));
+    CuAssertPtrEquals(test, tokens[4].data, intern_table_name(&compiler.symbols, id));
+    CuAssertTrue(test, !intern_table_find(&compiler.symbols, "func", 4, NULL));
+
+    // Names from elsewhere resolve to the same interned strings as the tokens
+    CuAssertPtrEquals(test, tokens[4].data, intern_table_find_cstr(&compiler.symbols, "y"));
+    CuAssertPtrEquals(test, tokens[0].data, intern_table_insert_cstr(&compiler.symbols, "x"));
+    CuAssertPtrEquals(test, NULL, intern_table_find_cstr(&compiler.symbols, "z"));
+
+    compiler_free(&compiler);
+}
+
+static void TEST_lex_keywords(CuTest *test){
+    compiler_t compiler;
+    compiler_init(&compiler);
+
+    object_t *object = compiler_new_object(&compiler);
+    object->filename = strclone("fake_filename.adept");
+    object->full_filename = strclone("fake_filename.adept");
+
+    // Every keyword separated by spaces
+    string_builder_t builder;
+    string_builder_init(&builder);
+
+    for(length_t i = 0; i != global_token_keywords_list_length; i++){
+        string_builder_append(&builder, global_token_keywords_list[i]);
+        string_builder_append_char(&builder, ' ');
+    }
+
+    string_builder_append_char(&builder, '\n');
+    object->buffer = string_builder_finalize(&builder);
+    object->buffer_length = strlen(object->buffer);
+
+    CuAssert(test, "Failed to lex", lex_buffer(&compiler, object) == SUCCESS);
+    CuAssertIntEquals(test, global_token_keywords_list_length + 1, object->tokenlist.length);
+
+    for(length_t i = 0; i != global_token_keywords_list_length; i++){
+        CuAssertIntEquals_Msgf(test, "incorrect token for keyword '%s'", BEGINNING_OF_KEYWORD_TOKENS + i, object->tokenlist.tokens[i].id, global_token_keywords_list[i]);
+    }
+
+    compiler_free(&compiler);
+}
+
+static void TEST_lex_long_runs(CuTest *test){
+    compiler_t compiler;
+    compiler_init(&compiler);
+
+    object_t *object = compiler_new_object(&compiler);
+    object->filename = strclone("fake_filename.adept");
+    object->full_filename = strclone("fake_filename.adept");
+
+    // Runs of whitespace, identifiers, strings, and comments that are longer than a vector
+    // NOTE: Escape sequence in the string straddles the 16 and 32 character boundaries
+    string_builder_t builder;
+    string_builder_init(&builder);
+    string_builder_append(&builder, "                                        ");
+    string_builder_append(&builder, "a_really_long_identifier_name_that_keeps_going_123 ");
+    string_builder_append(&builder, "\"0123456789abcd\\\"0123456789abcd\\\\0123456789abcdef\"\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t");
+    string_builder_append(&builder, "/* a long comment with a * and a / inside of it ********* */x");
+    string_builder_append(&builder, "// a long line comment that goes on for more than thirty-two characters\n");
+    object->buffer = string_builder_finalize(&builder);
+    object->buffer_length = strlen(object->buffer);
+
+    CuAssert(test, "Failed to lex", lex_buffer(&compiler, object) == SUCCESS);
+
+    tokenid_t expected_token_ids[] = {
+        TOKEN_WORD, TOKEN_STRING, TOKEN_WORD, TOKEN_NEWLINE
+    };
+    source_t expected_sources[] = {
+        {.object_index = 0, .index = 40, .stride = 50},
+        {.object_index = 0, .index = 91, .stride = 50},
+        {.object_index = 0, .index = 219, .stride = 1},
+        {.object_index = 0, .index = 291, .stride = 1},
+    };
+
+    CuAssertIntEquals(test, sizeof(expected_token_ids) / sizeof(tokenid_t), object->tokenlist.length);
+
+    for(length_t i = 0; i < object->tokenlist.length; i++){
+        CuAssertIntEquals_Msgf(test, "incorrect tokens[%d].id", expected_token_ids[i], object->tokenlist.tokens[i].id, (int) i);
+
+        source_t actual = object->tokenlist.sources[i];
+        source_t expected = expected_sources[i];
+
+        CuAssertIntEquals_Msgf(test, "incorrect sources[%d].index", expected.index, actual.index, i);
+        CuAssertIntEquals_Msgf(test, "incorrect sources[%d].stride", expected.stride, actual.stride, i);
+    }
+
+    token_t *tokens = object->tokenlist.tokens;
+    CuAssertStrEquals(test, "a_really_long_identifier_name_that_keeps_going_123", tokens[0].data);
+    CuAssertStrEquals(test, "0123456789abcd\"0123456789abcd\\0123456789abcdef", ((token_string_data_t*) tokens[1].data)->array);
+
+    compiler_free(&compiler);
+}
+
+static void TEST_lex_scan_run_lengths(CuTest *test){
+    // Every run length from empty to several vectors long, so that the scalar prefix,
+    // SSE2, AVX2 (when supported), and scalar tail are each where a run ends
+    char buffer[160];
+
+    for(int length = 0; length != 128; length++){
+        memset(buffer, ' ', length);
+        memset(&buffer[length], '+', sizeof buffer - length);
+        CuAssertPtrEquals(test, &buffer[length], (void*) lex_scan_blanks(buffer, &buffer[sizeof buffer]));
+        CuAssertPtrEquals(test, &buffer[length], (void*) lex_scan_blanks(buffer, &buffer[length]));
+
+        memset(buffer, 'z', length);
+        memset(&buffer[length], '.', sizeof buffer - length);
+        CuAssertPtrEquals(test, &buffer[length], (void*) lex_scan_identifier(buffer, &buffer[sizeof buffer]));
+        CuAssertPtrEquals(test, &buffer[length], (void*) lex_scan_identifier(buffer, &buffer[length]));
+
+        memset(buffer, 'x', sizeof buffer);
+        buffer[length] = '"';
+        buffer[length + 1] = '\\';
+        CuAssertPtrEquals(test, &buffer[length], (void*) lex_scan_either(buffer, &buffer[sizeof buffer], '"', '\\'));
+        CuAssertPtrEquals(test, &buffer[length], (void*) lex_scan_either(buffer, &buffer[length], '"', '\\'));
+    }
+}
+
+static void TEST_lex_wide_strides(CuTest *test){
+    compiler_t compiler;
+    compiler_init(&compiler);
+
+    object_t *object = compiler_new_object(&compiler);
+    object->filename = strclone("fake_filename.adept");
+    object->full_filename = strclone("fake_filename.adept");
+
+    // String literal that is too long for its stride to fit in a 'source_t'
+    string_builder_t builder;
+    string_builder_init(&builder);
+    string_builder_append(&builder, "x = \"");
+    for(length_t i = 0; i != 70000; i++) string_builder_append_char(&builder, 'a');
+    string_builder_append(&builder, "\" y\n");
+    object->buffer = string_builder_finalize(&builder);
+    object->buffer_length = strlen(object->buffer);
+
+    CuAssert(test, "Failed to lex", lex_buffer(&compiler, object) == SUCCESS);
+
+    tokenlist_t *tokenlist = &object->tokenlist;
+    CuAssertIntEquals(test, 5, tokenlist->length);
+    CuAssertIntEquals(test, TOKEN_STRING, tokenlist->tokens[2].id);
+    CuAssertIntEquals(test, SOURCE_WIDE_STRIDE, tokenlist->sources[2].stride);
+    CuAssertIntEquals(test, 70002, tokenlist_source_stride(tokenlist, tokenlist->sources[2]));
+
+    // Sources that aren't wide are unaffected
+    CuAssertIntEquals(test, 70007, tokenlist->sources[3].index);
+    CuAssertIntEquals(test, 1, tokenlist_source_stride(tokenlist, tokenlist->sources[3]));
+    CuAssertIntEquals(test, 1, tokenlist->wide_strides_length);
+
+    compiler_free(&compiler);
+}
+
 CuSuite *CuSuite_for_lex(void){
     CuSuite *suite = CuSuiteNew();
     SUITE_ADD_TEST(suite, TEST_lex_1);
     SUITE_ADD_TEST(suite, TEST_lex_2);
+    SUITE_ADD_TEST(suite, TEST_lex_line_offsets);
+    SUITE_ADD_TEST(suite, TEST_lex_interned_words);
+    SUITE_ADD_TEST(suite, TEST_lex_keywords);
+    SUITE_ADD_TEST(suite, TEST_lex_long_runs);
+    SUITE_ADD_TEST(suite, TEST_lex_scan_run_lengths);
+    SUITE_ADD_TEST(suite, TEST_lex_wide_strides);
     return suite;
 }
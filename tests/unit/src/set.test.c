@@ -0,0 +1,103 @@
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "CuTest.h"
+#include "UTIL/ground.h"
+#include "UTIL/hash.h"
+#include "UTIL/map.h"
+#include "UTIL/set.h"
+#include "UTIL/string.h"
+#include "UTIL/util.h"
+
+static hash_t string_hash(const void *string){
+    return hash_string((const char*) string);
+}
+
+static bool string_equals(const void *a, const void *b){
+    return streq((const char*) a, (const char*) b);
+}
+
+static void *string_clone(const void *string){
+    return strclone((const char*) string);
+}
+
+static void count_item(void *item, void *user_pointer){
+    (void) item;
+    (*(length_t*) user_pointer)++;
+}
+
+static void TEST_set_insert_grows(CuTest *test){
+    set_t set;
+    set_init(&set, 0, &string_hash, &string_equals, &string_clone);
+
+    // Insert enough items to grow the set several times, each one twice
+    for(length_t i = 0; i != 1000; i++){
+        strong_cstr_t name = mallocandsprintf("Type%d", (int) i);
+        CuAssertTrue(test, set_insert(&set, name));
+        CuAssertTrue(test, !set_insert(&set, name));
+        free(name);
+    }
+
+    CuAssertIntEquals(test, 1000, set.count);
+    CuAssertTrue(test, set.count * 2 <= set.capacity);
+
+    // Every item should still be visited exactly once
+    length_t visited = 0;
+    set_collect(&set, &count_item, &visited);
+    CuAssertIntEquals(test, 1000, visited);
+
+    set_free(&set, &free);
+}
+
+static void TEST_map_insert_and_find(CuTest *test){
+    map_t map;
+    map_init(&map, 4, &string_hash, &string_equals);
+
+    strong_cstr_t keys[1000];
+
+    for(length_t i = 0; i != 1000; i++){
+        keys[i] = mallocandsprintf("field_%d", (int) i);
+        CuAssertTrue(test, map_insert(&map, keys[i], (void*) (uintptr_t) (i + 1)));
+    }
+
+    CuAssertTrue(test, !map_insert(&map, "field_10", (void*) 0x1));
+    CuAssertIntEquals(test, 1000, map.count);
+
+    for(length_t i = 0; i != 1000; i++){
+        CuAssertIntEquals(test, i + 1, (uintptr_t) map_find(&map, keys[i]));
+    }
+
+    CuAssertPtrEquals(test, NULL, map_find(&map, "field_1000"));
+    CuAssertTrue(test, !map_has(&map, "missing"));
+
+    // Replacing a value should return the old one
+    CuAssertIntEquals(test, 11, (uintptr_t) map_set(&map, "field_10", (void*) 0x2));
+    CuAssertIntEquals(test, 2, (uintptr_t) map_find(&map, "field_10"));
+    CuAssertIntEquals(test, 1000, map.count);
+
+    map_free(&map, NULL);
+
+    for(length_t i = 0; i != 1000; i++){
+        free(keys[i]);
+    }
+}
+
+static void TEST_map_empty(CuTest *test){
+    map_t map;
+    map_init(&map, 0, &string_hash, &string_equals);
+
+    CuAssertPtrEquals(test, NULL, map_find(&map, "anything"));
+    CuAssertTrue(test, !map_has(&map, "anything"));
+
+    map_free(&map, NULL);
+}
+
+CuSuite *CuSuite_for_set(void){
+    CuSuite *suite = CuSuiteNew();
+    SUITE_ADD_TEST(suite, TEST_set_insert_grows);
+    SUITE_ADD_TEST(suite, TEST_map_insert_and_find);
+    SUITE_ADD_TEST(suite, TEST_map_empty);
+    return suite;
+}
@@ -0,0 +1,62 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CuTest.h"
+#include "UTIL/ground.h"
+#include "UTIL/sha256.h"
+
+static void assert_digest(CuTest *test, const char *expected, sha256_t *sha256){
+    uint8_t digest[SHA256_DIGEST_SIZE];
+    sha256_finish(sha256, digest);
+
+    char actual[SHA256_DIGEST_SIZE * 2 + 1];
+
+    for(length_t i = 0; i != SHA256_DIGEST_SIZE; i++){
+        snprintf(&actual[i * 2], 3, "%02x", digest[i]);
+    }
+
+    CuAssertStrEquals(test, expected, actual);
+}
+
+static void assert_digest_of(CuTest *test, const char *expected, const char *message){
+    sha256_t sha256;
+    sha256_init(&sha256);
+    sha256_update(&sha256, message, strlen(message));
+    assert_digest(test, expected, &sha256);
+}
+
+static void TEST_sha256_known_answers(CuTest *test){
+    // Test vectors from FIPS 180-4 examples
+    assert_digest_of(test, "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", "");
+    assert_digest_of(test, "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", "abc");
+    assert_digest_of(test, "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1",
+        "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq");
+}
+
+static void TEST_sha256_split_updates(CuTest *test){
+    // One million 'a' characters, added in pieces that don't line up with blocks
+    length_t total = 1000000;
+    char *buffer = malloc(total);
+    memset(buffer, 'a', total);
+
+    sha256_t sha256;
+    sha256_init(&sha256);
+
+    for(length_t offset = 0, step = 1; offset != total; step = step % 131 + 1){
+        length_t size = total - offset < step ? total - offset : step;
+        sha256_update(&sha256, &buffer[offset], size);
+        offset += size;
+    }
+
+    assert_digest(test, "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0", &sha256);
+    free(buffer);
+}
+
+CuSuite *CuSuite_for_sha256(void){
+    CuSuite *suite = CuSuiteNew();
+    SUITE_ADD_TEST(suite, TEST_sha256_known_answers);
+    SUITE_ADD_TEST(suite, TEST_sha256_split_updates);
+    return suite;
+}
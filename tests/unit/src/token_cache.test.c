@@ -0,0 +1,124 @@
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <unistd.h>
+#include <utime.h>
+#endif
+
+#include "CuTest.h"
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "LEX/token_cache.h"
+#include "UTIL/ground.h"
+#include "UTIL/string.h"
+#include "UTIL/util.h"
+
+#ifndef _WIN32
+
+static void write_file(const char *filename, const char *contents, time_t modified){
+    FILE *file = fopen(filename, "wb");
+    fwrite(contents, 1, strlen(contents), file);
+    fclose(file);
+
+    struct utimbuf times = {.actime = modified, .modtime = modified};
+    utime(filename, &times);
+}
+
+static length_t count_images(const char *directory){
+    DIR *dir = opendir(directory);
+    if(dir == NULL) return 0;
+
+    length_t count = 0;
+    struct dirent *dirent;
+
+    while((dirent = readdir(dir))){
+        length_t length = strlen(dirent->d_name);
+        if(length > 7 && streq(&dirent->d_name[length - 7], ".tokens")) count++;
+    }
+
+    closedir(dir);
+    return count;
+}
+
+// Lexes a file through the token cache, and returns its number of tokens,
+// or -1 on failure
+static int cache_lex(weak_cstr_t filename, bool *out_was_cached){
+    compiler_t compiler;
+    compiler_init(&compiler);
+
+    object_t *object = compiler_new_object(&compiler);
+    object->filename = strclone(filename);
+    object->full_filename = strclone(filename);
+
+    int result = -1;
+
+    if(file_text_contents(filename, &object->buffer, &object->buffer_length, false) && token_cache_lex(&compiler, object) == SUCCESS){
+        result = (int) object->tokenlist.length;
+        *out_was_cached = object->tokenlist.image != NULL;
+    }
+
+    compiler_free(&compiler);
+    return result;
+}
+
+static void TEST_token_cache_edit_replaces_image(CuTest *test){
+    char directory_template[] = "/tmp/adept-token-cache-test-XXXXXX";
+    CuAssertPtrNotNull(test, mkdtemp(directory_template));
+
+    maybe_null_strong_cstr_t previous_cache_home = getenv("XDG_CACHE_HOME") ? strclone(getenv("XDG_CACHE_HOME")) : NULL;
+    setenv("XDG_CACHE_HOME", directory_template, 1);
+
+    strong_cstr_t filename = mallocandsprintf("%s/main.adept", directory_template);
+    strong_cstr_t cache_directory = mallocandsprintf("%s/adept/", directory_template);
+    bool was_cached;
+
+    // First lex stores an image, and second lex uses it
+    write_file(filename, "func main { x int = 10 }\n", 1000);
+    int length = cache_lex(filename, &was_cached);
+    CuAssertTrue(test, length > 0);
+    CuAssertTrue(test, !was_cached);
+    CuAssertIntEquals(test, 1, count_images(cache_directory));
+
+    CuAssertIntEquals(test, length, cache_lex(filename, &was_cached));
+    CuAssertTrue(test, was_cached);
+
+    // Editing the file replaces its image instead of adding another
+    write_file(filename, "func main { x int = 10 + 20 }\n", 2000);
+    CuAssertIntEquals(test, length + 2, cache_lex(filename, &was_cached));
+    CuAssertTrue(test, !was_cached);
+    CuAssertIntEquals(test, 1, count_images(cache_directory));
+
+    CuAssertIntEquals(test, length + 2, cache_lex(filename, &was_cached));
+    CuAssertTrue(test, was_cached);
+
+    // Cleanup
+    if(previous_cache_home){
+        setenv("XDG_CACHE_HOME", previous_cache_home, 1);
+        free(previous_cache_home);
+    } else {
+        unsetenv("XDG_CACHE_HOME");
+    }
+
+    strong_cstr_t command = mallocandsprintf("rm -rf '%s'", directory_template);
+    CuAssertIntEquals(test, 0, system(command));
+    free(command);
+    free(cache_directory);
+    free(filename);
+}
+
+#endif // _WIN32
+
+CuSuite *CuSuite_for_token_cache(void){
+    CuSuite *suite = CuSuiteNew();
+
+    #ifndef _WIN32
+    SUITE_ADD_TEST(suite, TEST_token_cache_edit_replaces_image);
+    #endif
+
+    return suite;
+}
@@ -0,0 +1,86 @@
+
+#include <stdlib.h>
+
+#include "AST/TYPE/ast_type_make.h"
+#include "AST/ast_type.h"
+#include "TypeCorpus.h"
+#include "UTIL/ground.h"
+#include "UTIL/string.h"
+#include "UTIL/util.h"
+
+static const char *type_corpus_names[] = {
+    // Primitives
+    "bool", "byte", "ubyte", "short", "ushort", "int", "uint", "long", "ulong",
+    "usize", "float", "double", "ptr", "successful",
+
+    // Standard library
+    "String", "StringView", "StringOwnership", "Any", "AnyType", "AnyTypeKind",
+    "AnyPtrType", "AnyCompositeType", "AnyFuncPtrType", "AnyFixedArrayType", "AnyEnumType",
+    "List", "ListIterator", "Array", "ArrayIterator", "Optional", "Pair", "Unique",
+    "Ownership", "Grid", "Queue", "Stack", "Vector2f", "Vector3f", "Vector4f",
+    "Matrix4f", "Quaternion", "File", "FileHandle", "Terminal", "Random", "JSON",
+    "JSONValue", "JSONKind", "Captured", "CapturedPair", "Variadic", "InitializerList",
+    "VariadicArray", "ErrorOr", "Duration", "Time", "Iterator", "Shape", "Slice",
+};
+
+static const char *type_corpus_containers[] = {
+    "List", "Array", "Optional", "Unique", "Queue", "Stack", "Grid", "InitializerList",
+};
+
+static ast_type_t type_corpus_make_fixed_array(length_t count, const char *base){
+    ast_type_t type;
+    type.elements = malloc(sizeof(ast_elem_t*) * 2);
+    type.elements[0] = ast_elem_fixed_array_make(NULL_SOURCE, count);
+    type.elements[1] = ast_elem_base_make(strclone(base), NULL_SOURCE);
+    type.elements_length = 2;
+    type.source = NULL_SOURCE;
+    return type;
+}
+
+static ast_type_t type_corpus_make_generic(const char *container, const char *argument){
+    ast_type_t *generics = malloc(sizeof(ast_type_t));
+    generics[0] = ast_type_make_base(strclone(argument));
+
+    ast_type_t type;
+    type.elements = malloc(sizeof(ast_elem_t*));
+    type.elements[0] = ast_elem_generic_base_make(strclone(container), NULL_SOURCE, generics, 1);
+    type.elements_length = 1;
+    type.source = NULL_SOURCE;
+    return type;
+}
+
+ast_type_t *type_corpus_create(length_t *out_length){
+    length_t names_length = NUM_ITEMS(type_corpus_names);
+    length_t containers_length = NUM_ITEMS(type_corpus_containers);
+
+    length_t capacity = names_length * 6 + containers_length * names_length * 2;
+    ast_type_t *types = malloc(sizeof(ast_type_t) * capacity);
+    length_t length = 0;
+
+    for(length_t i = 0; i != names_length; i++){
+        const char *name = type_corpus_names[i];
+
+        types[length++] = ast_type_make_base(strclone(name));
+        types[length++] = ast_type_make_base_ptr(strclone(name));
+        types[length++] = ast_type_make_base_ptr_ptr(strclone(name));
+        types[length++] = type_corpus_make_fixed_array(4, name);
+        types[length++] = type_corpus_make_fixed_array(16, name);
+        types[length++] = type_corpus_make_fixed_array(256, name);
+    }
+
+    for(length_t i = 0; i != containers_length; i++){
+        for(length_t j = 0; j != names_length; j++){
+            ast_type_t generic = type_corpus_make_generic(type_corpus_containers[i], type_corpus_names[j]);
+            types[length++] = ast_type_pointer_to(ast_type_clone(&generic));
+            types[length++] = generic;
+        }
+    }
+
+    *out_length = length;
+    return types;
+}
+
+void type_corpus_free(ast_type_t *types, length_t length){
+    ast_types_free(types, length);
+    free(types);
+}